@@ -0,0 +1,68 @@
+#pragma once
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Incremental parser for the accelerometer rig's protocol
+	*
+	* Each frame is a ':' followed by an x, y, and z field for every
+	* sensor, each FIELD_WIDTH characters wide. A field is read the way
+	* atoi would (leading spaces, an optional sign, then digits up to the
+	* first non-digit). Anything between the end of a frame and the next
+	* ':' is ignored, and a frame cut short by a ':' is dropped.
+	*
+	* The bytes are parsed in place as they arrive, in whatever chunks
+	* they arrive in, so nothing is buffered, copied, or allocated.
+	*
+	***********************************************/
+	class AccelerometerFrameParser{
+	public:
+		// width of each field, in characters
+		static const unsigned long int FIELD_WIDTH = 3;
+		// number of axes per sensor
+		static const unsigned long int AXES = 3;
+		static const unsigned long int MAX_SENSORS = 8;
+
+		// _sensors is the number of sensors in each frame (at most MAX_SENSORS)
+		explicit AccelerometerFrameParser(unsigned long int _sensors = 4);
+
+		// parses _size bytes of _data, continuing from wherever the last call left off
+		// returns the number of frames completed
+		unsigned long int parse(const char * _data, unsigned long int _size);
+
+		// returns the value of _axis (0: x, 1: y, 2: z) of sensor _sensor in the latest complete frame
+		int getValue(unsigned long int _sensor, unsigned long int _axis) const;
+		unsigned long int getSensorCount() const;
+		// number of characters in a frame, including the ':'
+		unsigned long int getFrameSize() const;
+
+		// total number of complete frames parsed
+		unsigned long long int getFrameCount() const;
+		// total number of frames which were cut short
+		unsigned long long int getDroppedCount() const;
+
+	private:
+		unsigned long int sensors;
+		int latest[MAX_SENSORS * AXES];
+		int current[MAX_SENSORS * AXES];
+
+		// whether we're between a ':' and the end of its frame
+		bool inFrame;
+		// index into current of the field being parsed
+		unsigned long int field;
+		// number of characters of the field parsed so far
+		unsigned long int fieldChars;
+		int value;
+		bool negative;
+		// whether the field has passed its leading spaces and sign
+		bool started;
+		// whether the field has hit a character which ends the number
+		bool stopped;
+
+		unsigned long long int frameCount;
+		unsigned long long int droppedCount;
+
+		void startField();
+	};
+}
\ No newline at end of file
@@ -2,26 +2,37 @@
 #include <vector>
 
 #include "Arduino.h"
-
-#define LINE_SIZE 37
+#include <SerialReader.h>
+#include <AccelerometerFrameParser.h>
 
 class Accelerometer;
 
+// Reads frames of accelerometer values from an Arduino on a background thread
+// and gives the latest values to the accelerometers once per update
 class AccelerometerParser : public Arduino{
 public:
 	bool forced;
 	bool firstPing;
 
-	explicit AccelerometerParser(std::string portName);
+	// _sensors is the number of accelerometers in each frame the rig sends
+	explicit AccelerometerParser(std::string portName, unsigned long int _sensors = 4);
 	~AccelerometerParser();
 
+	// stops the reader, reopens the port, and starts the reader again if the port opened
+	// the ping is sent again on the next update
+	virtual void connect(std::string _portName) override;
+
+	// the accelerometers are given the values of the sensors in the order they were added
 	Accelerometer *  addAccelerometer();
 
 	virtual void update(Step * _step) override;
 
+	// total number of complete frames received
+	unsigned long long int getFrameCount() const;
+
 private:
-	std::string accumlator;
+	sweet::SerialReader reader;
+	sweet::AccelerometerFrameParser frameParser;
 
 	std::vector<Accelerometer *> accelerometers;
-	std::string AccelerometerParser::getLatestData(std::string _acc);
 };
\ No newline at end of file
@@ -2,34 +2,31 @@
 
 #define ARDUINO_WAIT_TIME 2000
 
-#include <windows.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
 #include <node/NodeUpdatable.h>
+#include <SerialPort.h>
 
 /***************************************************************
 *
-* Taken from http://playground.arduino.cc/Interfacing/CPPWindows
+* Based on http://playground.arduino.cc/Interfacing/CPPWindows
+*
+* The port itself is a sweet::SerialPort, so this works with the
+* Win32 comm API or termios
 *
 ****************************************************************/
 class Arduino : public NodeUpdatable
 {
   public:
         //Serial comm handler
-        HANDLE hSerial;
+        sweet::SerialPort port;
         //Connection status
         bool connected;
-        //Get various information about the connection
-        COMSTAT status;
-        //Keep track of last error
-        DWORD errors;
 
         //Initialize Serial communication with the given COM port
         Arduino(std::string portName);
         //Close the connection
-        //NOTA: for some reason you can't connect again before exiting
-        //the program and running it again
         ~Arduino();
         //Read data in a buffer, if nbChar is greater than the
         //maximum number of bytes available, it will return only the
@@ -37,6 +34,8 @@ class Arduino : public NodeUpdatable
         //be read, the number of bytes actually read.
         int ReadData(char *buffer, unsigned int nbChar);
 
+		// Returns the data up to (but not including) the next _until
+		// If _until hasn't arrived yet, returns everything that has and sets _forced to true
 		std::string ReadDataUntil(char _until, bool * _forced);
         //Writes data from a buffer through the Serial connection
         //return true on success.
@@ -44,9 +43,13 @@ class Arduino : public NodeUpdatable
         //Check if we are actually connected
         bool IsConnected();
 
-		void connect(std::string _portName);
+		// (re)opens the port as _portName
+		virtual void connect(std::string _portName);
 
 		virtual void update(Step * _step) override;
-		
+
+  private:
+		// bytes read by ReadDataUntil past the last _until it returned
+		std::string pending;
 };
 
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Packed asset archive
+	*
+	* A single file containing many assets, so that loading a scenario
+	* doesn't need to open, stat, and read thousands of loose files.
+	* The archive is memory-mapped when opened; uncompressed entries are
+	* read directly from the mapping, and compressed entries (LZ4 block
+	* format) are decompressed on demand.
+	*
+	* The table of contents is keyed both by asset type and id, and by the
+	* path the asset would have been loaded from. Mounted archives are
+	* searched by path by the asset loaders (Texture, Font, OpenAL_Buffer,
+	* Resource::loadMeshFromObj, TextureSampler) before falling back to
+	* loose files, so asset code doesn't need to know where its data is.
+	*
+	* Layout (little-endian):
+	*	"STPK", version, number of entries, size of string block
+	*	entries: type, id, path (offsets into the string block), flags, offset, stored size, size
+	*	string block (null-terminated strings)
+	*	entry data, each starting on a multiple of the archive's alignment
+	*
+	***********************************************/
+	class AssetArchive{
+	public:
+		typedef enum{
+			// the entry's data is LZ4 compressed
+			kCOMPRESSED = 1
+		} EntryFlags;
+
+		struct Entry{
+			std::string type;
+			std::string id;
+			std::string path;
+			unsigned long int flags;
+			// position of the data in the archive
+			unsigned long long int offset;
+			// size of the data in the archive
+			unsigned long long int storedSize;
+			// size of the data once decompressed
+			unsigned long long int size;
+		};
+
+		// collects files and writes them into an archive
+		class Builder{
+		public:
+			// entry data is padded to start on a multiple of alignment bytes
+			unsigned long int alignment;
+			// if true, entries are compressed (unless compression doesn't make them any smaller)
+			bool compress;
+
+			Builder();
+
+			// adds the file at _path under _type and _id
+			// files which have already been added are skipped
+			void add(std::string _type, std::string _id, std::string _path);
+			// reads every file and writes the archive to _outputSrc
+			// returns false if a file couldn't be read or the archive couldn't be written
+			bool write(std::string _outputSrc) const;
+
+		private:
+			std::vector<Entry> entries;
+		};
+
+		// opens and maps the archive at _src; use isOpen to check whether it succeeded
+		explicit AssetArchive(std::string _src);
+		~AssetArchive();
+
+		bool isOpen() const;
+		const std::string & getSource() const;
+		const std::vector<Entry> & getEntries() const;
+
+		// returns the entry with the given type and id, or nullptr if there isn't one
+		const Entry * find(const std::string & _type, const std::string & _id) const;
+		// returns the entry which was packed from _path, or nullptr if there isn't one
+		const Entry * findFile(const std::string & _path) const;
+		// returns a pointer to _entry's data
+		// uncompressed entries point directly into the mapped archive; compressed entries are decompressed into _buffer
+		// returns nullptr if the data is corrupt
+		const unsigned char * getData(const Entry * _entry, std::string & _buffer) const;
+
+		// mounted archives are searched by the asset loaders
+		// archives aren't owned by the mount list; unmount them before deleting them
+		static void mount(AssetArchive * _archive);
+		static void unmount(AssetArchive * _archive);
+
+		// searches the mounted archives (most recently mounted first) for _path
+		// if found, returns a pointer to the data (see getData) and sets _size; otherwise returns nullptr
+		static const unsigned char * getFile(const std::string & _path, size_t & _size, std::string & _buffer);
+		// returns the contents of _path from the mounted archives, or from FileUtils::readFile if it isn't in any of them
+		static std::string readFile(const std::string & _path);
+
+		// packs the assets referenced by the scenario json at _scenarioSrc into an archive at _outputSrc
+		// (the Scenario constructor looks for an archive at its source + ".pack")
+		static bool packScenario(std::string _scenarioSrc, std::string _outputSrc, bool _compress = true);
+
+		// LZ4 block format compression
+		static void compressBlock(const unsigned char * _src, size_t _size, std::string & _output);
+		// returns false if _src isn't valid or doesn't decompress to exactly _dstSize bytes
+		static bool decompressBlock(const unsigned char * _src, size_t _size, unsigned char * _dst, size_t _dstSize);
+
+	private:
+		std::string src;
+		std::vector<Entry> entries;
+		// "type/id" -> entry index
+		std::map<std::string, unsigned long int> ids;
+		// path -> entry index
+		std::map<std::string, unsigned long int> paths;
+
+		const unsigned char * data;
+		size_t size;
+		// platform handles for the mapping
+		void * fileHandle;
+		void * mappingHandle;
+
+		bool parse();
+		void close();
+
+		static std::vector<AssetArchive *> mounted;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+class Step;
+
+namespace sweet{
+
+	// A single benchmark case
+	// setUp is called once, then frame is called for warmup frames followed by timed frames, then tearDown
+	class Benchmark{
+	public:
+		// used to identify the results (e.g. "physics/bullet")
+		std::string name;
+		// number of timed frames
+		unsigned long int frames;
+		// extra values to include in the results; benchmarks can add their own in tearDown
+		// if "items per frame" is set, the runner also reports "items per ms"
+		// the runner adds the per-frame averages of the null GL counters
+		std::map<std::string, double> metrics;
+		// checks which didn't pass during the last run (see fail)
+		std::vector<std::string> failures;
+
+		Benchmark(std::string _name, unsigned long int _frames);
+		virtual ~Benchmark();
+
+		// returns false if the benchmark can't be run (e.g. a required file is missing), in which case it's reported as skipped
+		virtual bool setUp();
+		virtual void frame(Step * _step) = 0;
+		virtual void tearDown();
+
+		// records a failed correctness check; the benchmark is reported as failed instead of skipped or passed
+		// can be called from any of setUp, frame, or tearDown
+		void fail(std::string _message);
+	};
+
+	// Benchmark which calls a function each frame
+	class FunctionBenchmark : public Benchmark{
+	public:
+		std::function<void(Step *)> function;
+
+		FunctionBenchmark(std::string _name, unsigned long int _frames, std::function<void(Step *)> _function);
+
+		virtual void frame(Step * _step) override;
+	};
+
+	struct BenchmarkResult{
+		std::string name;
+		bool skipped;
+		// the messages passed to Benchmark::fail; the result is failed if there are any
+		std::vector<std::string> failures;
+		unsigned long int frames;
+		// frame times, in milliseconds
+		double total, mean, median, fastest, slowest, p95;
+		std::map<std::string, double> metrics;
+	};
+
+	/***********************************************
+	*
+	* Headless, deterministic benchmark runner
+	*
+	* Every benchmark is driven with a fixed Step (constant delta
+	* time, starting at time 0) after re-seeding the shared RNG,
+	* so repeated runs do the same work. The null GL backend is
+	* installed on construction so that rendering code can run
+	* without a window or GPU.
+	*
+	* Results can be written as JSON for tracking regressions.
+	* Benchmarks which also check their results report failures
+	* through Benchmark::fail; see getNumFailed.
+	*
+	***********************************************/
+	class BenchmarkRunner{
+	public:
+		// fixed frame rate used for the Step
+		double fps;
+		// frames run before timing starts
+		unsigned long int warmupFrames;
+		// RNG seed used before each benchmark
+		unsigned long int seed;
+
+		BenchmarkRunner();
+		~BenchmarkRunner();
+
+		// takes ownership of _benchmark
+		void add(Benchmark * _benchmark);
+		void add(std::string _name, unsigned long int _frames, std::function<void(Step *)> _frame);
+
+		// adds the built-in benchmarks: scene graph traversal, mesh upload, text layout, UI layout and hit testing,
+		// phrase generation, asset loading, physics stepping, audio generation, and particles
+		// _fontFile is used for text layout (the text benchmark is skipped if the file doesn't exist)
+		void addDefaultBenchmarks(std::string _fontFile = "assets/engine basics/OpenSans-Regular.ttf");
+
+		// runs every benchmark whose name contains _filter (or all of them, if _filter is empty)
+		// results are logged as they complete, and returned
+		const std::vector<BenchmarkResult> & run(std::string _filter = "");
+
+		const std::vector<BenchmarkResult> & getResults() const;
+		// number of results from the last run which have failures
+		// a benchmark executable should exit with a non-zero code if this isn't 0, so that regressions fail the build
+		unsigned long int getNumFailed() const;
+		// writes the results of the last run to _filename as JSON; returns false if the file couldn't be opened
+		bool writeResults(std::string _filename) const;
+
+	private:
+		std::vector<Benchmark *> benchmarks;
+		std::vector<BenchmarkResult> results;
+
+		BenchmarkResult runBenchmark(Benchmark * _benchmark);
+	};
+}
\ No newline at end of file
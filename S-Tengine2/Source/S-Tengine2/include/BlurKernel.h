@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* One-dimensional Gaussian kernel for separable blurs
+	*
+	* The discrete kernel covers texels -radius to +radius. Because
+	* a bilinear fetch between two texels returns their weighted
+	* average, each pair of neighbouring texels can be read with a
+	* single fetch at an offset between them, so a pass needs
+	* 2 * (taps - 1) + 1 fetches instead of 2 * radius + 1.
+	*
+	* The CPU functions run the same passes as BlurShader, texel for
+	* texel (bilinear sampling, clamped to the edge), so that the
+	* weights and output can be checked without a GPU.
+	*
+	* Images are arrays of floats with _channels values per pixel,
+	* row by row.
+	*
+	***********************************************/
+	class BlurKernel{
+	public:
+		// the most bilinear taps a pass can use (including the centre); matches the arrays in BlurShader
+		static const unsigned long int MAX_TAPS = 16;
+
+		// standard deviation, in texels
+		float sigma;
+		// weights of the discrete kernel, from the centre out; the centre is used once, the rest on both sides
+		// they sum to 1 that way
+		std::vector<float> weights;
+		// offsets (in texels) and weights of the bilinear taps, from the centre out; mirrored the same way as weights
+		std::vector<float> tapOffsets;
+		std::vector<float> tapWeights;
+
+		// _radius defaults to ceil(3 * _sigma), and is capped so that the taps fit in MAX_TAPS
+		// a _sigma of 0 makes a kernel which copies the image
+		explicit BlurKernel(float _sigma, unsigned long int _radius = 0);
+
+		unsigned long int getRadius() const;
+		unsigned long int getTapCount() const;
+		// texture fetches per pixel for one pass using the bilinear taps
+		unsigned long int getFetchesPerPass() const;
+		// texture fetches per pixel for one pass using the discrete weights
+		unsigned long int getDiscreteFetchesPerPass() const;
+
+		// samples channel _channel of _image at (_x, _y), in texels (0, 0 is the centre of the first texel), like GL_LINEAR with GL_CLAMP_TO_EDGE
+		static float sample(const float * _image, unsigned long int _width, unsigned long int _height, unsigned long int _channels, float _x, float _y, unsigned long int _channel);
+		// resamples _src into _dst with one bilinear fetch per pixel, the way a downsample or upsample pass does
+		static void resample(const float * _src, unsigned long int _srcWidth, unsigned long int _srcHeight, float * _dst, unsigned long int _dstWidth, unsigned long int _dstHeight, unsigned long int _channels);
+
+		// blurs _src into _dst along (_dx, _dy) (e.g. 1, 0 for a horizontal pass) using the bilinear taps
+		void pass(const float * _src, float * _dst, unsigned long int _width, unsigned long int _height, unsigned long int _channels, signed long int _dx, signed long int _dy) const;
+		// blurs _src into _dst along (_dx, _dy) using the discrete weights, one fetch per texel
+		void discretePass(const float * _src, float * _dst, unsigned long int _width, unsigned long int _height, unsigned long int _channels, signed long int _dx, signed long int _dy) const;
+	};
+}
\ No newline at end of file
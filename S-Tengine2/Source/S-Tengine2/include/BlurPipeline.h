@@ -0,0 +1,85 @@
+#pragma once
+
+#include <BlurKernel.h>
+#include <FrameBufferChannel.h>
+
+#include <vector>
+
+class BlurShader;
+class RenderSurface;
+class FrameBufferInterface;
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Gaussian blur of a framebuffer's colour channel
+	*
+	* The source is halved in size _levels times with bilinear
+	* copies, blurred there with a horizontal and a vertical
+	* BlurKernel pass, and scaled back up the same way. Each level
+	* halves the sigma (and so the taps) the passes need, and
+	* quarters the number of pixels they run on, so wide blurs stay
+	* cheap; the auto level count keeps the per-level sigma at or
+	* under maxSigmaPerLevel.
+	*
+	* Texel offsets come from the size of the framebuffer each pass
+	* reads, and the intermediate framebuffers come from the
+	* RenderTargetPool.
+	*
+	* applyCpu runs the same passes on a float image, and
+	* getFetchCount returns how many texture fetches apply makes, so
+	* configurations can be compared with the old 81 fetch box blur.
+	*
+	***********************************************/
+	class BlurPipeline{
+	public:
+		// levels are added until the sigma at the lowest level is at most this
+		// default: 3 (3 bilinear taps per side)
+		static float maxSigmaPerLevel;
+
+		// _sigma is in pixels of the source; _levels < 0 picks the level count from maxSigmaPerLevel
+		explicit BlurPipeline(float _sigma, signed long int _levels = -1);
+		~BlurPipeline();
+
+		void setSigma(float _sigma, signed long int _levels = -1);
+		float getSigma() const;
+		unsigned long int getLevels() const;
+		// the kernel used at the lowest level
+		const BlurKernel & getKernel() const;
+
+		// blurs the first channel of _source into _target, which must be a different framebuffer
+		// if _target is nullptr, the result is drawn into the framebuffer which is currently bound, using the current viewport
+		void apply(FrameBufferInterface * _source, FrameBufferInterface * _target);
+
+		// blurs _src (_width by _height, _channels floats per pixel) into _dst, doing what apply would do
+		void applyCpu(const std::vector<float> & _src, unsigned long int _width, unsigned long int _height, unsigned long int _channels, std::vector<float> & _dst) const;
+
+		// returns the number of texture fetches apply makes for a _width by _height source
+		unsigned long long int getFetchCount(unsigned long int _width, unsigned long int _height) const;
+		// returns the number of texture fetches the 9x9 box blur made for a _width by _height source
+		static unsigned long long int getBoxFetchCount(unsigned long int _width, unsigned long int _height);
+
+		// returns _size halved _level times (at least 1)
+		static unsigned long int getLevelSize(unsigned long int _size, unsigned long int _level);
+		// channels of the intermediate framebuffers
+		static std::vector<FrameBufferChannel> getChannels();
+
+	private:
+		float sigma;
+		unsigned long int levels;
+		BlurKernel kernel;
+
+		// created on the first apply, so that the CPU side can be used without a GL context
+		BlurShader * shader;
+		RenderSurface * surface;
+
+		// draws _texture (_srcWidth by _srcHeight) into the framebuffer and viewport which are set
+		// (_dx, _dy) is the direction of a blur pass; (0, 0) makes it a bilinear copy
+		void draw(GLuint _texture, unsigned long int _srcWidth, unsigned long int _srcHeight, signed long int _dx, signed long int _dy);
+
+		// not copyable
+		BlurPipeline(const BlurPipeline & _other);
+		BlurPipeline & operator=(const BlurPipeline & _other);
+	};
+}
\ No newline at end of file
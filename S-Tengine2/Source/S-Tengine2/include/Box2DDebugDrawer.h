@@ -24,6 +24,8 @@ public:
 	void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) override;
 	void DrawTransform(const b2Transform& xf) override;
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) override;
+	// debug drawing covers the whole world, so it is never culled
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
 	
 	void load() override;
 	void unload() override;
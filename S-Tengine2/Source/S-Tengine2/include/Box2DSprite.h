@@ -33,6 +33,12 @@ public:
 	// Creates a rectangular shape that fits the sprite
 	b2PolygonShape createFixtureShape();
 
+	// Creates convex polygon fixtures which follow the outline of the pixels in _texture above _threshold (the alpha channel is used for RGBA textures)
+	// the texture is stretched over the sprite's corrected width and height, centred on the body; holes in the outline are filled in
+	// _tolerance is the distance in pixels that the outline is allowed to be simplified by
+	// NOTE: unlike createFixture, this doesn't change the mesh
+	std::vector<b2Fixture *> createFixturesFromTexture(Texture * _texture, unsigned long int _threshold = 128, float _tolerance = 1.f, b2Filter _filter = b2Filter(), void * _userData = nullptr, bool _isSensor = false);
+
 	// We seem to need this fairly often
 	void setGroupIndex(int16 _groupIndex);
 
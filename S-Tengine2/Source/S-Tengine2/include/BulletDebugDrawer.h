@@ -11,6 +11,10 @@ private:
 	int m_debugMode;
 	btCollisionWorld * world;
 public:
+	// some versions of bullet give their classes an aligned allocator; make sure the node allocator is the one used
+	using Node::operator new;
+	using Node::operator delete;
+
 	BulletDebugDrawer(btCollisionWorld * _world);
 	virtual ~BulletDebugDrawer(); 
 	virtual void drawLine(const btVector3& from,const btVector3& to,const btVector3& fromColor, const btVector3& toColor);
@@ -24,6 +28,8 @@ public:
 	virtual int getDebugMode() const { return m_debugMode;}
 	
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) override;
+	// debug drawing covers the whole world, so it is never culled
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
 	virtual void load() override;
 	virtual void unload() override;
 
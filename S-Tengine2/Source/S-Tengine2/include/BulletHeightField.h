@@ -2,9 +2,17 @@
 
 #include <BulletMeshEntity.h>
 #include <BulletCollision\CollisionShapes\btHeightfieldTerrainShape.h>
+#include <JobSystem.h>
+#include <Vertex.h>
+
+#include <GL\glew.h>
+
+#include <atomic>
 
 class Texture;
 class QuadMesh;
+class TriMesh;
+class BulletHeightFieldChunk;
 
 // since a height field doesn't copy the data used to create it,
 // we need to make sure that we don't accidentally delete the
@@ -18,22 +26,124 @@ public:
 	// _upAxis = 0, 1, or 2, indicating x, y, and z axis respectively
 	BulletHeightFieldShape(Texture * _heightMap, glm::vec3 _scale = glm::vec3(1.f), unsigned long int _upAxis = 1);
 	~BulletHeightFieldShape();
-	
+
 	// _tileUvs = if true, sets UVs such that each square on the height map is 0-1; if false sets UVs such that the entire height map is 0-1
 	TriMesh * getMesh(bool _tileUvs);
+
+	// fills _vertices and _indices with a triangulated grid covering the pixels from (_x, _y) to (_x + _size, _y + _size), clamped to the height map,
+	// sampling every _step pixels (the last row and column are always included so that neighbouring grids line up)
+	// if _skirtDepth is greater than zero, a skirt of that depth is added around the edges to hide cracks between neighbouring grids with different steps
+	// only reads the height data, so it's safe to call from a worker thread
+	void getGrid(unsigned long int _x, unsigned long int _y, unsigned long int _size, unsigned long int _step, float _skirtDepth, bool _tileUvs, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const;
+	// sets _min and _max to the bounds of the pixels from (_x, _y) to (_x + _size, _y + _size), clamped to the height map
+	void getGridBounds(unsigned long int _x, unsigned long int _y, unsigned long int _size, glm::vec3 & _min, glm::vec3 & _max) const;
+
+	// returns the normal at pixel (_x, _y), smoothed using the neighbouring pixels
+	glm::vec3 getNormal(signed long int _x, signed long int _y) const;
+	// returns a unit vector along the up axis
+	glm::vec3 getUp() const;
+
+	unsigned long int getWidth() const;
+	unsigned long int getHeight() const;
+};
+
+// a square section of a BulletHeightField's visible mesh
+// level of detail n samples every 2^n pixels; each level is generated on the job system the first time it's needed,
+// and the closest level which is ready is rendered in the meantime
+// a skirt around the edges hides the cracks between neighbouring chunks at different levels
+class BulletHeightFieldChunk : public virtual NodeRenderable, public virtual NodeLoadable, public virtual NodeChild{
+public:
+	// pixel coordinates of the chunk's corner, and the number of pixels it covers along each axis
+	const unsigned long int x, y, size;
+	// distance from the camera at which the full resolution level is dropped
+	// each level after that starts at double the previous distance
+	float lodDistance;
+
+	// _source = mesh whose textures, materials, and texture settings are used when rendering the chunk
+	// _jobs = counter used for the generation jobs
+	BulletHeightFieldChunk(BulletHeightFieldShape * _shape, MeshInterface * _source, unsigned long int _x, unsigned long int _y, unsigned long int _size, float _lodDistance, bool _tileUvs, sweet::JobCounter * _jobs);
+	~BulletHeightFieldChunk();
+
+	// picks a level of detail based on the distance to the camera and renders it
+	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) override;
+	virtual void load() override;
+	virtual void unload() override;
+	// returns the bounds of the chunk, including the skirt
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
+
+	// returns the number of levels of detail
+	unsigned long int getNumLods() const;
+	// returns the level of detail which should be used when the camera is _distance away from the chunk
+	unsigned long int getDesiredLod(float _distance) const;
+	// queues generation of level _lod on the job system if it isn't ready or already queued
+	void requestLod(unsigned long int _lod);
+	// re-calculates the bounds and flags every level of detail for regeneration
+	// the existing meshes are still rendered until their replacements are ready
+	// NOTE: make sure that none of the generation jobs are running when you call this
+	void invalidate();
+
+private:
+	typedef enum{
+		kNONE,
+		kPENDING,
+		kGENERATED,
+		kREADY
+	} LodState;
+
+	struct Lod{
+		std::atomic<int> state;
+		// filled in by the generation job, then swapped into the mesh on the main thread
+		std::vector<Vertex> vertices;
+		std::vector<GLuint> indices;
+		TriMesh * mesh;
+		// shader which the mesh's vertex attributes were last configured for
+		Shader * configuredShader;
+
+		Lod();
+	};
+	std::vector<Lod *> lods;
+
+	BulletHeightFieldShape * shape;
+	MeshInterface * source;
+	sweet::JobCounter * jobs;
+	bool tileUvs;
+
+	glm::vec3 boundingBoxMin, boundingBoxMax;
+	float skirtDepth;
+
+	// moves generated data into the mesh for level _lod; returns whether the level has a mesh to render
+	bool uploadLod(unsigned long int _lod);
+	// copies the textures, materials, and texture settings from the source mesh to _mesh
+	void syncMaterials(MeshInterface * _mesh);
 };
 
 class BulletHeightField : public BulletMeshEntity{
 private:
 	Texture * heightMap;
 	bool tileUvs;
+	// 0 if chunking is disabled
+	unsigned long int chunkSize;
+	float lodDistance;
+	std::vector<BulletHeightFieldChunk *> chunks;
+	// tracks the chunk generation jobs so that they can be finished before the chunks are changed or deleted
+	sweet::JobCounter chunkJobs;
 public:
 	// NOTE: a BulletHeightField calls setColliderAsHeightMap in its constructor, so you don't need to construct the shape yourself
 	// _tileUvs = if true, sets UVs such that each square on the height map is 0-1; if false sets UVs such that the entire height map is 0-1
 	// _upAxis = 0, 1, or 2, indicating x, y, and z axis respectively
-	BulletHeightField(BulletWorld * _world, Texture * _heightMap, Shader * _shader, bool _tileUvs = false, glm::vec3 _scale = glm::vec3(1.f), unsigned long int _upAxis = 1);
+	// _chunkSize = number of pixels along each side of a chunk (rounded up to a power of two); if 0, the whole height map is put into mesh instead
+	// NOTE: when chunking is enabled, mesh is left empty and only used to hold the textures and materials for the chunks
+	// the collision shape always uses the full resolution height map
+	BulletHeightField(BulletWorld * _world, Texture * _heightMap, Shader * _shader, bool _tileUvs = false, glm::vec3 _scale = glm::vec3(1.f), unsigned long int _upAxis = 1, unsigned long int _chunkSize = 64);
 	~BulletHeightField();
 
 	// sets the mesh vertices to reflect to collider vertices
+	// when chunking is enabled, regenerates the chunks instead
 	void updateMesh();
+
+	// sets the distance at which the chunks drop their full resolution level of detail (each level after that starts at double the previous distance)
+	void setLodDistance(float _distance);
+	float getLodDistance() const;
+
+	const std::vector<BulletHeightFieldChunk *> & getChunks() const;
 };
\ No newline at end of file
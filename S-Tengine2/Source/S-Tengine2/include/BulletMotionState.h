@@ -0,0 +1,27 @@
+#pragma once
+
+#include <btBulletDynamicsCommon.h>
+
+class NodeBulletBody;
+
+// motion state used by NodeBulletBody
+// Bullet only calls setWorldTransform for bodies which are awake, and passes the transform
+// interpolated between the last two fixed steps; when the transform has actually changed,
+// the body is queued on its world so that its childTransform is realigned after the step
+// (sleeping and resting bodies are never touched)
+class BulletMotionState : public btMotionState{
+public:
+	// transform has SIMD members, so heap allocations have to be aligned (the same as btDefaultMotionState)
+	BT_DECLARE_ALIGNED_ALLOCATOR();
+
+	NodeBulletBody * owner;
+	// the transform last passed by Bullet (or set directly)
+	btTransform transform;
+	// whether the owner is in its world's list of bodies to realign
+	bool queued;
+
+	BulletMotionState(NodeBulletBody * _owner, const btTransform & _transform);
+
+	virtual void getWorldTransform(btTransform & _transform) const override;
+	virtual void setWorldTransform(const btTransform & _transform) override;
+};
\ No newline at end of file
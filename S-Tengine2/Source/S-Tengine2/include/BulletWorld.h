@@ -4,6 +4,8 @@
 #include <btBulletDynamicsCommon.h>
 #include <glm\glm.hpp>
 
+#include <vector>
+
 class NodeBulletBody;
 class Camera;
 
@@ -29,10 +31,23 @@ public:
 	unsigned long int maxSubSteps;
 	float fixedTimeStep;
 
+	// if true, bodies are realigned to the transform interpolated between the last two fixed steps
+	// (smooth motion when the frame rate doesn't match fixedTimeStep)
+	// if false, bodies are realigned to the transform of the last fixed step
+	// default: true
+	bool interpolate;
+
+	// bodies whose transform has changed during the current update, and need to be realigned
+	// filled by their motion states, and emptied by syncBodies
+	std::vector<NodeBulletBody *> movedBodies;
+
 	BulletWorld(glm::vec3 _gravity = glm::vec3(0, -9.8, 0));
 	~BulletWorld();
 
+	// steps the simulation and then calls syncBodies
 	virtual void update(Step * _step) override;
+	// realigns every body in movedBodies and clears the list
+	void syncBodies();
 
 	// runs a raycast from _camera along its forward vector
 	// returns the first intersection found within _range
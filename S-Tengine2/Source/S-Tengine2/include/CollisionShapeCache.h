@@ -0,0 +1,174 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <string>
+
+#include <LinearMath/btScalar.h>
+
+class btCollisionShape;
+class btStridingMeshInterface;
+class btBvhTriangleMeshShape;
+class btOptimizedBvh;
+class MeshInterface;
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Singleton cache of Bullet collision shapes
+	*
+	* Shapes are shared between every body which asks for the same
+	* one: primitives are keyed by their type and dimensions, and
+	* mesh colliders by a hash of their vertices (and indices, for
+	* concave meshes), so a field of identical crates or a crowd of
+	* ragdolls only has one shape per distinct part, and a concave
+	* mesh's BVH is only built once.
+	*
+	* Shapes are reference counted; each get* call adds a reference,
+	* and the shape is deleted when the last one is released. Shared
+	* shapes must be treated as immutable (e.g. don't set their local
+	* scaling or margin).
+	*
+	* If bvhDirectory is set, the BVHs of concave meshes are written
+	* there after they're built, and later requests for the same mesh
+	* (in this run or the next) load them instead of rebuilding them.
+	* The files are specific to the build which wrote them.
+	*
+	***********************************************/
+	class CollisionShapeCache{
+	public:
+		struct Stats{
+			// calls to the get* functions
+			unsigned long int requests;
+			// requests served by a shape which was already in the cache
+			unsigned long int hits;
+
+			// shapes in the cache, and references to them
+			unsigned long int shapes;
+			unsigned long int references;
+			// approximate number of bytes used by the shapes in the cache (including mesh copies and BVHs)
+			unsigned long int bytes;
+			// approximate number of bytes the same references would use if each had its own shape
+			unsigned long int unsharedBytes;
+
+			// BVHs built, loaded from bvhDirectory, and written to bvhDirectory
+			unsigned long int bvhBuilds;
+			unsigned long int bvhLoads;
+			unsigned long int bvhSaves;
+
+			// seconds spent creating shapes (including building or loading BVHs)
+			double seconds;
+			// seconds which hits and BVH loads avoided spending, based on how long the shapes originally took to create
+			double secondsSaved;
+
+			Stats();
+
+			// returns the fraction of requests which were served by an existing shape
+			double getHitRate() const;
+		};
+
+		// if false, every request creates a new shape which isn't shared (they're still deleted on release)
+		// useful for comparing against the shared numbers
+		// default: true
+		bool enabled;
+		// directory that BVHs for concave meshes are loaded from and saved to; it must already exist
+		// default: "" (BVHs aren't saved)
+		std::string bvhDirectory;
+
+		static CollisionShapeCache & getInstance();
+
+		btCollisionShape * getStaticPlane(float _normalX, float _normalY, float _normalZ, float _distanceFromOrigin);
+		btCollisionShape * getBox(float _halfX, float _halfY, float _halfZ);
+		btCollisionShape * getSphere(float _radius);
+		btCollisionShape * getCapsule(float _radius, float _height);
+		// copies the vertex positions (and the indices, if _convex is false) of _mesh into a convex hull or a concave triangle mesh
+		btCollisionShape * getMesh(const MeshInterface * _mesh, bool _convex);
+
+		// removes a reference to _shape, deleting it if it was the last one
+		// returns false (and does nothing) if _shape didn't come from the cache
+		bool release(btCollisionShape * _shape);
+		// returns true if _shape came from the cache and hasn't been deleted
+		bool isCached(const btCollisionShape * _shape) const;
+		// returns the number of references to _shape, or 0 if it isn't in the cache
+		unsigned long int getReferenceCount(const btCollisionShape * _shape) const;
+
+		// returns the file in bvhDirectory which the BVH for _mesh (as a concave collider) is saved to
+		// e.g. for shipping prebuilt BVHs, or deleting stale ones
+		std::string getBvhFilename(const MeshInterface * _mesh) const;
+
+		const Stats & getStats() const;
+		// resets the counters, but not the current number of shapes, references, or bytes
+		void resetStats();
+		// returns a human-readable summary of the stats, including the memory and time saved
+		std::string getReport() const;
+
+	private:
+		typedef enum{
+			kPLANE,
+			kBOX,
+			kSPHERE,
+			kCAPSULE,
+			kCONVEX_MESH,
+			kCONCAVE_MESH
+		} ShapeType;
+
+		struct Key{
+			ShapeType type;
+			// dimensions of primitives, or the vertex and index counts of meshes
+			float params[4];
+			// content hash of meshes; 0 for primitives
+			unsigned long long int hash;
+
+			Key(ShapeType _type, float _a = 0, float _b = 0, float _c = 0, float _d = 0, unsigned long long int _hash = 0);
+			bool operator<(const Key & _other) const;
+		};
+
+		struct Entry{
+			Key key;
+			btCollisionShape * shape;
+			unsigned long int references;
+			unsigned long int bytes;
+			// how long the shape took to create
+			double seconds;
+			// whether the entry is in the shapes map (false when the cache is disabled)
+			bool shared;
+
+			// the mesh data behind concave shapes, which Bullet doesn't copy
+			std::vector<btScalar> vertices;
+			std::vector<int> indices;
+			btStridingMeshInterface * meshInterface;
+			// BVH loaded from bvhDirectory, and the aligned buffer it lives in; the shape doesn't own it
+			btOptimizedBvh * loadedBvh;
+			void * bvhBuffer;
+
+			explicit Entry(const Key & _key);
+			~Entry();
+		};
+
+		std::map<Key, Entry *> shapes;
+		std::map<const btCollisionShape *, Entry *> entries;
+		Stats stats;
+
+		CollisionShapeCache();
+		~CollisionShapeCache();
+
+		// returns the key for _mesh, hashing the vertex positions (and the indices, if _convex is false)
+		static Key getMeshKey(const MeshInterface * _mesh, bool _convex);
+		// returns the entry for _key with a new reference if there is one, or nullptr if the shape needs to be created
+		Entry * find(const Key & _key);
+		// adds a new entry for _shape (with one reference) which took _seconds to create
+		btCollisionShape * add(Entry * _entry, btCollisionShape * _shape, unsigned long int _bytes, double _seconds);
+
+		// builds (or loads) the concave shape for _entry's mesh data
+		btBvhTriangleMeshShape * createConcaveShape(Entry * _entry, unsigned long int & _bytes, double & _secondsSaved);
+		std::string getBvhFilename(const Key & _key) const;
+		// loads the BVH for _key into _entry; returns false if there isn't a usable file
+		bool loadBvh(const Key & _key, Entry * _entry, double & _buildSeconds);
+		void saveBvh(const Key & _key, btOptimizedBvh * _bvh, double _buildSeconds);
+
+		// not copyable
+		CollisionShapeCache(const CollisionShapeCache & _other);
+		CollisionShapeCache & operator=(const CollisionShapeCache & _other);
+	};
+}
\ No newline at end of file
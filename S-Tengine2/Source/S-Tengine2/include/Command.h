@@ -1,13 +1,30 @@
 #pragma once
 
 #include <vector>
+#include <string>
 #include "CommandProcessor.h"
 #include "node/Node.h"
 
 class Command : public Node{
 public:
+	// rebuilds a command from a delta written by serialize
+	typedef Command * (*Deserializer)(const std::string & _delta);
+
 	virtual bool execute() = 0;
 	virtual bool unexecute() = 0;
+
+	// returns an estimate of the memory used by this command, in bytes
+	// overrides should add the size of any heap data they own to Command::getSize()
+	virtual unsigned long int getSize();
+	// called by the processor after _next has been executed straight after this command
+	// if _next can be folded into this command (e.g. they both move the same target), do so and return true, and _next will be deleted
+	// after coalescing, unexecuting this command has to undo both
+	virtual bool coalesce(Command * _next);
+	// writes everything needed to both execute and unexecute this command into _delta and returns the function which can rebuild it
+	// old history entries are replaced by their serialized form (see CommandProcessor::liveCommands)
+	// returns nullptr if the command can't be serialized (default)
+	// NOTE: a rebuilt command is only used for a single call to execute or unexecute, and is then deleted
+	virtual Deserializer serialize(std::string & _delta);
 	
 	Command();
 	virtual ~Command();
@@ -18,4 +35,9 @@ public:
 	bool executed;
 	// True from creation up until the end of the first call to execute, false otherwise
 	bool firstRun;
+	// result of getSize when the command was last added to a processor's history
+	// used by the processor to keep its total up to date
+	unsigned long int historySize;
+	// whether a processor has already archived this command (see CommandProcessor::liveCommands)
+	bool archived;
 };
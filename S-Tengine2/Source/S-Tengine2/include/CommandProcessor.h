@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <deque>
 
 class Command;
 class CompressedCommand;
@@ -11,12 +12,27 @@ public:
 	CommandProcessor(void);
 	~CommandProcessor(void);
 
+	// maximum number of bytes (as reported by Command::getSize) that the undo and redo stacks can use
+	// when the stacks go over the budget, the redo commands furthest from the current state are deleted first,
+	// followed by the oldest commands in the undoStack (the newest is always kept)
+	// 0 means unlimited (default)
+	unsigned long int byteBudget;
+	// number of commands at the top of the undoStack (and of the redoStack) which are kept as-is
+	// commands further from the current state than this are replaced with their serialized form, if they have one (see Command::serialize)
+	// default: 32
+	unsigned long int liveCommands;
+	// if true, each new command is offered to the previous one to be folded into it (see Command::coalesce)
+	// default: true
+	bool coalesceCommands;
+
 	bool executeCommand(Command * c);
 	// Runs "unexecute()" on the last command in the undoStack, pops it off the stack, and pushes it onto the redoStack
+	// the history is then trimmed (see liveCommands and byteBudget)
 	bool undo();
 	// Runs "unexecute()" on every command in the undoStack, pops them off the stack, and pushes it onto the redoStack
 	void undoAll();
 	// Runs "execute()" on the last command in the redoStack, pops it off the stack, and pushes it onto the undoStack
+	// the history is then trimmed in the same way as for a new command (see liveCommands and byteBudget)
 	bool redo();
 	// Runs "execute()" on every command in the redoStack, pops them off the stack, and pushes it onto the undoStack
 	void redoAll();
@@ -25,11 +41,34 @@ public:
 	
 	void startCompressing();
 	void endCompressing();
+
+	// replaces every command in the undo and redo stacks with its serialized form, if it has one
+	// commands which can't be serialized have their sub-commands serialized instead
+	void archiveAll();
+
+	// returns the total size of the commands in the undo and redo stacks, in bytes
+	unsigned long int getHistorySize() const;
+	unsigned long int getUndoCount() const;
+	unsigned long int getRedoCount() const;
 	
 	std::vector<ConsoleEntry *> consoleEntries;
 private:
-	std::vector<Command *> undoStack;
-	std::vector<Command *> redoStack;
+	std::deque<Command *> undoStack;
+	std::deque<Command *> redoStack;
 
 	CompressedCommand * currentCompressedCommand;
+
+	// total of the historySize of every command in the undo and redo stacks
+	unsigned long int historySize;
+
+	// adds _c's size to the total
+	void track(Command * _c);
+	// removes _c's size from the total
+	void untrack(Command * _c);
+	// replaces _c with its serialized form, or archives its sub-commands if it doesn't have one
+	void archive(Command *& _c);
+	// archives every command outside the live range and deletes commands while over budget
+	void trimHistory();
+	// redo without trimming the history afterwards
+	bool redoNext();
 };
@@ -12,7 +12,11 @@ public:
 	signed long int monitor;
 	std::string title;
 	bool useLibOVR;
+	// whether a node census change and the node resources left behind are logged on each scene switch, and the live nodes are printed by sweet::printNodes
+	// the census itself is always running (see sweet::NodeCensus)
 	bool nodeCounting;
+	// number of worker threads for the job system; negative means one less than the number of hardware threads
+	signed long int workerThreads;
 
 	bool windowDecorated;
 	bool windowResizable;
@@ -15,4 +15,6 @@ public:
 	~CubeMap();
 
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOption) override;
+	// the cube is drawn around the camera (the shader ignores its translation), so it is never culled
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
 };
\ No newline at end of file
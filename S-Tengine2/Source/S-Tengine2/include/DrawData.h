@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glm\glm.hpp>
+
+#include <vector>
+
+class Texture;
+class SpriteSheet;
+
+namespace sweet{
+	class Rectangle;
+}
+
+// per-draw settings for a MeshEntity
+// these let entities which share a mesh (see MeshFactory's shared primitives) look different
+// without changing the mesh's vertices; they're passed to the shader through RenderOptions::drawData while the entity renders
+class DrawData{
+public:
+	// multiplied with the vertex colours
+	// requires the shader to have a ShaderComponentDrawColour
+	// default: (1, 1, 1, 1)
+	glm::vec4 colour;
+	// rect (x, y, width, height) which the mesh's 0-1 UVs are mapped onto, with the top of the mesh at y + height (i.e. the same layout as a sprite sheet frame)
+	// requires the shader to have a ShaderComponentSpriteSheet
+	// default: (0, 1, 1, -1), which leaves the UVs as they are
+	glm::vec4 uvRect;
+	// sheet whose frame table is used for frame
+	SpriteSheet * spriteSheet;
+	// index into spriteSheet's frame table, used instead of uvRect; -1 means uvRect is used
+	signed long int frame;
+	// if not empty, these are used instead of the mesh's textures (by ShaderComponentTexture)
+	// use the functions below to change them so that their references are counted
+	std::vector<Texture *> textures;
+
+	DrawData();
+	~DrawData();
+
+	void pushTexture2D(Texture * _texture);
+	void clearTextures();
+	// calls clearTextures() and then pushTexture2D(_texture) (unless _texture is already the only texture)
+	void replaceTextures(Texture * _texture);
+
+	// sets uvRect to _rect
+	void setUvRect(const sweet::Rectangle & _rect);
+	// resets uvRect so that the mesh's UVs are used as they are
+	void resetUvRect();
+
+private:
+	// textures are reference-counted, so draw data can't be copied
+	DrawData(const DrawData & _other);
+	DrawData & operator=(const DrawData & _other);
+};
\ No newline at end of file
@@ -14,6 +14,13 @@ public:
 
 	bool active;
 
+	// whether this entity's update (including its children) can be run on a worker thread in parallel with its siblings
+	// only set this if the update doesn't touch anything outside of this entity's own subtree,
+	// doesn't create or delete nodes, and doesn't use shared state (e.g. NumberUtils' RNG) without synchronization
+	// (moving itself is fine: bounds changes are passed up to the parent once the parallel updates have finished)
+	// false by default
+	bool parallelUpdate;
+
 	explicit Entity();
 	virtual ~Entity(void);
 	void makeCumulativeModelMatrixDirty() override;
@@ -29,6 +36,12 @@ public:
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) override;
 	/** Doesn't do anything by default */
 	virtual void update(Step * _step) override;
+	// returns parallelUpdate
+	virtual bool isParallelUpdateSafe() override;
+
+	// returns the bounds of the childTransform
+	// override and return false in subclasses which render things outside of the childTransform
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
 
 	/** Calls unload on all children */
 	virtual void unload() override;
@@ -43,6 +43,11 @@ public:
 	void setIntData(std::string _key, int _val);
 	void setFloatData(std::string _key, float _val);
 	void setStringData(std::string _key, std::string _val);
+
+	// all of the data of each type, keyed by name
+	const std::map<std::string, int> & getAllIntData() const;
+	const std::map<std::string, float> & getAllFloatData() const;
+	const std::map<std::string, std::string> & getAllStringData() const;
 	
 	// empty event with the given tag
 	explicit Event(const char * _tag);
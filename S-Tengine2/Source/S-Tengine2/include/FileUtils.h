@@ -15,6 +15,9 @@ class FileUtils{
 public:
 	// reads the contents of a file located at _filename and returns them as a string
 	static std::string readFile(const std::string & _filename);
+	// reads the contents of a file located at _filename without any newline conversion and returns them as a string
+	// use this instead of readFile for anything that isn't text
+	static std::string readBinaryFile(const std::string & _filename);
 
 	// if the directory at _src does not exist, attempts to create it
 	// returns whether or not the directory exists at the end of the operation
@@ -50,6 +50,8 @@ public:
 class Font : public NodeResource{
 public:	
 	FT_Face face;
+	// the font file, if it was loaded from an archive (FreeType needs it to stay in memory for as long as the face exists)
+	std::string fileData;
 	float lineGapRatio;
 	FontScaleMode scaleMode;
 
@@ -32,6 +32,11 @@ public:
 	* may be a texture ID or a render buffer ID
 	*/
 	GLuint id;
+	/**
+	* Whether the FrameBufferInterface creates and deletes this channel's buffer itself (default: true)
+	* If false, the buffer is created elsewhere (e.g. shared by the RenderTargetPool) and only attached
+	*/
+	bool owned;
 
 	/**
 	* @param _internalFormat Refers to the format OpenGL uses to store the channel. Possible base types are:
@@ -89,4 +94,7 @@ public:
 	*
 	*/
 	FrameBufferChannel(GLint _internalFormat, GLenum _attachmentType, GLenum _format, ChannelType _channelType, GLenum _size);
+
+	// returns the approximate number of bytes a pixel of this channel uses on the GPU
+	unsigned long int getBytesPerPixel() const;
 };
\ No newline at end of file
@@ -33,6 +33,12 @@ public:
 	// if the stack is empty, binds the default FBO (0) instead
 	// NOTE: Remember to keep calls to pushFbo symettric with popFbo
 	static void popFbo();
+	// pushFbo and popFbo skip binding an FBO which is already bound
+	// call this after binding a framebuffer directly (i.e. with glBindFramebuffer) so that the next push/pop binds regardless
+	static void invalidateBinding();
+	// number of times pushFbo/popFbo bound an FBO, and number of times they skipped it because it was already bound
+	static unsigned long int getBindCount();
+	static unsigned long int getSkippedBindCount();
 
 
 	//The openGL ID for the Frame Buffer
@@ -95,7 +101,8 @@ public:
 	void reload();
 	
 	/**
-	* Alters the buffers width and heights calling reload if they've changed
+	* Alters the buffers width and heights if they've changed
+	* The existing textures and render buffers are given new storage instead of being recreated
 	* Returns true if a resize actually occurs, false otherwise
 	*
 	* @param _width The width to resize the framebuffer to
@@ -116,4 +123,20 @@ public:
 	// Returns the pixel data for the framebuffer
 	// !!! NOTE: you have to free the returned array yourself; it's malloced inside the function
 	GLubyte * getPixelData(unsigned long int _fbochannel);
+
+	// returns the approximate number of bytes used on the GPU by the channels this framebuffer owns
+	unsigned long int getByteSize() const;
+
+private:
+	// the FBO bound by the last push/pop
+	static GLuint boundFbo;
+	// false if something may have bound a framebuffer behind pushFbo/popFbo's back
+	static bool boundFboKnown;
+	static unsigned long int bindCount;
+	static unsigned long int skippedBindCount;
+
+	// binds _fboId for reading and drawing unless it's already bound
+	static void bind(GLuint _fboId);
+	// gives the channel at _index storage for the current width and height
+	void allocateStorage(unsigned long int _index);
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glm\glm.hpp>
+
+namespace sweet{
+/***********************************************
+*
+* A view frustum, stored as six planes extracted
+* from a view-projection matrix
+*
+* Used to skip rendering nodes whose bounds are
+* entirely off-screen
+*
+***********************************************/
+class Frustum{
+public:
+	typedef enum{
+		kLEFT,
+		kRIGHT,
+		kBOTTOM,
+		kTOP,
+		kNEAR,
+		kFAR
+	} Side;
+
+	// plane equations (xyz = inward-facing normal, w = distance)
+	glm::vec4 planes[6];
+
+	Frustum();
+
+	// extracts the planes from _viewProjection (Gribb/Hartmann)
+	void set(const glm::mat4 & _viewProjection);
+
+	// returns whether the world-space box defined by _min and _max is at least partially inside the frustum
+	bool intersects(const glm::vec3 & _min, const glm::vec3 & _max) const;
+	// returns whether the box defined by _min and _max, after being transformed by _model, is at least partially inside the frustum
+	bool intersects(const glm::vec3 & _min, const glm::vec3 & _max, const glm::mat4 & _model) const;
+
+	// transforms the box defined by _min and _max by _matrix and stores the axis-aligned box which covers the result in _resMin and _resMax
+	static void transformBounds(const glm::vec3 & _min, const glm::vec3 & _max, const glm::mat4 & _matrix, glm::vec3 & _resMin, glm::vec3 & _resMax);
+};
+};
\ No newline at end of file
@@ -7,7 +7,9 @@
 
 #include "Scene.h"
 #include "ResourceManager.h"
+#include "RenderOptions.h"
 #include <Scene_Splash.h>
+#include <NodeCensus.h>
 
 #define VOX_LIMIT_FRAMERATE 1
 
@@ -45,6 +47,10 @@ private:
 
 	unsigned long int numSplashScenes;
 
+	// node census taken when the current scene became current; if node counting is on,
+	// the node resources created since then which outlive the scene are logged when it's deleted
+	sweet::NodeCensus::Snapshot sceneCensus;
+
 public:
 	// must be called in the main before the game loop is started
 	// sets up the splash screens
@@ -119,4 +125,7 @@ public:
 
 	// whether the game will call resize on draw and fullscreen calls
 	bool autoResize;
+
+	// render counters (nodes visited, culled, and drawn) from the last call to draw
+	RenderStats renderStats;
 };
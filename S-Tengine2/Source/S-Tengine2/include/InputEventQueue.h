@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <atomic>
+
+namespace sweet{
+
+	struct InputEvent{
+		typedef enum{
+			kKEY_DOWN,
+			kKEY_UP,
+			kMOUSE_DOWN,
+			kMOUSE_UP,
+			// x and y are the new position
+			kMOUSE_MOVE,
+			// y is the change in the wheel
+			kMOUSE_WHEEL
+		} Type;
+
+		Type type;
+		// key or button code (GLFW_KEY_*, GLFW_MOUSE_BUTTON_*)
+		int code;
+		// modifier keys (GLFW_MOD_*)
+		int mods;
+		double x, y;
+		// time the event happened, in seconds (glfwGetTime)
+		double time;
+		// number of the frame the event was dispatched on
+		unsigned long int frame;
+
+		InputEvent();
+		InputEvent(Type _type, int _code, int _mods, double _x, double _y, double _time);
+	};
+
+	/***********************************************
+	*
+	* Singleton queue of timestamped input events
+	*
+	* The GLFW callbacks push events into a fixed-size lock-free ring
+	* buffer (single producer, single consumer) instead of changing the
+	* Keyboard and Mouse directly, so the order and timing of events
+	* within a frame isn't lost. dispatch, called once per frame after
+	* polling, drains the ring into the Keyboard and Mouse state and into
+	* a history which can be queried by frame or by time.
+	*
+	* Dispatched events can be recorded and replayed later (by frame),
+	* e.g. to drive a benchmark or a bug reproduction with the same input
+	* every run. While replaying, live events are dropped.
+	*
+	***********************************************/
+	class InputEventQueue{
+	public:
+		// number of events the ring can hold between dispatches; must be a power of two
+		static const unsigned long int CAPACITY = 1024;
+
+		// how long dispatched events are kept in the history, in seconds
+		// default: 2
+		double historyDuration;
+
+		// adds _event to the ring
+		// safe to call from one thread while another dispatches
+		// returns false (and counts the event as dropped) if the ring is full
+		bool push(const InputEvent & _event);
+
+		// moves the events in the ring (or the replay's events for this frame) into the Keyboard, Mouse, and history,
+		// then starts a new frame
+		void dispatch(double _time);
+
+		// returns the events dispatched in the latest frame, in the order they happened
+		const std::vector<InputEvent> & getFrameEvents() const;
+		// appends the events in the history from frame _frame to _out
+		void getEventsForFrame(unsigned long int _frame, std::vector<InputEvent> & _out) const;
+		// appends the events in the history which happened in [_start, _end) to _out
+		void getEventsInWindow(double _start, double _end, std::vector<InputEvent> & _out) const;
+		// returns the number of events of _type with _code in the history which happened in [_start, _end)
+		unsigned long int countEventsInWindow(InputEvent::Type _type, int _code, double _start, double _end) const;
+
+		// number of the frame which will be dispatched next
+		unsigned long int getFrame() const;
+		// number of events dropped because the ring was full
+		unsigned long int getDroppedCount() const;
+
+		// starts saving every dispatched event (replacing any previous recording)
+		void startRecording();
+		// stops saving events and returns the recording
+		// the recorded frames and times are relative to when the recording started
+		const std::vector<InputEvent> & stopRecording();
+		bool isRecording() const;
+
+		// dispatches _events instead of live events, starting with the next dispatch
+		// events are dispatched on the frame they were recorded on (relative to the start of the replay), with their times offset to match
+		void startReplay(const std::vector<InputEvent> & _events);
+		void stopReplay();
+		// returns true while there are replay events left to dispatch
+		bool isReplaying() const;
+
+		// writes _events to _filename, one event per line
+		static bool saveRecording(const std::vector<InputEvent> & _events, const std::string & _filename);
+		// reads events written by saveRecording into _events
+		static bool loadRecording(const std::string & _filename, std::vector<InputEvent> & _events);
+
+		static InputEventQueue & getInstance();
+
+	private:
+		InputEventQueue();
+		~InputEventQueue();
+
+		// ring buffer; head is only written by the consumer, tail by the producer
+		InputEvent ring[CAPACITY];
+		std::atomic<unsigned long int> head;
+		std::atomic<unsigned long int> tail;
+		std::atomic<unsigned long int> dropped;
+
+		unsigned long int frame;
+		std::vector<InputEvent> frameEvents;
+		std::deque<InputEvent> history;
+
+		bool recording;
+		unsigned long int recordingStartFrame;
+		double recordingStartTime;
+		std::vector<InputEvent> recorded;
+
+		bool replaying;
+		unsigned long int replayStartFrame;
+		double replayStartTime;
+		unsigned long int replayIndex;
+		std::vector<InputEvent> replayEvents;
+
+		// applies _event to the Keyboard or Mouse and adds it to the frame's events, the history, and the recording
+		void apply(InputEvent _event);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// thread-local storage for plain data (C++11's thread_local isn't available in every compiler we build with)
+#ifdef _MSC_VER
+#define SWEET_THREAD_LOCAL __declspec(thread)
+#else
+#define SWEET_THREAD_LOCAL __thread
+#endif
+
+namespace sweet{
+
+	// Tracks the number of unfinished jobs in a group so that they can be waited on together
+	class JobCounter{
+	public:
+		std::atomic<unsigned long int> pending;
+
+		JobCounter();
+
+		// returns whether every job submitted with this counter has finished
+		bool isDone() const;
+	};
+
+	/***********************************************
+	*
+	* Singleton work-stealing job system
+	*
+	* Every thread has its own queue of jobs: threads take
+	* work from the back of their own queue and steal from
+	* the front of the other queues when they run out.
+	* Threads which aren't workers (e.g. the main thread)
+	* share the first queue.
+	*
+	* Threads waiting on a JobCounter run jobs until the counter
+	* reaches zero, so it is safe to submit and wait from inside of a job
+	*
+	***********************************************/
+	class JobSystem{
+	public:
+		typedef std::function<void()> Job;
+
+		static JobSystem & getInstance();
+
+		// starts _numWorkers worker threads
+		// if _numWorkers is negative, uses one less than the number of hardware threads
+		// if the job system is already running, it is destructed first
+		void initialize(signed long int _numWorkers);
+		// finishes any remaining jobs and joins the worker threads
+		void destruct();
+
+		// returns the number of threads which can run jobs (the workers plus the calling thread)
+		unsigned long int getNumThreads() const;
+		// returns i+1 if the calling thread is workers[i], or 0 if it isn't a worker
+		unsigned long int getThreadIndex() const;
+
+		// queues _job on the calling thread's queue
+		// _counter is incremented immediately and decremented once the job has finished
+		// if there aren't any worker threads, the job is run immediately instead
+		void submit(Job _job, JobCounter * _counter);
+		// runs queued jobs until _counter reaches zero
+		void wait(JobCounter * _counter);
+
+		// calls _job(i) for every i in [0, _count), in batches of _batchSize, and waits for all of them to finish
+		void parallelFor(unsigned long int _count, std::function<void(unsigned long int)> _job, unsigned long int _batchSize = 1);
+
+	private:
+		struct Entry{
+			Job job;
+			JobCounter * counter;
+		};
+		struct Queue{
+			std::mutex mutex;
+			std::deque<Entry> jobs;
+		};
+
+		// queues[0] is shared by every thread which isn't a worker, queues[i+1] belongs to workers[i]
+		std::vector<Queue *> queues;
+		std::vector<std::thread> workers;
+
+		// total number of jobs waiting in the queues
+		std::atomic<unsigned long int> queuedJobs;
+		std::atomic<bool> running;
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+
+		// returns the index of the calling thread's queue (which each worker keeps in a thread-local when it starts)
+		unsigned long int getQueueIndex() const;
+		// pops a job from the back of queue _queue, or steals one from the front of another queue, and runs it
+		// returns false if there weren't any jobs to run
+		bool runJob(unsigned long int _queue);
+		void workerLoop(unsigned long int _queue);
+
+		JobSystem();
+		~JobSystem();
+	};
+}
\ No newline at end of file
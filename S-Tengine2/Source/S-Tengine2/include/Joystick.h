@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <map>
+#include <bitset>
 
 /************************************************************
 *
@@ -93,14 +94,14 @@ public:
 	virtual void update(Step * _step) override;
 
 	/**
-	* Inserts _code into the maps of justPressed and pressed buttons
+	* Inserts _code into the sets of justPressed and pressed buttons
 	*
 	* @param The button code
 	*/
 	void buttonDownListener(int _code);
 
 	/**
-	* Inserts _code into the map of justPressed buttons and removes it from the maps of justPressed and pressed buttons
+	* Inserts _code into the set of justReleased buttons and removes it from the sets of justPressed and pressed buttons
 	*
 	* @param The button code
 	*/
@@ -112,13 +113,16 @@ public:
 	Joystick(int _id, float _deadZone = 0.25f);
 	~Joystick();
 protected:
-
-	/** Map of buttons which are currently pressed down */
-	std::map<int, int> pressedButtons;
-	/** Map of buttons which were pressed down since the joystick's last call to update */
-	std::map<int, int> justPressedButtons;
-	/** Map of buttons which were released since the joystick's last call to update */
-	std::map<int, int> justReleasedButtons;
+	// one more than the largest button code
+	// (JoystickVirtual uses GLFW key codes as buttons, so this matches Keyboard::NUM_KEYS)
+	static const unsigned long int NUM_BUTTONS = 512;
+
+	/** Set of buttons which are currently pressed down, indexed by button code */
+	std::bitset<NUM_BUTTONS> pressedButtons;
+	/** Set of buttons which were pressed down since the joystick's last call to update */
+	std::bitset<NUM_BUTTONS> justPressedButtons;
+	/** Set of buttons which were released since the joystick's last call to update */
+	std::bitset<NUM_BUTTONS> justReleasedButtons;
 	
 	/** Map of axes values since the joystick's last call to update */
 	std::map<int, float> axesValues;
@@ -132,4 +136,8 @@ protected:
 	void initPlaystation();
 	// sets the button codes to correspond with snes controller layout
 	void initSNES();
+
+private:
+	// returns true if _code can be stored in the button sets (unmapped buttons are -1)
+	static bool isValidButton(int _code);
 };
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <iostream>
-#include <map>
+#include <bitset>
 
 #include <node/NodeUpdatable.h>
 
@@ -41,19 +41,19 @@ public:
 	bool keyJustDown(int _glfwKeyCode) const;
 
 	/**
-	* Clears the maps of justPressed and justReleased keys
+	* Clears the sets of justPressed and justReleased keys
 	*/
 	virtual void update(Step * _step) override;
 
 	/**
-	* Inserts _glfwKeyCode into the maps of justPressed and pressed keys
+	* Inserts _glfwKeyCode into the sets of justPressed and pressed keys
 	*
 	* @param The GLFW key code - eg. GLFW_KEY_A
 	*/
 	void keyDownListener(int _glfwKeyCode);
 
 	/**
-	* Inserts _glfwKeyCode into the map of justPressed keys and removes it from the maps of justPressed and pressed keys
+	* Inserts _glfwKeyCode into the set of justReleased keys and removes it from the sets of justPressed and pressed keys
 	*
 	* @param The GLFW key code - eg. GLFW_KEY_A
 	*/
@@ -66,12 +66,15 @@ public:
 	*/
 	static Keyboard& getInstance();
 
-	/** Map of keys which are currently pressed down */
-	std::map<int, int> pressedKeys;
-	/** Map of keys which were pressed down since the keyboard's last call to update */
-	std::map<int, int> justPressedKeys;
-	/** Map of keys which were released since the keyboard's last call to update */
-	std::map<int, int> justReleasedKeys;
+	// one more than the largest key code which is tracked (GLFW_KEY_LAST is 348); other codes are ignored
+	static const unsigned long int NUM_KEYS = 512;
+
+	/** Set of keys which are currently pressed down, indexed by key code */
+	std::bitset<NUM_KEYS> pressedKeys;
+	/** Set of keys which were pressed down since the keyboard's last call to update */
+	std::bitset<NUM_KEYS> justPressedKeys;
+	/** Set of keys which were released since the keyboard's last call to update */
+	std::bitset<NUM_KEYS> justReleasedKeys;
 
 	// whether shift is down
 	bool shift;
@@ -85,4 +88,7 @@ public:
 private:
 	Keyboard();
 	~Keyboard();
+
+	// returns whether _glfwKeyCode is in the range of tracked keys
+	static bool isValidKey(int _glfwKeyCode);
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <glm\glm.hpp>
+#include <Frustum.h>
 
 class Camera;
 
@@ -27,6 +28,9 @@ private:
 	/** Current View-Projection matrix */
 	glm::mat4 vp;
 	bool vpDirty;
+	/** Frustum of the current View-Projection matrix */
+	Frustum frustum;
+	bool frustumDirty;
 public:
 	/** Current model matrix */
 	glm::mat4 currentModelMatrix;
@@ -43,6 +47,9 @@ public:
 	// if the view-projection matrix is dirty, pre-multiplies it
 	// returns the value of the view-projection matrix
 	const glm::mat4 * getVP();
+	// if the view-projection matrix has changed, re-extracts the frustum planes
+	// returns the frustum of the current view-projection matrix
+	const Frustum & getFrustum();
 	
 	void setViewMatrix(const glm::mat4 * _viewMatrix);
 	void setProjectionMatrix(const glm::mat4 * _projectionMatrix);
@@ -4,6 +4,7 @@
 #include <Entity.h>
 #include <Box.h>
 #include <node\NodeShadable.h>
+#include <DrawData.h>
 
 class Shader;
 class MeshInterface;
@@ -16,6 +17,8 @@ public:
 	MeshInterface * mesh;
 	// Reference to the transform which is a child of this entity's childTransform and the parent of its mesh
 	Transform * const meshTransform;
+	// per-draw colour, UVs, and textures; used to customize shared meshes without changing their vertices
+	DrawData drawData;
 
 	// returns a box which covers the verts of the mesh and all of its children
 	//sweet::Box calcOverallBoundingBox();
@@ -24,6 +27,7 @@ public:
 	virtual ~MeshEntity(void);
 
 	/**
+	* Sets the render options' draw data to this entity's,
 	* Pushes model matrix stack,
 	* Applies the model matrix of transform,
 	* Loads and cleans mesh (if necessary),
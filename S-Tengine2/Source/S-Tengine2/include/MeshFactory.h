@@ -2,6 +2,9 @@
 
 #include <gl/glew.h>
 
+#include <map>
+#include <tuple>
+
 class QuadMesh;
 
 class MeshFactory{
@@ -16,4 +19,31 @@ public:
 	// creates a plane in the XY plane, facing down Z
 	// origin is center of mesh
 	static QuadMesh * getPlaneMesh(float _halfWidth, float _halfHeight, bool _autorelease = true);
+
+	// shared primitives
+	// these return an immutable mesh which is created the first time it's requested and then handed out to every caller
+	// asking for the same primitive, so many entities can draw the same vertex buffer
+	// the library holds a reference to each mesh, so they aren't deleted when the last entity using them is (see releaseUnusedSharedMeshes)
+	// per-entity colours, UVs, and textures go in the entity's DrawData, since the mesh can't be changed
+	static QuadMesh * getSharedCubeMesh(float _halfSize = 0.5f);
+	static QuadMesh * getSharedPlaneMesh(float _halfSize = 0.5f);
+	static QuadMesh * getSharedPlaneMesh(float _halfWidth, float _halfHeight);
+
+	// deletes the shared meshes which aren't referenced by anything other than the library
+	// returns the number of meshes deleted
+	static unsigned long int releaseUnusedSharedMeshes();
+	// returns the number of shared meshes which currently exist
+	static unsigned long int getSharedMeshCount();
+
+private:
+	typedef enum{
+		kCUBE,
+		kPLANE
+	} PrimitiveType;
+
+	// shared meshes, keyed by primitive type and dimensions
+	static std::map<std::tuple<PrimitiveType, float, float>, QuadMesh *> sharedMeshes;
+
+	// returns the shared mesh for the given primitive, creating it if needed
+	static QuadMesh * getSharedMesh(PrimitiveType _type, float _a, float _b);
 };
\ No newline at end of file
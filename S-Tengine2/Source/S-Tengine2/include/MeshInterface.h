@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <ostream>
+#include <string>
 
 #include "Sweet.h"
 #include "shader/Shader.h"
@@ -24,8 +25,37 @@ class Material;
 class MatrixStack;
 
 class MeshInterface : public virtual NodeRenderable, public virtual NodeLoadable, public virtual NodeResource, public virtual NodeChild{
+private:
+	// whether the cached bounds need to be re-calculated from the vertices
+	bool boundingBoxDirty;
+	// cached bounds of the vertices
+	glm::vec3 boundingBoxMin, boundingBoxMax;
+
+	// ranges of vertices and indices which have changed since the last upload, as [first, end)
+	unsigned long int dirtyVerticesFirst, dirtyVerticesEnd;
+	unsigned long int dirtyIndicesFirst, dirtyIndicesEnd;
+	// whether any ranges have been flagged since the last upload
+	// the ranges are only uploaded on their own if dirty hasn't also been set (which means the whole mesh needs uploading)
+	bool rangesDirty;
+	// number of vertices and indices that the vbo and ibo currently have room for
+	unsigned long int vboCapacity, iboCapacity;
+	// number of vertices and indices that were in the vbo and ibo after the last upload
+	unsigned long int vboCount, iboCount;
+	// whether the vertices, indices, and textures are locked (see makeImmutable)
+	bool immutable;
+
+	// uploads _count elements of _elementSize bytes from _data into the buffer bound to _target
+	// if _partial is true and the number of elements hasn't changed since the last upload (_uploaded), only the elements in [_first, _end) are uploaded (using glBufferSubData)
+	// otherwise, the whole buffer is uploaded; dynamic and streamed buffers grow geometrically and are orphaned instead of
+	// re-allocated, so meshes which change every frame don't have to wait on the previous frame's draw
+	void uploadBuffer(GLenum _target, unsigned long int & _capacity, unsigned long int & _uploaded, size_t _elementSize, const void * _data, unsigned long int _count, bool _partial, unsigned long int _first, unsigned long int _end);
+protected:
+	// returns true if the mesh can be changed; otherwise, logs a warning about _action and returns false
+	bool checkMutable(const std::string & _action) const;
 public:
 	/** Whether the vbo and ibo contain up-to-date vertex and index data */
+	// NOTE: after changing vertices, call makeDirty (or makeVerticesDirty) instead of setting this directly;
+	// the cached bounds are only updated by those, and a mesh whose stale bounds are off-screen is culled before it can be cleaned
 	bool dirty;
 	/** Textures */
 	std::vector<Texture *> textures;
@@ -108,7 +138,22 @@ public:
 	/** If loaded, deletes the VAO, VBO, IBO and flags as not loaded and dirty */
 	virtual void unload() override;
 	/** If dirty, copies data from vertices and indices to VBO and IBO and flags as clean */
+	// if only ranges have been flagged (see makeVerticesDirty), only those ranges are copied
 	virtual void clean();
+	// flags the mesh as dirty and its bounds as out-of-date
+	// use this instead of setting dirty directly after moving vertices so that frustum culling stays accurate
+	void makeDirty();
+	// flags _count vertices starting at _first as changed
+	// if only ranges have been flagged since the last clean (i.e. dirty hasn't been set, directly or through makeDirty), only those ranges are uploaded
+	// NOTE: if the number of vertices changes, the whole mesh is uploaded anyway
+	void makeVerticesDirty(unsigned long int _first, unsigned long int _count = 1);
+	// flags _count indices starting at _first as changed (see makeVerticesDirty)
+	void makeIndicesDirty(unsigned long int _first, unsigned long int _count = 1);
+	// locks the vertices, indices, and textures; used for meshes which are shared between entities (see MeshFactory)
+	// after this, the mesh's own modifiers log a warning and do nothing
+	// per-entity colours, UVs, and textures should go in the entity's DrawData instead
+	void makeImmutable();
+	bool isImmutable() const;
 	/** Renders the vao using the given shader, model-view-projection and lights */
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOption) override;
 	/** A helper method to configure all the starndard vertex attributes - Position, Colours, Normals */
@@ -151,6 +196,12 @@ public:
 	// returns a box which covers the verts of the mesh
 	sweet::Box calcBoundingBox() const;
 
+	// flags the cached bounds of this mesh and its parents as out-of-date
+	virtual void makeBoundingBoxDirty() override;
+	// sets _min and _max to the cached bounds of the verts, re-calculating them if needed
+	// returns true (a mesh's bounds are always known)
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
+
 	// multiplies the mesh's vertices by the transformation matrix of the provided _transform
 	void applyTransformation(Transform * _transform);
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <iostream>
-#include <map>
+#include <bitset>
 
 #include <glm/glm.hpp>
 #include <node/NodeUpdatable.h>
@@ -91,19 +91,19 @@ public:
 	void translate(glm::vec2 _v, bool _relative = true);
 
 	/**
-	* Clears the maps of justPressed and justReleased buttons
+	* Clears the sets of justPressed and justReleased buttons
 	*/
 	virtual void update(Step * _step) override;
 
 	/**
-	* Inserts _glfwMouseCode into the maps of justPressed and pressed buttons
+	* Inserts _glfwMouseCode into the sets of justPressed and pressed buttons
 	*
 	* @param _glfwMouseCode The GLFW Mouse Code. eg. GLFW_MOUSE_BUTTON_LEFT
 	*/
 	void mouseDownListener(int _glfwMouseCode);
 
 	/**
-	* Inserts _glfwMouseCode into the map of justPressed buttons and removes it from the maps of justPressed and pressed buttons
+	* Inserts _glfwMouseCode into the set of justReleased buttons and removes it from the sets of justPressed and pressed buttons
 	*
 	* @param _glfwMouseCode The GLFW Mouse Code. eg. GLFW_MOUSE_BUTTON_LEFT
 	*/
@@ -137,12 +137,15 @@ private:
 	Mouse();
 	~Mouse();
 
-	/** Map of mouse buttons which are currently pressed down */
-	std::map<int, int> pressedButtons;
-	/** Map of mouse buttons which were pressed down since the mouse's last call to update */
-	std::map<int, int> justPressedButtons;
-	/** Map of mouse buttons which were released since the mouse's last call to update */
-	std::map<int, int> justReleasedButtons;
+	// one more than the largest button code (GLFW_MOUSE_BUTTON_LAST is 7)
+	static const unsigned long int NUM_BUTTONS = 8;
+
+	/** Set of mouse buttons which are currently pressed down, indexed by button code */
+	std::bitset<NUM_BUTTONS> pressedButtons;
+	/** Set of mouse buttons which were pressed down since the mouse's last call to update */
+	std::bitset<NUM_BUTTONS> justPressedButtons;
+	/** Set of mouse buttons which were released since the mouse's last call to update */
+	std::bitset<NUM_BUTTONS> justReleasedButtons;
 
 	/** The mouse's current X coordinate, relative to the left border */
 	double x;
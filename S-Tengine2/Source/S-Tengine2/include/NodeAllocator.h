@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <string>
+
+namespace sweet{
+
+	// Fixed-size block allocator
+	// blocks are carved out of large slabs and recycled through a free list,
+	// so allocating and freeing a block is O(1) and only touches the system allocator once per slab
+	// NOTE: slabs are only released when the pool is deleted
+	class SlabPool{
+	public:
+		const unsigned long int blockSize;
+		const unsigned long int blocksPerSlab;
+
+		// _blockSize is rounded up to the size of a pointer
+		SlabPool(unsigned long int _blockSize, unsigned long int _blocksPerSlab);
+		~SlabPool();
+
+		void * allocate();
+		// _block must have been returned by allocate on this pool
+		void deallocate(void * _block);
+
+		// number of blocks currently allocated
+		unsigned long int getNumLive() const;
+		// highest number of blocks which have been allocated at once
+		unsigned long int getPeakLive() const;
+		// total number of calls to allocate
+		unsigned long int getNumAllocations() const;
+		unsigned long int getNumSlabs() const;
+		// number of bytes requested from the system allocator
+		unsigned long int getReservedBytes() const;
+		// returns true if _ptr points into one of this pool's slabs
+		bool owns(const void * _ptr) const;
+
+	private:
+		struct FreeBlock{
+			FreeBlock * next;
+		};
+
+		mutable std::mutex mutex;
+		FreeBlock * freeList;
+		std::vector<char *> slabs;
+		unsigned long int numLive;
+		unsigned long int peakLive;
+		unsigned long int numAllocations;
+
+		// adds a new slab's blocks to the free list
+		void grow();
+	};
+
+	/***********************************************
+	*
+	* Singleton allocator used for every Node
+	*
+	* Node overrides operator new and delete to route through
+	* here; requests are rounded up to a multiple of granularity
+	* and served from the SlabPool for that size, so the nodes of a
+	* scene graph of N nodes only cost about N * size / slabBytes calls
+	* to the system allocator, and nodes of the same size are packed
+	* together in memory.
+	* Requests larger than maxBlockSize fall through to the global operator new.
+	*
+	* NOTE: this only covers the nodes themselves. The containers they
+	* own (child lists, names, mesh data, etc.) still allocate from the
+	* global heap, so building a scene graph isn't bounded yet; the
+	* scenegraph benchmarks report those as "container heap blocks".
+	*
+	* The pools can be turned off with setPoolsEnabled (e.g. to compare
+	* against the system allocator); blocks are freed correctly whichever
+	* mode they were allocated in.
+	*
+	***********************************************/
+	class NodeAllocator{
+	public:
+		static const unsigned long int granularity = 16;
+		static const unsigned long int maxBlockSize = 1024;
+		// approximate size of each slab
+		static const unsigned long int slabBytes = 64 * 1024;
+
+		static NodeAllocator & getInstance();
+
+		void * allocate(size_t _size);
+		// _size must be the same size that was passed to allocate
+		void deallocate(void * _ptr, size_t _size);
+
+		// returns a table of the size of the core node classes followed by the usage of each pool
+		std::string getReport() const;
+		// logs the result of getReport
+		void printReport() const;
+
+		// number of allocations which were too large for the pools
+		unsigned long int getNumLargeAllocations() const;
+		// number of calls made to the system allocator (slabs, large allocations, and allocations while the pools are off)
+		unsigned long int getNumSystemAllocations() const;
+
+		// if false, every allocation goes straight to the global operator new
+		// default: true
+		void setPoolsEnabled(bool _enabled);
+		bool isPoolsEnabled() const;
+
+	private:
+		// one pool for each multiple of granularity up to maxBlockSize
+		std::vector<SlabPool *> pools;
+		// the counters are atomic so that nodes can be allocated on any thread
+		std::atomic<unsigned long int> numLargeAllocations;
+		std::atomic<bool> poolsEnabled;
+		// allocations made while the pools were off
+		std::atomic<unsigned long int> numHeapAllocations;
+		// allocations made while the pools were off which haven't been freed; while there are any,
+		// deallocate has to check whether a block came from a pool before returning it
+		std::atomic<unsigned long int> numHeapLive;
+
+		NodeAllocator();
+		// never called (see getInstance)
+		~NodeAllocator();
+	};
+}
\ No newline at end of file
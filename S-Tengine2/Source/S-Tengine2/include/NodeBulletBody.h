@@ -5,6 +5,7 @@
 
 class TriMesh;
 class Texture;
+class BulletMotionState;
 
 // NOTE: physics bodies override Entity's update and don't call it
 // This is because the MeshEntity varieties will also call it,
@@ -15,10 +16,17 @@ class NodeBulletBody : public virtual NodePhysicsBody{
 protected:
 	btVector3 internalPos;
 
+	// called after the body is moved directly, so that the next realign doesn't interpolate from where it used to be
+	void resetInterpolation();
+
 public:
 	BulletWorld * world;
 	btRigidBody * body;
+	// shapes set by the setColliderAs functions (other than height maps) come from the CollisionShapeCache,
+	// and are shared with every other body using the same collider; don't modify or delete them directly
 	btCollisionShape * shape;
+	// created with the rigid body; queues this body on the world when the simulation moves it
+	BulletMotionState * motionState;
 	//Max velocity. Should always be set as positive. -1 means no limit
 	btVector3 maxVelocity;
 	
@@ -27,6 +35,7 @@ public:
 	unsigned short int collisionGroup, collisionMask;
 
 	NodeBulletBody(BulletWorld * _world);
+	// releases the shape
 	virtual ~NodeBulletBody();
 
 	void setColliderAsStaticPlane(float _normalX = 0.f, float _normalY = 1.f, float _normalZ = 0.f, float _distanceFromOrigin = 0.f);
@@ -36,6 +45,9 @@ public:
 	void setColliderAsMesh(TriMesh * _colliderMesh, bool _convex);
 	// upAxis = 0, 1, or 2 = x, y, or z axis
 	void setColliderAsHeightMap(Texture * _heightMap, glm::vec3 _scale, unsigned long int _upAxis = 1);
+	// returns the shape to the CollisionShapeCache (or deletes it if it didn't come from the cache) and sets it to nullptr
+	// the rigid body isn't changed, so either replace its shape or remove it from the world before the next step
+	void releaseShape();
 	// a mass of zero makes it static
 	virtual void createRigidBody(float _mass, unsigned short int _collisionGroup = btBroadphaseProxy::DefaultFilter, unsigned short int _collisionMask = btBroadphaseProxy::AllFilter);
 
@@ -45,6 +57,8 @@ public:
 	virtual void rotatePhysical(float _angle, float _x, float _y, float _z, bool _relative = true);
 	virtual void rotatePhysical(glm::quat _rotation, bool _relative = true);
 
+	// realigns the childTransform if the body has been directly adjusted
+	// bodies moved by the simulation are realigned by the world after it steps (see BulletWorld::syncBodies)
 	virtual void update(Step * _step) override;
 	
 	virtual void applyForce(glm::vec3 _force, glm::vec3 _point) override;
@@ -56,5 +70,6 @@ public:
 	virtual glm::vec3 getPhysicsBodyCenter() override;
 	
 	virtual void translatePhysical(glm::vec3 _translation, bool _relative = true) override;
+	// uses the interpolated transform from the motion state if the world is interpolating
 	virtual void realign() override;
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeindex>
+
+class Node;
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Singleton count of the live nodes of each concrete type
+	*
+	* Every Node adds itself to an intrusive list when it's
+	* constructed and removes itself when it's destroyed, which is
+	* O(1) either way; along with it, Node's operator new records the
+	* size of the allocation and the address of the code which called
+	* new (its allocation site).
+	*
+	* The concrete type of a node isn't known until its constructor
+	* has finished, so nodes are sorted into types lazily: new nodes
+	* are kept at the front of the list, and are looked up (once each)
+	* the next time the counts are read. Because of that, the counts
+	* should only be read from the main thread, while nothing is being
+	* constructed on other threads.
+	*
+	* Snapshots of the counts can be compared with diff, and every
+	* node gets a serial number so that the NodeResources created
+	* between two snapshots which are still alive (e.g. after a scene
+	* has been deleted) can be listed along with their allocation
+	* sites.
+	*
+	* This is always on; it replaces the old _DEBUG-only node list.
+	*
+	***********************************************/
+	class NodeCensus{
+	public:
+		struct TypeCount{
+			// name of the concrete type (as given by typeid)
+			std::string name;
+			// nodes of this type which are alive
+			unsigned long int live;
+			// bytes allocated for them by Node's operator new (0 for nodes which weren't allocated with new, e.g. members)
+			unsigned long long int bytes;
+			// highest value live has reached (since the type was first seen)
+			unsigned long int peak;
+			// nodes of this type which have been constructed and destroyed in total
+			unsigned long int constructed;
+			unsigned long int destroyed;
+
+			TypeCount();
+		};
+
+		struct Snapshot{
+			// serial number the next node will get
+			unsigned long long int serial;
+			// keyed by type name
+			std::map<std::string, TypeCount> types;
+			unsigned long int live;
+			unsigned long long int bytes;
+
+			Snapshot();
+		};
+
+		struct TypeDiff{
+			std::string name;
+			signed long int live;
+			signed long long int bytes;
+		};
+
+		struct Leak{
+			std::string type;
+			std::string nodeName;
+			unsigned long int referenceCount;
+			bool autoRelease;
+			unsigned long long int serial;
+			// e.g. "S-Tengine2.exe+0x1a2b3c" or a symbol name; "unknown" if the node wasn't allocated with new
+			std::string site;
+		};
+
+		static NodeCensus & getInstance();
+
+		// called by Node's constructor and destructor
+		void add(Node * _node, unsigned long int _bytes, void * _site);
+		void remove(Node * _node);
+
+		// returns the number of nodes which are alive (doesn't need to sort the new nodes)
+		unsigned long int getLiveCount() const;
+		// returns the counts for every type which has been seen
+		Snapshot takeSnapshot();
+		// returns the change in each type's live count and bytes from _before to _after, largest change in bytes first
+		// types whose counts didn't change are left out
+		static std::vector<TypeDiff> diff(const Snapshot & _before, const Snapshot & _after);
+		static std::string getDiffReport(const Snapshot & _before, const Snapshot & _after);
+
+		// returns every NodeResource which is still alive and was constructed between the two snapshots
+		std::vector<Leak> getLeaks(const Snapshot & _since, const Snapshot & _until);
+		std::string getLeakReport(const Snapshot & _since, const Snapshot & _until);
+
+		// returns a table of the live count, bytes, and peak of each type, most bytes first
+		std::string getReport();
+		// logs the result of getReport
+		void printReport();
+		// returns a line for every node which is alive, in the format: TYPE ADDRESS NAME
+		std::string getNodeList();
+
+		// returns a readable name for the code at _site
+		static std::string getSiteName(void * _site);
+
+	private:
+		mutable std::mutex mutex;
+		// every live node; nodes which haven't been sorted into a type yet are at the front
+		Node * first;
+		unsigned long int live;
+		unsigned long long int bytes;
+		unsigned long long int nextSerial;
+
+		std::vector<TypeCount> types;
+		std::map<std::type_index, unsigned long int> typeIndices;
+
+		// sorts the new nodes into their types; the mutex must be locked
+		void classify();
+
+		NodeCensus();
+		// never called (see getInstance)
+		~NodeCensus();
+	};
+}
\ No newline at end of file
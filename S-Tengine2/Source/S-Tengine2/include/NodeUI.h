@@ -99,7 +99,7 @@ public:
 	Plane * const background;
 
 	OrthographicCamera * textureCam;
-	StandardFrameBuffer * frameBuffer;
+	// copy of the pixels last rendered to a render target from the sweet::RenderTargetPool
 	FBOTexture * renderedTexture;
 	MeshEntity * texturedPlane;
 
@@ -111,6 +111,8 @@ public:
 
 	virtual void update(Step * _step) override;
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOption) override;
+	// UI may be drawn through a texture or with a different camera, so it is never culled as a whole
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
 	virtual void load() override;
 	virtual void unload() override;
 
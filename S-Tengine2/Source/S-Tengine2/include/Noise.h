@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glm\glm.hpp>
+
+namespace sweet{
+
+/***********************************************
+*
+* Coherent noise generator
+*
+* Supports Perlin, simplex, and value noise, summed
+* over several octaves. Each generator has its own
+* permutation table, so it doesn't touch the shared
+* RNG and can be sampled from several threads at once.
+*
+* Rows of samples are generated four at a time
+* using SSE2 where it's available
+*
+***********************************************/
+class Noise{
+public:
+	typedef enum{
+		kPERLIN,
+		kSIMPLEX,
+		kVALUE
+	} Type;
+
+	Type type;
+	// number of layers of noise which are added together
+	unsigned long int octaves;
+	// frequency multiplier between successive octaves
+	float lacunarity;
+	// amplitude multiplier between successive octaves
+	float persistence;
+
+	explicit Noise(Type _type = kPERLIN, unsigned long int _seed = 0);
+
+	// rebuilds the permutation table from _seed
+	void setSeed(unsigned long int _seed);
+	unsigned long int getSeed() const;
+
+	// returns the fractal noise at the given point, roughly in the range [-1, 1]
+	float get(float _x, float _y, float _z) const;
+	// fills _res with the fractal noise at (_x + i*_dx, _y, _z) for i in [0, _count)
+	void getRow(float * _res, unsigned long int _count, float _x, float _dx, float _y, float _z) const;
+
+	// fills _data (_width x _height pixels, _channels bytes each) with noise sampled at (x/_width * _frequency.x, y/_height * _frequency.y, _z * _frequency.z)
+	// each sample is mapped to value * _amplitude + _offset, clamped to 0-255, and written to every channel of the pixel
+	// the rows are split into tiles which are filled in parallel on the job system
+	void fill(unsigned char * _data, unsigned long int _width, unsigned long int _height, unsigned long int _channels, glm::vec3 _frequency, float _z, float _amplitude = 127.5f, float _offset = 127.5f) const;
+
+	// returns a well-mixed hash of _x (useful as cheap, thread-safe white noise)
+	static unsigned long int hash(unsigned long int _x);
+
+private:
+	unsigned long int seed;
+	// permutation of 0-255, repeated twice so that lookups don't need to wrap
+	unsigned char perm[512];
+
+	// single octave of each type of noise
+	float perlin(float _x, float _y, float _z) const;
+	float simplex(float _x, float _y, float _z) const;
+	float value(float _x, float _y, float _z) const;
+
+	// single octave of noise at (_x + i*_dx, _y, _z), added to _res after being multiplied by _amplitude
+	void addRow(float * _res, unsigned long int _count, float _x, float _dx, float _y, float _z, float _amplitude) const;
+
+	// returns the permutation of the lattice point (_x, _y, _z)
+	unsigned char hash3(signed long int _x, signed long int _y, signed long int _z) const;
+};
+
+}
\ No newline at end of file
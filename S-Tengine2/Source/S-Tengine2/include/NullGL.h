@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Null OpenGL backend
+	*
+	* install() points GLEW's function pointers at stubs which
+	* don't need a context or a GPU: object creation hands out
+	* increasing ids, queries report success (compile/link status,
+	* framebuffer completeness), and everything else just records
+	* what would have been sent to the driver.
+	*
+	* This lets meshes, shaders, and scenes be loaded, cleaned, and
+	* rendered headlessly (e.g. by the BenchmarkRunner).
+	*
+	* NOTE: only entry points loaded through GLEW can be replaced;
+	* GL 1.1 functions (glBindTexture, glTexImage2D, glGetIntegerv, etc.)
+	* are exported directly by the system library and are expected
+	* to do nothing when there isn't a current context
+	*
+	***********************************************/
+	class NullGL{
+	public:
+		struct Stats{
+			// total number of stubbed calls
+			unsigned long int calls;
+			unsigned long int drawCalls;
+			unsigned long int indicesDrawn;
+			// glBufferData (with data) and glBufferSubData calls, and the number of bytes they were given
+			unsigned long int bufferUploads;
+			unsigned long int bufferUploadBytes;
+			// glUniform* calls
+			unsigned long int uniformUploads;
+			unsigned long int programBinds;
+			unsigned long int vertexArrayBinds;
+			unsigned long int framebufferBinds;
+			// buffers, vertex arrays, shaders, programs, framebuffers, and renderbuffers created
+			unsigned long int objectsCreated;
+			unsigned long int framebuffersCreated;
+			// glRenderbufferStorage calls, and the number of bytes they allocated (assuming 4 bytes per pixel)
+			unsigned long int renderbufferAllocations;
+			unsigned long int renderbufferBytes;
+
+			Stats();
+		};
+
+		// replaces the GLEW function pointers with the null stubs
+		// there's no way to uninstall, since the original pointers may not have been loaded in the first place
+		static void install();
+		static bool isInstalled();
+
+		// returns the counters recorded since the last call to resetStats
+		static const Stats & getStats();
+		static void resetStats();
+
+		// if enabled, the name of every stubbed call is appended to the call log
+		static void setRecording(bool _recording);
+		static const std::vector<const char *> & getCallLog();
+		static void clearCallLog();
+
+	private:
+		static bool installed;
+	};
+}
\ No newline at end of file
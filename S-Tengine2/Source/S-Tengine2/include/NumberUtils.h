@@ -95,25 +95,27 @@ namespace sweet{
 		{};
 	};
 
+	// the random functions here draw from the "default" stream of sweet::Random
+	// code which needs lots of random numbers, or its own reproducible sequence, should use its own stream instead (see Random.h)
 	class NumberUtils{
 	public:
-		// number of calls to randomInt() since the last call to seed()
+		// number of calls to the random functions since the last call to seed()
 		static unsigned long int numRandCalls;
 
 		static float pingPong(float _val, float _min, float _max);
 
 		static float map(float _val, float _oldMin, float _oldMax, float _newMin, float _newMax);
 
-		// returns a random number in the range _min < res < _max
+		// returns a random number in the range _min <= res < _max
 		static float randomFloat(float _min, float _max);
-		// returns a random number in the range 0 < res < 1
+		// returns a random number in the range 0 <= res < 1
 		static float randomFloat();
 
-		// returns a random number in the range _min <= res <= _max
+		// returns a random number in the range _min <= res <= _max (without modulo bias)
 		static int randomInt(int _min, int _max);
 		// returns a random number in the range 0 <= res <= INT_MAX/2
 		static int randomInt();
-		// returns true or false, based on a randomly generated int
+		// returns true or false
 		static bool randomBool();
 
 		// returns a random vec3 where each dimension is in the range _min <= _max
@@ -126,7 +128,7 @@ namespace sweet{
 			return _items.at(randomInt(0, _items.size()-1));
 		}
 
-		// seeds the random number generator
+		// seeds the random number generators (every sweet::Random stream is reseeded as well)
 		static void seed(unsigned long int _seed);
 
 		/* Perlin Noise port */
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <MeshEntity.h>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <Box2D/Box2D.h>
+
+class Box2DWorld;
+class Texture;
+
+// settings used to spawn particles
+// each value is picked randomly between value - variance and value + variance
+struct ParticleEmitter{
+	glm::vec3 position;
+	glm::vec3 positionVariance;
+	glm::vec3 velocity;
+	glm::vec3 velocityVariance;
+	float life;
+	float lifeVariance;
+	// size of the particle at the start and end of its life
+	float startSize;
+	float endSize;
+	float sizeVariance;
+	// colour of the particle at the start and end of its life
+	glm::vec4 startColour;
+	glm::vec4 endColour;
+	// particles emitted per second while active
+	float rate;
+	bool active;
+
+	ParticleEmitter();
+
+private:
+	// fractional particles left over from the last update
+	float accumulator;
+	friend class ParticlePool;
+};
+
+// an acceleration applied to every particle
+struct ParticleForce{
+	typedef enum{
+		// accelerates particles along vector (e.g. gravity, wind)
+		kDIRECTIONAL,
+		// accelerates particles towards the point vector with the given strength (negative values push them away)
+		kPOINT,
+		// slows particles down by strength * velocity
+		kDRAG
+	} Type;
+
+	Type type;
+	glm::vec3 vector;
+	float strength;
+
+	ParticleForce(Type _type, glm::vec3 _vector, float _strength = 1.f);
+};
+
+/***********************************************
+*
+* Pooled particle simulator
+*
+* Particle state is kept in a set of preallocated arrays
+* (one per property) instead of one node per particle,
+* so spawning and killing particles never allocates.
+* Dead particles are swapped with the last live particle,
+* which keeps the live particles packed at the start of
+* the arrays.
+*
+* All of the live particles are drawn as camera-independent
+* quads in the XY plane from a single dynamic mesh.
+*
+* If world is set, particles collide with the fixtures in it
+* (using the same units as the Box2DWorld, so the pool itself
+* shouldn't be transformed). The fixtures near the particles are
+* collected with a single query per update, and each particle's
+* movement is then raycast against those fixtures in parallel.
+*
+***********************************************/
+class ParticlePool : public MeshEntity{
+public:
+	std::vector<ParticleEmitter> emitters;
+	std::vector<ParticleForce> forces;
+
+	// world to collide with; nullptr to disable collision
+	Box2DWorld * world;
+	// only fixtures which would collide with this filter are considered
+	b2Filter collisionFilter;
+	// fraction of the velocity along the surface normal that is kept after a collision
+	float restitution;
+	// fraction of the velocity along the surface that is kept after a collision
+	float friction;
+
+	// _capacity = maximum number of live particles; any particles spawned past this are dropped
+	explicit ParticlePool(unsigned long int _capacity, Texture * _texture = nullptr, Shader * _shader = nullptr);
+	~ParticlePool();
+
+	// runs the emitters, simulates the particles, and rebuilds the mesh
+	virtual void update(Step * _step) override;
+
+	// spawns up to _count particles using the settings of _emitter; returns the number actually spawned
+	unsigned long int emit(const ParticleEmitter & _emitter, unsigned long int _count);
+	// moves the particles forward by _deltaTime seconds and kills the ones which have reached the end of their lives
+	// doesn't touch the mesh, so it can be used without a GL context
+	void simulate(float _deltaTime);
+	// rewrites the mesh's vertices and indices to match the live particles
+	void updateMesh();
+	// kills every particle
+	void clear();
+
+	unsigned long int getCount() const;
+	unsigned long int getCapacity() const;
+
+	// read-only access to the live particles (the first getCount() entries are valid)
+	const glm::vec3 * getPositions() const;
+	const glm::vec3 * getVelocities() const;
+	const float * getAges() const;
+	const float * getLives() const;
+
+private:
+	unsigned long int capacity;
+	unsigned long int count;
+
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> velocities;
+	std::vector<float> ages;
+	std::vector<float> lives;
+	std::vector<float> startSizes;
+	std::vector<float> endSizes;
+	std::vector<glm::vec4> startColours;
+	std::vector<glm::vec4> endColours;
+
+	// positions at the start of the last step, used for collision
+	std::vector<glm::vec3> previousPositions;
+	// fixtures near the particles, refreshed every step
+	std::vector<b2Fixture *> nearbyFixtures;
+
+	// indices for a full pool; the first count * 6 are copied into the mesh
+	std::vector<GLuint> quadIndices;
+
+	// replaces particle _idx with the last live particle
+	void kill(unsigned long int _idx);
+	// raycasts each particle's movement over the last step against the world and bounces it off anything it hits
+	void collide();
+};
\ No newline at end of file
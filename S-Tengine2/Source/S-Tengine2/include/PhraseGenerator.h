@@ -4,10 +4,23 @@
 #include <NumberUtils.h>
 
 #include <string>
+#include <vector>
 #include <map>
 
-// A generic phrase generator which uses regex to replace pre-defined
-// escaped terms with random entries from an externally-loaded JSON database
+// A phrase which has been split into literal text and placeholders,
+// so that it only needs to be parsed once no matter how many times it is expanded
+struct PhraseTemplate{
+	struct Segment{
+		// the literal text, or the name of the term list for a placeholder
+		std::string text;
+		// the term list a placeholder picks from; nullptr for literal text
+		sweet::ShuffleVector<std::string> * terms;
+	};
+	std::vector<Segment> segments;
+};
+
+// A generic phrase generator which replaces pre-defined escaped terms
+// with random entries from an externally-loaded JSON database
 //
 // Example term database:
 //
@@ -48,13 +61,38 @@ protected:
 	std::string escapeChar;
 
 	// replaces any escaped sequences within _phrase with random terms of the appropriate type and returns the result
-	// this is iterative, and will occur as many times as necessary
+	// this is recursive, and will occur as many times as necessary
 	// e.g. *phrase* -> The *noun* was *adjective*. -> The dog was good.
+	// an empty placeholder (i.e. two escapeChars in a row) is replaced with a single escapeChar
+	// NOTE: phrases and terms are compiled into templates the first time they are seen and cached, so
+	// repeated expansions don't need to re-parse anything
 	std::string replaceWords(std::string _phrase);
+	// the original regex-based implementation of replaceWords; terms are picked in the same order,
+	// but every placeholder requires building and running two regexes over the whole phrase
+	// kept as a reference for comparison (e.g. in the benchmarks)
+	std::string replaceWordsRegex(std::string _phrase);
+
+	// returns the compiled template for _phrase, compiling and caching it if it hasn't been seen before
+	const PhraseTemplate & getTemplate(const std::string & _phrase);
+	// appends the expansion of _template to _output
+	// placeholders are expanded depth-first, up to a maximum depth of 32 (deeper placeholders are left empty)
+	void expand(const PhraseTemplate & _template, std::string & _output, unsigned long int _depth = 0);
+	// removes all of the cached templates
+	// (called automatically when the database is loaded or the escapeChar changes)
+	void clearTemplates();
 
 	// accounts for the "a" vs. "an" problem
 	//std::string fixVowels(std::string phrase);
 	
 	// loads a json file stored at _databaseSrc into the map of terms
+	// every term is compiled into a template as it is loaded
 	void makeDatabases(std::string _databaseSrc);
+
+private:
+	// compiled templates, keyed by their source phrase
+	std::map<std::string, PhraseTemplate> templates;
+	// the escapeChar that the cached templates were compiled with
+	std::string templateEscapeChar;
+	// reused between calls to replaceWords to avoid reallocating
+	std::string buffer;
 };
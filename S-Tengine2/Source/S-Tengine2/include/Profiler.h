@@ -0,0 +1,174 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+
+// comment this out to compile the profiling macros out completely
+#define SWEET_PROFILING 1
+
+namespace sweet{
+
+	// a single timed scope
+	struct ProfileSample{
+		// NOTE: only the pointer is stored, so this needs to be a string literal (or otherwise outlive the profiler)
+		const char * name;
+		// seconds since the profiler was created
+		double start;
+		double duration;
+		// index of the thread which recorded the sample: 0 is the main thread, the job system's workers use their JobSystem::getThreadIndex,
+		// and other threads are numbered after them
+		unsigned long int thread;
+		// number of scopes which were open on the thread when this one started
+		unsigned long int depth;
+	};
+
+	/***********************************************
+	*
+	* Singleton frame profiler
+	*
+	* Use the SWEET_PROFILE_* macros instead of calling this
+	* directly so that the instrumentation disappears when
+	* SWEET_PROFILING isn't defined.
+	*
+	* Samples and counters are collected per-frame and the last
+	* getHistoryLength() frames are kept in a ring buffer, which
+	* can be shown with a ProfilerOverlay or exported for
+	* chrome://tracing with exportChromeTrace.
+	*
+	***********************************************/
+	class Profiler{
+	public:
+		typedef enum{
+			// glDraw* calls
+			kDRAW_CALLS,
+			// shader component cleans (each one uploads that component's uniforms)
+			kUNIFORM_UPLOADS,
+			// glBufferData and glBufferSubData calls which send data
+			kBUFFER_UPLOADS,
+			// bytes sent by glBufferData and glBufferSubData
+			kBUFFER_UPLOAD_BYTES,
+			// nodes allocated
+			kNODE_ALLOCATIONS,
+			// physics bodies realigned after a step
+			kPHYSICS_SYNCS,
+			// framebuffer binds sent to GL by pushFbo/popFbo (binds of the already-bound FBO are skipped)
+			kFRAMEBUFFER_BINDS,
+
+			kNUM_COUNTERS
+		} Counter;
+
+		struct Frame{
+			// number of frames before this one since the profiler was created
+			unsigned long int index;
+			double start;
+			double duration;
+			std::vector<ProfileSample> samples;
+			unsigned long int counters[kNUM_COUNTERS];
+		};
+
+		// whether samples and counters are recorded (they are still ignored if SWEET_PROFILING isn't defined)
+		bool enabled;
+
+		static Profiler & getInstance();
+
+		// returns the name used for _counter in reports and traces
+		static const char * getCounterName(Counter _counter);
+
+		// finishes the current frame, moves it into the history, and starts the next one
+		void beginFrame();
+
+		// returns the number of seconds since the profiler was created
+		double getTime() const;
+
+		// adds _amount to _counter for the current frame
+		void count(Counter _counter, unsigned long int _amount);
+
+		// number of completed frames kept in the history
+		void setHistoryLength(unsigned long int _frames);
+		unsigned long int getHistoryLength() const;
+		// returns the number of completed frames currently in the history
+		unsigned long int getNumFrames() const;
+		// returns a completed frame; 0 is the most recent
+		const Frame & getFrame(unsigned long int _age) const;
+
+		// writes every frame in the history to _filename in the trace event format used by chrome://tracing
+		// returns false if the file couldn't be opened
+		bool exportChromeTrace(const std::string & _filename) const;
+
+		// used by ProfileScope; opens a scope, setting _thread to the calling thread's index and _depth to the number of scopes already open on it
+		// returns false if the thread doesn't have any state to record into, in which case the scope is dropped
+		bool pushScope(unsigned long int & _thread, unsigned long int & _depth);
+		// used by ProfileScope; records a sample and closes the scope
+		void popScope(const char * _name, double _start, unsigned long int _thread, unsigned long int _depth);
+
+	private:
+		// samples are collected per thread so that threads only contend with beginFrame
+		// the first half is for the main thread and the workers, the second half is handed out to any other threads as they open their first scope
+		// (slots aren't reused, so once they run out, scopes on new threads are dropped)
+		static const unsigned long int maxThreads = 64;
+		static const unsigned long int firstOtherThread = maxThreads / 2;
+		struct ThreadState{
+			// spin lock guarding samples
+			std::atomic<bool> locked;
+			unsigned long int depth;
+			std::vector<ProfileSample> samples;
+		};
+		ThreadState threads[maxThreads];
+		// the thread which created the profiler, which is treated as the main thread
+		std::thread::id mainThread;
+		// next slot for a thread which is neither the main thread nor a worker
+		std::atomic<unsigned long int> nextOtherThread;
+
+		std::atomic<unsigned long int> counters[kNUM_COUNTERS];
+
+		// ring buffer of completed frames
+		std::vector<Frame> frames;
+		// index in frames where the next completed frame will be written
+		unsigned long int nextFrame;
+		unsigned long int numFrames;
+
+		unsigned long int frameIndex;
+		// negative until beginFrame is called for the first time
+		double frameStart;
+
+		// platform-specific reference point and resolution for getTime
+		long long int startTicks;
+		double tickFrequency;
+
+		Profiler();
+		~Profiler();
+	};
+
+	// records the time between its construction and destruction as a sample
+	class ProfileScope{
+	public:
+		explicit ProfileScope(const char * _name);
+		~ProfileScope();
+	private:
+		const char * name;
+		double start;
+		unsigned long int thread;
+		unsigned long int depth;
+		bool active;
+	};
+}
+
+#ifdef SWEET_PROFILING
+	#define SWEET_PROFILE_CONCAT_INNER(_a, _b) _a##_b
+	#define SWEET_PROFILE_CONCAT(_a, _b) SWEET_PROFILE_CONCAT_INNER(_a, _b)
+	// times the rest of the enclosing block
+	#define SWEET_PROFILE_SCOPE(_name) sweet::ProfileScope SWEET_PROFILE_CONCAT(profileScope, __LINE__)(_name)
+	// times the rest of the enclosing function, using the function name
+	#define SWEET_PROFILE_FUNCTION() SWEET_PROFILE_SCOPE(__FUNCTION__)
+	// adds _amount to counter _counter (e.g. kDRAW_CALLS)
+	#define SWEET_PROFILE_COUNT(_counter, _amount) sweet::Profiler::getInstance().count(sweet::Profiler::_counter, _amount)
+	// marks the start of a new frame
+	#define SWEET_PROFILE_FRAME() sweet::Profiler::getInstance().beginFrame()
+#else
+	#define SWEET_PROFILE_SCOPE(_name)
+	#define SWEET_PROFILE_FUNCTION()
+	#define SWEET_PROFILE_COUNT(_counter, _amount)
+	#define SWEET_PROFILE_FRAME()
+#endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <TextArea.h>
+
+// Text display for the frame profiler
+// shows the average and worst time spent in each scope on the main thread, along with the average of each counter,
+// over the frames in the profiler's history
+class ProfilerOverlay : public TextArea {
+public:
+	// scopes nested deeper than this aren't listed
+	unsigned long int maxDepth;
+	// seconds between refreshes of the text
+	float refreshInterval;
+
+	ProfilerOverlay(BulletWorld * _world, Font * _font, Shader * _textShader);
+
+	void update(Step * _step) override;
+
+	// returns the text shown by the overlay
+	static std::wstring getSummary(unsigned long int _maxDepth);
+
+private:
+	double lastRefresh;
+};
\ No newline at end of file
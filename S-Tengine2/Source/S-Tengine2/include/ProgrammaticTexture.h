@@ -1,8 +1,12 @@
 #pragma once
 
 #include "Texture.h"
+#include <Noise.h>
+#include <JobSystem.h>
 #include <glm\glm.hpp>
 
+#include <functional>
+
 class ProgrammaticTexture : public Texture {
 public:
 	ProgrammaticTexture(unsigned char * _data = nullptr, bool _autoRelease = true, bool _useMipmaps = true);
@@ -13,6 +17,20 @@ public:
 
 
 	void allocate(unsigned long int _width, unsigned long int _height, unsigned long int _channels = 4);
+
+	// double-buffering: fills a second buffer the same size as data in the background while data is being used
+	// _fill is run on the job system with the back buffer; the previous fill is finished first
+	void fillBackBuffer(std::function<void(unsigned char *)> _fill);
+	// waits for the last fillBackBuffer to finish and swaps the back buffer with data
+	// returns false if there wasn't a filled back buffer to swap in (or if the texture was resized after it was filled)
+	bool swapBuffers();
+
+private:
+	unsigned char * backBuffer;
+	// size of backBuffer; it's reallocated when it no longer matches numBytes
+	unsigned long int backBufferBytes;
+	bool backBufferFilled;
+	sweet::JobCounter backBufferJobs;
 };
 
 class NoiseTexture : public ProgrammaticTexture{
@@ -21,7 +39,15 @@ public:
 	unsigned char minVal, maxVal;
 	NoiseTexture(unsigned long int _width, unsigned long int _height, bool _autoRelease = true, bool _useMipmaps = true);
 
+	// fills the texture with new white noise (in parallel, using a hash instead of the shared RNG)
 	void setNoise();
+	// generates the next set of noise into the back buffer in the background; call swapBuffers to use it
+	void setNoiseAsync();
+
+private:
+	// incremented for every set of noise so that each one is different
+	unsigned long int generation;
+	void generate(unsigned char * _data, unsigned long int _generation) const;
 };
 
 class PerlinNoiseTexture : public ProgrammaticTexture{
@@ -29,12 +55,20 @@ public:
 	// coordinates are multiplied by frequency before calling perlin noise function
 	// low frequency = larger, smoother waves; high frequency = short, spikier waves
 	glm::vec3 frequency;
-	// result of perlin noise function is multiplied by amplitude
+	// result of perlin noise function (roughly -1 to 1) is multiplied by amplitude
+	// default: 127
 	unsigned char amplitude;
-	// offset is added to result of perlin noise
+	// offset is added to result of perlin noise after the amplitude is applied; the result is clamped to 0-255
+	// default: 128
 	unsigned char offset;
+	// the noise function; can be changed to simplex or value noise, and have more octaves
+	sweet::Noise noise;
 	PerlinNoiseTexture(unsigned long int _width, unsigned long int _height, bool _autoRelease = true, bool _useMipmaps = true);
 
 	// _time is the z coordinate of the perlin noise function
+	// the texture is filled in parallel tiles on the job system
 	void setNoise(float _time);
+	// generates the noise for _time into the back buffer in the background; call swapBuffers to use it
+	// e.g. each frame: swapBuffers(), bufferData(), then setNoiseAsync(nextTime) so the next frame is generated while this one is uploaded
+	void setNoiseAsync(float _time);
 };
\ No newline at end of file
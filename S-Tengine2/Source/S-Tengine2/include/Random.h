@@ -0,0 +1,99 @@
+#pragma once
+
+#include <glm\glm.hpp>
+
+#include <string>
+#include <map>
+
+namespace sweet{
+
+/***********************************************
+*
+* Pseudo-random number generator (xoshiro128**)
+*
+* Each generator is four words of state, so they're cheap
+* enough to keep one per subsystem or per thread. Generators
+* aren't thread-safe themselves; use split() to give each
+* thread (or job) its own.
+*
+* Named streams are generators derived from the global seed
+* (Configuration::rngSeed) and the stream's name, so a
+* subsystem gets the same numbers for the same seed no matter
+* what else draws from the other streams in between.
+*
+* Ranges are unbiased: integers use rejection sampling instead
+* of a modulo, and floats use the top 24 bits of a draw.
+*
+***********************************************/
+class Random{
+public:
+	explicit Random(unsigned long long int _seed = 0);
+
+	// resets the state using _seed
+	void seed(unsigned long long int _seed);
+
+	// returns the next 32 random bits
+	inline unsigned int next(){
+		const unsigned int res = rotl(state[1] * 5, 7) * 9;
+		const unsigned int t = state[1] << 9;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 11);
+		return res;
+	}
+
+	// returns a random number in the range 0 <= res < _bound (_bound must be greater than zero)
+	unsigned int nextBounded(unsigned int _bound);
+	// returns a random number in the range _min <= res <= _max
+	int nextInt(int _min, int _max);
+	// returns a random number in the range 0 <= res < 1
+	inline float nextFloat(){
+		return (next() >> 8) * (1.f / 16777216.f);
+	}
+	// returns a random number in the range _min <= res < _max
+	inline float nextFloat(float _min, float _max){
+		return _min + nextFloat() * (_max - _min);
+	}
+	bool nextBool();
+	// returns a random vec3 where each dimension is in the range _min <= res < _max
+	glm::vec3 nextVec3(glm::vec3 _min, glm::vec3 _max);
+
+	// fills _out with _count random numbers in the range _min <= res < _max
+	void fill(float * _out, unsigned long int _count, float _min = 0.f, float _max = 1.f);
+	// fills _out with _count random numbers in the range _min <= res <= _max
+	void fill(int * _out, unsigned long int _count, int _min, int _max);
+	// fills _out with _count random vec3s where each dimension is in the range _min <= res < _max
+	void fill(glm::vec3 * _out, unsigned long int _count, glm::vec3 _min, glm::vec3 _max);
+
+	// advances the state by 2^64 draws
+	void jump();
+	// returns a copy of this generator and then jumps this one ahead,
+	// so the two produce non-overlapping sequences (for up to 2^64 draws each)
+	Random split();
+
+	// returns the generator for the stream named _name, creating it if it doesn't exist yet
+	// NOTE: creating streams isn't thread-safe; get them on the main thread and split them for workers
+	static Random & getStream(const std::string & _name);
+	// reseeds every stream from _seed (called by NumberUtils::seed)
+	static void seedStreams(unsigned long long int _seed);
+
+private:
+	// (unsigned int is 32 bits on every platform we build for)
+	unsigned int state[4];
+
+	static inline unsigned int rotl(unsigned int _x, int _k){
+		return (_x << _k) | (_x >> (32 - _k));
+	}
+
+	// seed that the streams are derived from
+	static unsigned long long int streamSeed;
+	static std::map<std::string, Random> streams;
+
+	// returns the seed for the stream named _name
+	static unsigned long long int getStreamSeed(const std::string & _name);
+};
+
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 class Shader;
 class Light;
+class DrawData;
 
 struct ViewPortDimensions {
 	int x;
@@ -15,6 +16,22 @@ struct ViewPortDimensions {
 	int height;
 };
 
+// counters collected while traversing the scene graph during a render
+struct RenderStats {
+	// number of renderable nodes reached by transforms during traversal
+	unsigned long int nodesVisited;
+	// number of renderable nodes skipped because their bounds were outside of the view frustum
+	unsigned long int nodesCulled;
+	// number of meshes which issued a draw call
+	unsigned long int nodesDrawn;
+
+	RenderStats() :
+		nodesVisited(0),
+		nodesCulled(0),
+		nodesDrawn(0)
+	{}
+};
+
 class RenderOptions : public Node{
 public:
 
@@ -40,6 +57,13 @@ public:
 	// View port values
 	ViewPortDimensions viewPortDimensions;
 
+	// counters for everything rendered using these options
+	RenderStats stats;
+
+	// per-draw settings of the entity currently being rendered (see MeshEntity::drawData)
+	// nullptr outside of entities
+	DrawData * drawData;
+
 	// OpenGL clear colour - Defaults to black
 	float clearColour[4];
 
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <FrameBufferChannel.h>
+
+#include <vector>
+
+class FrameBufferInterface;
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Singleton pool of transient framebuffers
+	*
+	* Instead of owning a FrameBufferInterface for life, a pass
+	* acquires one with the channels and size it needs, renders to
+	* it, reads back whatever it needs, and releases it. Released
+	* targets are handed to the next pass asking for the same
+	* channels and size, and are deleted once they've gone unused
+	* for maxIdleFrames frames (e.g. after a window resize).
+	*
+	* Render buffer channels (e.g. depth) can't be read by shaders,
+	* so they're scratch space for the duration of a pass: they're
+	* shared between every pooled target of the same format and size,
+	* and only as many exist as are in use at once.
+	*
+	* Texture channels belong to their target until it's released.
+	*
+	***********************************************/
+	class RenderTargetPool{
+	public:
+		struct Stats{
+			// calls to acquire
+			unsigned long int acquisitions;
+			// acquisitions served by a target which was already in the pool
+			unsigned long int reuses;
+			// framebuffers created
+			unsigned long int allocations;
+			// shared render buffers created
+			unsigned long int renderBufferAllocations;
+			// framebuffers and render buffers deleted for being idle (or by clear)
+			unsigned long int frees;
+
+			// framebuffers in the pool, in use or not
+			unsigned long int targets;
+			unsigned long int targetsInUse;
+			// shared render buffers in the pool
+			unsigned long int renderBuffers;
+			// approximate number of bytes used on the GPU by the pool's textures and render buffers
+			unsigned long int bytes;
+			// largest value bytes has reached
+			unsigned long int peakBytes;
+
+			Stats();
+
+			// returns the fraction of acquisitions which reused a target
+			double getReuseRate() const;
+		};
+
+		// number of endFrame calls a released target or render buffer is kept for before it's deleted
+		// default: 60
+		unsigned long int maxIdleFrames;
+
+		static RenderTargetPool & getInstance();
+
+		// returns a framebuffer with _channels (as they would be passed to a FrameBufferInterface) and the given size
+		// the framebuffer is only yours until it's released; don't delete it, resize it, or keep pointers to it
+		FrameBufferInterface * acquire(const std::vector<FrameBufferChannel> & _channels, unsigned long int _width, unsigned long int _height);
+		// returns _target to the pool
+		void release(FrameBufferInterface * _target);
+
+		// deletes targets and render buffers which have been idle for too long
+		// called by the Game once per frame
+		void endFrame();
+		// deletes every target and render buffer which isn't in use
+		void clear();
+
+		const Stats & getStats() const;
+		// resets the counters, but not the current number of targets, render buffers, or bytes
+		void resetStats();
+
+	private:
+		struct RenderBuffer{
+			GLuint id;
+			GLint internalFormat;
+			unsigned long int width;
+			unsigned long int height;
+			unsigned long int bytes;
+			bool inUse;
+			unsigned long int lastUsedFrame;
+		};
+
+		struct Target{
+			FrameBufferInterface * fbo;
+			// render buffers attached to each channel (nullptr for texture channels)
+			std::vector<RenderBuffer *> renderBuffers;
+			bool inUse;
+			unsigned long int lastUsedFrame;
+		};
+
+		std::vector<Target *> targets;
+		std::vector<RenderBuffer *> renderBuffers;
+		unsigned long int frame;
+		Stats stats;
+
+		RenderTargetPool();
+		~RenderTargetPool();
+
+		// returns true if _target has _channels and is _width by _height
+		static bool matches(const Target * _target, const std::vector<FrameBufferChannel> & _channels, unsigned long int _width, unsigned long int _height);
+		// returns an unused render buffer for _channel, creating it if there isn't one
+		RenderBuffer * acquireRenderBuffer(const FrameBufferChannel & _channel, unsigned long int _width, unsigned long int _height);
+		// deletes targets and render buffers which aren't in use and were last used at or before _frame
+		void deleteIdle(unsigned long int _frame);
+		void addBytes(unsigned long int _bytes);
+	};
+}
\ No newline at end of file
@@ -71,6 +71,9 @@ public:
 	* the sweet::currentContext using the camera's view-projection matrix 
 	*/
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) override;
+
+	// scenes set up their own camera, so they are never culled
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
 	
 	//virtual void renderShadows(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions);
 
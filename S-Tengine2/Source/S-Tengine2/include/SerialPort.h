@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Serial port (8N1, no flow control) with non-blocking reads
+	*
+	* Uses the Win32 comm API on Windows and termios everywhere else.
+	* Port names are passed through as-is (e.g. "COM3" or "\\\\.\\COM10"
+	* on Windows, "/dev/ttyACM0" on Linux).
+	*
+	* One thread can read while another writes, but the port isn't
+	* safe to read from two threads at once.
+	*
+	***********************************************/
+	class SerialPort{
+	public:
+		SerialPort();
+		// closes the port if it's open
+		~SerialPort();
+
+		// opens _portName at _baudRate, closing the port first if it's already open
+		// returns true if the port was opened and configured
+		bool open(const std::string & _portName, unsigned long int _baudRate = 115200);
+		void close();
+		bool isOpen() const;
+
+		// copies up to _size bytes which have already arrived into _buffer; never blocks
+		// returns the number of bytes read (0 if nothing has arrived), or -1 if the port has failed
+		signed long int read(char * _buffer, unsigned long int _size);
+		// writes all _size bytes of _buffer, waiting on the device if it can't keep up
+		// returns false if they couldn't all be written
+		bool write(const char * _buffer, unsigned long int _size);
+		// returns the number of bytes waiting to be read, or -1 if the port has failed
+		signed long int available();
+		// waits up to _milliseconds for bytes to arrive
+		// returns true if there are bytes waiting to be read
+		bool waitForData(unsigned long int _milliseconds);
+		// discards everything in the input and output buffers
+		void purge();
+
+		// opens a pseudo-terminal pair, with this port as the terminal end and _device as the controlling end,
+		// so that bytes written to _device can be read from this port (and vice versa)
+		// used to stand in for real hardware when testing and benchmarking
+		// only available on POSIX systems; returns false elsewhere
+		bool openLoopback(SerialPort & _device);
+
+	private:
+#ifdef _WIN32
+		// HANDLE; stored as a void * so that windows.h isn't needed here
+		void * handle;
+#else
+		int fd;
+#endif
+
+		// not copyable
+		SerialPort(const SerialPort & _other);
+		SerialPort & operator=(const SerialPort & _other);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+namespace sweet{
+
+	class SerialPort;
+
+	/***********************************************
+	*
+	* Reads a SerialPort on a background thread into a ring buffer
+	*
+	* The main thread takes the bytes out with peek/consume, which
+	* hand out the ring's memory directly so that parsers don't need
+	* to copy it, or with read. The ring is single-producer,
+	* single-consumer and lock-free.
+	*
+	* If the ring fills up, the reader stops reading until there's
+	* room again, and the port's own buffer takes up the slack.
+	*
+	* The port must outlive the reader, and nothing else should read
+	* from the port while the reader is running.
+	*
+	***********************************************/
+	class SerialReader{
+	public:
+		// _capacity is rounded up to a power of two
+		explicit SerialReader(SerialPort & _port, unsigned long int _capacity = 65536);
+		// stops the reader
+		~SerialReader();
+
+		// starts the background thread (if it isn't already running)
+		void start();
+		// stops and joins the background thread; bytes already in the ring are kept
+		void stop();
+		bool isRunning() const;
+		// returns true if the reader stopped because the port failed (e.g. the device was unplugged)
+		bool hasFailed() const;
+
+		// returns the number of bytes in the ring
+		unsigned long int available() const;
+		// points _first and _second at the bytes in the ring, in order; _second is only used when the bytes wrap around the end of the ring
+		// the bytes stay valid until they're consumed
+		// returns the total number of bytes
+		unsigned long int peek(const char *& _first, unsigned long int & _firstSize, const char *& _second, unsigned long int & _secondSize) const;
+		// removes the first _count bytes from the ring
+		void consume(unsigned long int _count);
+		// copies up to _size bytes out of the ring into _buffer and removes them
+		// returns the number of bytes copied
+		unsigned long int read(char * _buffer, unsigned long int _size);
+
+		// total number of bytes read from the port
+		unsigned long long int getBytesRead() const;
+
+	private:
+		SerialPort & port;
+
+		std::vector<char> ring;
+		unsigned long int mask;
+		// head is only written by the consumer, tail by the reader thread
+		std::atomic<unsigned long int> head;
+		std::atomic<unsigned long int> tail;
+		std::atomic<unsigned long long int> bytesRead;
+
+		std::atomic<bool> running;
+		std::atomic<bool> failed;
+		std::thread thread;
+
+		// body of the background thread
+		void run();
+
+		// not copyable
+		SerialReader(const SerialReader & _other);
+		SerialReader & operator=(const SerialReader & _other);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Command.h"
+
+// stands in for an old command in a CommandProcessor's history once it has been serialized
+// executing or unexecuting rebuilds the original command from the delta, runs it, and deletes it again
+class SerializedCommand : public Command{
+public:
+	SerializedCommand(Deserializer _deserializer, const std::string & _delta);
+	~SerializedCommand();
+
+	bool execute();
+	bool unexecute();
+
+	unsigned long int getSize() override;
+
+private:
+	Deserializer deserializer;
+	std::string delta;
+
+	// rebuilds the command, runs it, and collects its console entries
+	bool run(bool _execute);
+};
\ No newline at end of file
@@ -10,7 +10,6 @@ class Texture;
 class TextureSampler;
 class SpriteSheetAnimation;
 class Rectangle;
-class SpriteMesh;
 class SpriteSheet;
 
 class Sprite : public MeshEntity{
@@ -18,17 +17,27 @@ public:
 	SpriteSheet * spriteSheet;
 	SpriteSheetAnimationInstance * currentAnimation;
 	bool playAnimation;
-
-	explicit Sprite(Shader * _shader = nullptr);
-	explicit Sprite(Texture * _texture, Shader * _shader = nullptr);
-	explicit Sprite(TextureSampler *_textureSampler, Shader * _shader = nullptr);
+	// if true, animation frames are drawn by passing the frame's index in the sheet's frame table to the shader
+	// instead of rewriting the UVs, so changing frames doesn't touch the vertices
+	// requires the sprite's shader to have a ShaderComponentSpriteSheet
+	// default: false (always true for sprites with a shared mesh)
+	bool sharedFrames;
+
+	// if _sharedMesh is true, the sprite draws MeshFactory's shared plane instead of its own SpriteMesh,
+	// and its textures, UVs, and size go in drawData and meshTransform instead of the vertices
+	// this requires the sprite's shader to have a ShaderComponentSpriteSheet for anything other than the default UVs
+	explicit Sprite(Shader * _shader = nullptr, bool _sharedMesh = false);
+	explicit Sprite(Texture * _texture, Shader * _shader = nullptr, bool _sharedMesh = false);
+	explicit Sprite(TextureSampler *_textureSampler, Shader * _shader = nullptr, bool _sharedMesh = false);
 	virtual ~Sprite();
 
+	// NOTE: the vertices of a shared mesh can't be changed
 	Vertex * getTopLeft();
 	Vertex * getTopRight();
 	Vertex * getBottomLeft();
 	Vertex * getBottomRight();
 
+	// if the mesh is shared, only the rect covering the bottom-left and top-right UVs is used
 	void setUvs(float _topLeftU, float _topLeftV, float _topRightU, float _topRightV, 
 	float _bottomLeftU, float _bottomLeftV, float _bottomRightU, float _bottomRightV);
 	void setUvs(sweet::Rectangle _rect);
@@ -39,4 +48,15 @@ public:
 	void setPrimaryTexture(TextureSampler * _textureSampler);
 
 	void setSpriteSheet(SpriteSheet * _spriteSheet, std::string _currentAnimation);
+
+private:
+	// whether the UVs are currently the plane's default (0-1) UVs
+	bool unitUvs;
+
+	// shows the current frame of the current animation, either by setting the frame on the mesh or by setting the UVs
+	void applyFrame();
+	// makes the sprite sheet's texture the only texture on the mesh (or in the draw data, if the mesh is shared)
+	void applySpriteSheetTexture();
+	// makes _texture the primary texture and sizes the sprite to fit _width and _height (relative to the texture's largest side)
+	void applyPrimaryTexture(Texture * _texture, float _width, float _height);
 };
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "MeshInterface.h"
+#include "DrawData.h"
+
+class SpriteSheet;
+
+// unit plane used by Sprite
+// when frame is set, it's drawn as the per-draw frame (see DrawData::frame) of any entity which doesn't set one of its own,
+// so every entity drawing the mesh shows that frame of spriteSheet's frame table without the vertices being touched or re-uploaded
+// requires the shader to have a ShaderComponentSpriteSheet
+class SpriteMesh : public QuadMesh{
+public:
+	// the sheet whose frame table is used when drawing
+	SpriteSheet * spriteSheet;
+	// index into spriteSheet's frame table; -1 means the UVs are used as-is
+	signed long int frame;
+
+	explicit SpriteMesh(bool _autorelease);
+
+	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOption) override;
+
+private:
+	// stands in for an entity's draw data when the mesh is rendered on its own
+	DrawData meshDrawData;
+};
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include <node/NodeLoadable.h>
+#include <glm/glm.hpp>
 
 class Texture;
 class SpriteSheetAnimationDefinition;
@@ -10,6 +12,12 @@ class SpriteSheet : public NodeLoadable{
 public:
 	std::map<std::string, SpriteSheetAnimationDefinition *> animations;
 	Texture * texture;
+	// the frames of every animation on the sheet, stored as (x, y, width, height), used by ShaderComponentSpriteSheet
+	// each animation's frames start at its firstFrame
+	// NOTE: frames pushed to an animation after it has been added aren't included
+	std::vector<glm::vec4> frameTable;
+	// unique id for the current contents of frameTable; changes whenever an animation is added
+	signed long int frameTableId;
 
 	explicit SpriteSheet(Texture * _texture);
 	~SpriteSheet();
@@ -13,6 +13,9 @@ class SpriteSheetAnimationDefinition : public Node{
 public:
 	std::vector<sweet::Rectangle> frames;
 	float secondsPerFrame;
+	// index of this animation's first frame in its sprite sheet's frame table
+	// set by SpriteSheet::addAnimation
+	unsigned long int firstFrame;
 
 	explicit SpriteSheetAnimationDefinition(float _secondsPerFrame);
 	~SpriteSheetAnimationDefinition();
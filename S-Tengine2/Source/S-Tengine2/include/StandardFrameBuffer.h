@@ -15,6 +15,11 @@ public:
 	explicit StandardFrameBuffer(bool _autoRelase);
 	virtual ~StandardFrameBuffer();
 
+	/**
+	* @returns The channels a StandardFrameBuffer is made of (e.g. for requesting a matching target from the RenderTargetPool)
+	*/
+	static std::vector<FrameBufferChannel> getChannels();
+
 	/**
 	* @returns The openGL texture ID of the texture channel
 	*/
@@ -155,7 +155,7 @@ namespace sweet{
 	void windowFocusCallback(GLFWwindow * _window, int _focused);
 	void error_callback(int _error, const char * _description);
 
-	// if in debug mode and node counting is turned on, prints every currently existing node in the format: TYPE ADDRESS NAME
+	// if node counting is turned on, prints every currently existing node in the format: TYPE ADDRESS NAME, followed by the counts for each type (see NodeCensus)
 	void printNodes();
 
 	/**
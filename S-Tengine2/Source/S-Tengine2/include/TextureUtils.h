@@ -12,6 +12,24 @@ public:
 	// if _includeNormals is false, returned vertices are in pairs forming edges; i.e. {edge1.v1, edge1.v2, edge2.v1, edge2.v2, etc.}
 	// if _includeNormals is true, returned vertices are in triplets forming edges and the edge normal; i.e. {edge1.v1, edge1.v2, edge1.n, edge2.v1, edge2.v2, edge2.n, etc.}
 	static std::vector<glm::vec2> getMarchingSquaresContour(Texture * _tex, unsigned long int _threshold = 128, bool _smooth = false, bool _includeNormals = false);
+
+	// returns the contours in the image as closed polylines, in the same space as getMarchingSquaresContour
+	// the image is marched in bands of rows spread across the job system, and the resulting edges are then stitched together
+	// pixels outside of the image count as being below _threshold, so every contour is closed
+	// outlines wind counter-clockwise (positive area) and holes wind clockwise (negative area)
+	// if _tolerance is greater than zero, the contours are simplified using simplifyContour
+	static std::vector<std::vector<glm::vec2>> getContours(Texture * _tex, unsigned long int _threshold = 128, bool _smooth = false, float _tolerance = 0, unsigned long int _channel = 0);
+
+	// returns a simplified version of the closed polyline _contour (Douglas-Peucker)
+	// none of the removed points are further than _tolerance from the result
+	static std::vector<glm::vec2> simplifyContour(const std::vector<glm::vec2> & _contour, float _tolerance);
+
+	// splits the simple polygon _polygon (counter-clockwise, no holes) into convex polygons with at most _maxVertices each
+	// triangulates by ear clipping, then merges neighbouring pieces while they stay convex (Hertel-Mehlhorn)
+	static std::vector<std::vector<glm::vec2>> getConvexDecomposition(const std::vector<glm::vec2> & _polygon, unsigned long int _maxVertices = 8);
+
+	// returns the area of _polygon; positive if it winds counter-clockwise, negative if it winds clockwise
+	static float getSignedArea(const std::vector<glm::vec2> & _polygon);
 	
 	// returns an ordered sequence of vertices describing the contour in the image
 	// follows Theo Pavlidis' Algorithm
@@ -34,28 +34,45 @@ private:
 	glm::vec3 scaleVector;
 	/** Orientation */
 	glm::quat orientation;
-	
+
+	// the flags are kept together after the matrices and bounds so that they don't each get padded out
+	glm::mat4 tMatrix;
+	glm::mat4 sMatrix;
+	glm::mat4 oMatrix;
+	glm::mat4 osMatrix;
+	glm::mat4 mMatrix;
+	// returns orientationMatrix * scaleMatrix
+	const glm::mat4 & getOrientationScaleMatrix();
+
+	// bounds of the children, in this transform's space
+	glm::vec3 localBoundingBoxMin, localBoundingBoxMax;
+	// bounds of the children after applying the model matrix (i.e. in the parent's space)
+	glm::vec3 boundingBoxMin, boundingBoxMax;
+	glm::vec3 worldBoundingBoxMin, worldBoundingBoxMax;
+
 	// whether the translation matrix is dirty
 	bool tDirty;
-	glm::mat4 tMatrix;
 	// whether the scale matrix is dirty
 	bool sDirty;
-	glm::mat4 sMatrix;
 	// whether the orientation matrix is dirty
 	bool oDirty;
-	glm::mat4 oMatrix;
 	// whether the orientation matrix or the scale matrix is dirty
 	bool osDirty;
-	glm::mat4 osMatrix;
-	// returns orientationMatrix * scaleMatrix
-	const glm::mat4 & getOrientationScaleMatrix();
 	// whether the model matrix (translation, scale, or orientation) is dirty
 	bool mDirty;
-	glm::mat4 mMatrix;
 
 	// used to optimize out some matrix multiplication if possible
 	// set to true on creation and reset; set to false on any modification
 	bool isIdentity;
+
+	// whether the cached bounds (local and model-space) are out-of-date
+	bool boundingBoxDirty;
+	// whether every renderable child had known bounds the last time they were calculated
+	bool boundingBoxKnown;
+	// whether the cached world-space bounds are out-of-date
+	bool worldBoundingBoxDirty;
+	// recalculates the local and model-space bounds if they are dirty
+	void cleanBoundingBox();
 	
 	// whether the transform indicator/shader have been initialized
 	static bool staticInit;
@@ -70,6 +87,8 @@ private:
 public:
 	// whether to draw the transform indicator on render
 	static bool drawTransforms;
+	// whether children with bounds outside of the view frustum are skipped on render
+	static bool frustumCulling;
 
 	static MeshInterface * transformIndicator;
 	static ComponentShaderBase * transformShader;
@@ -82,6 +101,19 @@ public:
 	glm::mat4 getCumulativeModelMatrix();
 
 	void addParent(Transform * const _parent) override;
+
+	// flags the cached bounds of this transform and its ancestors as out-of-date
+	void makeBoundingBoxDirty() override;
+
+	// bounds of the children after applying this transform's model matrix
+	// returns false if any renderable child has unknown bounds
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
+	// bounds of the children in this transform's space (i.e. without the model matrix applied)
+	// returns false if any renderable child has unknown bounds
+	bool getLocalBoundingBox(glm::vec3 & _min, glm::vec3 & _max);
+	// bounds of the children in world space (i.e. with the cumulative model matrix applied)
+	// returns false if any renderable child has unknown bounds
+	bool getWorldBoundingBox(glm::vec3 & _min, glm::vec3 & _max);
 	
 	Transform();
 	virtual ~Transform();
@@ -173,13 +205,20 @@ public:
 	/**
 	* Pushes model matrix stack,
 	* Applies the model matrix of transform,
-	* Renders children,
+	* Renders children (skipping any whose bounds are outside of the view frustum),
 	* Pops model matrix stack
 	*/
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) override;
 	
-	/** Calls update on all children */
+	/**
+	* Calls update on all children
+	* Consecutive parallel-safe children are updated together on the job system,
+	* and are always finished before the next child which isn't parallel-safe (and before this returns)
+	* Bounds changes made by the parallel children are held back and applied to this transform after each join
+	*/
 	virtual void update(Step * _step) override;
+	// returns true if this transform only wraps parallel-safe entities (i.e. the transform made by addChild(_child, true))
+	virtual bool isParallelUpdateSafe() override;
 
 	/** Calls unload on all children */
 	virtual void unload() override;
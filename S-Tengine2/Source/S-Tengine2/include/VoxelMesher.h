@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Vertex.h>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace sweet{
+
+	/***********************************************
+	*
+	* Dense cube of voxels
+	*
+	* Each voxel is a palette index; 0 is empty.
+	*
+	***********************************************/
+	class VoxelChunk{
+	public:
+		// number of voxels along each side
+		static const unsigned long int SIZE = 16;
+
+		VoxelChunk();
+
+		// _x, _y, and _z must be in [0, SIZE)
+		unsigned char get(unsigned long int _x, unsigned long int _y, unsigned long int _z) const;
+		// returns true if the voxel changed
+		bool set(unsigned long int _x, unsigned long int _y, unsigned long int _z, unsigned char _value);
+		// returns the number of voxels which aren't empty
+		unsigned long int getSolidCount() const;
+		// fills every voxel with _value
+		void fill(unsigned char _value);
+
+	private:
+		// x-major, then y, then z
+		std::vector<unsigned char> voxels;
+		unsigned long int solidCount;
+	};
+
+	/***********************************************
+	*
+	* Builds triangle meshes for VoxelChunks
+	*
+	* gather copies a chunk and a one voxel border from its
+	* neighbours, so that faces against neighbouring chunks can be
+	* culled and shaded; the meshing functions only read that copy,
+	* so they can run on a worker thread while the chunks are edited.
+	*
+	* mesh emits only the faces between solid and empty voxels, and
+	* (if _merge is set) merges neighbouring faces with the same
+	* palette entry and lighting into larger quads. Per-vertex ambient
+	* occlusion darkens corners based on the three voxels around them
+	* on the open side of the face; only faces whose corners are all
+	* equally lit are merged, so that the shading isn't stretched.
+	*
+	* meshNaive emits a whole cube for every solid voxel, which is what
+	* the ShaderComponentVoxel geometry shader draws; it's only there
+	* for comparison.
+	*
+	* Vertices are in voxel units times _resolution, offset by _origin
+	* (in voxels). UVs go from 0 to 1 across each voxel face, so a
+	* texture repeats once per voxel.
+	*
+	***********************************************/
+	class VoxelMesher{
+	public:
+		// number of voxels along each side of the copy, including the border
+		static const unsigned long int PADDED_SIZE = VoxelChunk::SIZE + 2;
+
+		// how much each level of occlusion (0 to 3 neighbours) darkens a corner
+		// default: 0.2
+		float ambientOcclusionStrength;
+
+		VoxelMesher();
+
+		// copies _chunks[13] (the centre of a 3x3x3 block of chunks, indexed [x + y * 3 + z * 9]) and the border around it
+		// neighbours which are nullptr are treated as empty
+		void gather(const VoxelChunk * const _chunks[27]);
+		// returns the gathered voxel at _x, _y, _z, which can be one outside of the chunk on any side
+		unsigned char get(signed long int _x, signed long int _y, signed long int _z) const;
+
+		// appends the culled (and merged, if _merge is set) faces of the gathered chunk to _vertices and _indices as triangles
+		// voxel colours come from _palette (white if the entry is missing)
+		void mesh(const glm::vec3 & _origin, float _resolution, const std::vector<glm::vec4> & _palette, bool _merge, bool _ambientOcclusion, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const;
+		// appends a full cube for every solid voxel in the gathered chunk
+		void meshNaive(const glm::vec3 & _origin, float _resolution, const std::vector<glm::vec4> & _palette, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const;
+
+	private:
+		std::vector<unsigned char> padded;
+
+		// returns the ambient occlusion level (0 is fully occluded, 3 is open) of the corner of the face of voxel _p facing _normal,
+		// in the directions _u and _v along the face
+		unsigned long int getOcclusion(const glm::ivec3 & _p, const glm::ivec3 & _normal, const glm::ivec3 & _u, const glm::ivec3 & _v) const;
+		// appends a _width by _height quad on the face of voxel _p which faces _side (-1 or 1) along axis _axis,
+		// starting at _p and extending along the two other axes in order
+		// _occlusion is the ambient occlusion level of each corner, counter-clockwise from _p in the same axes
+		void pushQuad(const glm::ivec3 & _p, unsigned long int _axis, signed long int _side, unsigned long int _width, unsigned long int _height, const unsigned long int _occlusion[4], const glm::vec4 & _colour, const glm::vec3 & _origin, float _resolution, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const;
+	};
+}
\ No newline at end of file
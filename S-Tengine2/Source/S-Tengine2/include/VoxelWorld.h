@@ -0,0 +1,137 @@
+#pragma once
+
+#include <MeshEntity.h>
+#include <VoxelMesher.h>
+#include <JobSystem.h>
+
+#include <map>
+#include <atomic>
+
+class TriMesh;
+class VoxelWorld;
+
+// a chunk of a VoxelWorld and the mesh of its visible faces
+// the mesh is rebuilt on the job system when the chunk (or the border of a neighbouring chunk) changes,
+// and the previous mesh is rendered until the new one is ready
+class VoxelWorldChunk : public virtual NodeRenderable, public virtual NodeLoadable, public virtual NodeChild{
+public:
+	// position of the chunk, in chunks
+	const glm::ivec3 position;
+	sweet::VoxelChunk voxels;
+
+	VoxelWorldChunk(VoxelWorld * _world, const glm::ivec3 & _position);
+	~VoxelWorldChunk();
+
+	// moves a newly built mesh in (if there is one) and renders the current mesh
+	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) override;
+	virtual void load() override;
+	virtual void unload() override;
+	// returns the bounds of the whole chunk
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max) override;
+
+	// whether the mesh needs to be rebuilt
+	bool isDirty() const;
+	// flags the mesh to be rebuilt on the next remesh
+	void makeDirty();
+	// copies the chunk and its border, and builds the mesh from the copy on the job system (or right away if _jobs is nullptr)
+	// if a build is already running, does nothing and stays dirty so that it can be tried again later
+	// returns true if a build was started
+	bool remesh(sweet::JobCounter * _jobs);
+
+	// returns the number of triangles in the mesh which is being rendered
+	unsigned long int getTriangleCount() const;
+
+private:
+	typedef enum{
+		kIDLE,
+		kPENDING,
+		kGENERATED
+	} MeshState;
+
+	VoxelWorld * world;
+	bool dirty;
+	std::atomic<int> state;
+
+	// only used by the build job while a build is pending
+	sweet::VoxelMesher mesher;
+	std::vector<glm::vec4> palette;
+	// filled in by the build job, then swapped into the mesh on the main thread
+	std::vector<Vertex> vertices;
+	std::vector<GLuint> indices;
+
+	TriMesh * mesh;
+	// shader which the mesh's vertex attributes were last configured for
+	Shader * configuredShader;
+
+	// copies the textures, materials, and texture settings from the world's mesh to the chunk's
+	void syncMaterials();
+};
+
+/***********************************************
+*
+* Voxels stored in dense chunks and drawn as ordinary triangle meshes
+*
+* Only the faces between solid and empty voxels are meshed, and
+* neighbouring faces are merged into larger quads (see
+* sweet::VoxelMesher). Chunks are only remeshed when they're
+* edited, so static voxels cost nothing but the draw call.
+*
+* Compared to ShaderComponentVoxel, which expands every voxel into
+* a whole cube in a geometry shader every frame, this needs no
+* special shader: any shader with the usual vertex attributes works.
+*
+* Chunks are created the first time a voxel is set in them, and
+* are children of the meshTransform. The mesh is left empty and
+* only holds the textures and materials for the chunks.
+*
+***********************************************/
+class VoxelWorld : public MeshEntity{
+public:
+	// size of a voxel in world units
+	const float resolution;
+	// colours of the palette entries; entry 0 is empty and never drawn, and entries which are missing are white
+	std::vector<glm::vec4> palette;
+	// whether neighbouring faces are merged (default: true)
+	bool merge;
+	// whether the corners of faces are darkened by the voxels around them (default: true)
+	bool ambientOcclusion;
+	// whether meshes are built on the job system (default: true); if false, they're built during update
+	bool useJobs;
+
+	explicit VoxelWorld(Shader * _shader, float _resolution = 1.f);
+	// waits for the meshes being built to finish; the chunks are deleted along with the meshTransform
+	~VoxelWorld();
+
+	// starts rebuilding the chunks which have changed
+	virtual void update(Step * _step) override;
+
+	// returns the voxel at _x, _y, _z (in voxels), or 0 if its chunk doesn't exist
+	unsigned char getVoxel(signed long int _x, signed long int _y, signed long int _z) const;
+	// sets the voxel at _x, _y, _z (in voxels), creating its chunk if needed, and flags the chunks whose meshes it touches as dirty
+	void setVoxel(signed long int _x, signed long int _y, signed long int _z, unsigned char _value);
+	// returns the chunk at _position (in chunks), or nullptr if it doesn't exist
+	VoxelWorldChunk * getChunk(const glm::ivec3 & _position) const;
+
+	// starts rebuilding the chunks which are dirty
+	void remesh();
+	// flags every chunk as dirty (e.g. after changing the palette, merge, or ambientOcclusion) and starts rebuilding them
+	void remeshAll();
+	// waits for the meshes which are being built
+	void finishMeshing();
+
+	unsigned long int getChunkCount() const;
+	// returns the number of triangles in the meshes which are being rendered
+	unsigned long int getTriangleCount() const;
+	// returns the number of times a chunk has been remeshed
+	unsigned long int getRemeshCount() const;
+
+private:
+	std::map<signed long long int, VoxelWorldChunk *> chunks;
+	// tracks the build jobs so that they can be finished before the chunks are deleted
+	sweet::JobCounter meshJobs;
+	unsigned long int remeshCount;
+
+	static signed long long int getKey(const glm::ivec3 & _position);
+	// returns _x divided by the chunk size, rounded down
+	static signed long int getChunkCoordinate(signed long int _x);
+};
\ No newline at end of file
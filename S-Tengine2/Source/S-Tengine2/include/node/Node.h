@@ -13,6 +13,10 @@ class NodeUpdatable;
 class NodeRenderable;
 class Transform;
 
+namespace sweet{
+	class NodeCensus;
+}
+
 typedef enum {
 	kNODE				= (1 << 0),
 	kNODE_RENDERABLE	= (1 << 1),
@@ -26,21 +30,24 @@ typedef enum {
 
 /** Abstract node */
 class Node abstract{
+	friend class sweet::NodeCensus;
 public:
-#ifdef _DEBUG
-	static bool nodeCounting;
-	static std::vector<Node *> nodes;
-#endif
-
 	unsigned int nodeType;
 
 	// an identification string used for debugging purposes
-	// when sweet::printNodes is called, the nodeNames are used in the result
+	// when sweet::printNodes is called, or a node shows up in a sweet::NodeCensus leak report, the nodeNames are used in the result
 	std::string nodeName;
 
 	Node();
 	virtual ~Node();
 
+	// nodes are allocated from size-classed slabs instead of the global heap (see sweet::NodeAllocator)
+	// only the node itself is; the containers it owns (e.g. nodeName) still allocate from the global heap
+	// the size passed to delete is the size of the most-derived class, since the destructor is virtual
+	// the size and the caller are also passed on to the node's entry in the sweet::NodeCensus
+	static void * operator new(size_t _size);
+	static void operator delete(void * _ptr, size_t _size);
+
 	bool isNodeType(NodeType _type) const;
 
 	friend std::ostream& operator<<(std::ostream& os, const Node& obj){
@@ -65,4 +72,14 @@ protected:
 	NodeUI			* ptrNodeUI;
 	NodeShadable    * ptrNodeShadable;
 	Transform		* ptrTransform;
+
+private:
+	// the node's entry in the sweet::NodeCensus
+	Node * censusPrev;
+	Node * censusNext;
+	// index of the node's type in the census, or -1 if it hasn't been sorted yet
+	signed long int censusType;
+	unsigned long int censusBytes;
+	unsigned long long int censusSerial;
+	void * censusSite;
 };
\ No newline at end of file
@@ -27,6 +27,9 @@ public:
 	virtual Transform * firstParent();
 	
 	virtual void makeCumulativeModelMatrixDirty();
+	// flags the cached bounds of this node's ancestors as out-of-date
+	// should be called whenever something changes the area covered by this node
+	virtual void makeBoundingBoxDirty();
 	bool cumulativeModelMatrixDirty;
 	glm::vec3 worldPos;
 	// finds the first non-zero ancestor translation vector in the _parent hierarchy and applies all of the matrices of its ancestors to produce world position
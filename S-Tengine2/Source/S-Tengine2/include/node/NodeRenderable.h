@@ -1,6 +1,7 @@
 # pragma once
 
 #include "node/Node.h"
+#include <glm/glm.hpp>
 
 namespace sweet{
 	class MatrixStack;
@@ -16,4 +17,9 @@ public:
 	virtual void setVisible(bool _visible);
 	bool isVisible();
 	virtual void render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions) = 0;
+
+	// sets _min and _max to the corners of a box which covers everything this node renders,
+	// in the space of the model matrix that is current when render is called
+	// returns false if the bounds aren't known, in which case the node is never frustum culled (default)
+	virtual bool getBoundingBox(glm::vec3 & _min, glm::vec3 & _max);
 };
\ No newline at end of file
@@ -25,6 +25,8 @@ public:
 
 	// increments the reference count and returns the current total
 	unsigned long int incrementReferenceCount();
+	// returns the current number of references
+	unsigned long int getReferenceCount() const;
 
 	bool isAutoReleasing();
 
@@ -8,4 +8,8 @@ class NodeUpdatable abstract : public virtual Node{
 public:
 	NodeUpdatable();
 	virtual void update(Step * _step) = 0;
+
+	// returns whether update can be called on a worker thread at the same time as the updates of its parallel-safe siblings
+	// false by default
+	virtual bool isParallelUpdateSafe();
 };
\ No newline at end of file
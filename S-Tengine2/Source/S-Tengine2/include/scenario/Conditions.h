@@ -16,11 +16,17 @@ public:
 	sweet::Event * event; 
 
 	explicit Condition(Json::Value _json, Scenario * _scenario);
+	// takes ownership of _event
+	explicit Condition(sweet::Event * _event, Scenario * _scenario);
 	~Condition();
 
 	// returns true if the condition's criteria are met
+	// the implementation is found by index in the scenario's condition table (see Scenario::registerCondition),
+	// falling back to a lookup by tag in the scenario's conditionImplementations
 	virtual bool evaluate();
 protected:
 	// the scenario this content belongs to
 	Scenario * scenario;
+	// index of the event's tag in the scenario's condition table
+	unsigned long int conditionId;
 };
@@ -3,12 +3,18 @@
 #include <node/NodeContent.h>
 #include <scenario/Dialogue.h>
 
+class Conversation;
+
 class Option : public NodeContent{
 public:
 	std::string text;
 	std::string link;
+	// the conversation that link refers to, resolved when the scenario is loaded
+	// nullptr if the link couldn't be resolved (e.g. "END"), in which case the conversation is looked up by link instead
+	Conversation * linkedConversation;
 
 	Option(Json::Value _json, Scenario * const _scenario);
+	Option(std::string _text, std::string _link);
 	~Option();
 };
 
@@ -33,6 +39,9 @@ public:
 	Conversation(Json::Value _json, Scenario * const _scenario);
 	~Conversation();
 
+	// returns the conversation that _option leads to
+	Conversation * getLinkedConversation(Option * _option);
+
 	// returns dialogueObjects.at(currentDialogue) or nullptr if currentDialogue >= dialogueObjects.size()
 	Dialogue * getCurrentDialogue();
 	// increments currentDialogue
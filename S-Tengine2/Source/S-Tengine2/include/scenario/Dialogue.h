@@ -40,6 +40,8 @@ public:
 	void reset();
 
 	Dialogue(Json::Value _json, Scenario * const _scenario);
+	// empty dialogue; text, triggers, and conditions are expected to be added afterwards
+	Dialogue(std::string _speaker, Scenario * const _scenario);
 protected:
 	// the scenario this content belongs to
 	Scenario * const scenario;
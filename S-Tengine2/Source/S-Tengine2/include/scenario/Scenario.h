@@ -23,13 +23,27 @@ public:
 };
 
 class Texture_NineSliced;
+namespace sweet{
+	class AssetArchive;
+}
 
 typedef std::map<std::string, std::function<bool(sweet::Event *)>> ConditionImplementations;
 
 class Scenario : public virtual NodeContent, public virtual NodeResource{
 private:
+	// condition tags are interned into indices so that conditions can find their implementation without any string lookups
+	std::map<std::string, unsigned long int> conditionIds;
+	std::vector<std::function<bool(sweet::Event *)>> conditionTable;
+
+	// points each conversation option at the conversation it links to
+	void resolveLinks();
+
+	// the scenario's packed assets, if it has any (mounted for as long as the scenario exists)
+	sweet::AssetArchive * archive;
 public:
 
+	// NOTE: conditions registered with registerCondition are checked first and don't require any string lookups;
+	// this map is only searched for conditions which haven't been registered
 	ConditionImplementations * conditionImplementations;
 
 	sweet::Event * variables; 
@@ -56,8 +70,19 @@ public:
 
 	Conversation * currentConversation;
 	
+	// _jsonSrc can be either a scenario json file or a scenario compiled with ScenarioBinary
+	// if there is an archive at _jsonSrc + ".pack" (see sweet::AssetArchive::packScenario), assets are loaded from it instead of loose files
 	Scenario(std::string _jsonSrc);
 	~Scenario();
+
+	// returns the index of _tag in the condition table, adding it if it isn't there already
+	unsigned long int getConditionId(const std::string & _tag);
+	// returns the implementation registered for the condition at _id (which will be empty if there isn't one)
+	const std::function<bool(sweet::Event *)> & getConditionImplementation(unsigned long int _id) const;
+	// sets the implementation for conditions with the given _tag
+	void registerCondition(const std::string & _tag, std::function<bool(sweet::Event *)> _implementation);
+	// calls registerCondition for every entry in _implementations
+	void registerConditions(const ConditionImplementations & _implementations);
 	
 	// returns the asset of the specified type with the specified id
 	// returns nullptr if not found (note that no default substitution is used when calling this function directly)
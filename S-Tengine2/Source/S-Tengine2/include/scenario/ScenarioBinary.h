@@ -0,0 +1,47 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <string>
+
+class Scenario;
+
+/***********************************************
+*
+* Compiled scenario format
+*
+* compile turns a scenario json file into a compact binary form which
+* can be passed to the Scenario constructor in place of the json.
+* Loading it doesn't involve any text parsing:
+*
+* - every string is stored once in a string table and referred to by index
+* - conversations are stored as flat records, and option links are stored
+*   as the index of the conversation they point to
+* - event and condition arguments are stored already typed (i.e. the type
+*   conversion done by sweet::Event's json constructor happens when compiling)
+* - other assets are stored as a binary encoding of their json, which is
+*   rebuilt directly and passed to Asset::getAsset
+*
+* The scenario's root is restored as well (including its "assets" member),
+* so that Scenario::root is the same whichever form was loaded
+*
+* NOTE: any argument types registered with sweet::Event::registerArgumentType
+* need to be registered before compiling, since the conversion is baked in
+*
+***********************************************/
+class ScenarioBinary{
+public:
+	// compiles the scenario json in _root into _output
+	static void compile(const Json::Value & _root, std::string & _output);
+	// reads the scenario json at _jsonSrc and writes the compiled version to _outputSrc
+	// returns false if the json couldn't be parsed or the output couldn't be written
+	static bool compileFile(std::string _jsonSrc, std::string _outputSrc);
+
+	// returns true if _data starts with the compiled scenario header
+	static bool isCompiled(const std::string & _data);
+
+	// fills _scenario with the contents of the compiled scenario in _data
+	// returns false if the data is malformed or from a different version
+	// (anything read before the problem was found is kept)
+	static bool load(const std::string & _data, Scenario * _scenario);
+};
\ No newline at end of file
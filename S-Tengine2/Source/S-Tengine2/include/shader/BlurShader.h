@@ -2,11 +2,40 @@
 
 #include "Shader.h"
 
+namespace sweet{
+	class BlurKernel;
+}
+
+/******************************************************
+*
+* One pass of a separable blur, drawn with a RenderSurface
+*
+* The texture is sampled at the kernel's bilinear taps along
+* the step given to setPass, so the same shader does the
+* horizontal and vertical passes. With a single tap of weight
+* 1 it's a plain bilinear copy, which is what the downsample
+* and upsample passes of a BlurPipeline use.
+*
+******************************************************/
 class BlurShader : public Shader{
 public:
 	explicit BlurShader(bool _autoRelease);
+
+	void load() override;
+	void unload() override;
+
+	// uploads _kernel's taps and the distance between them in UV space (e.g. 1 / width, 0 for a horizontal pass)
+	// the shader has to be in use
+	void setPass(const sweet::BlurKernel & _kernel, float _stepU, float _stepV);
+	// sets up a plain bilinear copy
+	// the shader has to be in use
+	void setCopy();
 private:
+	GLint texelStepLocation;
+	GLint numTapsLocation;
+	GLint tapOffsetsLocation;
+	GLint tapWeightsLocation;
+
 	std::string getVertString();
 	std::string getFragString();
 };
-
@@ -0,0 +1,28 @@
+#pragma once 
+
+#include "ShaderComponent.h"
+
+/******************************************************************************
+*
+* Multiplies the output colour by the colour in the draw data of the entity
+* being drawn (see DrawData::colour)
+*
+* This lets entities which share a mesh be tinted individually without
+* changing the mesh's vertex colours
+*
+******************************************************************************/
+class ShaderComponentDrawColour : public ShaderComponent{
+private:
+	GLint colourLoc;
+public:
+	ShaderComponentDrawColour(ComponentShaderBase * _shader);
+	~ShaderComponentDrawColour() override;
+	std::string getVertexVariablesString() override;
+	std::string getFragmentVariablesString() override;
+	std::string getVertexBodyString() override;
+	std::string getFragmentBodyString() override;
+	std::string getOutColorMod() override;
+	void load() override;
+	void configureUniforms(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable) override;
+	virtual void clean(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable) override;
+};
\ No newline at end of file
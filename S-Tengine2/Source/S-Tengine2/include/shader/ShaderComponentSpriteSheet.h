@@ -0,0 +1,36 @@
+#pragma once 
+
+#include "ShaderComponent.h"
+
+/******************************************************************************
+*
+* Maps the UVs of a mesh onto a frame of a sprite sheet, or onto a rect,
+* using the draw data of the entity being drawn (see DrawData)
+*
+* The sheet's frame table is stored in a uniform array which is only
+* sent when a different sheet is drawn; each draw only sends its frame index.
+* Without a frame, the UVs are mapped onto the draw data's uvRect instead
+* (which leaves them unchanged by default), so entities sharing a mesh can
+* show different parts of a texture
+*
+* The frame table holds at most MAX_SPRITE_FRAMES frames
+*
+******************************************************************************/
+class ShaderComponentSpriteSheet : public ShaderComponent{
+private:
+	GLint framesLoc, frameLoc, rectLoc;
+	// id of the frame table currently in the uniform array (see SpriteSheet::frameTableId)
+	signed long int currentFrameTable;
+public:
+	ShaderComponentSpriteSheet(ComponentShaderBase * _shader);
+	~ShaderComponentSpriteSheet() override;
+	std::string getVertexVariablesString() override;
+	std::string getFragmentVariablesString() override;
+	std::string getVertexBodyString() override;
+	std::string getFragmentBodyString() override;
+	std::string getOutColorMod() override;
+	void load() override;
+	void unload() override;
+	void configureUniforms(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable) override;
+	virtual void clean(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable) override;
+};
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "GeometryComponent.h"
 
+// expands every point into a whole cube in a geometry shader, every frame, hidden faces included
+// for static or rarely edited voxels, a VoxelWorld (which meshes only the visible faces on the CPU) is much cheaper
 class ShaderComponentVoxel : public GeometryComponent{
 public:
 	ShaderComponentVoxel(Shader * _shader);
@@ -14,6 +14,14 @@
 #define MAX_LIGHTS    32
 #define MAX_TEXTURES  5
 #define MAX_MATERIALS 5
+#define MAX_SPRITE_FRAMES 128
+
+// every shader binds the vertex attributes to these locations,
+// so a mesh's vao is configured the same way no matter which shader draws it
+#define GL_ATTRIBUTE_LOCATION_VERTEX_POSITION 0
+#define GL_ATTRIBUTE_LOCATION_VERTEX_COLOR    1
+#define GL_ATTRIBUTE_LOCATION_VERTEX_NORMALS  2
+#define GL_ATTRIBUTE_LOCATION_VERTEX_UVS      3
 
 const glm::mat4 BIAS_MATRIX(
 			0.5, 0.0, 0.0, 0.0,
@@ -86,6 +94,12 @@ const std::string GL_UNIFORM_ID_TEXT_COLOR			  = "textColor";
 const std::string GL_UNIFORM_ID_TOON_LEVELS			  = "toonLevels";
 const std::string GL_UNIFORM_ID_TOON_TEXTURE		  = "toonTexture";
 
+const std::string GL_UNIFORM_ID_SPRITE_FRAMES		  = "spriteFrames";
+const std::string GL_UNIFORM_ID_SPRITE_FRAME		  = "spriteFrame";
+const std::string GL_UNIFORM_ID_SPRITE_RECT			  = "spriteRect";
+
+const std::string GL_UNIFORM_ID_DRAW_COLOUR			  = "drawColour";
+
 
 //Attribute variable names
 const std::string GL_ATTRIBUTE_ID_VERTEX_POSITION	  = "aVertexPosition";
@@ -103,6 +117,7 @@ const std::string GL_IN_OUT_SHADOW_COORD			  =	"shadowCoord";
 const std::string SHADER_COMPONENT_TEXTURE	          =	"SHADER_COMPONENT_TEXTURE";
 const std::string SHADER_COMPONENT_WORLDSPACEUVS	  =	"SHADER_COMPONENT_WORLDSPACEUVS";
 const std::string SHADER_COMPONENT_UV_OFFSET	  =	"SHADER_COMPONENT_UV_OFFSET";
+const std::string SHADER_COMPONENT_SPRITE_SHEET	  =	"SHADER_COMPONENT_SPRITE_SHEET";
 const std::string SHADER_COMPONENT_MASK_RENDER	      =	"SHADER_COMPONENT_MASK_RENDER";
 const std::string SHADER_COMPONENT_SHADOW	          =	"SHADER_COMPONENT_SHADOW";
 const std::string SHADER_COMPONENT_LIGHT	          =	"SHADER_COMPONENT_LIGHT";
@@ -113,6 +128,7 @@ const std::string SHADER_COMPONENT_DIFFUSE			  = "SHADER_COMPONENT_DIFFUSE";
 const std::string SHADER_COMPONENT_BLINN			  = "SHADER_COMPONENT_BLINN";
 const std::string SHADER_COMPONENT_VOXEL			  = "SHADER_COMPONENT_VOXEL";
 const std::string SHADER_COMPONENT_TINT				  = "SHADER_COMPONENT_TINT";
+const std::string SHADER_COMPONENT_DRAW_COLOUR		  = "SHADER_COMPONENT_DRAW_COLOUR";
 const std::string SHADER_COMPONENT_HSV				  = "SHADER_COMPONENT_HSV";
 const std::string SHADER_COMPONENT_ALPHA			  = "SHADER_COMPONENT_ALPHA";
 const std::string SHADER_COMPONENT_TEXT				  = "SHADER_COMPONENT_TEXT";
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <AccelerometerFrameParser.h>
+#include <Log.h>
+
+#include <cstring>
+
+sweet::AccelerometerFrameParser::AccelerometerFrameParser(unsigned long int _sensors) :
+	sensors(_sensors),
+	inFrame(false),
+	field(0),
+	fieldChars(0),
+	value(0),
+	negative(false),
+	started(false),
+	stopped(false),
+	frameCount(0),
+	droppedCount(0)
+{
+	if(sensors > MAX_SENSORS){
+		Log::warn("Too many accelerometers in a frame; only the first few will be parsed");
+		sensors = MAX_SENSORS;
+	}
+	memset(latest, 0, sizeof(latest));
+	memset(current, 0, sizeof(current));
+}
+
+void sweet::AccelerometerFrameParser::startField(){
+	fieldChars = 0;
+	value = 0;
+	negative = false;
+	started = false;
+	stopped = false;
+}
+
+unsigned long int sweet::AccelerometerFrameParser::parse(const char * _data, unsigned long int _size){
+	const unsigned long int numFields = sensors * AXES;
+	unsigned long int res = 0;
+
+	for(unsigned long int i = 0; i < _size; ++i){
+		const char c = _data[i];
+		if(c == ':'){
+			if(inFrame){
+				++droppedCount;
+			}
+			inFrame = true;
+			field = 0;
+			startField();
+			continue;
+		}
+		if(!inFrame){
+			continue;
+		}
+
+		// same rules as atoi
+		if(!stopped){
+			if(c >= '0' && c <= '9'){
+				value = value * 10 + (c - '0');
+				started = true;
+			}else if(!started && c == ' '){
+				// leading spaces are skipped
+			}else if(!started && (c == '-' || c == '+')){
+				negative = c == '-';
+				started = true;
+			}else{
+				stopped = true;
+			}
+		}
+
+		if(++fieldChars == FIELD_WIDTH){
+			current[field] = negative ? -value : value;
+			startField();
+			if(++field == numFields){
+				memcpy(latest, current, numFields * sizeof(int));
+				inFrame = false;
+				++frameCount;
+				++res;
+			}
+		}
+	}
+	return res;
+}
+
+int sweet::AccelerometerFrameParser::getValue(unsigned long int _sensor, unsigned long int _axis) const{
+	return latest[_sensor * AXES + _axis];
+}
+
+unsigned long int sweet::AccelerometerFrameParser::getSensorCount() const{
+	return sensors;
+}
+
+unsigned long int sweet::AccelerometerFrameParser::getFrameSize() const{
+	return sensors * AXES * FIELD_WIDTH + 1;
+}
+
+unsigned long long int sweet::AccelerometerFrameParser::getFrameCount() const{
+	return frameCount;
+}
+
+unsigned long long int sweet::AccelerometerFrameParser::getDroppedCount() const{
+	return droppedCount;
+}
\ No newline at end of file
@@ -3,24 +3,37 @@
 #include "AccelerometerParser.h"
 #include "Accelerometer.h"
 
-#include <StringUtils.h>
-#include <Arduino.h>
+#include <Log.h>
 
-#include <iostream>
+#include <algorithm>
 
-AccelerometerParser::AccelerometerParser(std::string portName):
+AccelerometerParser::AccelerometerParser(std::string portName, unsigned long int _sensors):
 	Arduino(portName),
 	forced(false),
-	firstPing(true)
+	firstPing(true),
+	reader(port),
+	frameParser(_sensors)
 {
 	//Make sure our buffer is clear
-    PurgeComm(hSerial, PURGE_RXABORT); 
-	PurgeComm(hSerial, PURGE_TXABORT);
-	PurgeComm(hSerial, PURGE_RXCLEAR);
-	PurgeComm(hSerial, PURGE_TXCLEAR);
+	port.purge();
+	if(IsConnected()){
+		reader.start();
+	}
+}
+
+void AccelerometerParser::connect(std::string _portName){
+	// the reader can't be reading the port while it's reopened
+	reader.stop();
+	Arduino::connect(_portName);
+	firstPing = true;
+	if(IsConnected()){
+		port.purge();
+		reader.start();
+	}
 }
 
 AccelerometerParser::~AccelerometerParser(){
+	reader.stop();
 	while(accelerometers.size() > 0){
 		delete accelerometers.back();
 		accelerometers.pop_back();
@@ -36,66 +49,41 @@ void AccelerometerParser::update(Step* _step){
 	Arduino::update(_step);
 	if(IsConnected()) {
 		if(firstPing){
-			ClearCommError(this->hSerial, &this->errors, &this->status);
 			firstPing = false;
 			char ping[1] = {'1'};
 			WriteData(ping, 1);
 		}
-		ClearCommError(this->hSerial, &this->errors, &this->status);
-		int inQ = status.cbInQue;
-		if(inQ >= LINE_SIZE * 2){
-			char * buffer = new char[inQ]();
-			int numRead = ReadData(buffer, inQ);
-			accumlator += buffer;
-			std::string src = getLatestData(accumlator);
-			if(src.size() >= LINE_SIZE - 1){
-				accumlator.clear();
-				for(unsigned long int i = 0; i < accelerometers.size(); ++i){
-					char x[4];
-					char y[4];
-					char z[4];
-					
-					int mod = i * 9;
-					x[0] = src[0 + mod];
-					x[1] = src[1 + mod];
-					x[2] = src[2 + mod];
-					x[3] = '\0';
-						
-					y[0] = src[3 + mod];
-					y[1] = src[4 + mod];
-					y[2] = src[5 + mod];
-					y[3] = '\0';
-						
-					z[0] = src[6 + mod];
-					z[1] = src[7 + mod];
-					z[2] = src[8 + mod];
-					z[3] = '\0';
 
-					accelerometers.at(i)->lx = accelerometers.at(i)->x;
-					accelerometers.at(i)->ly = accelerometers.at(i)->y;
-					accelerometers.at(i)->lz = accelerometers.at(i)->z;
-					accelerometers.at(i)->x = atoi(x);
-					accelerometers.at(i)->y = atoi(y);
-					accelerometers.at(i)->z = atoi(z);
-					accelerometers.at(i)->update(_step);
-				}
+		// parse everything the reader has collected since the last update, straight out of its buffer
+		const char * first;
+		const char * second;
+		unsigned long int firstSize, secondSize;
+		unsigned long int size = reader.peek(first, firstSize, second, secondSize);
+		unsigned long int frames = frameParser.parse(first, firstSize) + frameParser.parse(second, secondSize);
+		reader.consume(size);
+
+		// only the latest frame matters
+		if(frames > 0){
+			unsigned long int n = std::min((unsigned long int)accelerometers.size(), frameParser.getSensorCount());
+			for(unsigned long int i = 0; i < n; ++i){
+				Accelerometer * a = accelerometers.at(i);
+				a->lx = a->x;
+				a->ly = a->y;
+				a->lz = a->z;
+				a->x = frameParser.getValue(i, 0);
+				a->y = frameParser.getValue(i, 1);
+				a->z = frameParser.getValue(i, 2);
+				a->update(_step);
 			}
 		}
-	}		
-}
 
-std::string AccelerometerParser::getLatestData(std::string _acc){
-	bool firstPassed = false;
-	for(signed long int i = _acc.size() - 1; i >= 0; --i) {
-		if(_acc.at(i) == ':') {
-			if(!firstPassed){
-				firstPassed = true;
-			}else{
-				if(_acc.size() - i >= LINE_SIZE) {
-					return _acc.substr(i + 1, LINE_SIZE - 1);
-				}
-			}
+		if(reader.hasFailed()){
+			Log::warn("Lost connection to the accelerometers");
+			connected = false;
 		}
 	}
-	return "";
+}
+
+unsigned long long int AccelerometerParser::getFrameCount() const{
+	return frameParser.getFrameCount();
 }
\ No newline at end of file
@@ -101,14 +101,14 @@ void AnimationJoint::update(Step * _step){
 			pointVis->mesh->vertices.at(i+1).x = outJoints.at(i)->pos.x;
 			pointVis->mesh->vertices.at(i+1).y = outJoints.at(i)->pos.y;
 		}
-		pointVis->mesh->dirty = true;
+		pointVis->mesh->makeDirty();
 	}
 	if(lineVis->isVisible()){
 		for(unsigned long int i = 0; i < outJoints.size(); ++i){
 			lineVis->mesh->vertices.at(i*2+1).x = outJoints.at(i)->pos.x;
 			lineVis->mesh->vertices.at(i*2+1).y = outJoints.at(i)->pos.y;
 		}
-		lineVis->mesh->dirty = true;
+		lineVis->mesh->makeDirty();
 	}
 
 	Entity::update(_step);
@@ -7,81 +7,58 @@
 
 /***************************************************************
 *
-* Taken from http://playground.arduino.cc/Interfacing/CPPWindows
+* Based on http://playground.arduino.cc/Interfacing/CPPWindows
 *
 ****************************************************************/
 
-Arduino::Arduino(std::string _portName){
+Arduino::Arduino(std::string _portName) :
+	connected(false)
+{
 	if(_portName != "") {
 		connect(_portName);
 	}
 }
 
 Arduino::~Arduino(){
-    //Check if we are connected before trying to disconnect
-    if(this->connected){
-        //We're no longer connected
-        this->connected = false;
-        //Close the serial handler
-        CloseHandle(this->hSerial);
-    }
+    //We're no longer connected
+    this->connected = false;
+    //Close the serial handler
+    port.close();
 }
 
 int Arduino::ReadData(char *buffer, unsigned int nbChar){
-    //Number of bytes we'll have read.
-
-    DWORD bytesRead;
-    //Number of bytes we'll really ask to read
-    unsigned int toRead;
-
-    //Use the ClearCommError function to get status info on the Serial port
-    ClearCommError(this->hSerial, &this->errors, &this->status);
-
-    //Check if there is something to read
-    if(this->status.cbInQue > 0){
-        //If there is we check if there is enough data to read the required number
-        //of characters, if not we'll read only the available characters to prevent
-        //locking of the application.
-        toRead = min(nbChar, this->status.cbInQue);
-
-        //Try to read the require number of chars, and return the number of read bytes on success
-        if(ReadFile(this->hSerial, buffer, toRead, &bytesRead, NULL) && bytesRead != 0){
-            return bytesRead;
-        }
-    }
+    //Only reads what has already arrived, to prevent locking of the application
+    signed long int bytesRead = port.read(buffer, nbChar);
 
     //If nothing has been read, or that an error was detected return -1
-    return -1;
-
+    return bytesRead > 0 ? bytesRead : -1;
 }
 
 std::string Arduino::ReadDataUntil(char _until, bool * _forced){
-	std::string ret; 
-	char data[1];
+	// read whatever has arrived in chunks instead of a byte at a time
+	char data[256];
 	while(true){
-		if(ReadData(data, 1) != -1) {
-			if(data[0] == _until) {
-				break;
-			}
-			ret += data[0];
-		}else{
+		size_t found = pending.find(_until);
+		if(found != std::string::npos){
+			std::string ret = pending.substr(0, found);
+			pending.erase(0, found + 1);
+			return ret;
+		}
+
+		int numRead = ReadData(data, sizeof(data));
+		if(numRead == -1){
 			*_forced = true;
-			break;
+			std::string ret;
+			ret.swap(pending);
+			return ret;
 		}
+		pending.append(data, numRead);
 	}
-	return ret;
 }
 
 bool Arduino::WriteData(const char * buffer, unsigned int nbChar){
-    DWORD bytesSend;
-
     //Try to write the buffer on the Serial port
-    if(!WriteFile(this->hSerial, static_cast<const void *>(buffer), nbChar, &bytesSend, 0)){
-        //In case it don't work get comm error and return false
-        ClearCommError(this->hSerial, &this->errors, &this->status);
-        return false;
-    }
-    return true;
+    return port.write(buffer, nbChar);
 }
 
 bool Arduino::IsConnected(){
@@ -90,58 +67,13 @@ bool Arduino::IsConnected(){
 }
 
 void Arduino::connect(std::string _portName) {
-	 //We're not yet connected
-    this->connected = false;
-
-    //Try to connect to the given port throuh CreateFile
-	std::wstring portName_t;
-	for(unsigned long int i = 0; i < _portName.length(); ++i){
-	  portName_t += wchar_t(_portName[i]);
-	}
-
-    this->hSerial = CreateFile(portName_t.c_str(),
-            GENERIC_READ | GENERIC_WRITE,
-            0,
-            NULL,
-            OPEN_EXISTING,
-            FILE_ATTRIBUTE_NORMAL,
-            NULL);
-
-    //Check if the connection was successfull
-    if(this->hSerial==INVALID_HANDLE_VALUE){
-        //If not success full display an Error
-        if(GetLastError()==ERROR_FILE_NOT_FOUND){
-            //Print Error if neccessary
-			ST_LOG_WARN("Handle was not attached. Reason: "+_portName+" not available");
-        }else{
-			ST_LOG_WARN("Handle was not attached. Reason: unknown");
-        }
-    }else{
-        //If connected we try to set the comm parameters
-        DCB dcbSerialParams = {0};
-
-        //Try to get the current
-        if (!GetCommState(this->hSerial, &dcbSerialParams)){
-            //If impossible, show an error
-			ST_LOG_WARN("Failed to get current serial parameters");
-        }else{
-            //Define serial connection parameters for the arduino board
-            dcbSerialParams.BaudRate=CBR_115200;
-            dcbSerialParams.ByteSize=8;
-            dcbSerialParams.StopBits=ONESTOPBIT;
-            dcbSerialParams.Parity=NOPARITY;
-
-             //Set the parameters and check for their proper application
-             if(!SetCommState(hSerial, &dcbSerialParams)){
-				Log::warn("Could not set Serial Port parameters");
-             }else{
-                 //If everything went fine we're connected
-                 this->connected = true;
-                 //We wait 2s as the arduino board will be reseting
-                // Sleep(ARDUINO_WAIT_TIME);
-             }
-        }
+    //Define serial connection parameters for the arduino board
+    //If everything went fine we're connected
+    this->connected = port.open(_portName, 115200);
+    if(!this->connected){
+		ST_LOG_WARN("Handle was not attached. Reason: "+_portName+" not available");
     }
+    pending.clear();
 }
 
 void Arduino::update(Step* _step){
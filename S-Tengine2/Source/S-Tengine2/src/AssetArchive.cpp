@@ -0,0 +1,507 @@
+#pragma once
+
+#include <AssetArchive.h>
+#include <FileUtils.h>
+#include <Log.h>
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+std::vector<sweet::AssetArchive *> sweet::AssetArchive::mounted;
+
+namespace{
+	const char MAGIC[4] = {'S', 'T', 'P', 'K'};
+	const unsigned long int VERSION = 1;
+	const size_t HEADER_SIZE = 16;
+	const size_t ENTRY_SIZE = 40;
+
+	std::string normalizePath(std::string _path){
+		std::replace(_path.begin(), _path.end(), '\\', '/');
+		return _path;
+	}
+
+	unsigned long int readU32(const unsigned char * _p){
+		return _p[0] | (_p[1] << 8) | (_p[2] << 16) | ((unsigned long int)_p[3] << 24);
+	}
+	unsigned long long int readU64(const unsigned char * _p){
+		return readU32(_p) | ((unsigned long long int)readU32(_p + 4) << 32);
+	}
+	void writeU32(std::string & _out, unsigned long int _v){
+		for(unsigned long int i = 0; i < 4; ++i){
+			_out.push_back((char)((_v >> (i*8)) & 0xFF));
+		}
+	}
+	void writeU64(std::string & _out, unsigned long long int _v){
+		writeU32(_out, (unsigned long int)(_v & 0xFFFFFFFF));
+		writeU32(_out, (unsigned long int)(_v >> 32));
+	}
+
+	// LZ4 length fields: 15 in the token, then 255s until the remainder
+	void writeLength(std::string & _out, size_t _length){
+		while(_length >= 255){
+			_out.push_back((char)255);
+			_length -= 255;
+		}
+		_out.push_back((char)_length);
+	}
+	bool readLength(const unsigned char * _src, size_t _size, size_t & _pos, size_t & _length){
+		unsigned char b;
+		do{
+			if(_pos >= _size){
+				return false;
+			}
+			b = _src[_pos++];
+			_length += b;
+		}while(b == 255);
+		return true;
+	}
+}
+
+void sweet::AssetArchive::compressBlock(const unsigned char * _src, size_t _size, std::string & _output){
+	// the format requires the last 5 bytes to be literals, and the last match to start at least 12 bytes from the end
+	const size_t MIN_MATCH = 4;
+	const size_t LAST_LITERALS = 5;
+	const size_t MATCH_LIMIT = 12;
+	const unsigned long int HASH_BITS = 12;
+
+	std::vector<long long int> table(1 << HASH_BITS, -1);
+	size_t anchor = 0;
+	size_t pos = 0;
+	_output.clear();
+	_output.reserve(_size + _size / 255 + 16);
+
+	auto emit = [&](size_t _literalEnd, size_t _offset, size_t _matchLength){
+		size_t literals = _literalEnd - anchor;
+		size_t match = _matchLength > 0 ? _matchLength - MIN_MATCH : 0;
+		unsigned char token = (unsigned char)((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(match, 15));
+		_output.push_back((char)token);
+		if(literals >= 15){
+			writeLength(_output, literals - 15);
+		}
+		_output.append((const char *)_src + anchor, literals);
+		if(_matchLength > 0){
+			_output.push_back((char)(_offset & 0xFF));
+			_output.push_back((char)(_offset >> 8));
+			if(match >= 15){
+				writeLength(_output, match - 15);
+			}
+		}
+	};
+
+	if(_size > MATCH_LIMIT){
+		size_t limit = _size - MATCH_LIMIT;
+		while(pos < limit){
+			unsigned int sequence;
+			memcpy(&sequence, _src + pos, 4);
+			unsigned int hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+			long long int ref = table[hash];
+			table[hash] = pos;
+			if(ref >= 0 && pos - ref <= 0xFFFF && memcmp(_src + ref, _src + pos, 4) == 0){
+				size_t length = MIN_MATCH;
+				while(pos + length < _size - LAST_LITERALS && _src[ref + length] == _src[pos + length]){
+					++length;
+				}
+				emit(pos, pos - (size_t)ref, length);
+				pos += length;
+				anchor = pos;
+			}else{
+				++pos;
+			}
+		}
+	}
+	// everything left is a final run of literals
+	emit(_size, 0, 0);
+}
+
+bool sweet::AssetArchive::decompressBlock(const unsigned char * _src, size_t _size, unsigned char * _dst, size_t _dstSize){
+	size_t in = 0;
+	size_t out = 0;
+	while(in < _size){
+		unsigned char token = _src[in++];
+
+		size_t literals = token >> 4;
+		if(literals == 15 && !readLength(_src, _size, in, literals)){
+			return false;
+		}
+		if(literals > _size - in || literals > _dstSize - out){
+			return false;
+		}
+		memcpy(_dst + out, _src + in, literals);
+		in += literals;
+		out += literals;
+
+		// the last sequence doesn't have a match
+		if(in == _size){
+			break;
+		}
+
+		if(_size - in < 2){
+			return false;
+		}
+		size_t offset = _src[in] | (_src[in + 1] << 8);
+		in += 2;
+		if(offset == 0 || offset > out){
+			return false;
+		}
+		size_t match = token & 15;
+		if(match == 15 && !readLength(_src, _size, in, match)){
+			return false;
+		}
+		match += 4;
+		if(match > _dstSize - out){
+			return false;
+		}
+		// matches can overlap the output, so this has to be done byte-by-byte
+		for(size_t i = 0; i < match; ++i, ++out){
+			_dst[out] = _dst[out - offset];
+		}
+	}
+	return out == _dstSize;
+}
+
+
+
+sweet::AssetArchive::Builder::Builder() :
+	alignment(64),
+	compress(true)
+{
+}
+
+void sweet::AssetArchive::Builder::add(std::string _type, std::string _id, std::string _path){
+	_path = normalizePath(_path);
+	for(const Entry & e : entries){
+		if(e.path == _path){
+			return;
+		}
+	}
+	Entry e;
+	e.type = _type;
+	e.id = _id;
+	e.path = _path;
+	e.flags = 0;
+	e.offset = e.storedSize = e.size = 0;
+	entries.push_back(e);
+}
+
+bool sweet::AssetArchive::Builder::write(std::string _outputSrc) const{
+	std::vector<Entry> toc = entries;
+	std::vector<std::string> contents;
+
+	// read and (optionally) compress everything first, so that the table of contents can be written up-front
+	for(Entry & e : toc){
+		std::string file = FileUtils::readBinaryFile(e.path);
+		if(file.empty() && !FileUtils::fileExists(e.path)){
+			Log::error("Couldn't pack \"" + e.path + "\"");
+			return false;
+		}
+		e.size = file.size();
+		if(compress && file.size() > 0){
+			std::string compressed;
+			compressBlock((const unsigned char *)file.data(), file.size(), compressed);
+			if(compressed.size() < file.size()){
+				e.flags |= kCOMPRESSED;
+				file.swap(compressed);
+			}
+		}
+		e.storedSize = file.size();
+		contents.push_back(file);
+	}
+
+	std::string strings;
+	std::vector<unsigned long int> stringOffsets;
+	for(const Entry & e : toc){
+		stringOffsets.push_back(strings.size());
+		strings.append(e.type).push_back('\0');
+		stringOffsets.push_back(strings.size());
+		strings.append(e.id).push_back('\0');
+		stringOffsets.push_back(strings.size());
+		strings.append(e.path).push_back('\0');
+	}
+
+	unsigned long int align = std::max(alignment, 1ul);
+	unsigned long long int offset = HEADER_SIZE + ENTRY_SIZE * toc.size() + strings.size();
+	for(Entry & e : toc){
+		offset = (offset + align - 1) / align * align;
+		e.offset = offset;
+		offset += e.storedSize;
+	}
+
+	std::string header;
+	header.append(MAGIC, 4);
+	writeU32(header, VERSION);
+	writeU32(header, toc.size());
+	writeU32(header, strings.size());
+	for(unsigned long int i = 0; i < toc.size(); ++i){
+		writeU32(header, stringOffsets.at(i*3));
+		writeU32(header, stringOffsets.at(i*3 + 1));
+		writeU32(header, stringOffsets.at(i*3 + 2));
+		writeU32(header, toc.at(i).flags);
+		writeU64(header, toc.at(i).offset);
+		writeU64(header, toc.at(i).storedSize);
+		writeU64(header, toc.at(i).size);
+	}
+	header.append(strings);
+
+	std::ofstream file(_outputSrc, std::ios::out | std::ios::binary);
+	if(!file.is_open()){
+		Log::error("File \"" + _outputSrc + "\" could not be opened for writing.");
+		return false;
+	}
+	file.write(header.data(), header.size());
+	unsigned long long int written = header.size();
+	for(unsigned long int i = 0; i < toc.size(); ++i){
+		std::string padding((size_t)(toc.at(i).offset - written), '\0');
+		file.write(padding.data(), padding.size());
+		file.write(contents.at(i).data(), contents.at(i).size());
+		written = toc.at(i).offset + contents.at(i).size();
+	}
+	return file.good();
+}
+
+
+
+sweet::AssetArchive::AssetArchive(std::string _src) :
+	src(_src),
+	data(nullptr),
+	size(0),
+	fileHandle(nullptr),
+	mappingHandle(nullptr)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(_src.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if(file != INVALID_HANDLE_VALUE){
+		LARGE_INTEGER fileSize;
+		GetFileSizeEx(file, &fileSize);
+		HANDLE mapping = fileSize.QuadPart > 0 ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+		if(mapping != NULL){
+			data = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			size = (size_t)fileSize.QuadPart;
+			mappingHandle = mapping;
+		}
+		fileHandle = file;
+	}
+#else
+	int fd = open(_src.c_str(), O_RDONLY);
+	if(fd >= 0){
+		struct stat st;
+		if(fstat(fd, &st) == 0 && st.st_size > 0){
+			void * mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(mapping != MAP_FAILED){
+				data = (const unsigned char *)mapping;
+				size = st.st_size;
+			}
+		}
+		::close(fd);
+	}
+#endif
+
+	if(data == nullptr){
+		Log::error("Archive \"" + _src + "\" could not be opened.");
+		close();
+	}else if(!parse()){
+		Log::error("Archive \"" + _src + "\" is corrupt or from a different version.");
+		close();
+	}
+}
+
+sweet::AssetArchive::~AssetArchive(){
+	unmount(this);
+	close();
+}
+
+void sweet::AssetArchive::close(){
+#ifdef _WIN32
+	if(data != nullptr){
+		UnmapViewOfFile(data);
+	}
+	if(mappingHandle != nullptr){
+		CloseHandle((HANDLE)mappingHandle);
+	}
+	if(fileHandle != nullptr){
+		CloseHandle((HANDLE)fileHandle);
+	}
+#else
+	if(data != nullptr){
+		munmap((void *)data, size);
+	}
+#endif
+	data = nullptr;
+	size = 0;
+	fileHandle = mappingHandle = nullptr;
+	entries.clear();
+	ids.clear();
+	paths.clear();
+}
+
+bool sweet::AssetArchive::parse(){
+	if(size < HEADER_SIZE || memcmp(data, MAGIC, 4) != 0 || readU32(data + 4) != VERSION){
+		return false;
+	}
+	unsigned long long int numEntries = readU32(data + 8);
+	unsigned long long int stringsSize = readU32(data + 12);
+	unsigned long long int tocEnd = HEADER_SIZE + numEntries * ENTRY_SIZE;
+	if(tocEnd + stringsSize > size){
+		return false;
+	}
+	const char * strings = (const char *)data + tocEnd;
+	auto getString = [&](unsigned long int _offset, std::string & _out){
+		if(_offset >= stringsSize){
+			return false;
+		}
+		const char * end = (const char *)memchr(strings + _offset, '\0', (size_t)(stringsSize - _offset));
+		if(end == nullptr){
+			return false;
+		}
+		_out.assign(strings + _offset, end);
+		return true;
+	};
+
+	for(unsigned long int i = 0; i < numEntries; ++i){
+		const unsigned char * p = data + HEADER_SIZE + i * ENTRY_SIZE;
+		Entry e;
+		if(!getString(readU32(p), e.type) || !getString(readU32(p + 4), e.id) || !getString(readU32(p + 8), e.path)){
+			return false;
+		}
+		e.flags = readU32(p + 12);
+		e.offset = readU64(p + 16);
+		e.storedSize = readU64(p + 24);
+		e.size = readU64(p + 32);
+		if(e.offset > size || e.storedSize > size - e.offset){
+			return false;
+		}
+		ids[e.type + "/" + e.id] = entries.size();
+		paths[e.path] = entries.size();
+		entries.push_back(e);
+	}
+	return true;
+}
+
+bool sweet::AssetArchive::isOpen() const{
+	return data != nullptr;
+}
+
+const std::string & sweet::AssetArchive::getSource() const{
+	return src;
+}
+
+const std::vector<sweet::AssetArchive::Entry> & sweet::AssetArchive::getEntries() const{
+	return entries;
+}
+
+const sweet::AssetArchive::Entry * sweet::AssetArchive::find(const std::string & _type, const std::string & _id) const{
+	auto it = ids.find(_type + "/" + _id);
+	return it == ids.end() ? nullptr : &entries.at(it->second);
+}
+
+const sweet::AssetArchive::Entry * sweet::AssetArchive::findFile(const std::string & _path) const{
+	auto it = paths.find(normalizePath(_path));
+	return it == paths.end() ? nullptr : &entries.at(it->second);
+}
+
+const unsigned char * sweet::AssetArchive::getData(const Entry * _entry, std::string & _buffer) const{
+	const unsigned char * stored = data + _entry->offset;
+	if((_entry->flags & kCOMPRESSED) == 0){
+		return stored;
+	}
+	_buffer.resize((size_t)_entry->size);
+	if(_entry->size > 0 && !decompressBlock(stored, (size_t)_entry->storedSize, (unsigned char *)&_buffer[0], _buffer.size())){
+		Log::error("Archive \"" + src + "\" has a corrupt entry: " + _entry->path);
+		_buffer.clear();
+		return nullptr;
+	}
+	return (const unsigned char *)_buffer.data();
+}
+
+void sweet::AssetArchive::mount(AssetArchive * _archive){
+	if(_archive->isOpen() && std::find(mounted.begin(), mounted.end(), _archive) == mounted.end()){
+		mounted.push_back(_archive);
+	}
+}
+
+void sweet::AssetArchive::unmount(AssetArchive * _archive){
+	auto it = std::find(mounted.begin(), mounted.end(), _archive);
+	if(it != mounted.end()){
+		mounted.erase(it);
+	}
+}
+
+const unsigned char * sweet::AssetArchive::getFile(const std::string & _path, size_t & _size, std::string & _buffer){
+	for(auto it = mounted.rbegin(); it != mounted.rend(); ++it){
+		const Entry * e = (*it)->findFile(_path);
+		if(e != nullptr){
+			const unsigned char * res = (*it)->getData(e, _buffer);
+			_size = res != nullptr ? (size_t)e->size : 0;
+			return res;
+		}
+	}
+	_size = 0;
+	return nullptr;
+}
+
+std::string sweet::AssetArchive::readFile(const std::string & _path){
+	std::string buffer;
+	size_t fileSize;
+	const unsigned char * file = getFile(_path, fileSize, buffer);
+	if(file == nullptr){
+		return FileUtils::readFile(_path);
+	}
+	if(file != (const unsigned char *)buffer.data()){
+		buffer.assign((const char *)file, fileSize);
+	}
+	return buffer;
+}
+
+bool sweet::AssetArchive::packScenario(std::string _scenarioSrc, std::string _outputSrc, bool _compress){
+	Json::Reader reader;
+	Json::Value root;
+	if(!reader.parse(FileUtils::readFile(_scenarioSrc), root)){
+		Log::error("JSON parse failed: " + reader.getFormattedErrorMessages());
+		return false;
+	}
+
+	// the directories each asset type is loaded from (see the Asset subclasses)
+	std::map<std::string, std::string> directories;
+	directories["texture"] = "assets/textures/";
+	directories["textureSampler"] = "assets/textures/";
+	directories["audio"] = "assets/audio/";
+	directories["font"] = "assets/fonts/";
+	directories["mesh"] = "assets/meshes/";
+
+	Builder builder;
+	builder.compress = _compress;
+	const Json::Value assetsJson = root["assets"];
+	for(Json::Value::ArrayIndex i = 0; i < assetsJson.size(); ++i){
+		std::string type = assetsJson[i].get("type", "NO_TYPE").asString();
+		std::string id = assetsJson[i].get("id", "NO_ID").asString();
+		auto dir = directories.find(type);
+		if(dir == directories.end() || !assetsJson[i].isMember("src")){
+			continue;
+		}
+		std::string path = dir->second + assetsJson[i]["src"].asString();
+		builder.add(type, id, path);
+
+		// texture samplers are a definition file which refers to a texture
+		if(type == "textureSampler"){
+			Json::Value defJson;
+			if(reader.parse(FileUtils::readFile(path), defJson) && defJson.isMember("t")){
+				std::string texture = path.substr(0, path.find_last_of("\\/")) + "/" + defJson["t"].asString();
+				builder.add("texture", id + "/t", texture);
+			}
+		}
+	}
+	return builder.write(_outputSrc);
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <BenchmarkRunner.h>
+#include <NullGL.h>
+#include <Profiler.h>
+#include <NumberUtils.h>
+#include <Step.h>
+#include <Log.h>
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+sweet::Benchmark::Benchmark(std::string _name, unsigned long int _frames) :
+	name(_name),
+	frames(_frames)
+{
+}
+
+sweet::Benchmark::~Benchmark(){
+}
+
+bool sweet::Benchmark::setUp(){
+	return true;
+}
+
+void sweet::Benchmark::tearDown(){
+}
+
+void sweet::Benchmark::fail(std::string _message){
+	failures.push_back(_message);
+}
+
+sweet::FunctionBenchmark::FunctionBenchmark(std::string _name, unsigned long int _frames, std::function<void(Step *)> _function) :
+	Benchmark(_name, _frames),
+	function(_function)
+{
+}
+
+void sweet::FunctionBenchmark::frame(Step * _step){
+	function(_step);
+}
+
+
+
+sweet::BenchmarkRunner::BenchmarkRunner() :
+	fps(60),
+	warmupFrames(10),
+	seed(1)
+{
+	if(!NullGL::isInstalled()){
+		NullGL::install();
+	}
+}
+
+sweet::BenchmarkRunner::~BenchmarkRunner(){
+	for(Benchmark * b : benchmarks){
+		delete b;
+	}
+}
+
+void sweet::BenchmarkRunner::add(Benchmark * _benchmark){
+	benchmarks.push_back(_benchmark);
+}
+
+void sweet::BenchmarkRunner::add(std::string _name, unsigned long int _frames, std::function<void(Step *)> _frame){
+	add(new FunctionBenchmark(_name, _frames, _frame));
+}
+
+const std::vector<sweet::BenchmarkResult> & sweet::BenchmarkRunner::run(std::string _filter){
+	results.clear();
+	for(Benchmark * b : benchmarks){
+		if(_filter.size() > 0 && b->name.find(_filter) == std::string::npos){
+			continue;
+		}
+		BenchmarkResult r = runBenchmark(b);
+		std::stringstream ss;
+		if(r.failures.size() > 0){
+			ss << r.name << ": FAILED";
+			for(const std::string & f : r.failures){
+				ss << std::endl << "  " << f;
+			}
+			Log::error(ss.str());
+			results.push_back(r);
+			continue;
+		}else if(r.skipped){
+			ss << r.name << ": skipped";
+		}else{
+			ss << r.name << ": " << r.mean << "ms mean, " << r.median << "ms median, " << r.p95 << "ms p95 (" << r.frames << " frames)";
+		}
+		Log::info(ss.str());
+		results.push_back(r);
+	}
+	return results;
+}
+
+sweet::BenchmarkResult sweet::BenchmarkRunner::runBenchmark(Benchmark * _benchmark){
+	BenchmarkResult res;
+	res.name = _benchmark->name;
+	res.skipped = false;
+	res.frames = 0;
+	res.total = res.mean = res.median = res.fastest = res.slowest = res.p95 = 0;
+
+	// same seed and same steps every time, so the work done is reproducible
+	NumberUtils::seed(seed);
+	std::srand(seed);
+	Step step;
+	step.targetFrameDuration = 1.0 / fps;
+	step.deltaTimeCorrection = 1.0;
+	step.setDeltaTime(step.targetFrameDuration);
+	auto advance = [&step](){
+		step.time += step.deltaTime;
+		step.lastTimestamp = step.time;
+		++step.cycles;
+	};
+
+	_benchmark->metrics.clear();
+	_benchmark->failures.clear();
+	if(!_benchmark->setUp()){
+		res.skipped = true;
+		res.failures = _benchmark->failures;
+		return res;
+	}
+
+	for(unsigned long int i = 0; i < warmupFrames; ++i){
+		_benchmark->frame(&step);
+		advance();
+	}
+
+	NullGL::resetStats();
+	Profiler & profiler = Profiler::getInstance();
+	std::vector<double> times;
+	times.reserve(_benchmark->frames);
+	for(unsigned long int i = 0; i < _benchmark->frames; ++i){
+		double start = profiler.getTime();
+		_benchmark->frame(&step);
+		times.push_back((profiler.getTime() - start) * 1000.0);
+		advance();
+	}
+	const NullGL::Stats & gl = NullGL::getStats();
+
+	_benchmark->tearDown();
+
+	res.frames = times.size();
+	if(res.frames > 0){
+		double frames = (double)res.frames;
+		for(double t : times){
+			res.total += t;
+		}
+		res.mean = res.total / frames;
+		std::sort(times.begin(), times.end());
+		res.median = times.at(times.size() / 2);
+		res.fastest = times.front();
+		res.slowest = times.back();
+		res.p95 = times.at(std::min(times.size() - 1, (size_t)(times.size() * 0.95)));
+
+		res.metrics["gl calls per frame"] = gl.calls / frames;
+		res.metrics["draw calls per frame"] = gl.drawCalls / frames;
+		res.metrics["indices drawn per frame"] = gl.indicesDrawn / frames;
+		res.metrics["buffer uploads per frame"] = gl.bufferUploads / frames;
+		res.metrics["buffer upload bytes per frame"] = gl.bufferUploadBytes / frames;
+		res.metrics["uniform uploads per frame"] = gl.uniformUploads / frames;
+		res.metrics["framebuffer binds per frame"] = gl.framebufferBinds / frames;
+		res.metrics["framebuffers created per frame"] = gl.framebuffersCreated / frames;
+		res.metrics["renderbuffer allocations per frame"] = gl.renderbufferAllocations / frames;
+	}
+	for(auto & m : _benchmark->metrics){
+		res.metrics[m.first] = m.second;
+	}
+	res.failures = _benchmark->failures;
+	// throughput, for benchmarks that report how much work they do
+	auto items = res.metrics.find("items per frame");
+	if(items != res.metrics.end() && res.mean > 0){
+		res.metrics["items per ms"] = items->second / res.mean;
+	}
+	return res;
+}
+
+const std::vector<sweet::BenchmarkResult> & sweet::BenchmarkRunner::getResults() const{
+	return results;
+}
+
+unsigned long int sweet::BenchmarkRunner::getNumFailed() const{
+	unsigned long int res = 0;
+	for(const BenchmarkResult & r : results){
+		if(r.failures.size() > 0){
+			++res;
+		}
+	}
+	return res;
+}
+
+bool sweet::BenchmarkRunner::writeResults(std::string _filename) const{
+	Json::Value root;
+	root["fps"] = fps;
+	root["warmupFrames"] = (Json::UInt)warmupFrames;
+	root["seed"] = (Json::UInt)seed;
+	root["results"] = Json::Value(Json::arrayValue);
+	for(const BenchmarkResult & r : results){
+		Json::Value v;
+		v["name"] = r.name;
+		v["skipped"] = r.skipped;
+		v["failed"] = r.failures.size() > 0;
+		Json::Value failures(Json::arrayValue);
+		for(const std::string & f : r.failures){
+			failures.append(f);
+		}
+		v["failures"] = failures;
+		v["frames"] = (Json::UInt)r.frames;
+		v["totalMs"] = r.total;
+		v["meanMs"] = r.mean;
+		v["medianMs"] = r.median;
+		v["minMs"] = r.fastest;
+		v["maxMs"] = r.slowest;
+		v["p95Ms"] = r.p95;
+		Json::Value metrics(Json::objectValue);
+		for(auto & m : r.metrics){
+			metrics[m.first] = m.second;
+		}
+		v["metrics"] = metrics;
+		root["results"].append(v);
+	}
+
+	std::ofstream file(_filename);
+	if(!file.is_open()){
+		Log::error("Couldn't open " + _filename + " to write the benchmark results");
+		return false;
+	}
+	Json::StyledWriter writer;
+	file << writer.write(root);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,2190 @@
+#pragma once
+
+#include <BenchmarkRunner.h>
+
+#include <Transform.h>
+#include <MeshEntity.h>
+#include <MeshFactory.h>
+#include <MeshInterface.h>
+#include <MatrixStack.h>
+#include <RenderOptions.h>
+#include <shader/ComponentShaderBase.h>
+#include <shader/ShaderComponentMVP.h>
+#include <shader/ShaderComponentText.h>
+#include <shader/ShaderComponentSpriteSheet.h>
+#include <shader/ShaderComponentDrawColour.h>
+#include <Font.h>
+#include <TextArea.h>
+#include <NodeUI.h>
+#include <VerticalLinearLayout.h>
+#include <UILayer.h>
+#include <BulletWorld.h>
+#include <NodeBulletBody.h>
+#include <CollisionShapeCache.h>
+#include <Box2DWorld.h>
+#include <AutoMusic.h>
+#include <ParticlePool.h>
+#include <ParticleSystem.h>
+#include <Sprite.h>
+#include <SpriteSheet.h>
+#include <ProgrammaticTexture.h>
+#include <PhraseGenerator.h>
+#include <AssetArchive.h>
+#include <scenario/Scenario.h>
+#include <scenario/ScenarioBinary.h>
+#include <FileUtils.h>
+#include <NumberUtils.h>
+#include <Random.h>
+#include <Keyboard.h>
+#include <SerialPort.h>
+#include <SerialReader.h>
+#include <AccelerometerFrameParser.h>
+#include <FrameBufferInterface.h>
+#include <StandardFrameBuffer.h>
+#include <RenderTargetPool.h>
+#include <BlurPipeline.h>
+#include <VoxelWorld.h>
+#include <JobSystem.h>
+#include <NodeAllocator.h>
+#include <NodeCensus.h>
+#include <CommandProcessor.h>
+#include <Command.h>
+#include <NullGL.h>
+#include <Log.h>
+#include <Step.h>
+
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <set>
+#include <map>
+
+// the generator NumberUtils used to use, for comparison
+namespace knuth{
+#include <rng.h>
+}
+#undef KK
+#undef LL
+#undef MM
+#undef mod_diff
+#undef QUALITY
+#undef TT
+#undef is_odd
+#undef ran_arr_next
+
+namespace{
+	ComponentShaderBase * makeShader(bool _text){
+		ComponentShaderBase * shader = new ComponentShaderBase(false);
+		shader->addComponent(new ShaderComponentMVP(shader));
+		if(_text){
+			shader->addComponent(new ShaderComponentText(shader));
+		}
+		shader->compileShader();
+		return shader;
+	}
+
+	// counts the heap blocks held by containers in and under _node (child lists, names, and mesh data), which the node pools don't cover
+	unsigned long int countContainerAllocations(NodeChild * _node){
+		static const size_t inlineName = std::string().capacity();
+		unsigned long int res = _node->nodeName.capacity() > inlineName ? 1 : 0;
+		if(Transform * t = _node->asTransform()){
+			res += t->children.capacity() > 0 ? 1 : 0;
+			for(NodeChild * c : t->children){
+				res += countContainerAllocations(c);
+			}
+		}else if(Entity * e = dynamic_cast<Entity *>(_node)){
+			res += countContainerAllocations(e->childTransform);
+		}else if(MeshInterface * m = dynamic_cast<MeshInterface *>(_node)){
+			res += (m->vertices.capacity() > 0 ? 1 : 0) + (m->indices.capacity() > 0 ? 1 : 0);
+		}
+		return res;
+	}
+
+	// Transform tree with a mesh at each leaf; the top level is rotated every frame so that the world matrices change
+	// run with the node pools on and off to compare them with the system allocator
+	class SceneGraphBenchmark : public sweet::Benchmark{
+	public:
+		bool pooled;
+		Transform * root;
+		ComponentShaderBase * shader;
+		unsigned long int nodeAllocations;
+
+		SceneGraphBenchmark(bool _pooled) :
+			Benchmark(_pooled ? "scenegraph/traversal" : "scenegraph/traversal-heap", 300),
+			pooled(_pooled),
+			root(nullptr),
+			shader(nullptr),
+			nodeAllocations(0)
+		{
+		}
+
+		void build(Transform * _parent, unsigned long int _depth){
+			for(unsigned long int i = 0; i < 8; ++i){
+				if(_depth == 0){
+					_parent->addChild(new MeshEntity(MeshFactory::getPlaneMesh(), shader))->translate((float)i, 0, 0);
+				}else{
+					Transform * t = new Transform();
+					_parent->addChild(t, false);
+					t->translate((float)i, (float)_depth, 0);
+					build(t, _depth - 1);
+				}
+			}
+		}
+
+		bool setUp() override{
+			sweet::NodeAllocator & allocator = sweet::NodeAllocator::getInstance();
+			allocator.setPoolsEnabled(pooled);
+			shader = makeShader(false);
+			unsigned long int before = allocator.getNumSystemAllocations();
+			root = new Transform();
+			build(root, 2);
+			nodeAllocations = allocator.getNumSystemAllocations() - before;
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			for(NodeChild * c : root->children){
+				dynamic_cast<Transform *>(c)->rotate(1.f, 0, 1, 0, kOBJECT);
+			}
+			root->update(_step);
+			sweet::MatrixStack ms;
+			RenderOptions ro(shader, nullptr);
+			root->render(&ms, &ro);
+		}
+
+		void tearDown() override{
+			metrics["leaves"] = 512;
+			// calls to the system allocator for the nodes themselves while building the tree
+			metrics["node system allocations"] = nodeAllocations;
+			// heap blocks which the pools don't cover, so the tree's allocations aren't bounded yet
+			metrics["container heap blocks"] = countContainerAllocations(root);
+			delete root;
+			delete shader;
+			sweet::NodeAllocator::getInstance().setPoolsEnabled(true);
+		}
+	};
+
+	// entity which steers a small swarm of points every update and moves itself to follow them
+	class SwarmEntity : public Entity{
+	public:
+		std::vector<glm::vec3> points;
+		std::vector<glm::vec3> velocities;
+
+		explicit SwarmEntity(unsigned long int _seed){
+			parallelUpdate = true;
+			for(unsigned long int i = 0; i < 256; ++i){
+				float a = (float)(_seed * 256 + i);
+				points.push_back(glm::vec3(sin(a), cos(a * 1.3f), sin(a * 0.7f)));
+				velocities.push_back(glm::vec3(0));
+			}
+		}
+
+		void update(Step * _step) override{
+			float dt = (float)_step->getDeltaTime();
+			glm::vec3 centre(0);
+			for(const glm::vec3 & p : points){
+				centre += p;
+			}
+			centre /= (float)points.size();
+			for(unsigned long int i = 0; i < points.size(); ++i){
+				// pulled towards the centre and pushed away from the next point along
+				glm::vec3 away = points[i] - points[(i + 1) % points.size()];
+				velocities[i] += ((centre - points[i]) + away / (glm::dot(away, away) + 0.01f) * 0.01f) * dt;
+				points[i] += velocities[i] * dt;
+			}
+			firstParent()->translate(centre * 0.001f);
+			Entity::update(_step);
+		}
+	};
+
+	// updates a flat list of parallel-safe entities with _threads threads (0 = all hardware threads)
+	class ParallelUpdateBenchmark : public sweet::Benchmark{
+	public:
+		unsigned long int threads;
+		unsigned long int previousThreads;
+		Transform * root;
+
+		static std::string getName(unsigned long int _threads){
+			std::stringstream ss;
+			ss << "update/parallel-";
+			if(_threads == 0){
+				ss << "all";
+			}else{
+				ss << _threads;
+			}
+			return ss.str();
+		}
+
+		ParallelUpdateBenchmark(unsigned long int _threads) : Benchmark(getName(_threads), 120), threads(_threads), previousThreads(1), root(nullptr){}
+
+		bool setUp() override{
+			sweet::JobSystem & jobs = sweet::JobSystem::getInstance();
+			previousThreads = jobs.getNumThreads();
+			jobs.initialize(threads == 0 ? -1 : (signed long int)threads - 1);
+			root = new Transform();
+			for(unsigned long int i = 0; i < 512; ++i){
+				root->addChild(new SwarmEntity(i), true);
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			root->update(_step);
+		}
+
+		void tearDown() override{
+			metrics["threads"] = (double)sweet::JobSystem::getInstance().getNumThreads();
+			metrics["items per frame"] = 512;
+			delete root;
+			root = nullptr;
+			sweet::JobSystem::getInstance().initialize((signed long int)previousThreads - 1);
+		}
+	};
+
+	// rewrites and re-uploads every vertex of a large mesh each frame
+	class MeshUploadBenchmark : public sweet::Benchmark{
+	public:
+		MeshInterface * mesh;
+
+		MeshUploadBenchmark() : Benchmark("mesh/upload", 300), mesh(nullptr){}
+
+		bool setUp() override{
+			mesh = new TriMesh(false, GL_TRIANGLES, GL_DYNAMIC_DRAW);
+			for(unsigned long int i = 0; i < 65536; ++i){
+				mesh->pushVert(Vertex((float)(i % 256), (float)(i / 256), 0.f));
+			}
+			mesh->load();
+			mesh->clean();
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			float z = (float)_step->time;
+			for(Vertex & v : mesh->vertices){
+				v.z = z;
+			}
+			mesh->makeDirty();
+			mesh->clean();
+		}
+
+		void tearDown() override{
+			metrics["vertices"] = (double)mesh->vertices.size();
+			delete mesh;
+		}
+	};
+
+	// moves a contiguous 1% of the vertices of a large dynamic mesh each frame and uploads only what changed
+	class MeshPartialUploadBenchmark : public MeshUploadBenchmark{
+	public:
+		unsigned long int frameCount;
+
+		MeshPartialUploadBenchmark() : frameCount(0){
+			name = "mesh/partial-upload";
+		}
+
+		void frame(Step * _step) override{
+			float z = (float)_step->time;
+			unsigned long int count = mesh->vertices.size() / 100;
+			unsigned long int first = (frameCount * count) % (mesh->vertices.size() - count);
+			for(unsigned long int i = first; i < first + count; ++i){
+				mesh->vertices[i].z = z;
+			}
+			mesh->makeVerticesDirty(first, count);
+			++frameCount;
+			mesh->clean();
+		}
+	};
+
+	// re-lays out a paragraph of wrapped text each frame
+	class TextLayoutBenchmark : public sweet::Benchmark{
+	public:
+		std::string fontFile;
+		BulletWorld * world;
+		Font * font;
+		ComponentShaderBase * shader;
+		TextArea * text;
+
+		TextLayoutBenchmark(std::string _fontFile) : Benchmark("text/layout", 300), fontFile(_fontFile), world(nullptr), font(nullptr), shader(nullptr), text(nullptr){}
+
+		bool setUp() override{
+			if(!sweet::FileUtils::fileExists(fontFile)){
+				return false;
+			}
+			world = new BulletWorld();
+			font = new Font(fontFile, 24, false);
+			shader = makeShader(true);
+			text = new TextArea(world, font, shader);
+			text->setPixelWidth(400);
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			text->setText(_step->cycles % 2 == 0 ?
+				"The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs. How vexingly quick daft zebras jump!" :
+				"Sphinx of black quartz, judge my vow. The five boxing wizards jump quickly. Jackdaws love my big sphinx of quartz.");
+			text->update(_step);
+		}
+
+		void tearDown() override{
+			delete text;
+			delete shader;
+			delete font;
+			delete world;
+		}
+	};
+
+	// resizes one element of a long vertical layout each frame, forcing the layout to be recalculated
+	class UILayoutBenchmark : public sweet::Benchmark{
+	public:
+		BulletWorld * world;
+		VerticalLinearLayout * layout;
+
+		UILayoutBenchmark() : Benchmark("ui/layout", 300), world(nullptr), layout(nullptr){}
+
+		bool setUp() override{
+			world = new BulletWorld();
+			layout = new VerticalLinearLayout(world);
+			for(unsigned long int i = 0; i < 200; ++i){
+				NodeUI * n = new NodeUI(world);
+				n->setPixelWidth(100);
+				n->setPixelHeight(10);
+				layout->addChild(n, false);
+			}
+			layout->invalidateLayout();
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			NodeUI * n = dynamic_cast<NodeUI *>(dynamic_cast<Transform *>(layout->uiElements->children.at(_step->cycles % 200))->children.at(0));
+			n->setPixelHeight(_step->cycles % 2 == 0 ? 20.f : 10.f);
+			layout->invalidateLayout();
+			layout->update(_step);
+		}
+
+		void tearDown() override{
+			metrics["elements"] = 200;
+			delete layout;
+			delete world;
+		}
+	};
+
+	// updates a UI layer full of mouse-enabled elements, which hit tests all of them every frame
+	class UIHitTestBenchmark : public sweet::Benchmark{
+	public:
+		UILayer * layer;
+
+		UIHitTestBenchmark() : Benchmark("ui/hittest", 300), layer(nullptr){}
+
+		bool setUp() override{
+			layer = new UILayer(0, 1920, 0, 1080);
+			VerticalLinearLayout * layout = new VerticalLinearLayout(layer->world);
+			layout->setRationalWidth(1.f, layer);
+			layout->setRationalHeight(1.f, layer);
+			for(unsigned long int i = 0; i < 200; ++i){
+				NodeUI * n = new NodeUI(layer->world, kENTITIES, true);
+				n->setPixelWidth(100);
+				n->setPixelHeight(5);
+				layout->addChild(n, false);
+			}
+			layer->addChild(layout);
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			layer->update(_step);
+		}
+
+		void tearDown() override{
+			metrics["elements"] = 200;
+			delete layer;
+		}
+	};
+
+	// a stack of boxes settling on a ground plane
+	class BulletBenchmark : public sweet::Benchmark{
+	public:
+		BulletWorld * world;
+		btCollisionShape * ground;
+		btCollisionShape * box;
+		std::vector<btRigidBody *> bodies;
+
+		BulletBenchmark() : Benchmark("physics/bullet", 300), world(nullptr), ground(nullptr), box(nullptr){}
+
+		btRigidBody * addBody(btCollisionShape * _shape, float _mass, btVector3 _pos){
+			btVector3 inertia(0, 0, 0);
+			if(_mass > 0){
+				_shape->calculateLocalInertia(_mass, inertia);
+			}
+			btTransform t;
+			t.setIdentity();
+			t.setOrigin(_pos);
+			btRigidBody * b = new btRigidBody(_mass, new btDefaultMotionState(t), _shape, inertia);
+			world->world->addRigidBody(b);
+			bodies.push_back(b);
+			return b;
+		}
+
+		bool setUp() override{
+			world = new BulletWorld();
+			ground = new btStaticPlaneShape(btVector3(0, 1, 0), 0);
+			box = new btBoxShape(btVector3(0.5f, 0.5f, 0.5f));
+			addBody(ground, 0, btVector3(0, 0, 0));
+			for(unsigned long int i = 0; i < 500; ++i){
+				addBody(box, 1, btVector3((float)(i % 10) * 1.1f, 0.5f + (float)(i / 100) * 1.1f, (float)(i / 10 % 10) * 1.1f));
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			world->update(_step);
+		}
+
+		void tearDown() override{
+			metrics["bodies"] = (double)bodies.size();
+			for(btRigidBody * b : bodies){
+				world->world->removeRigidBody(b);
+				delete b->getMotionState();
+				delete b;
+			}
+			bodies.clear();
+			delete box;
+			delete ground;
+			delete world;
+		}
+	};
+
+	// thousands of node bodies which have settled and gone to sleep, plus a few which keep getting pushed
+	// only the bodies which actually move should cost anything to keep in sync with their nodes
+	class BulletSleepingBenchmark : public sweet::Benchmark{
+	public:
+		BulletWorld * world;
+		std::vector<NodeBulletBody *> bodies;
+
+		BulletSleepingBenchmark() : Benchmark("physics/bullet-sleeping", 300), world(nullptr){}
+
+		bool setUp() override{
+			world = new BulletWorld();
+			NodeBulletBody * ground = new NodeBulletBody(world);
+			ground->setColliderAsStaticPlane();
+			ground->createRigidBody(0);
+			bodies.push_back(ground);
+			for(unsigned long int i = 0; i < 4096; ++i){
+				NodeBulletBody * b = new NodeBulletBody(world);
+				b->setColliderAsBox();
+				b->createRigidBody(1);
+				b->translatePhysical(glm::vec3((float)(i % 64) * 1.5f, 0.5f, (float)(i / 64) * 1.5f), false);
+				bodies.push_back(b);
+			}
+
+			// let everything settle
+			Step step;
+			step.deltaTimeCorrection = 1.0;
+			step.setDeltaTime(1.0 / 60.0);
+			for(unsigned long int i = 0; i < 240; ++i){
+				world->update(&step);
+				for(NodeBulletBody * b : bodies){
+					b->update(&step);
+				}
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			// wake up 1% of the bodies
+			for(unsigned long int i = 1; i < bodies.size(); i += 100){
+				bodies[i]->applyLinearImpulseToCenter(glm::vec3(0, 0.1f, 0));
+			}
+			world->update(_step);
+			for(NodeBulletBody * b : bodies){
+				b->update(_step);
+			}
+		}
+
+		void tearDown() override{
+			metrics["bodies"] = (double)bodies.size();
+			for(NodeBulletBody * b : bodies){
+				btRigidBody * rb = b->body;
+				// the shape is released by the body
+				delete b;
+				delete rb;
+			}
+			bodies.clear();
+			delete world;
+		}
+	};
+
+	// a bumpy grid of (_size * _size * 2) triangles, as a stand-in for a level mesh
+	TriMesh * makeColliderGrid(unsigned long int _size){
+		TriMesh * mesh = new TriMesh(true);
+		for(unsigned long int z = 0; z <= _size; ++z){
+			for(unsigned long int x = 0; x <= _size; ++x){
+				mesh->pushVert(Vertex((float)x, sin(x * 0.3f) * cos(z * 0.2f), (float)z));
+			}
+		}
+		for(unsigned long int z = 0; z < _size; ++z){
+			for(unsigned long int x = 0; x < _size; ++x){
+				GLuint i = z * (_size + 1) + x;
+				mesh->pushTri(i, i + _size + 1, i + 1);
+				mesh->pushTri(i + 1, i + _size + 1, i + _size + 2);
+			}
+		}
+		return mesh;
+	}
+
+	// gives a crowd of bodies ragdoll-sized boxes and copies of one concave mesh, with and without the shape cache sharing them
+	class ShapeCacheBenchmark : public sweet::Benchmark{
+	public:
+		bool share;
+		TriMesh * mesh;
+		std::vector<NodeBulletBody *> bodies;
+
+		ShapeCacheBenchmark(bool _share) : Benchmark(_share ? "physics/shapes-shared" : "physics/shapes-unshared", 60), share(_share), mesh(nullptr){}
+
+		bool setUp() override{
+			mesh = makeColliderGrid(32);
+			mesh->incrementReferenceCount();
+			sweet::CollisionShapeCache::getInstance().enabled = share;
+			sweet::CollisionShapeCache::getInstance().resetStats();
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			for(unsigned long int i = 0; i < 4; ++i){
+				NodeBulletBody * b = new NodeBulletBody(nullptr);
+				b->setColliderAsMesh(mesh, false);
+				bodies.push_back(b);
+			}
+			for(unsigned long int i = 0; i < 44; ++i){
+				NodeBulletBody * b = new NodeBulletBody(nullptr);
+				b->setColliderAsBox(1.f + i % 4, 3.f, 1.f);
+				bodies.push_back(b);
+			}
+		}
+
+		void tearDown() override{
+			const sweet::CollisionShapeCache::Stats & stats = sweet::CollisionShapeCache::getInstance().getStats();
+			metrics["items per frame"] = 48;
+			metrics["shapes"] = stats.shapes;
+			metrics["KB"] = stats.bytes / 1024.0;
+			metrics["KB saved"] = (stats.unsharedBytes - stats.bytes) / 1024.0;
+			metrics["BVH builds"] = stats.bvhBuilds;
+			metrics["ms creating shapes"] = stats.seconds * 1000;
+			metrics["ms saved"] = stats.secondsSaved * 1000;
+			for(NodeBulletBody * b : bodies){
+				delete b;
+			}
+			bodies.clear();
+			mesh->decrementAndDelete();
+			sweet::CollisionShapeCache::getInstance().enabled = true;
+		}
+	};
+
+	// creates and releases a large concave collider each frame, building its BVH or loading it from a file
+	class BvhLoadBenchmark : public sweet::Benchmark{
+	public:
+		bool load;
+		TriMesh * mesh;
+
+		BvhLoadBenchmark(bool _load) : Benchmark(_load ? "physics/bvh-load" : "physics/bvh-build", 60), load(_load), mesh(nullptr){}
+
+		bool setUp() override{
+			mesh = makeColliderGrid(128);
+			mesh->incrementReferenceCount();
+			sweet::CollisionShapeCache & cache = sweet::CollisionShapeCache::getInstance();
+			cache.resetStats();
+			if(load){
+				sweet::FileUtils::createDirectoryIfNotExists("benchmark_bvhs");
+				cache.bvhDirectory = "benchmark_bvhs";
+				// build it once so that there's something to load
+				cache.release(cache.getMesh(mesh, false));
+				return cache.getStats().bvhSaves == 1;
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			sweet::CollisionShapeCache & cache = sweet::CollisionShapeCache::getInstance();
+			cache.release(cache.getMesh(mesh, false));
+		}
+
+		void tearDown() override{
+			sweet::CollisionShapeCache & cache = sweet::CollisionShapeCache::getInstance();
+			metrics["triangles"] = (double)mesh->indices.size() / 3;
+			metrics["BVH loads"] = cache.getStats().bvhLoads;
+			metrics["ms saved"] = cache.getStats().secondsSaved * 1000;
+			if(load){
+				std::remove(cache.getBvhFilename(mesh).c_str());
+				cache.bvhDirectory = "";
+			}
+			mesh->decrementAndDelete();
+		}
+	};
+
+	class Box2DBenchmark : public sweet::Benchmark{
+	public:
+		Box2DWorld * world;
+
+		Box2DBenchmark() : Benchmark("physics/box2d", 300), world(nullptr){}
+
+		bool setUp() override{
+			world = new Box2DWorld();
+			b2BodyDef groundDef;
+			b2Body * ground = world->b2world->CreateBody(&groundDef);
+			b2EdgeShape edge;
+			edge.Set(b2Vec2(-100, 0), b2Vec2(100, 0));
+			ground->CreateFixture(&edge, 0);
+
+			b2PolygonShape box;
+			box.SetAsBox(0.5f, 0.5f);
+			for(unsigned long int i = 0; i < 500; ++i){
+				b2BodyDef def;
+				def.type = b2_dynamicBody;
+				def.position.Set((float)(i % 20) * 1.1f - 11.f, 0.5f + (float)(i / 20) * 1.1f);
+				world->b2world->CreateBody(&def)->CreateFixture(&box, 1.f);
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			world->update(_step);
+		}
+
+		void tearDown() override{
+			metrics["bodies"] = 500;
+			delete world;
+		}
+	};
+
+	// expands nested phrases, either through the compiled templates or the original regex path
+	class PhraseBenchmark : public sweet::Benchmark, public PhraseGenerator{
+	public:
+		bool useRegex;
+
+		PhraseBenchmark(bool _useRegex) : Benchmark(_useRegex ? "text/phrases-regex" : "text/phrases", 300), useRegex(_useRegex){}
+
+		bool setUp() override{
+			terms.clear();
+			clearTemplates();
+			terms["sentence"].push("That's a *adjective* *noun*.");
+			terms["sentence"].push("You should *verb* with the *adjective* *noun*!");
+			terms["sentence"].push("Never *verb* near a *noun* that looks *adjective*.");
+			terms["adjective"].push("bad");
+			terms["adjective"].push("good");
+			terms["adjective"].push("*adverb* strange");
+			terms["adverb"].push("very");
+			terms["adverb"].push("somewhat");
+			terms["noun"].push("dog");
+			terms["noun"].push("cat");
+			terms["noun"].push("*adjective* lamp");
+			terms["verb"].push("run");
+			terms["verb"].push("walk");
+			terms["verb"].push("dance");
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			for(unsigned long int i = 0; i < 100; ++i){
+				if(useRegex){
+					replaceWordsRegex("*sentence* *sentence*");
+				}else{
+					replaceWords("*sentence* *sentence*");
+				}
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = 100;
+		}
+	};
+
+	// reads a few hundred small files, either loose or from an archive (opened fresh each frame)
+	// NOTE: this only measures a warm OS file cache; for true cold-start numbers, flush the cache between runs
+	class AssetLoadBenchmark : public sweet::Benchmark{
+	public:
+		bool useArchive;
+		std::vector<std::string> files;
+
+		AssetLoadBenchmark(bool _useArchive) : Benchmark(_useArchive ? "assets/archive" : "assets/loose", 60), useArchive(_useArchive){}
+
+		bool setUp() override{
+			sweet::FileUtils::createDirectoryIfNotExists("benchmark_assets");
+			sweet::AssetArchive::Builder builder;
+			for(unsigned long int i = 0; i < 200; ++i){
+				std::stringstream ss;
+				ss << "benchmark_assets/" << i << ".txt";
+				std::ofstream file(ss.str(), std::ios::out | std::ios::binary);
+				for(unsigned long int j = 0; j < 256; ++j){
+					file << "asset " << i << " line " << j << "\n";
+				}
+				files.push_back(ss.str());
+				builder.add("benchmark", ss.str(), ss.str());
+			}
+			return builder.write("benchmark_assets.pack");
+		}
+
+		void frame(Step * _step) override{
+			if(useArchive){
+				sweet::AssetArchive archive("benchmark_assets.pack");
+				std::string buffer;
+				for(const std::string & f : files){
+					archive.getData(archive.findFile(f), buffer);
+				}
+			}else{
+				for(const std::string & f : files){
+					std::ifstream file(f, std::ios::in | std::ios::binary);
+					std::stringstream contents;
+					contents << file.rdbuf();
+				}
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = (double)files.size();
+			for(const std::string & f : files){
+				std::remove(f.c_str());
+			}
+			files.clear();
+			std::remove("benchmark_assets.pack");
+		}
+	};
+
+	// compares the events' tags and data, ignoring the "scenario" string (which is the scenario's filename)
+	bool sameEvent(const sweet::Event * _a, const sweet::Event * _b){
+		std::map<std::string, std::string> stringsA = _a->getAllStringData(), stringsB = _b->getAllStringData();
+		stringsA.erase("scenario");
+		stringsB.erase("scenario");
+		return _a->tag == _b->tag
+			&& _a->getAllIntData() == _b->getAllIntData()
+			&& _a->getAllFloatData() == _b->getAllFloatData()
+			&& stringsA == stringsB;
+	}
+
+	// returns a description of the first difference between the roots, conversations, options, links, triggers, and condition results of _a and _b,
+	// or an empty string if there isn't one
+	std::string compareScenarios(Scenario * _a, Scenario * _b){
+		if(_a->root != _b->root){
+			return "root";
+		}
+		const std::map<std::string, Asset *> & convosA = _a->assets["conversation"];
+		const std::map<std::string, Asset *> & convosB = _b->assets["conversation"];
+		if(convosA.size() != convosB.size()){
+			return "conversation count";
+		}
+		for(auto itA = convosA.begin(), itB = convosB.begin(); itA != convosA.end(); ++itA, ++itB){
+			Conversation * a = static_cast<AssetConversation *>(itA->second)->conversation;
+			Conversation * b = static_cast<AssetConversation *>(itB->second)->conversation;
+			if(itA->first != itB->first || a->id != b->id){
+				return "conversation " + itA->first;
+			}
+			if(a->options.size() != b->options.size()){
+				return "option count in " + a->id;
+			}
+			for(unsigned long int i = 0; i < a->options.size(); ++i){
+				Option * oA = a->options.at(i);
+				Option * oB = b->options.at(i);
+				if(oA->text != oB->text || oA->link != oB->link
+					|| (oA->linkedConversation == nullptr) != (oB->linkedConversation == nullptr)
+					|| (oA->linkedConversation != nullptr && oA->linkedConversation->id != oB->linkedConversation->id)){
+					return "option \"" + oA->text + "\" in " + a->id;
+				}
+			}
+			if(a->dialogueObjects.size() != b->dialogueObjects.size()){
+				return "dialogue count in " + a->id;
+			}
+			for(unsigned long int i = 0; i < a->dialogueObjects.size(); ++i){
+				Dialogue * dA = a->dialogueObjects.at(i);
+				Dialogue * dB = b->dialogueObjects.at(i);
+				if(dA->speaker != dB->speaker || dA->text != dB->text
+					|| dA->triggers.size() != dB->triggers.size() || dA->conditions.size() != dB->conditions.size()){
+					return "dialogue in " + a->id;
+				}
+				for(unsigned long int j = 0; j < dA->triggers.size(); ++j){
+					if(!sameEvent(dA->triggers.at(j), dB->triggers.at(j))){
+						return "trigger " + dA->triggers.at(j)->tag + " in " + a->id;
+					}
+				}
+				for(unsigned long int j = 0; j < dA->conditions.size(); ++j){
+					Condition * cA = dA->conditions.at(j);
+					Condition * cB = dB->conditions.at(j);
+					if(!sameEvent(cA->event, cB->event) || cA->evaluate() != cB->evaluate()){
+						return "condition " + cA->event->tag + " in " + a->id;
+					}
+				}
+				if(dA->evaluateConditions() != dB->evaluateConditions()){
+					return "condition results in " + a->id;
+				}
+			}
+		}
+		return "";
+	}
+
+	// loads a small scenario either from its json or compiled with ScenarioBinary
+	// setUp loads both versions and fails the benchmark unless they have the same root, conversations, links, triggers, and condition results
+	class ScenarioLoadBenchmark : public sweet::Benchmark{
+	public:
+		bool compiled;
+		ConditionImplementations fallbackConditions;
+
+		ScenarioLoadBenchmark(bool _compiled) : Benchmark(_compiled ? "scenario/binary" : "scenario/json", 100), compiled(_compiled){
+			// only reachable through the fallback map, so that both dispatch paths are compared
+			fallbackConditions["isNamed"] = [](sweet::Event * _event){
+				return _event->getStringData("name") == "sweet";
+			};
+		}
+
+		Scenario * load(const std::string & _src){
+			Scenario * res = new Scenario(_src);
+			res->conditionImplementations = &fallbackConditions;
+			res->registerCondition("hasItem", [](sweet::Event * _event){
+				return _event->getStringData("item") == "key" && _event->getIntData("count") >= 2;
+			});
+			res->registerCondition("above", [](sweet::Event * _event){
+				return _event->getFloatData("value") > 0.5f;
+			});
+			return res;
+		}
+
+		bool setUp() override{
+			std::ofstream file("benchmark_scenario.json", std::ios::out | std::ios::binary);
+			file << "{\"name\":\"benchmark\",\"version\":2,\"assets\":[";
+			for(unsigned long int i = 0; i < 64; ++i){
+				file << (i > 0 ? "," : "")
+					<< "{\"id\":\"c" << i << "\",\"type\":\"conversation\",\"dialogue\":["
+						<< "{\"speaker\":\"s" << i % 4 << "\",\"text\":[\"line " << i << "\",\"line " << i << " again\"],"
+						<< "\"triggers\":[{\"type\":\"setVariable\",\"args\":{\"count\":{\"type\":\"int\",\"value\":" << i << "},\"scale\":{\"type\":\"float\",\"value\":" << i * 0.25f << "}}}],"
+						<< "\"conditions\":["
+							<< "{\"type\":\"hasItem\",\"args\":{\"item\":{\"type\":\"string\",\"value\":\"" << (i % 3 == 0 ? "key" : "map") << "\"},\"count\":{\"type\":\"int\",\"value\":" << i % 4 << "}}},"
+							<< "{\"type\":\"above\",\"args\":{\"value\":{\"value\":" << (i % 10) * 0.1f << "}}},"
+							<< "{\"type\":\"isNamed\",\"args\":{\"name\":{\"type\":\"string\",\"value\":\"" << (i % 2 == 0 ? "sweet" : "sour") << "\"}}}"
+						<< "]},"
+						<< "{\"speaker\":\"narrator\",\"text\":[\"the end of " << i << "\"]}"
+					<< "],\"options\":["
+						<< "{\"label\":\"next\",\"convoId\":\"c" << (i + 1) % 64 << "\"},"
+						<< "{\"label\":\"back\",\"convoId\":\"c" << (i + 63) % 64 << "\"},"
+						<< "{\"label\":\"quit\",\"convoId\":\"END\"}"
+					<< "]}";
+			}
+			file << "]}";
+			file.close();
+
+			if(!ScenarioBinary::compileFile("benchmark_scenario.json", "benchmark_scenario.bin")){
+				fail("couldn't compile the scenario");
+				return false;
+			}
+			Scenario * json = load("benchmark_scenario.json");
+			Scenario * binary = load("benchmark_scenario.bin");
+			std::string difference = compareScenarios(json, binary);
+			delete json;
+			delete binary;
+			if(difference != ""){
+				fail("compiled scenario doesn't match its json: " + difference);
+				return false;
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			delete load(compiled ? "benchmark_scenario.bin" : "benchmark_scenario.json");
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = 64;
+			std::remove("benchmark_scenario.json");
+			std::remove("benchmark_scenario.bin");
+		}
+	};
+
+	// composes riffs (no instrument, so nothing is played)
+	class AudioBenchmark : public sweet::Benchmark{
+	public:
+		AutoRiff * riff;
+
+		AudioBenchmark() : Benchmark("audio/autoriff", 300), riff(nullptr){}
+
+		bool setUp() override{
+			riff = new AutoRiff(nullptr);
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			for(unsigned long int i = 0; i < 10; ++i){
+				riff->generate();
+			}
+		}
+
+		void tearDown() override{
+			metrics["riffs per frame"] = 10;
+			delete riff;
+		}
+	};
+
+	// plays a sprite sheet animation on lots of sprites and cleans their meshes like a render would
+	// with shared frames, changing frames shouldn't cause any buffer uploads
+	class SpriteAnimationBenchmark : public sweet::Benchmark{
+	public:
+		bool sharedFrames;
+		SpriteSheet * sheet;
+		std::vector<Sprite *> sprites;
+
+		SpriteAnimationBenchmark(bool _sharedFrames) : Benchmark(_sharedFrames ? "sprites/shared-frames" : "sprites/animated", 300), sharedFrames(_sharedFrames), sheet(nullptr){}
+
+		bool setUp() override{
+			ProgrammaticTexture * texture = new ProgrammaticTexture();
+			texture->allocate(256, 32);
+			sheet = new SpriteSheet(texture);
+			sheet->addAnimation("run", 0, 7, 32, 32, 1.f / 30.f);
+			for(unsigned long int i = 0; i < 512; ++i){
+				Sprite * s = new Sprite();
+				s->sharedFrames = sharedFrames;
+				s->setSpriteSheet(sheet, "run");
+				s->mesh->clean();
+				sprites.push_back(s);
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			for(Sprite * s : sprites){
+				s->update(_step);
+				s->mesh->clean();
+			}
+		}
+
+		void tearDown() override{
+			metrics["sprites"] = (double)sprites.size();
+			for(Sprite * s : sprites){
+				delete s;
+			}
+			sprites.clear();
+			delete sheet;
+		}
+	};
+
+	// draws lots of tinted sprites, each showing a different part of their texture
+	// with a shared mesh, every sprite draws the same vertex buffer and the differences are only per-draw uniforms
+	class SpriteMeshBenchmark : public sweet::Benchmark{
+	public:
+		bool sharedMesh;
+		ComponentShaderBase * shader;
+		ProgrammaticTexture * texture;
+		Transform * root;
+
+		SpriteMeshBenchmark(bool _sharedMesh) : Benchmark(_sharedMesh ? "sprites/shared-mesh" : "sprites/private-meshes", 60), sharedMesh(_sharedMesh), shader(nullptr), texture(nullptr), root(nullptr){}
+
+		bool setUp() override{
+			shader = new ComponentShaderBase(false);
+			shader->addComponent(new ShaderComponentMVP(shader));
+			shader->addComponent(new ShaderComponentSpriteSheet(shader));
+			shader->addComponent(new ShaderComponentDrawColour(shader));
+			shader->compileShader();
+			texture = new ProgrammaticTexture();
+			texture->allocate(256, 256);
+			texture->incrementReferenceCount();
+			root = new Transform();
+			for(unsigned long int i = 0; i < 10000; ++i){
+				Sprite * s = new Sprite(texture, shader, sharedMesh);
+				s->setUvs(sweet::Rectangle((i % 8) / 8.f, ((i / 8) % 8) / 8.f, 1 / 8.f, 1 / 8.f));
+				s->drawData.colour = glm::vec4((i % 3) / 2.f, (i % 5) / 4.f, (i % 7) / 6.f, 1.f);
+				root->addChild(s)->translate((float)(i % 100), (float)(i / 100), 0.f);
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			root->update(_step);
+			sweet::MatrixStack ms;
+			RenderOptions ro(shader, nullptr);
+			root->render(&ms, &ro);
+		}
+
+		void tearDown() override{
+			std::set<MeshInterface *> meshes;
+			for(NodeChild * c : root->children){
+				Sprite * s = dynamic_cast<Sprite *>(dynamic_cast<Transform *>(c)->children.at(0));
+				meshes.insert(s->mesh);
+			}
+			metrics["sprites"] = (double)root->children.size();
+			metrics["meshes"] = (double)meshes.size();
+			delete root;
+			MeshFactory::releaseUnusedSharedMeshes();
+			texture->decrementAndDelete();
+			delete shader;
+		}
+	};
+
+	// draws random ints in [0, 99], the way particles and procedural generation do
+	class RandomBenchmark : public sweet::Benchmark{
+	public:
+		typedef enum{
+			// the old global generator, ranged with a modulo
+			kKNUTH,
+			// sweet::NumberUtils::randomInt
+			kNUMBER_UTILS,
+			// a sweet::Random, one call per number
+			kSTREAM,
+			// a sweet::Random, filling an array
+			kFILL
+		} Mode;
+
+		Mode mode;
+		sweet::Random random;
+		std::vector<int> values;
+		double sum;
+
+		static std::string getName(Mode _mode){
+			switch(_mode){
+				case kKNUTH: return "random/knuth";
+				case kNUMBER_UTILS: return "random/numberutils";
+				case kSTREAM: return "random/stream";
+				default: return "random/fill";
+			}
+		}
+
+		RandomBenchmark(Mode _mode) : Benchmark(getName(_mode), 100), mode(_mode), random(1), values(100000), sum(0){}
+
+		bool setUp() override{
+			knuth::ran_start(1);
+			sweet::NumberUtils::seed(1);
+			random.seed(1);
+			sum = 0;
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			switch(mode){
+				case kKNUTH:
+					for(unsigned long int i = 0; i < values.size(); ++i){
+						values[i] = knuth::ran_arr_cycle() % 100;
+					}
+					break;
+				case kNUMBER_UTILS:
+					for(unsigned long int i = 0; i < values.size(); ++i){
+						values[i] = sweet::NumberUtils::randomInt(0, 99);
+					}
+					break;
+				case kSTREAM:
+					for(unsigned long int i = 0; i < values.size(); ++i){
+						values[i] = random.nextInt(0, 99);
+					}
+					break;
+				case kFILL:
+					random.fill(&values[0], values.size(), 0, 99);
+					break;
+			}
+			sum += values[values.size() / 2];
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = (double)values.size();
+			// keeps the results from being optimized away
+			metrics["checksum"] = sum;
+		}
+	};
+
+	// replica of the map-based key state Keyboard used before it switched to bitsets
+	class MapKeyboard{
+	public:
+		std::map<int, int> pressedKeys;
+		std::map<int, int> justPressedKeys;
+		std::map<int, int> justReleasedKeys;
+
+		bool keyDown(int _code) const{
+			return justPressedKeys.find(_code) != justPressedKeys.end() || pressedKeys.find(_code) != pressedKeys.end();
+		}
+		bool keyJustDown(int _code) const{
+			return justPressedKeys.find(_code) != justPressedKeys.end();
+		}
+		bool keyJustUp(int _code) const{
+			return justReleasedKeys.find(_code) != justReleasedKeys.end();
+		}
+		void keyDownListener(int _code){
+			justPressedKeys.insert(std::make_pair(_code, _code));
+			pressedKeys.insert(std::make_pair(_code, _code));
+		}
+		void keyUpListener(int _code){
+			justReleasedKeys.insert(std::make_pair(_code, _code));
+			pressedKeys.erase(_code);
+			justPressedKeys.erase(_code);
+		}
+		void update(Step * _step){
+			justPressedKeys.clear();
+			justReleasedKeys.clear();
+		}
+	};
+
+	// a frame's worth of key events followed by the kind of polling a game does every frame
+	template<typename KeyboardType>
+	class InputLookupBenchmark : public sweet::Benchmark{
+	public:
+		KeyboardType & keyboard;
+		std::vector<int> codes;
+		unsigned long int tick;
+		double hits;
+
+		InputLookupBenchmark(std::string _name, KeyboardType & _keyboard) : Benchmark(_name, 300), keyboard(_keyboard), codes(10000), tick(0), hits(0){}
+
+		bool setUp() override{
+			sweet::Random random(1);
+			random.fill(&codes[0], codes.size(), GLFW_KEY_SPACE, GLFW_KEY_LAST);
+			tick = 0;
+			hits = 0;
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			// hold down a rolling window of keys
+			++tick;
+			keyboard.keyUpListener(codes[tick % 64]);
+			keyboard.keyDownListener(codes[(tick + 16) % 64]);
+			for(unsigned long int i = 0; i < codes.size(); ++i){
+				int code = codes[i];
+				hits += keyboard.keyDown(code) + keyboard.keyJustDown(code) + keyboard.keyJustUp(code);
+			}
+			keyboard.update(nullptr);
+		}
+
+		void tearDown() override{
+			for(unsigned long int i = 0; i < 64; ++i){
+				keyboard.keyUpListener(codes[i]);
+			}
+			keyboard.update(nullptr);
+			metrics["items per frame"] = (double)codes.size() * 3;
+			// keeps the results from being optimized away
+			metrics["checksum"] = hits;
+		}
+	};
+
+	// returns _frames frames of the accelerometer protocol for _sensors sensors, with a line break after each
+	std::string makeAccelerometerStream(unsigned long int _frames, unsigned long int _sensors){
+		sweet::Random random(1);
+		std::string res;
+		char field[8];
+		for(unsigned long int i = 0; i < _frames; ++i){
+			res += ':';
+			for(unsigned long int j = 0; j < _sensors * 3; ++j){
+				sprintf(field, "%3d", random.nextInt(130, 530));
+				res += field;
+			}
+			res += "\r\n";
+		}
+		return res;
+	}
+
+	// checks _parser's latest values against the last frame of _stream, decoded the way the old parser did (atoi on each field)
+	void checkLatestFrame(sweet::Benchmark & _benchmark, const sweet::AccelerometerFrameParser & _parser, const std::string & _stream){
+		const unsigned long int width = sweet::AccelerometerFrameParser::FIELD_WIDTH;
+		const unsigned long int axes = sweet::AccelerometerFrameParser::AXES;
+		const unsigned long int fields = _parser.getSensorCount() * axes;
+		std::string src = _stream.substr(_stream.find_last_of(':') + 1, fields * width);
+		if(src.size() < fields * width){
+			_benchmark.fail("the last frame of the stream is incomplete");
+			return;
+		}
+		for(unsigned long int i = 0; i < fields; ++i){
+			int expected = atoi(src.substr(i * width, width).c_str());
+			int actual = _parser.getValue(i / axes, i % axes);
+			if(actual != expected){
+				std::stringstream ss;
+				ss << "sensor " << i / axes << " axis " << i % axes << " decoded as " << actual << " instead of " << expected;
+				_benchmark.fail(ss.str());
+			}
+		}
+	}
+
+	// known frames for two sensors, with the values of the latest complete frame and the number of complete and dropped frames
+	struct AccelerometerCase{
+		const char * data;
+		int values[6];
+		unsigned long int frames;
+		unsigned long int dropped;
+	};
+
+	// feeds each case to a new parser, in one piece and then a byte at a time, and checks what it decodes
+	void checkAccelerometerCases(sweet::Benchmark & _benchmark){
+		const AccelerometerCase cases[] = {
+			// leading spaces and signs
+			{ ":130200530  1 -2+34\r\n", { 130, 200, 530, 1, -2, 34 }, 1, 0 },
+			// bytes before the first ':' are ignored, and a frame cut short by a ':' is dropped
+			{ "noise:1 2 3 :  7  8  9 10 11 12\r\n", { 7, 8, 9, 10, 11, 12 }, 1, 1 },
+			// only the latest frame is kept, and a field stops at its first non-digit
+			{ ":  1  2  3  4  5  6\r\n:-99 x9  0999999-0 \r\n", { -99, 0, 0, 999, 999, 0 }, 2, 0 }
+		};
+		for(unsigned long int c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c){
+			const AccelerometerCase & test = cases[c];
+			const unsigned long int size = strlen(test.data);
+			for(unsigned long int bytewise = 0; bytewise < 2; ++bytewise){
+				sweet::AccelerometerFrameParser parser(2);
+				unsigned long int frames = 0;
+				if(bytewise){
+					for(unsigned long int i = 0; i < size; ++i){
+						frames += parser.parse(test.data + i, 1);
+					}
+				}else{
+					frames = parser.parse(test.data, size);
+				}
+
+				std::stringstream ss;
+				ss << "accelerometer case " << c << (bytewise ? " (a byte at a time)" : "") << ": ";
+				if(frames != test.frames || parser.getFrameCount() != test.frames || parser.getDroppedCount() != test.dropped){
+					_benchmark.fail(ss.str() + "wrong number of complete or dropped frames");
+				}
+				for(unsigned long int i = 0; i < 6; ++i){
+					if(parser.getValue(i / 3, i % 3) != test.values[i]){
+						std::stringstream vs;
+						vs << "sensor " << i / 3 << " axis " << i % 3 << " decoded as " << parser.getValue(i / 3, i % 3) << " instead of " << test.values[i];
+						_benchmark.fail(ss.str() + vs.str());
+					}
+				}
+			}
+		}
+	}
+
+	// parses a stream of accelerometer frames arriving in small chunks
+	// the legacy mode replicates the old AccelerometerParser: accumulate into a string, search back for the latest frame, and copy each field out for atoi
+	class AccelerometerParseBenchmark : public sweet::Benchmark{
+	public:
+		bool legacy;
+		std::string stream;
+		std::string accumulator;
+		sweet::AccelerometerFrameParser parser;
+		double sum;
+
+		AccelerometerParseBenchmark(bool _legacy) :
+			Benchmark(_legacy ? "serial/parse-string" : "serial/parse-frame", 300),
+			legacy(_legacy),
+			sum(0)
+		{
+		}
+
+		bool setUp() override{
+			stream = makeAccelerometerStream(1000, 4);
+			sum = 0;
+			if(!legacy){
+				checkAccelerometerCases(*this);
+			}
+			return true;
+		}
+
+		std::string getLatestData(const std::string & _acc){
+			bool firstPassed = false;
+			for(signed long int i = _acc.size() - 1; i >= 0; --i) {
+				if(_acc.at(i) == ':') {
+					if(!firstPassed){
+						firstPassed = true;
+					}else if(_acc.size() - i >= 37) {
+						return _acc.substr(i + 1, 36);
+					}
+				}
+			}
+			return "";
+		}
+
+		void frame(Step * _step) override{
+			// the size of a read at a few hundred frames per second
+			const unsigned long int chunk = 96;
+			for(unsigned long int offset = 0; offset < stream.size(); offset += chunk){
+				unsigned long int n = std::min(chunk, (unsigned long int)stream.size() - offset);
+				if(legacy){
+					accumulator += stream.substr(offset, n);
+					std::string src = getLatestData(accumulator);
+					if(src.size() >= 36){
+						accumulator.clear();
+						for(unsigned long int i = 0; i < 4; ++i){
+							char x[4] = { src[i * 9], src[i * 9 + 1], src[i * 9 + 2], '\0' };
+							char y[4] = { src[i * 9 + 3], src[i * 9 + 4], src[i * 9 + 5], '\0' };
+							char z[4] = { src[i * 9 + 6], src[i * 9 + 7], src[i * 9 + 8], '\0' };
+							sum += atoi(x) + atoi(y) + atoi(z);
+						}
+					}
+				}else{
+					if(parser.parse(stream.data() + offset, n) > 0){
+						for(unsigned long int i = 0; i < 4; ++i){
+							sum += parser.getValue(i, 0) + parser.getValue(i, 1) + parser.getValue(i, 2);
+						}
+					}
+				}
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = (double)stream.size();
+			// keeps the results from being optimized away
+			metrics["checksum"] = sum;
+			accumulator.clear();
+			if(!legacy){
+				checkLatestFrame(*this, parser, stream);
+			}
+		}
+	};
+
+	// sends accelerometer frames through a pseudo-terminal standing in for the rig,
+	// and times how long it takes the reader thread and parser to receive them
+	// (skipped where SerialPort::openLoopback isn't available, i.e. on Windows)
+	class SerialLoopbackBenchmark : public sweet::Benchmark{
+	public:
+		sweet::SerialPort device;
+		sweet::SerialPort port;
+		sweet::SerialReader * reader;
+		sweet::AccelerometerFrameParser parser;
+		std::string stream;
+		unsigned long long int expected;
+		double timeouts;
+
+		SerialLoopbackBenchmark() : Benchmark("serial/loopback", 100), reader(nullptr), expected(0), timeouts(0){}
+
+		bool setUp() override{
+			if(!port.openLoopback(device)){
+				return false;
+			}
+			reader = new sweet::SerialReader(port);
+			reader->start();
+			// small enough to fit in the pseudo-terminal's buffer
+			stream = makeAccelerometerStream(64, 4);
+			expected = parser.getFrameCount();
+			timeouts = 0;
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			device.write(stream.data(), stream.size());
+			expected += 64;
+
+			const char * first;
+			const char * second;
+			unsigned long int firstSize, secondSize;
+			for(unsigned long int i = 0; parser.getFrameCount() < expected; ++i){
+				if(i > 100000){
+					++timeouts;
+					expected = parser.getFrameCount();
+					break;
+				}
+				unsigned long int size = reader->peek(first, firstSize, second, secondSize);
+				if(size == 0){
+					std::this_thread::yield();
+					continue;
+				}
+				parser.parse(first, firstSize);
+				parser.parse(second, secondSize);
+				reader->consume(size);
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = 64;
+			metrics["timeouts"] = timeouts;
+			if(timeouts > 0){
+				fail("frames written to the loopback device didn't all arrive");
+			}
+			checkLatestFrame(*this, parser, stream);
+			delete reader;
+			reader = nullptr;
+			port.close();
+			device.close();
+		}
+	};
+
+	// UI elements rendering themselves to textures, each with a nested pass for a child, and a window resize every 60 frames
+	// with the pool, the framebuffer creations and binds NullGL sees are checked against what the pool and FrameBufferInterface report
+	class RenderTargetBenchmark : public sweet::Benchmark{
+	public:
+		bool pooled;
+		std::vector<FrameBufferInterface *> privateTargets;
+		unsigned long int tick;
+		unsigned long int size;
+		double mismatches;
+
+		static const unsigned long int NUM_ELEMENTS = 64;
+
+		RenderTargetBenchmark(bool _pooled) :
+			Benchmark(_pooled ? "render-targets/pool" : "render-targets/private", 300),
+			pooled(_pooled),
+			tick(0),
+			size(128),
+			mismatches(0)
+		{
+		}
+
+		bool setUp() override{
+			tick = 0;
+			size = 128;
+			mismatches = 0;
+			if(pooled){
+				sweet::RenderTargetPool::getInstance().clear();
+				sweet::RenderTargetPool::getInstance().resetStats();
+			}else{
+				// each element and its child own their targets
+				for(unsigned long int i = 0; i < NUM_ELEMENTS * 2; ++i){
+					privateTargets.push_back(new FrameBufferInterface(StandardFrameBuffer::getChannels(), size, size, false));
+				}
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			if(++tick % 60 == 0){
+				size = size == 128 ? 160 : 128;
+				for(auto t : privateTargets){
+					t->resize(size, size);
+				}
+			}
+
+			const sweet::NullGL::Stats & gl = sweet::NullGL::getStats();
+			const sweet::RenderTargetPool::Stats & poolStats = sweet::RenderTargetPool::getInstance().getStats();
+			unsigned long int glBinds = gl.framebufferBinds;
+			unsigned long int glFramebuffers = gl.framebuffersCreated;
+			unsigned long int binds = FrameBufferInterface::getBindCount();
+			unsigned long int allocations = poolStats.allocations;
+
+			for(unsigned long int i = 0; i < NUM_ELEMENTS; ++i){
+				if(pooled){
+					sweet::RenderTargetPool & pool = sweet::RenderTargetPool::getInstance();
+					FrameBufferInterface * element = pool.acquire(StandardFrameBuffer::getChannels(), size, size);
+					FrameBufferInterface::pushFbo(element);
+					FrameBufferInterface * child = pool.acquire(StandardFrameBuffer::getChannels(), size / 2, size / 2);
+					FrameBufferInterface::pushFbo(child);
+					FrameBufferInterface::popFbo();
+					pool.release(child);
+					FrameBufferInterface::popFbo();
+					pool.release(element);
+				}else{
+					FrameBufferInterface::pushFbo(privateTargets.at(i * 2));
+					FrameBufferInterface::pushFbo(privateTargets.at(i * 2 + 1));
+					FrameBufferInterface::popFbo();
+					FrameBufferInterface::popFbo();
+				}
+			}
+
+			if(pooled){
+				sweet::RenderTargetPool::getInstance().endFrame();
+				// every bind reaches GL as a read and a draw bind, and every framebuffer GL creates should be one the pool allocated
+				if(gl.framebufferBinds - glBinds != (FrameBufferInterface::getBindCount() - binds) * 2 || gl.framebuffersCreated - glFramebuffers != poolStats.allocations - allocations){
+					++mismatches;
+				}
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = NUM_ELEMENTS * 2;
+			if(pooled){
+				sweet::RenderTargetPool & pool = sweet::RenderTargetPool::getInstance();
+				const sweet::RenderTargetPool::Stats & s = pool.getStats();
+				metrics["pool reuse rate"] = s.getReuseRate();
+				metrics["pool allocations"] = s.allocations + s.renderBufferAllocations;
+				metrics["pool peak bytes"] = s.peakBytes;
+				metrics["count mismatches"] = mismatches;
+				if(mismatches > 0){
+					std::stringstream ss;
+					ss << "render target pool counts didn't match the GL calls on " << mismatches << " frames";
+					fail(ss.str());
+				}
+				pool.clear();
+			}else{
+				unsigned long int bytes = 0;
+				for(auto t : privateTargets){
+					bytes += t->getByteSize();
+					delete t;
+				}
+				privateTargets.clear();
+				metrics["peak bytes"] = bytes;
+			}
+		}
+	};
+
+	// checks BlurKernel against a reference Gaussian for a few sigmas and radii: the radius, the discrete weights (which have to sum to 1),
+	// and the bilinear taps (which have to sum to 1 as well, with each offset between the two texels it stands in for)
+	void checkBlurKernels(sweet::Benchmark & _benchmark){
+		const float sigmas[] = { 0.f, 0.5f, 1.f, 2.5f, 3.f, 2.f, 5.f, 20.f };
+		const unsigned long int radii[] = { 0, 0, 0, 0, 0, 4, 3, 0 };
+		const double tolerance = 1e-5;
+		for(unsigned long int k = 0; k < sizeof(sigmas) / sizeof(sigmas[0]); ++k){
+			sweet::BlurKernel kernel(sigmas[k], radii[k]);
+			std::stringstream name;
+			name << "blur kernel (sigma " << sigmas[k] << ", radius " << radii[k] << "): ";
+
+			unsigned long int radius = 0;
+			if(sigmas[k] > 0){
+				radius = std::min(radii[k] > 0 ? radii[k] : (unsigned long int)std::ceil(sigmas[k] * 3.f), (sweet::BlurKernel::MAX_TAPS - 1) * 2);
+			}
+			if(kernel.getRadius() != radius){
+				_benchmark.fail(name.str() + "wrong radius");
+				continue;
+			}
+
+			// the reference, in double precision
+			std::vector<double> reference(radius + 1);
+			double total = 0;
+			for(unsigned long int i = 0; i <= radius; ++i){
+				reference.at(i) = radius == 0 ? 1. : std::exp(-(double)(i * i) / (2. * sigmas[k] * sigmas[k]));
+				total += i == 0 ? reference.at(i) : reference.at(i) * 2.;
+			}
+			double sum = 0;
+			for(unsigned long int i = 0; i <= radius; ++i){
+				reference.at(i) /= total;
+				sum += i == 0 ? kernel.weights.at(i) : kernel.weights.at(i) * 2.;
+				if(std::abs(kernel.weights.at(i) - reference.at(i)) > tolerance){
+					_benchmark.fail(name.str() + "weights don't match the reference kernel");
+					break;
+				}
+			}
+			if(std::abs(sum - 1.) > tolerance){
+				_benchmark.fail(name.str() + "weights don't sum to 1");
+			}
+
+			if(kernel.getTapCount() != 1 + (radius + 1) / 2 || kernel.tapWeights.size() != kernel.getTapCount()){
+				_benchmark.fail(name.str() + "wrong number of taps");
+				continue;
+			}
+			double tapSum = kernel.tapWeights.at(0);
+			if(kernel.tapOffsets.at(0) != 0){
+				_benchmark.fail(name.str() + "the centre tap isn't at 0");
+			}
+			for(unsigned long int t = 1; t < kernel.getTapCount(); ++t){
+				// tap t stands in for texels i and i + 1 (or just i, at the end of an odd radius)
+				unsigned long int i = t * 2 - 1;
+				double w = reference.at(i) + (i < radius ? reference.at(i + 1) : 0.);
+				double offset = i < radius ? (i * reference.at(i) + (i + 1) * reference.at(i + 1)) / w : (double)i;
+				tapSum += kernel.tapWeights.at(t) * 2.;
+				if(std::abs(kernel.tapWeights.at(t) - w) > tolerance || std::abs(kernel.tapOffsets.at(t) - offset) > 1e-3
+					|| kernel.tapOffsets.at(t) < i || kernel.tapOffsets.at(t) > (i < radius ? i + 1 : i)){
+					_benchmark.fail(name.str() + "taps don't match the reference kernel");
+					break;
+				}
+			}
+			if(std::abs(tapSum - 1.) > tolerance){
+				_benchmark.fail(name.str() + "tap weights don't sum to 1");
+			}
+		}
+	}
+
+	class BlurBenchmark : public sweet::Benchmark{
+	public:
+		float sigma;
+		signed long int levels;
+		sweet::BlurPipeline * pipeline;
+		FrameBufferInterface * source;
+		FrameBufferInterface * target;
+		std::vector<float> image;
+		std::vector<float> result;
+
+		// the GPU passes run at the screen size, the CPU reference on a smaller image
+		static const unsigned long int WIDTH = 1280;
+		static const unsigned long int HEIGHT = 720;
+		static const unsigned long int CPU_WIDTH = 160;
+		static const unsigned long int CPU_HEIGHT = 90;
+
+		BlurBenchmark(const std::string & _name, float _sigma, signed long int _levels) :
+			Benchmark(_name, 30),
+			sigma(_sigma),
+			levels(_levels),
+			pipeline(nullptr),
+			source(nullptr),
+			target(nullptr)
+		{
+		}
+
+		bool setUp() override{
+			pipeline = new sweet::BlurPipeline(sigma, levels);
+			source = new FrameBufferInterface(sweet::BlurPipeline::getChannels(), WIDTH, HEIGHT, false);
+			target = new FrameBufferInterface(sweet::BlurPipeline::getChannels(), WIDTH, HEIGHT, false);
+			image.resize(CPU_WIDTH * CPU_HEIGHT * 4);
+			for(unsigned long int i = 0; i < image.size(); ++i){
+				image.at(i) = (float)((i * 7919) % 256) / 255.f;
+			}
+			checkBlurKernels(*this);
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			pipeline->apply(source, target);
+			pipeline->applyCpu(image, CPU_WIDTH, CPU_HEIGHT, 4, result);
+		}
+
+		void tearDown() override{
+			const sweet::BlurKernel & kernel = pipeline->getKernel();
+			unsigned long long int fetches = pipeline->getFetchCount(WIDTH, HEIGHT);
+			metrics["items per frame"] = CPU_WIDTH * CPU_HEIGHT;
+			metrics["levels"] = pipeline->getLevels();
+			metrics["taps per pass"] = kernel.getFetchesPerPass();
+			metrics["fetches per pixel"] = (double)fetches / (WIDTH * HEIGHT);
+			metrics["box fetches / fetches"] = (double)sweet::BlurPipeline::getBoxFetchCount(WIDTH, HEIGHT) / fetches;
+
+			// the bilinear taps should give the same result as the discrete kernel
+			std::vector<float> a(image.size());
+			std::vector<float> b(image.size());
+			kernel.pass(image.data(), a.data(), CPU_WIDTH, CPU_HEIGHT, 4, 1, 0);
+			kernel.discretePass(image.data(), b.data(), CPU_WIDTH, CPU_HEIGHT, 4, 1, 0);
+			double error = 0;
+			for(unsigned long int i = 0; i < a.size(); ++i){
+				error = std::max(error, (double)std::abs(a.at(i) - b.at(i)));
+			}
+			metrics["tap error"] = error;
+			if(error > 1e-4){
+				fail("blur taps don't match the discrete kernel");
+			}
+
+			delete pipeline;
+			delete source;
+			delete target;
+			pipeline = nullptr;
+			source = nullptr;
+			target = nullptr;
+			sweet::RenderTargetPool::getInstance().clear();
+		}
+	};
+
+	// rolling terrain, with a solid layer under the bottom chunks
+	unsigned char getTerrainVoxel(signed long int _x, signed long int _y, signed long int _z){
+		signed long int height = 12 + (signed long int)(6.f * std::sin(_x * 0.15f) + 6.f * std::cos(_z * 0.11f) + 3.f * std::sin((_x + _z) * 0.4f));
+		if(_y >= height){
+			return 0;
+		}
+		return _y == height - 1 ? 2 : 1;
+	}
+
+	// small layouts for checking the mesher, in a chunk of their own
+	unsigned char getSolidVoxel(unsigned long int _x, unsigned long int _y, unsigned long int _z){
+		return 1;
+	}
+	unsigned char getSingleVoxel(unsigned long int _x, unsigned long int _y, unsigned long int _z){
+		const unsigned long int c = sweet::VoxelChunk::SIZE / 2;
+		return _x == c && _y == c && _z == c ? 1 : 0;
+	}
+	// no two solid voxels share a face, so nothing can be culled or merged
+	unsigned char getCheckerboardVoxel(unsigned long int _x, unsigned long int _y, unsigned long int _z){
+		return (_x + _y + _z) % 2 == 0 ? 1 : 0;
+	}
+	// a one voxel thick floor with a single voxel standing in the middle of it, which shades the floor around it
+	unsigned char getPillarVoxel(unsigned long int _x, unsigned long int _y, unsigned long int _z){
+		const unsigned long int c = sweet::VoxelChunk::SIZE / 2;
+		return _y == 0 || (_y == 1 && _x == c && _z == c) ? 1 : 0;
+	}
+
+	class VoxelMeshBenchmark : public sweet::Benchmark{
+	public:
+		typedef enum{
+			kNAIVE,
+			kCULLED,
+			kGREEDY,
+			kGREEDY_AO
+		} Mode;
+
+		Mode mode;
+		std::vector<sweet::VoxelChunk *> chunks;
+		std::vector<sweet::VoxelMesher *> meshers;
+		std::vector<glm::vec4> palette;
+		std::vector<Vertex> vertices;
+		std::vector<GLuint> indices;
+		unsigned long int triangles;
+		unsigned long int vertexBytes;
+
+		// chunks along each axis
+		static const unsigned long int CHUNKS_X = 4;
+		static const unsigned long int CHUNKS_Y = 2;
+		static const unsigned long int CHUNKS_Z = 4;
+
+		static std::string getName(Mode _mode){
+			switch(_mode){
+				case kNAIVE: return "voxels/naive-cubes";
+				case kCULLED: return "voxels/culled";
+				case kGREEDY: return "voxels/greedy";
+				default: return "voxels/greedy-ao";
+			}
+		}
+
+		VoxelMeshBenchmark(Mode _mode) :
+			Benchmark(getName(_mode), 30),
+			mode(_mode),
+			triangles(0),
+			vertexBytes(0)
+		{
+		}
+
+		// meshes _voxel on its own with the benchmark's mode, and checks that it makes _quads quads
+		// with ambient occlusion, _shaded is whether any vertices should be darkened; without it, none should be
+		void checkLayout(const std::string & _name, unsigned char (*_voxel)(unsigned long int, unsigned long int, unsigned long int), unsigned long int _quads, bool _shaded){
+			const unsigned long int size = sweet::VoxelChunk::SIZE;
+			sweet::VoxelChunk chunk;
+			for(unsigned long int i = 0; i < size * size * size; ++i){
+				chunk.set(i % size, (i / size) % size, i / (size * size), _voxel(i % size, (i / size) % size, i / (size * size)));
+			}
+			const sweet::VoxelChunk * neighbours[27] = {};
+			neighbours[13] = &chunk;
+			sweet::VoxelMesher mesher;
+			mesher.gather(neighbours);
+
+			std::vector<Vertex> v;
+			std::vector<GLuint> i;
+			if(mode == kNAIVE){
+				mesher.meshNaive(glm::vec3(0), 1.f, palette, v, i);
+			}else{
+				mesher.mesh(glm::vec3(0), 1.f, palette, mode != kCULLED, mode == kGREEDY_AO, v, i);
+			}
+
+			if(v.size() != _quads * 4 || i.size() != _quads * 6){
+				std::stringstream ss;
+				ss << _name << ": " << v.size() / 4 << " quads instead of " << _quads;
+				fail(ss.str());
+			}
+			bool shaded = false;
+			for(const Vertex & vert : v){
+				shaded = shaded || vert.red != palette.at(1).r;
+			}
+			if(shaded != (_shaded && mode == kGREEDY_AO)){
+				fail(_name + (shaded ? ": vertices are darkened" : ": vertices aren't darkened"));
+			}
+		}
+
+		sweet::VoxelChunk * getChunk(signed long int _x, signed long int _y, signed long int _z){
+			if(_x < 0 || _y < 0 || _z < 0 || _x >= (signed long int)CHUNKS_X || _y >= (signed long int)CHUNKS_Y || _z >= (signed long int)CHUNKS_Z){
+				return nullptr;
+			}
+			return chunks.at(_x + (_y + _z * CHUNKS_Y) * CHUNKS_X);
+		}
+
+		bool setUp() override{
+			const unsigned long int size = sweet::VoxelChunk::SIZE;
+			palette.clear();
+			palette.push_back(glm::vec4(0));
+			palette.push_back(glm::vec4(0.5f, 0.4f, 0.3f, 1.f));
+			palette.push_back(glm::vec4(0.3f, 0.7f, 0.2f, 1.f));
+
+			// the naive mesher emits six quads for every solid voxel, culling keeps the faces next to empty voxels,
+			// and merging turns each flat, evenly lit area into as few rectangles as it can
+			// (the floor around the pillar is split into four rectangles, and the eight faces next to the pillar can't be merged with them
+			// when they're shaded; the pillar's sides are shaded by the floor as well)
+			const unsigned long int size = sweet::VoxelChunk::SIZE;
+			const unsigned long int solid[] = { size * size * size * 6, size * size * 6, 6, 6 };
+			const unsigned long int single[] = { 6, 6, 6, 6 };
+			const unsigned long int checkerboard[] = { size * size * size / 2 * 6, size * size * size / 2 * 6, size * size * size / 2 * 6, size * size * size / 2 * 6 };
+			const unsigned long int pillar[] = { (size * size + 1) * 6, (size * size - 1) + size * size + size * 4 + 5, 14, 22 };
+			checkLayout("solid chunk", &getSolidVoxel, solid[mode], false);
+			checkLayout("single voxel", &getSingleVoxel, single[mode], false);
+			checkLayout("checkerboard", &getCheckerboardVoxel, checkerboard[mode], true);
+			checkLayout("pillar", &getPillarVoxel, pillar[mode], true);
+
+			for(unsigned long int z = 0; z < CHUNKS_Z; ++z){
+				for(unsigned long int y = 0; y < CHUNKS_Y; ++y){
+					for(unsigned long int x = 0; x < CHUNKS_X; ++x){
+						sweet::VoxelChunk * c = new sweet::VoxelChunk();
+						for(unsigned long int i = 0; i < size * size * size; ++i){
+							unsigned long int vx = i % size, vy = (i / size) % size, vz = i / (size * size);
+							c->set(vx, vy, vz, getTerrainVoxel(x * size + vx, y * size + vy, z * size + vz));
+						}
+						chunks.push_back(c);
+					}
+				}
+			}
+
+			// the border copies are made once; the benchmark only times the meshing
+			for(unsigned long int z = 0; z < CHUNKS_Z; ++z){
+				for(unsigned long int y = 0; y < CHUNKS_Y; ++y){
+					for(unsigned long int x = 0; x < CHUNKS_X; ++x){
+						const sweet::VoxelChunk * neighbours[27];
+						for(unsigned long int i = 0; i < 27; ++i){
+							neighbours[i] = getChunk(x + i % 3 - 1, y + (i / 3) % 3 - 1, z + i / 9 - 1);
+						}
+						sweet::VoxelMesher * m = new sweet::VoxelMesher();
+						m->gather(neighbours);
+						meshers.push_back(m);
+					}
+				}
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			triangles = 0;
+			vertexBytes = 0;
+			for(unsigned long int i = 0; i < meshers.size(); ++i){
+				const sweet::VoxelChunk * c = chunks.at(i);
+				glm::vec3 origin(i % CHUNKS_X, (i / CHUNKS_X) % CHUNKS_Y, i / (CHUNKS_X * CHUNKS_Y));
+				origin *= (float)sweet::VoxelChunk::SIZE;
+				vertices.clear();
+				indices.clear();
+				if(mode == kNAIVE){
+					meshers.at(i)->meshNaive(origin, 1.f, palette, vertices, indices);
+				}else{
+					meshers.at(i)->mesh(origin, 1.f, palette, mode != kCULLED, mode == kGREEDY_AO, vertices, indices);
+				}
+				triangles += indices.size() / 3;
+				vertexBytes += vertices.size() * sizeof(Vertex);
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = meshers.size();
+			metrics["triangles per chunk"] = (double)triangles / meshers.size();
+			metrics["vertex bytes per chunk"] = (double)vertexBytes / meshers.size();
+			for(auto m : meshers){
+				delete m;
+			}
+			for(auto c : chunks){
+				delete c;
+			}
+			meshers.clear();
+			chunks.clear();
+		}
+	};
+
+	class VoxelWorldBenchmark : public sweet::Benchmark{
+	public:
+		VoxelWorld * world;
+		unsigned long int tick;
+		unsigned long int edits;
+
+		static const unsigned long int WIDTH = 64;
+
+		VoxelWorldBenchmark() :
+			Benchmark("voxels/world-edit", 120),
+			world(nullptr),
+			tick(0),
+			edits(0)
+		{
+		}
+
+		bool setUp() override{
+			tick = 0;
+			edits = 0;
+			world = new VoxelWorld(nullptr);
+			for(unsigned long int z = 0; z < WIDTH; ++z){
+				for(unsigned long int x = 0; x < WIDTH; ++x){
+					for(unsigned long int y = 0; y < 32; ++y){
+						world->setVoxel(x, y, z, getTerrainVoxel(x, y, z));
+					}
+				}
+			}
+			world->remesh();
+			world->finishMeshing();
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			// dig a trench one voxel at a time; only the chunks around each edit are remeshed
+			++tick;
+			signed long int x = tick % WIDTH;
+			signed long int z = (tick / WIDTH) * 8 % WIDTH;
+			for(signed long int y = 31; y >= 0; --y){
+				if(world->getVoxel(x, y, z) != 0){
+					world->setVoxel(x, y, z, 0);
+					++edits;
+					break;
+				}
+			}
+			world->update(_step);
+			world->finishMeshing();
+		}
+
+		void tearDown() override{
+			metrics["chunks"] = world->getChunkCount();
+			metrics["remeshes per edit"] = edits > 0 ? (double)(world->getRemeshCount() - world->getChunkCount()) / edits : 0;
+			delete world;
+			world = nullptr;
+		}
+	};
+
+	// adds amount to a counter; carries a payload so that live commands are much bigger than serialized ones
+	class AddCommand : public Command{
+	public:
+		long int * target;
+		long int amount;
+		std::vector<char> payload;
+		// number of AddCommands which exist (i.e. which haven't been replaced by their serialized form)
+		static unsigned long int numLive;
+
+		AddCommand(long int * _target, long int _amount) : target(_target), amount(_amount), payload(1024){
+			++numLive;
+		}
+		~AddCommand(){
+			--numLive;
+		}
+
+		bool execute() override{
+			*target += amount;
+			return true;
+		}
+		bool unexecute() override{
+			*target -= amount;
+			return true;
+		}
+		unsigned long int getSize() override{
+			return Command::getSize() + payload.capacity();
+		}
+		Deserializer serialize(std::string & _delta) override{
+			_delta.assign(reinterpret_cast<const char *>(&target), sizeof(target));
+			_delta.append(reinterpret_cast<const char *>(&amount), sizeof(amount));
+			return &deserialize;
+		}
+
+		static Command * deserialize(const std::string & _delta){
+			long int * target;
+			long int amount;
+			memcpy(&target, _delta.data(), sizeof(target));
+			memcpy(&amount, _delta.data() + sizeof(target), sizeof(amount));
+			return new AddCommand(target, amount);
+		}
+	};
+	unsigned long int AddCommand::numLive = 0;
+
+	// runs commands well past liveCommands and byteBudget, then undoes and redoes through the archived and evicted history,
+	// checking the counter, the history size, and the number of live commands at each step; any problem fails the benchmark
+	class CommandHistoryBenchmark : public sweet::Benchmark{
+	public:
+		static const unsigned long int numCommands = 256;
+
+		CommandHistoryBenchmark() : Benchmark("commands/history", 100){}
+
+		// returns a description of the first problem found, or an empty string if there wasn't one
+		std::string run(){
+			long int counter = 0;
+			CommandProcessor processor;
+			processor.coalesceCommands = false;
+			processor.liveCommands = 8;
+			processor.byteBudget = 8 * AddCommand(&counter, 0).getSize() + 4096;
+
+			for(unsigned long int i = 1; i <= numCommands; ++i){
+				processor.executeCommand(new AddCommand(&counter, i));
+				if(processor.getHistorySize() > processor.byteBudget){
+					return "history over budget after executing";
+				}
+			}
+			// the sum of the amounts of the first _n commands
+			auto sum = [](unsigned long int _n){
+				return (long int)(_n * (_n + 1) / 2);
+			};
+			unsigned long int kept = processor.getUndoCount();
+			if(kept <= processor.liveCommands || kept >= numCommands){
+				return "history wasn't both archived and evicted";
+			}
+			if(counter != sum(numCommands)){
+				return "wrong total after executing";
+			}
+
+			// evicted commands can't be undone, so undoing everything leaves their total behind
+			processor.undoAll();
+			if(counter != sum(numCommands - kept) || processor.getRedoCount() != kept){
+				return "wrong total after undoing through archived commands";
+			}
+			processor.redoAll();
+			if(counter != sum(numCommands) || processor.getUndoCount() != kept || processor.getHistorySize() > processor.byteBudget){
+				return "wrong total or history after redoing";
+			}
+
+			// shrinking the live range archives everything outside it the next time the history is trimmed
+			processor.liveCommands = 2;
+			processor.undo();
+			processor.redo();
+			if(AddCommand::numLive > processor.liveCommands){
+				return "commands outside the live range weren't archived";
+			}
+
+			// the redo stack counts towards the budget as well; the commands furthest from the current state are dropped first
+			processor.undoAll();
+			processor.byteBudget = processor.getHistorySize() / 2;
+			processor.redo();
+			if(processor.getHistorySize() > processor.byteBudget || processor.getRedoCount() + 1 >= kept){
+				return "redo stack wasn't trimmed to the budget";
+			}
+			processor.redoAll();
+			if(counter != sum(numCommands - kept + processor.getUndoCount())){
+				return "wrong total after redoing a trimmed redo stack";
+			}
+			return "";
+		}
+
+		bool setUp() override{
+			std::string problem = run();
+			if(problem != ""){
+				fail(problem);
+				return false;
+			}
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			std::string problem = run();
+			if(problem != "" && failures.empty()){
+				fail(problem);
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = numCommands;
+		}
+	};
+
+	// builds and deletes a small scene each frame, taking a census snapshot and diff around it like Game::switchScene does
+	class NodeCensusBenchmark : public sweet::Benchmark{
+	public:
+		double nodes;
+		double changedTypes;
+
+		NodeCensusBenchmark() : Benchmark("nodes/census", 300), nodes(0), changedTypes(0){}
+
+		bool setUp() override{
+			nodes = 0;
+			changedTypes = 0;
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			sweet::NodeCensus & census = sweet::NodeCensus::getInstance();
+			sweet::NodeCensus::Snapshot before = census.takeSnapshot();
+
+			Transform * root = new Transform();
+			for(unsigned long int i = 0; i < 64; ++i){
+				Transform * t = new Transform();
+				root->addChild(t, false);
+				for(unsigned long int j = 0; j < 8; ++j){
+					t->addChild(new Transform(), false);
+				}
+			}
+			sweet::NodeCensus::Snapshot during = census.takeSnapshot();
+			nodes += during.live - before.live;
+			delete root;
+
+			sweet::NodeCensus::Snapshot after = census.takeSnapshot();
+			changedTypes += sweet::NodeCensus::diff(before, during).size();
+			if(!census.getLeaks(before, after).empty()){
+				Log::warn("Node census benchmark leaked nodes");
+			}
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = nodes / frames;
+			metrics["changed types per frame"] = changedTypes / frames;
+			metrics["live nodes"] = sweet::NodeCensus::getInstance().getLiveCount();
+		}
+	};
+
+	class ParticlePoolBenchmark : public sweet::Benchmark{
+	public:
+		ParticlePool * pool;
+		ComponentShaderBase * shader;
+		double liveParticles;
+
+		ParticlePoolBenchmark() : Benchmark("particles/pool", 300), pool(nullptr), shader(nullptr), liveParticles(0){}
+
+		bool setUp() override{
+			shader = makeShader(false);
+			pool = new ParticlePool(4096, nullptr, shader);
+			ParticleEmitter e;
+			e.rate = 2000;
+			e.life = 1;
+			e.velocity = glm::vec3(0, 5, 0);
+			e.velocityVariance = glm::vec3(5, 5, 5);
+			pool->emitters.push_back(e);
+			pool->forces.push_back(ParticleForce(ParticleForce::kDIRECTIONAL, glm::vec3(0, -9.8f, 0)));
+			liveParticles = 0;
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			pool->update(_step);
+			liveParticles += pool->getCount();
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = liveParticles / frames;
+			delete pool;
+			delete shader;
+		}
+	};
+
+	// the Box2D-backed ParticleSystem, emitting at the same rate as the pool benchmark
+	class ParticleSystemBenchmark : public sweet::Benchmark{
+	public:
+		Box2DWorld * world;
+		ParticleSystem * system;
+		ComponentShaderBase * shader;
+		double liveParticles;
+
+		ParticleSystemBenchmark() : Benchmark("particles/legacy", 300), world(nullptr), system(nullptr), shader(nullptr), liveParticles(0){}
+
+		bool setUp() override{
+			shader = makeShader(false);
+			world = new Box2DWorld();
+			// the particles are textured, so the texture needs pixels to upload
+			ProgrammaticTexture * texture = new ProgrammaticTexture();
+			texture->allocate(16, 16);
+			system = new ParticleSystem(texture, world, 1);
+			system->setShader(shader, true);
+			system->emissionRate = 1.f / 60.f;
+			system->emissionAmount = 33;
+			liveParticles = 0;
+			return true;
+		}
+
+		void frame(Step * _step) override{
+			world->update(_step);
+			system->update(_step);
+			liveParticles += system->components.size();
+		}
+
+		void tearDown() override{
+			metrics["items per frame"] = liveParticles / frames;
+			delete system;
+			delete world;
+			delete shader;
+		}
+	};
+}
+
+void sweet::BenchmarkRunner::addDefaultBenchmarks(std::string _fontFile){
+	add(new SceneGraphBenchmark(true));
+	add(new SceneGraphBenchmark(false));
+	add(new ParallelUpdateBenchmark(1));
+	add(new ParallelUpdateBenchmark(2));
+	add(new ParallelUpdateBenchmark(0));
+	add(new MeshUploadBenchmark());
+	add(new MeshPartialUploadBenchmark());
+	add(new TextLayoutBenchmark(_fontFile));
+	add(new UILayoutBenchmark());
+	add(new UIHitTestBenchmark());
+	add(new BulletBenchmark());
+	add(new BulletSleepingBenchmark());
+	add(new ShapeCacheBenchmark(false));
+	add(new ShapeCacheBenchmark(true));
+	add(new BvhLoadBenchmark(false));
+	add(new BvhLoadBenchmark(true));
+	add(new Box2DBenchmark());
+	add(new PhraseBenchmark(false));
+	add(new PhraseBenchmark(true));
+	add(new AssetLoadBenchmark(false));
+	add(new AssetLoadBenchmark(true));
+	add(new ScenarioLoadBenchmark(false));
+	add(new ScenarioLoadBenchmark(true));
+	add(new AudioBenchmark());
+	add(new SpriteAnimationBenchmark(false));
+	add(new SpriteAnimationBenchmark(true));
+	add(new SpriteMeshBenchmark(false));
+	add(new SpriteMeshBenchmark(true));
+	add(new ParticlePoolBenchmark());
+	add(new ParticleSystemBenchmark());
+	add(new RandomBenchmark(RandomBenchmark::kKNUTH));
+	add(new RandomBenchmark(RandomBenchmark::kNUMBER_UTILS));
+	add(new RandomBenchmark(RandomBenchmark::kSTREAM));
+	add(new RandomBenchmark(RandomBenchmark::kFILL));
+	add(new RenderTargetBenchmark(false));
+	add(new RenderTargetBenchmark(true));
+	add(new BlurBenchmark("blur/sigma-2", 2.f, -1));
+	add(new BlurBenchmark("blur/sigma-8-full-res", 8.f, 0));
+	add(new BlurBenchmark("blur/sigma-8", 8.f, -1));
+	add(new BlurBenchmark("blur/sigma-24", 24.f, -1));
+	add(new VoxelMeshBenchmark(VoxelMeshBenchmark::kNAIVE));
+	add(new VoxelMeshBenchmark(VoxelMeshBenchmark::kCULLED));
+	add(new VoxelMeshBenchmark(VoxelMeshBenchmark::kGREEDY));
+	add(new VoxelMeshBenchmark(VoxelMeshBenchmark::kGREEDY_AO));
+	add(new VoxelWorldBenchmark());
+	add(new NodeCensusBenchmark());
+	add(new CommandHistoryBenchmark());
+	static MapKeyboard mapKeyboard;
+	add(new InputLookupBenchmark<MapKeyboard>("input/map", mapKeyboard));
+	add(new InputLookupBenchmark<Keyboard>("input/bitset", Keyboard::getInstance()));
+	add(new AccelerometerParseBenchmark(true));
+	add(new AccelerometerParseBenchmark(false));
+	add(new SerialLoopbackBenchmark());
+}
\ No newline at end of file
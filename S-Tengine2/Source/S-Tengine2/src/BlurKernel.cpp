@@ -0,0 +1,133 @@
+#pragma once
+
+#include <BlurKernel.h>
+
+#include <cmath>
+
+sweet::BlurKernel::BlurKernel(float _sigma, unsigned long int _radius) :
+	sigma(_sigma > 0 ? _sigma : 0)
+{
+	unsigned long int radius = 0;
+	if(sigma > 0){
+		radius = _radius > 0 ? _radius : (unsigned long int)std::ceil(sigma * 3.f);
+		// every tap past the centre covers two texels
+		if(radius > (MAX_TAPS - 1) * 2){
+			radius = (MAX_TAPS - 1) * 2;
+		}
+	}
+
+	float total = 0;
+	for(unsigned long int i = 0; i <= radius; ++i){
+		float w = radius == 0 ? 1.f : std::exp(-(float)(i * i) / (2.f * sigma * sigma));
+		weights.push_back(w);
+		total += i == 0 ? w : w * 2.f;
+	}
+	for(auto & w : weights){
+		w /= total;
+	}
+
+	tapOffsets.push_back(0);
+	tapWeights.push_back(weights.at(0));
+	for(unsigned long int i = 1; i <= radius; i += 2){
+		if(i + 1 <= radius){
+			// sampling between i and i + 1 at this offset gives each of them their own weight
+			float w = weights.at(i) + weights.at(i + 1);
+			tapOffsets.push_back((i * weights.at(i) + (i + 1) * weights.at(i + 1)) / w);
+			tapWeights.push_back(w);
+		}else{
+			tapOffsets.push_back((float)i);
+			tapWeights.push_back(weights.at(i));
+		}
+	}
+}
+
+unsigned long int sweet::BlurKernel::getRadius() const{
+	return weights.size() - 1;
+}
+
+unsigned long int sweet::BlurKernel::getTapCount() const{
+	return tapOffsets.size();
+}
+
+unsigned long int sweet::BlurKernel::getFetchesPerPass() const{
+	return tapOffsets.size() * 2 - 1;
+}
+
+unsigned long int sweet::BlurKernel::getDiscreteFetchesPerPass() const{
+	return weights.size() * 2 - 1;
+}
+
+float sweet::BlurKernel::sample(const float * _image, unsigned long int _width, unsigned long int _height, unsigned long int _channels, float _x, float _y, unsigned long int _channel){
+	float fx = std::floor(_x);
+	float fy = std::floor(_y);
+	float tx = _x - fx;
+	float ty = _y - fy;
+
+	signed long int x0 = (signed long int)fx;
+	signed long int y0 = (signed long int)fy;
+	signed long int x1 = x0 + 1;
+	signed long int y1 = y0 + 1;
+	signed long int maxX = (signed long int)_width - 1;
+	signed long int maxY = (signed long int)_height - 1;
+	x0 = x0 < 0 ? 0 : (x0 > maxX ? maxX : x0);
+	x1 = x1 < 0 ? 0 : (x1 > maxX ? maxX : x1);
+	y0 = y0 < 0 ? 0 : (y0 > maxY ? maxY : y0);
+	y1 = y1 < 0 ? 0 : (y1 > maxY ? maxY : y1);
+
+	float a = _image[(y0 * _width + x0) * _channels + _channel];
+	float b = _image[(y0 * _width + x1) * _channels + _channel];
+	float c = _image[(y1 * _width + x0) * _channels + _channel];
+	float d = _image[(y1 * _width + x1) * _channels + _channel];
+	return (a + (b - a) * tx) * (1.f - ty) + (c + (d - c) * tx) * ty;
+}
+
+void sweet::BlurKernel::resample(const float * _src, unsigned long int _srcWidth, unsigned long int _srcHeight, float * _dst, unsigned long int _dstWidth, unsigned long int _dstHeight, unsigned long int _channels){
+	float sx = (float)_srcWidth / _dstWidth;
+	float sy = (float)_srcHeight / _dstHeight;
+	for(unsigned long int y = 0; y < _dstHeight; ++y){
+		// the centre of the destination texel, in source texels
+		float v = (y + 0.5f) * sy - 0.5f;
+		for(unsigned long int x = 0; x < _dstWidth; ++x){
+			float u = (x + 0.5f) * sx - 0.5f;
+			for(unsigned long int c = 0; c < _channels; ++c){
+				_dst[(y * _dstWidth + x) * _channels + c] = sample(_src, _srcWidth, _srcHeight, _channels, u, v, c);
+			}
+		}
+	}
+}
+
+void sweet::BlurKernel::pass(const float * _src, float * _dst, unsigned long int _width, unsigned long int _height, unsigned long int _channels, signed long int _dx, signed long int _dy) const{
+	for(unsigned long int y = 0; y < _height; ++y){
+		for(unsigned long int x = 0; x < _width; ++x){
+			for(unsigned long int c = 0; c < _channels; ++c){
+				float sum = sample(_src, _width, _height, _channels, (float)x, (float)y, c) * tapWeights.at(0);
+				for(unsigned long int i = 1; i < tapOffsets.size(); ++i){
+					float ox = tapOffsets.at(i) * _dx;
+					float oy = tapOffsets.at(i) * _dy;
+					sum += (sample(_src, _width, _height, _channels, x + ox, y + oy, c) + sample(_src, _width, _height, _channels, x - ox, y - oy, c)) * tapWeights.at(i);
+				}
+				_dst[(y * _width + x) * _channels + c] = sum;
+			}
+		}
+	}
+}
+
+void sweet::BlurKernel::discretePass(const float * _src, float * _dst, unsigned long int _width, unsigned long int _height, unsigned long int _channels, signed long int _dx, signed long int _dy) const{
+	signed long int maxX = (signed long int)_width - 1;
+	signed long int maxY = (signed long int)_height - 1;
+	for(signed long int y = 0; y <= maxY; ++y){
+		for(signed long int x = 0; x <= maxX; ++x){
+			for(unsigned long int c = 0; c < _channels; ++c){
+				float sum = 0;
+				for(signed long int i = -(signed long int)getRadius(); i <= (signed long int)getRadius(); ++i){
+					signed long int sx = x + i * _dx;
+					signed long int sy = y + i * _dy;
+					sx = sx < 0 ? 0 : (sx > maxX ? maxX : sx);
+					sy = sy < 0 ? 0 : (sy > maxY ? maxY : sy);
+					sum += _src[(sy * _width + sx) * _channels + c] * weights.at(i < 0 ? -i : i);
+				}
+				_dst[(y * _width + x) * _channels + c] = sum;
+			}
+		}
+	}
+}
\ No newline at end of file
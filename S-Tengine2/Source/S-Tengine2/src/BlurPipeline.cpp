@@ -0,0 +1,208 @@
+#pragma once
+
+#include <BlurPipeline.h>
+#include <FrameBufferInterface.h>
+#include <RenderSurface.h>
+#include <RenderTargetPool.h>
+#include <shader/BlurShader.h>
+#include <Log.h>
+
+#include <cmath>
+
+float sweet::BlurPipeline::maxSigmaPerLevel = 3.f;
+
+sweet::BlurPipeline::BlurPipeline(float _sigma, signed long int _levels) :
+	sigma(0),
+	levels(0),
+	kernel(0),
+	shader(nullptr),
+	surface(nullptr)
+{
+	setSigma(_sigma, _levels);
+}
+
+sweet::BlurPipeline::~BlurPipeline(){
+	// the surface releases the shader
+	delete surface;
+}
+
+void sweet::BlurPipeline::setSigma(float _sigma, signed long int _levels){
+	sigma = _sigma > 0 ? _sigma : 0;
+	if(_levels >= 0){
+		levels = _levels;
+	}else{
+		levels = 0;
+		while(levels < 8 && sigma / (1 << levels) > maxSigmaPerLevel){
+			++levels;
+		}
+	}
+	// each level halves the size, so the sigma in texels halves too
+	kernel = BlurKernel(sigma / (1 << levels));
+}
+
+float sweet::BlurPipeline::getSigma() const{
+	return sigma;
+}
+
+unsigned long int sweet::BlurPipeline::getLevels() const{
+	return levels;
+}
+
+const sweet::BlurKernel & sweet::BlurPipeline::getKernel() const{
+	return kernel;
+}
+
+unsigned long int sweet::BlurPipeline::getLevelSize(unsigned long int _size, unsigned long int _level){
+	unsigned long int res = _size >> _level;
+	return res > 0 ? res : 1;
+}
+
+std::vector<FrameBufferChannel> sweet::BlurPipeline::getChannels(){
+	std::vector<FrameBufferChannel> res;
+	res.push_back(FrameBufferChannel(GL_RGBA, GL_COLOR_ATTACHMENT0, GL_RGBA, FrameBufferChannel::TEXTURE, GL_UNSIGNED_BYTE));
+	return res;
+}
+
+void sweet::BlurPipeline::draw(GLuint _texture, unsigned long int _srcWidth, unsigned long int _srcHeight, signed long int _dx, signed long int _dy){
+	glUseProgram(shader->getProgramId());
+	if(_dx == 0 && _dy == 0){
+		shader->setCopy();
+	}else{
+		shader->setPass(kernel, (float)_dx / _srcWidth, (float)_dy / _srcHeight);
+	}
+	surface->render(_texture);
+}
+
+void sweet::BlurPipeline::apply(FrameBufferInterface * _source, FrameBufferInterface * _target){
+	if(_source == nullptr || _source == _target){
+		Log::warn("BlurPipeline needs a source which isn't the target");
+		return;
+	}
+
+	if(surface == nullptr){
+		shader = new BlurShader(true);
+		surface = new RenderSurface(shader, false);
+		surface->setScaleMode(GL_LINEAR);
+		surface->uvEdgeMode = GL_CLAMP_TO_EDGE;
+	}
+	shader->load();
+
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	RenderTargetPool & pool = RenderTargetPool::getInstance();
+	const std::vector<FrameBufferChannel> channels = getChannels();
+	const unsigned long int width = _source->width;
+	const unsigned long int height = _source->height;
+
+	// downsample; pyramid[0] is the source
+	std::vector<FrameBufferInterface *> pyramid(levels + 1, nullptr);
+	pyramid.at(0) = _source;
+	for(unsigned long int l = 1; l <= levels; ++l){
+		unsigned long int w = getLevelSize(width, l);
+		unsigned long int h = getLevelSize(height, l);
+		pyramid.at(l) = pool.acquire(channels, w, h);
+		FrameBufferInterface::pushFbo(pyramid.at(l));
+		glViewport(0, 0, w, h);
+		draw(pyramid.at(l - 1)->frameBufferChannels.at(0).id, pyramid.at(l - 1)->width, pyramid.at(l - 1)->height, 0, 0);
+		FrameBufferInterface::popFbo();
+	}
+
+	// horizontal pass
+	FrameBufferInterface * lowest = pyramid.at(levels);
+	FrameBufferInterface * tmp = pool.acquire(channels, lowest->width, lowest->height);
+	FrameBufferInterface::pushFbo(tmp);
+	glViewport(0, 0, tmp->width, tmp->height);
+	draw(lowest->frameBufferChannels.at(0).id, lowest->width, lowest->height, 1, 0);
+	FrameBufferInterface::popFbo();
+
+	// vertical pass, back into the lowest level (it's been read already), or into the target if there are no levels
+	GLuint result = tmp->frameBufferChannels.at(0).id;
+	unsigned long int resultWidth = tmp->width;
+	unsigned long int resultHeight = tmp->height;
+	signed long int finalDy = 1;
+	if(levels > 0){
+		FrameBufferInterface::pushFbo(lowest);
+		glViewport(0, 0, lowest->width, lowest->height);
+		draw(result, resultWidth, resultHeight, 0, 1);
+		FrameBufferInterface::popFbo();
+		pool.release(tmp);
+		tmp = nullptr;
+
+		// upsample into each level above, down to the first
+		for(unsigned long int l = levels - 1; l >= 1; --l){
+			FrameBufferInterface::pushFbo(pyramid.at(l));
+			glViewport(0, 0, pyramid.at(l)->width, pyramid.at(l)->height);
+			draw(pyramid.at(l + 1)->frameBufferChannels.at(0).id, pyramid.at(l + 1)->width, pyramid.at(l + 1)->height, 0, 0);
+			FrameBufferInterface::popFbo();
+			pool.release(pyramid.at(l + 1));
+			pyramid.at(l + 1) = nullptr;
+		}
+		result = pyramid.at(1)->frameBufferChannels.at(0).id;
+		resultWidth = pyramid.at(1)->width;
+		resultHeight = pyramid.at(1)->height;
+		finalDy = 0;
+	}
+
+	// last pass into the target
+	if(_target != nullptr){
+		FrameBufferInterface::pushFbo(_target);
+		glViewport(0, 0, _target->width, _target->height);
+	}else{
+		glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	}
+	draw(result, resultWidth, resultHeight, 0, finalDy);
+	if(_target != nullptr){
+		FrameBufferInterface::popFbo();
+	}
+
+	if(tmp != nullptr){
+		pool.release(tmp);
+	}
+	if(levels > 0){
+		pool.release(pyramid.at(1));
+	}
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void sweet::BlurPipeline::applyCpu(const std::vector<float> & _src, unsigned long int _width, unsigned long int _height, unsigned long int _channels, std::vector<float> & _dst) const{
+	_dst.resize(_width * _height * _channels);
+
+	std::vector<std::vector<float> > pyramid(levels + 1);
+	for(unsigned long int l = 1; l <= levels; ++l){
+		const std::vector<float> & prev = l == 1 ? _src : pyramid.at(l - 1);
+		pyramid.at(l).resize(getLevelSize(_width, l) * getLevelSize(_height, l) * _channels);
+		BlurKernel::resample(prev.data(), getLevelSize(_width, l - 1), getLevelSize(_height, l - 1), pyramid.at(l).data(), getLevelSize(_width, l), getLevelSize(_height, l), _channels);
+	}
+
+	const std::vector<float> & lowest = levels == 0 ? _src : pyramid.at(levels);
+	unsigned long int w = getLevelSize(_width, levels);
+	unsigned long int h = getLevelSize(_height, levels);
+	std::vector<float> tmp(lowest.size());
+	kernel.pass(lowest.data(), tmp.data(), w, h, _channels, 1, 0);
+	if(levels == 0){
+		kernel.pass(tmp.data(), _dst.data(), w, h, _channels, 0, 1);
+		return;
+	}
+	kernel.pass(tmp.data(), pyramid.at(levels).data(), w, h, _channels, 0, 1);
+
+	for(unsigned long int l = levels - 1; l >= 1; --l){
+		BlurKernel::resample(pyramid.at(l + 1).data(), getLevelSize(_width, l + 1), getLevelSize(_height, l + 1), pyramid.at(l).data(), getLevelSize(_width, l), getLevelSize(_height, l), _channels);
+	}
+	BlurKernel::resample(pyramid.at(1).data(), getLevelSize(_width, 1), getLevelSize(_height, 1), _dst.data(), _width, _height, _channels);
+}
+
+unsigned long long int sweet::BlurPipeline::getFetchCount(unsigned long int _width, unsigned long int _height) const{
+	unsigned long long int res = 0;
+	// one bilinear fetch per pixel for each downsample, and for each upsample (the last of which is into the target)
+	for(unsigned long int l = 1; l <= levels; ++l){
+		res += (unsigned long long int)getLevelSize(_width, l) * getLevelSize(_height, l);
+		res += (unsigned long long int)getLevelSize(_width, l - 1) * getLevelSize(_height, l - 1);
+	}
+	res += 2ull * kernel.getFetchesPerPass() * getLevelSize(_width, levels) * getLevelSize(_height, levels);
+	return res;
+}
+
+unsigned long long int sweet::BlurPipeline::getBoxFetchCount(unsigned long int _width, unsigned long int _height){
+	return 81ull * _width * _height;
+}
\ No newline at end of file
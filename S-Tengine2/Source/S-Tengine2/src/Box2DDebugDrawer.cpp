@@ -136,6 +136,10 @@ void Box2DDebugDrawer::DrawTransform(const b2Transform& xf){
 	spriteTransform->firstParent()->render(matrixStack, renderOptions);
 }
 
+bool Box2DDebugDrawer::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	return false;
+}
+
 void Box2DDebugDrawer::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
 	
 	// don't bother doing any work if we aren't rendering anyway
@@ -5,6 +5,7 @@
 #include <Texture.h>
 #include <TextureSampler.h>
 #include <MeshInterface.h>
+#include <TextureUtils.h>
 
 Box2DSprite::Box2DSprite(Box2DWorld * _world, TextureSampler * _textureSampler, b2BodyType _bodyType, Shader* _shader, float _componentScale) :
 	Sprite(_shader),
@@ -76,6 +77,7 @@ b2Fixture * Box2DSprite::createFixture(b2Filter _filter, b2Vec2 _offset, void *
 		mesh->vertices.at(i).x = tShape.GetVertex(numVerts-(i+1)).x;
 		mesh->vertices.at(i).y = tShape.GetVertex(numVerts-(i+1)).y;
 	}
+	mesh->makeDirty();
 	
 	if(useTextureSamplerUVs){
 		configureUVs();
@@ -95,6 +97,48 @@ b2PolygonShape Box2DSprite::createFixtureShape(){
 	return tShape;
 }
 
+std::vector<b2Fixture *> Box2DSprite::createFixturesFromTexture(Texture * _texture, unsigned long int _threshold, float _tolerance, b2Filter _filter, void * _userData, bool _isSensor){
+	std::vector<b2Fixture *> res;
+
+	float scaleX = getCorrectedWidth() / _texture->width;
+	float scaleY = getCorrectedHeight() / _texture->height;
+	unsigned long int channel = _texture->channels == 4 ? 3 : 0;
+
+	std::vector<std::vector<glm::vec2>> contours = sweet::TextureUtils::getContours(_texture, _threshold, true, _tolerance, channel);
+	for(const std::vector<glm::vec2> & contour : contours){
+		// holes wind clockwise
+		if(sweet::TextureUtils::getSignedArea(contour) <= 0){
+			continue;
+		}
+
+		for(const std::vector<glm::vec2> & piece : sweet::TextureUtils::getConvexDecomposition(contour, b2_maxPolygonVertices)){
+			// Box2D asserts on slivers, so skip anything too small to matter
+			if(sweet::TextureUtils::getSignedArea(piece) * scaleX * scaleY < b2_linearSlop * b2_linearSlop){
+				continue;
+			}
+
+			b2Vec2 verts[b2_maxPolygonVertices];
+			for(unsigned long int i = 0; i < piece.size(); ++i){
+				verts[i].Set((piece.at(i).x - _texture->width*0.5f) * scaleX, (piece.at(i).y - _texture->height*0.5f) * scaleY);
+			}
+			b2PolygonShape tShape;
+			tShape.Set(verts, piece.size());
+
+			b2FixtureDef fd;
+			fd.shape = &tShape;
+			fd.restitution = 0.f;
+			fd.friction = 0.5f;
+			fd.isSensor = _isSensor;
+			fd.density = 1.f;
+			fd.userData = _userData;
+			fd.filter = _filter;
+			res.push_back(body->CreateFixture(&fd));
+		}
+	}
+
+	return res;
+}
+
 Box2DSprite::~Box2DSprite(){
 	if(world != nullptr && body != nullptr) {
 		world->b2world->DestroyBody(body);
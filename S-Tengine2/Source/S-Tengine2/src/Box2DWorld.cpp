@@ -4,6 +4,7 @@
 #include <node/NodeBox2DBody.h>
 #include <Step.h>
 #include <Box2DDebugDrawer.h>
+#include <Profiler.h>
 
 Box2DWorld::Box2DWorld(b2Vec2 _gravityVector):
 	NodeUpdatable(),
@@ -19,6 +20,7 @@ Box2DWorld::~Box2DWorld(){
 }
 
 void Box2DWorld::update(Step* _step){
+	SWEET_PROFILE_FUNCTION();
 	timeStepAccumulator = _step->getDeltaTime();
 	while(timeStepAccumulator >= _step->targetFrameDuration*2){
 		b2world->Step(_step->targetFrameDuration, velocityIterations, positionIterations);
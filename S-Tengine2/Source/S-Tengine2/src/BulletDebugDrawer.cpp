@@ -117,6 +117,10 @@ void BulletDebugDrawer::drawContactPoint(const btVector3& pointOnB, const btVect
 }
 
 
+bool BulletDebugDrawer::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	return false;
+}
+
 void BulletDebugDrawer::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
 	// don't bother doing any work if we aren't rendering anyway
 	if(!isVisible()){
@@ -4,6 +4,12 @@
 #include <Texture.h>
 #include <TextureUtils.h>
 #include <MeshInterface.h>
+#include <Material.h>
+#include <MatrixStack.h>
+#include <RenderOptions.h>
+#include <shader\Shader.h>
+
+#include <algorithm>
 
 BulletHeightFieldShape::BulletHeightFieldShape(Texture * _heightMap, glm::vec3 _scale, unsigned long int _upAxis) :
 	heightMap(_heightMap),
@@ -19,68 +25,395 @@ BulletHeightFieldShape::~BulletHeightFieldShape(){
 
 TriMesh * BulletHeightFieldShape::getMesh(bool _tileUvs){
 	TriMesh * res = new TriMesh(true);
+	getGrid(0, 0, std::max(getWidth(), getHeight()), 1, 0, _tileUvs, res->vertices, res->indices);
+	res->makeDirty();
+	return res;
+}
+
+void BulletHeightFieldShape::getGrid(unsigned long int _x, unsigned long int _y, unsigned long int _size, unsigned long int _step, float _skirtDepth, bool _tileUvs, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const{
+	_step = std::max(1ul, _step);
+
+	// pick out the pixels to sample along each axis
+	std::vector<unsigned long int> xs, ys;
+	unsigned long int xEnd = std::min(_x + _size, getWidth() - 1);
+	unsigned long int yEnd = std::min(_y + _size, getHeight() - 1);
+	for(unsigned long int i = _x; i < xEnd; i += _step){
+		xs.push_back(i);
+	}
+	xs.push_back(xEnd);
+	for(unsigned long int i = _y; i < yEnd; i += _step){
+		ys.push_back(i);
+	}
+	ys.push_back(yEnd);
 
-	// copy the vertices into the mesh while also setting up the UVs
-	for(unsigned long int y = 0; y < heightMap->height; ++y){
-		for(unsigned long int x = 0; x < heightMap->width; ++x){
-			// copy verts
-			btVector3 v1;
-			getVertex(x, y, v1);
-			Vertex v2(v1.x(), v1.y(), v1.z());
-			v2.u = x;
-			v2.v = y;
+	unsigned long int w = xs.size();
+	unsigned long int h = ys.size();
+
+	_vertices.clear();
+	_indices.clear();
+	_vertices.reserve(w * h + (w + h) * 2);
+	_indices.reserve((w-1) * (h-1) * 6 + (w + h) * 24);
+
+	// copy the vertices while also setting up the normals and UVs
+	for(unsigned long int y : ys){
+		for(unsigned long int x : xs){
+			btVector3 p;
+			getVertex(x, y, p);
+			glm::vec3 n = getNormal(x, y);
+			Vertex v(p.x(), p.y(), p.z());
+			v.nx = n.x;
+			v.ny = n.y;
+			v.nz = n.z;
+			v.u = x;
+			v.v = y;
 			if(!_tileUvs){
-				v2.u /= heightMap->width;
-				v2.v /= heightMap->height;
+				v.u /= heightMap->width;
+				v.v /= heightMap->height;
 			}
-			res->vertices.push_back(v2);
-		}
-	}
-	
-	// connect the verts to make triangles and set the normals on each set of 4 as the average of both triangle face normals
-	for(unsigned long int i = 0; i < res->vertices.size() - heightMap->width - 1; ++i){
-		if((i+1) % heightMap->width == 0){
-			continue;
-		}
-		
-		unsigned long int
-			v1 = i,
-			v2 = i+1,
-			v3 = i+heightMap->width,
-			v4 = v3+1;
-			
-		res->pushTri(v1, v2, v3);
-		res->pushTri(v3, v2, v4);
-		
-		// calculate the normal as an average of both face normals
-		glm::vec3 n = ( res->calcNormal(v1, v2, v3) + res->calcNormal(v3, v2, v4) ) * 0.5f;
-		
-		res->setNormal(i, n.x, n.y, n.z);
-		res->setNormal(i+1, n.x, n.y, n.z);
-		res->setNormal(i+heightMap->width, n.x, n.y, n.z);
-		res->setNormal(i+heightMap->width+1, n.x, n.y, n.z);
+			_vertices.push_back(v);
+		}
+	}
+
+	// connect the verts to make triangles
+	for(unsigned long int j = 0; j+1 < h; ++j){
+		for(unsigned long int i = 0; i+1 < w; ++i){
+			GLuint
+				v1 = j*w + i,
+				v2 = v1+1,
+				v3 = v1+w,
+				v4 = v3+1;
+			_indices.push_back(v1);
+			_indices.push_back(v2);
+			_indices.push_back(v3);
+			_indices.push_back(v3);
+			_indices.push_back(v2);
+			_indices.push_back(v4);
+		}
+	}
+
+	if(_skirtDepth > 0){
+		// walk around the edge of the grid
+		std::vector<GLuint> edge;
+		for(unsigned long int i = 0; i < w; ++i){
+			edge.push_back(i);
+		}
+		for(unsigned long int j = 1; j < h; ++j){
+			edge.push_back(j*w + w-1);
+		}
+		for(signed long int i = w-2; i >= 0; --i){
+			edge.push_back((h-1)*w + i);
+		}
+		for(signed long int j = h-2; j > 0; --j){
+			edge.push_back(j*w);
+		}
+
+		// hang a copy of each edge vertex below it
+		glm::vec3 down = -getUp() * _skirtDepth;
+		GLuint base = _vertices.size();
+		for(GLuint e : edge){
+			Vertex v = _vertices.at(e);
+			v.x += down.x;
+			v.y += down.y;
+			v.z += down.z;
+			_vertices.push_back(v);
+		}
+
+		// the skirt is double-sided so that it covers the crack regardless of which side it's seen from
+		for(unsigned long int k = 0; k < edge.size(); ++k){
+			unsigned long int k2 = (k+1) % edge.size();
+			GLuint
+				v1 = edge.at(k),
+				v2 = edge.at(k2),
+				v3 = base + k,
+				v4 = base + k2;
+			GLuint tris[12] = {
+				v1, v2, v3,
+				v3, v2, v4,
+				v3, v2, v1,
+				v4, v2, v3
+			};
+			_indices.insert(_indices.end(), tris, tris + 12);
+		}
 	}
+}
+
+void BulletHeightFieldShape::getGridBounds(unsigned long int _x, unsigned long int _y, unsigned long int _size, glm::vec3 & _min, glm::vec3 & _max) const{
+	unsigned long int xEnd = std::min(_x + _size, getWidth() - 1);
+	unsigned long int yEnd = std::min(_y + _size, getHeight() - 1);
+	btVector3 p;
+	getVertex(_x, _y, p);
+	_min = _max = glm::vec3(p.x(), p.y(), p.z());
+	for(unsigned long int y = _y; y <= yEnd; ++y){
+		for(unsigned long int x = _x; x <= xEnd; ++x){
+			getVertex(x, y, p);
+			glm::vec3 v(p.x(), p.y(), p.z());
+			_min = glm::min(_min, v);
+			_max = glm::max(_max, v);
+		}
+	}
+}
 
+glm::vec3 BulletHeightFieldShape::getNormal(signed long int _x, signed long int _y) const{
+	// central differences, falling back to one-sided differences at the edges
+	signed long int
+		x0 = std::max(0l, _x-1),
+		x1 = std::min((signed long int)getWidth()-1, _x+1),
+		y0 = std::max(0l, _y-1),
+		y1 = std::min((signed long int)getHeight()-1, _y+1);
+
+	btVector3 a, b, c, d;
+	getVertex(x0, _y, a);
+	getVertex(x1, _y, b);
+	getVertex(_x, y0, c);
+	getVertex(_x, y1, d);
+	glm::vec3 dx(b.x() - a.x(), b.y() - a.y(), b.z() - a.z());
+	glm::vec3 dy(d.x() - c.x(), d.y() - c.y(), d.z() - c.z());
+
+	// same winding as the triangles in getGrid (see MeshInterface::calcNormal)
+	glm::vec3 n = glm::cross(dy, dx);
+	float l = glm::length(n);
+	return l > 0 ? n / l : getUp();
+}
+
+glm::vec3 BulletHeightFieldShape::getUp() const{
+	glm::vec3 res(0);
+	res[m_upAxis] = 1;
 	return res;
 }
 
-BulletHeightField::BulletHeightField(BulletWorld * _world, Texture * _heightMap, Shader * _shader, bool _tileUvs, glm::vec3 _scale, unsigned long int _upAxis) :
+unsigned long int BulletHeightFieldShape::getWidth() const{
+	return heightMap->width;
+}
+
+unsigned long int BulletHeightFieldShape::getHeight() const{
+	return heightMap->height;
+}
+
+BulletHeightFieldChunk::Lod::Lod() :
+	state(kNONE),
+	mesh(nullptr),
+	configuredShader(nullptr)
+{
+}
+
+BulletHeightFieldChunk::BulletHeightFieldChunk(BulletHeightFieldShape * _shape, MeshInterface * _source, unsigned long int _x, unsigned long int _y, unsigned long int _size, float _lodDistance, bool _tileUvs, sweet::JobCounter * _jobs) :
+	shape(_shape),
+	source(_source),
+	x(_x),
+	y(_y),
+	size(_size),
+	lodDistance(_lodDistance),
+	tileUvs(_tileUvs),
+	jobs(_jobs),
+	skirtDepth(0)
+{
+	// one level for each power of two up to the size of the chunk
+	for(unsigned long int step = 1; step <= size; step *= 2){
+		lods.push_back(new Lod());
+	}
+	invalidate();
+}
+
+BulletHeightFieldChunk::~BulletHeightFieldChunk(){
+	while(lods.size() > 0){
+		if(lods.back()->mesh != nullptr){
+			lods.back()->mesh->decrementAndDelete();
+		}
+		delete lods.back();
+		lods.pop_back();
+	}
+}
+
+void BulletHeightFieldChunk::invalidate(){
+	shape->getGridBounds(x, y, size, boundingBoxMin, boundingBoxMax);
+
+	// the largest crack between two levels can't be any deeper than the height range of the chunk
+	glm::vec3 up = shape->getUp();
+	skirtDepth = glm::dot(boundingBoxMax - boundingBoxMin, up) + 1.f;
+	boundingBoxMin -= up * skirtDepth;
+	makeBoundingBoxDirty();
+
+	for(Lod * l : lods){
+		l->state = kNONE;
+	}
+	// always have the coarsest level on the way so that there's something to fall back on
+	requestLod(lods.size()-1);
+}
+
+unsigned long int BulletHeightFieldChunk::getNumLods() const{
+	return lods.size();
+}
+
+unsigned long int BulletHeightFieldChunk::getDesiredLod(float _distance) const{
+	unsigned long int res = 0;
+	float d = lodDistance;
+	while(_distance > d && res+1 < lods.size()){
+		++res;
+		d *= 2;
+	}
+	return res;
+}
+
+void BulletHeightFieldChunk::requestLod(unsigned long int _lod){
+	Lod * l = lods.at(_lod);
+	if(l->state == kPENDING || l->state == kGENERATED || l->state == kREADY){
+		return;
+	}
+	l->state = kPENDING;
+
+	unsigned long int step = 1 << _lod;
+	sweet::JobSystem::getInstance().submit([this, l, step](){
+		shape->getGrid(x, y, size, step, skirtDepth, tileUvs, l->vertices, l->indices);
+		l->state = kGENERATED;
+	}, jobs);
+}
+
+bool BulletHeightFieldChunk::uploadLod(unsigned long int _lod){
+	Lod * l = lods.at(_lod);
+	if(l->state == kGENERATED){
+		if(l->mesh == nullptr){
+			l->mesh = new TriMesh(true);
+			l->mesh->incrementReferenceCount();
+		}
+		l->mesh->vertices.swap(l->vertices);
+		l->mesh->indices.swap(l->indices);
+		l->mesh->makeDirty();
+		l->vertices.clear();
+		l->indices.clear();
+		l->state = kREADY;
+	}
+	return l->mesh != nullptr;
+}
+
+void BulletHeightFieldChunk::syncMaterials(MeshInterface * _mesh){
+	if(_mesh->textures != source->textures){
+		_mesh->clearTextures();
+		for(Texture * t : source->textures){
+			_mesh->pushTexture2D(t);
+		}
+	}
+	if(_mesh->materials != source->materials){
+		while(_mesh->materials.size() > 0){
+			_mesh->materials.back()->decrementAndDelete();
+			_mesh->materials.pop_back();
+		}
+		for(Material * m : source->materials){
+			_mesh->pushMaterial(m);
+		}
+	}
+	_mesh->uvEdgeMode = source->uvEdgeMode;
+	_mesh->scaleModeMag = source->scaleModeMag;
+	_mesh->scaleModeMin = source->scaleModeMin;
+}
+
+void BulletHeightFieldChunk::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
+	// don't bother doing any work if we aren't rendering anyway
+	if(!isVisible()){
+		return;
+	}
+
+	// find the distance from the camera to the closest point on the chunk
+	glm::mat4 modelView = *_matrixStack->getViewMatrix() * *_matrixStack->getModelMatrix();
+	glm::vec3 camera(glm::inverse(modelView) * glm::vec4(0, 0, 0, 1));
+	glm::vec3 closest = glm::clamp(camera, boundingBoxMin, boundingBoxMax);
+	float distance = glm::length(glm::vec3(modelView * glm::vec4(closest, 1)));
+
+	unsigned long int desired = getDesiredLod(distance);
+	requestLod(desired);
+
+	// render the desired level if it's ready, otherwise a coarser one, otherwise a finer one
+	signed long int lod = -1;
+	for(unsigned long int i = desired; lod == -1 && i < lods.size(); ++i){
+		if(uploadLod(i)){
+			lod = i;
+		}
+	}
+	for(signed long int i = desired-1; lod == -1 && i >= 0; --i){
+		if(uploadLod(i)){
+			lod = i;
+		}
+	}
+	if(lod == -1){
+		return;
+	}
+
+	Lod * l = lods.at(lod);
+	syncMaterials(l->mesh);
+	if(_renderOptions->shader != nullptr && l->configuredShader != _renderOptions->shader){
+		l->mesh->load();
+		l->mesh->configureDefaultVertexAttributes(_renderOptions->shader);
+		l->configuredShader = _renderOptions->shader;
+	}
+	l->mesh->render(_matrixStack, _renderOptions);
+}
+
+void BulletHeightFieldChunk::load(){
+	// the meshes are loaded and configured for the current shader the next time they're rendered
+	NodeLoadable::load();
+}
+
+void BulletHeightFieldChunk::unload(){
+	for(Lod * l : lods){
+		if(l->mesh != nullptr){
+			l->mesh->unload();
+		}
+		l->configuredShader = nullptr;
+	}
+	NodeLoadable::unload();
+}
+
+bool BulletHeightFieldChunk::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	_min = boundingBoxMin;
+	_max = boundingBoxMax;
+	return true;
+}
+
+BulletHeightField::BulletHeightField(BulletWorld * _world, Texture * _heightMap, Shader * _shader, bool _tileUvs, glm::vec3 _scale, unsigned long int _upAxis, unsigned long int _chunkSize) :
 	BulletMeshEntity(_world, new TriMesh(true), _shader),
 	heightMap(_heightMap),
-	tileUvs(_tileUvs)
+	tileUvs(_tileUvs),
+	chunkSize(0),
+	lodDistance(0)
 {
 	heightMap->incrementReferenceCount();
 
 	setColliderAsHeightMap(_heightMap, _scale, _upAxis);
-	updateMesh();
+
+	if(_chunkSize > 0){
+		// round up to a power of two so that every level of detail lines up with the chunk edges
+		chunkSize = 1;
+		while(chunkSize < _chunkSize){
+			chunkSize *= 2;
+		}
+		lodDistance = chunkSize * 2 * std::max(_scale.x, std::max(_scale.y, _scale.z));
+
+		BulletHeightFieldShape * s = dynamic_cast<BulletHeightFieldShape *>(shape);
+		for(unsigned long int y = 0; y+1 < s->getHeight(); y += chunkSize){
+			for(unsigned long int x = 0; x+1 < s->getWidth(); x += chunkSize){
+				chunks.push_back(new BulletHeightFieldChunk(s, mesh, x, y, chunkSize, lodDistance, tileUvs, &chunkJobs));
+				meshTransform->addChild(chunks.back(), false);
+			}
+		}
+	}else{
+		updateMesh();
+	}
 }
 
 BulletHeightField::~BulletHeightField(){
+	// the chunks are deleted along with the meshTransform, but the jobs need to finish first
+	sweet::JobSystem::getInstance().wait(&chunkJobs);
 	heightMap->decrementAndDelete();
 }
 
-
 void BulletHeightField::updateMesh(){
+	if(chunkSize > 0){
+		sweet::JobSystem::getInstance().wait(&chunkJobs);
+		for(BulletHeightFieldChunk * c : chunks){
+			c->invalidate();
+		}
+		return;
+	}
+
 	// clear out any existing verts
 	mesh->vertices.clear();
 	mesh->indices.clear();
@@ -90,4 +423,19 @@ void BulletHeightField::updateMesh(){
 	TriMesh * temp = s->getMesh(tileUvs);
 	mesh->insertVertices(*temp);
 	delete temp;
+}
+
+void BulletHeightField::setLodDistance(float _distance){
+	lodDistance = _distance;
+	for(BulletHeightFieldChunk * c : chunks){
+		c->lodDistance = lodDistance;
+	}
+}
+
+float BulletHeightField::getLodDistance() const{
+	return lodDistance;
+}
+
+const std::vector<BulletHeightFieldChunk *> & BulletHeightField::getChunks() const{
+	return chunks;
 }
\ No newline at end of file
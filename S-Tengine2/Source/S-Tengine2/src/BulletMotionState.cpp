@@ -0,0 +1,26 @@
+#pragma once
+
+#include <BulletMotionState.h>
+#include <NodeBulletBody.h>
+
+BulletMotionState::BulletMotionState(NodeBulletBody * _owner, const btTransform & _transform) :
+	owner(_owner),
+	transform(_transform),
+	queued(false)
+{
+}
+
+void BulletMotionState::getWorldTransform(btTransform & _transform) const{
+	_transform = transform;
+}
+
+void BulletMotionState::setWorldTransform(const btTransform & _transform){
+	if(_transform.getOrigin() == transform.getOrigin() && _transform.getBasis() == transform.getBasis()){
+		return;
+	}
+	transform = _transform;
+	if(!queued && owner->world != nullptr){
+		queued = true;
+		owner->world->movedBodies.push_back(owner);
+	}
+}
\ No newline at end of file
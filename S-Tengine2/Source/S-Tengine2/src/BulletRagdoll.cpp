@@ -8,99 +8,77 @@
 #include <MeshInterface.h>
 
 BulletRagdoll::BulletRagdoll(BulletWorld * _world, float gs){
-	upperbody = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	upperbody = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(upperbody);
 	upperbody->firstParent()->scale(3*gs, 3*gs, 1*gs);
 	upperbody->setColliderAsBox(3*gs, 3*gs, 1*gs);
 	upperbody->createRigidBody(1);
 
-	lowerbody = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	lowerbody = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(lowerbody);
 	lowerbody->firstParent()->scale(3*gs, 2*gs, 1*gs);
 	lowerbody->setColliderAsBox(3*gs, 2*gs, 1*gs);
 	lowerbody->createRigidBody(1);
 
-	head = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	head = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(head);
 	head->firstParent()->scale(2*gs, 2*gs, 2*gs);
 	head->setColliderAsBox(2*gs, 2*gs, 2*gs);
 	head->createRigidBody(1);
 
-	upperlegLeft = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	upperlegLeft = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(upperlegLeft);
 	upperlegLeft->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	upperlegLeft->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	upperlegLeft->createRigidBody(1);
 
-	upperlegRight = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	upperlegRight = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(upperlegRight);
 	upperlegRight->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	upperlegRight->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	upperlegRight->createRigidBody(1);
 
-	lowerlegLeft = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	lowerlegLeft = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(lowerlegLeft);
 	lowerlegLeft->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	lowerlegLeft->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	lowerlegLeft->createRigidBody(1);
 
-	lowerlegRight = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	lowerlegRight = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(lowerlegRight);
 	lowerlegRight->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	lowerlegRight->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	lowerlegRight->createRigidBody(1);
 
-	upperarmLeft = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	upperarmLeft = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(upperarmLeft);
 	upperarmLeft->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	upperarmLeft->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	upperarmLeft->createRigidBody(1);
 
-	upperarmRight = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	upperarmRight = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(upperarmRight);
 	upperarmRight->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	upperarmRight->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	upperarmRight->createRigidBody(1);
 
-	lowerarmLeft = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	lowerarmLeft = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(lowerarmLeft);
 	lowerarmLeft->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	lowerarmLeft->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	lowerarmLeft->createRigidBody(1);
 
-	lowerarmRight = new BulletMeshEntity(_world, MeshFactory::getCubeMesh(1));
+	lowerarmRight = new BulletMeshEntity(_world, MeshFactory::getSharedCubeMesh(1));
 	childTransform->addChild(lowerarmRight);
 	lowerarmRight->firstParent()->scale(1*gs, 3*gs, 1*gs);
 	lowerarmRight->setColliderAsBox(1*gs, 3*gs, 1*gs);
 	lowerarmRight->createRigidBody(1);
 	
 	// colour code sides for debugging purposes
-	for(unsigned long int i = 0; i < upperlegLeft->mesh->vertices.size(); ++i){
-		upperlegLeft->mesh->vertices.at(i).red = 0;
-		lowerlegLeft->mesh->vertices.at(i).red = 0;
-		upperarmLeft->mesh->vertices.at(i).red = 0;
-		lowerarmLeft->mesh->vertices.at(i).red = 0;
-		upperlegLeft->mesh->vertices.at(i).green = 0;
-		lowerlegLeft->mesh->vertices.at(i).green = 0;
-		upperarmLeft->mesh->vertices.at(i).green = 0;
-		lowerarmLeft->mesh->vertices.at(i).green = 0;
-		
-		upperlegRight->mesh->vertices.at(i).blue = 0;
-		lowerlegRight->mesh->vertices.at(i).blue = 0;
-		upperarmRight->mesh->vertices.at(i).blue = 0;
-		lowerarmRight->mesh->vertices.at(i).blue = 0;
-		upperlegRight->mesh->vertices.at(i).green = 0;
-		lowerlegRight->mesh->vertices.at(i).green = 0;
-		upperarmRight->mesh->vertices.at(i).green = 0;
-		lowerarmRight->mesh->vertices.at(i).green = 0;
-		
-		head->mesh->vertices.at(i).red = 0;
-		upperbody->mesh->vertices.at(i).red = 0;
-		lowerbody->mesh->vertices.at(i).red = 0;
-		head->mesh->vertices.at(i).blue = 0;
-		upperbody->mesh->vertices.at(i).blue = 0;
-		lowerbody->mesh->vertices.at(i).blue = 0;
-	}
+	// (the cubes are shared, so this is done per-draw; it shows up with shaders that have a ShaderComponentDrawColour)
+	upperlegLeft->drawData.colour = lowerlegLeft->drawData.colour = upperarmLeft->drawData.colour = lowerarmLeft->drawData.colour = glm::vec4(0.f, 0.f, 1.f, 1.f);
+	upperlegRight->drawData.colour = lowerlegRight->drawData.colour = upperarmRight->drawData.colour = lowerarmRight->drawData.colour = glm::vec4(1.f, 0.f, 0.f, 1.f);
+	head->drawData.colour = upperbody->drawData.colour = lowerbody->drawData.colour = glm::vec4(0.f, 1.f, 0.f, 1.f);
 	
 	btPoint2PointConstraint * p2pconstraint;
 	btHingeConstraint * hingeConstraint;
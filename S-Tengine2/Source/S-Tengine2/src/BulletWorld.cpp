@@ -1,8 +1,11 @@
 #pragma once
 
 #include <BulletWorld.h>
+#include <NodeBulletBody.h>
+#include <BulletMotionState.h>
 #include <Step.h>
 #include <Camera.h>
+#include <Profiler.h>
 
 BulletWorld::BulletWorld(glm::vec3 _gravity) :
 	collisionConfig(new btDefaultCollisionConfiguration()),
@@ -11,7 +14,8 @@ BulletWorld::BulletWorld(glm::vec3 _gravity) :
 	solver(new btSequentialImpulseConstraintSolver()),
 	world(new btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfig)),
 	maxSubSteps(1),
-	fixedTimeStep(1.f/60.f)
+	fixedTimeStep(1.f/60.f),
+	interpolate(true)
 {
 	world->setGravity(btVector3(_gravity.x, _gravity.y, _gravity.z));
 }
@@ -29,6 +33,13 @@ BulletWorld::~BulletWorld(){
 		btCollisionObject * obj = world->getCollisionObjectArray()[i];
 		btRigidBody * body = btRigidBody::upcast(obj);
 		if (body && body->getMotionState()){
+			// bodies owned by a node lose their motion state and rigid body along with the world
+			BulletMotionState * ms = dynamic_cast<BulletMotionState *>(body->getMotionState());
+			if(ms != nullptr){
+				ms->owner->motionState = nullptr;
+				ms->owner->body = nullptr;
+				ms->owner->world = nullptr;
+			}
 			delete body->getMotionState();
 		}
 		world->removeCollisionObject(obj);
@@ -43,7 +54,19 @@ BulletWorld::~BulletWorld(){
 }
 
 void BulletWorld::update(Step * _step){
+	SWEET_PROFILE_FUNCTION();
 	world->stepSimulation(_step->deltaTime, maxSubSteps, fixedTimeStep);
+	syncBodies();
+}
+
+void BulletWorld::syncBodies(){
+	SWEET_PROFILE_COUNT(kPHYSICS_SYNCS, movedBodies.size());
+	for(unsigned long int i = 0; i < movedBodies.size(); ++i){
+		NodeBulletBody * b = movedBodies[i];
+		b->motionState->queued = false;
+		b->realign();
+	}
+	movedBodies.clear();
 }
 
 NodeBulletBody * BulletWorld::raycast(Camera * _camera, float _range, btCollisionWorld::ClosestRayResultCallback * _rayCallback){
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <CollisionShapeCache.h>
+#include <MeshInterface.h>
+#include <Log.h>
+
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace{
+	// FNV-1a
+	unsigned long long int hashBytes(unsigned long long int _hash, const void * _data, unsigned long int _size){
+		const unsigned char * bytes = (const unsigned char *)_data;
+		for(unsigned long int i = 0; i < _size; ++i){
+			_hash ^= bytes[i];
+			_hash *= 0x100000001B3ULL;
+		}
+		return _hash;
+	}
+
+	double getSeconds(){
+		return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// BVH files start with this header, followed by the serialized BVH
+	struct BvhHeader{
+		char magic[4];
+		// changes if the layout of the serialized BVH would (the files are specific to a build)
+		unsigned long int format;
+		unsigned long long int hash;
+		float vertexCount;
+		float indexCount;
+		unsigned long int bufferSize;
+		// how long the BVH originally took to build, so that loads can report what they saved
+		double buildSeconds;
+	};
+
+	unsigned long int getBvhFormat(){
+		return 1 | (sizeof(void *) << 8) | (sizeof(btScalar) << 16);
+	}
+}
+
+sweet::CollisionShapeCache::Stats::Stats() :
+	requests(0),
+	hits(0),
+	shapes(0),
+	references(0),
+	bytes(0),
+	unsharedBytes(0),
+	bvhBuilds(0),
+	bvhLoads(0),
+	bvhSaves(0),
+	seconds(0),
+	secondsSaved(0)
+{
+}
+
+double sweet::CollisionShapeCache::Stats::getHitRate() const{
+	return requests > 0 ? (double)hits / requests : 0;
+}
+
+sweet::CollisionShapeCache::Key::Key(ShapeType _type, float _a, float _b, float _c, float _d, unsigned long long int _hash) :
+	type(_type),
+	hash(_hash)
+{
+	params[0] = _a;
+	params[1] = _b;
+	params[2] = _c;
+	params[3] = _d;
+}
+
+bool sweet::CollisionShapeCache::Key::operator<(const Key & _other) const{
+	if(type != _other.type){
+		return type < _other.type;
+	}
+	for(unsigned long int i = 0; i < 4; ++i){
+		if(params[i] != _other.params[i]){
+			return params[i] < _other.params[i];
+		}
+	}
+	return hash < _other.hash;
+}
+
+sweet::CollisionShapeCache::Entry::Entry(const Key & _key) :
+	key(_key),
+	shape(nullptr),
+	references(1),
+	bytes(0),
+	seconds(0),
+	shared(false),
+	meshInterface(nullptr),
+	loadedBvh(nullptr),
+	bvhBuffer(nullptr)
+{
+}
+
+sweet::CollisionShapeCache::Entry::~Entry(){
+	// the shape references the BVH and the mesh interface, so it goes first
+	delete shape;
+	if(loadedBvh != nullptr){
+		// the BVH was deserialized in place, so only its destructor is called; the buffer is freed separately
+		static_cast<btQuantizedBvh *>(loadedBvh)->~btQuantizedBvh();
+	}
+	if(bvhBuffer != nullptr){
+		btAlignedFree(bvhBuffer);
+	}
+	delete meshInterface;
+}
+
+sweet::CollisionShapeCache::CollisionShapeCache() :
+	enabled(true)
+{
+}
+
+sweet::CollisionShapeCache::~CollisionShapeCache(){
+	for(auto e : entries){
+		delete e.second;
+	}
+}
+
+sweet::CollisionShapeCache & sweet::CollisionShapeCache::getInstance(){
+	static CollisionShapeCache * cache;
+	if(cache == nullptr){
+		cache = new CollisionShapeCache();
+	}
+	return *cache;
+}
+
+sweet::CollisionShapeCache::Entry * sweet::CollisionShapeCache::find(const Key & _key){
+	++stats.requests;
+	if(!enabled){
+		return nullptr;
+	}
+	auto it = shapes.find(_key);
+	if(it == shapes.end()){
+		return nullptr;
+	}
+	Entry * e = it->second;
+	++e->references;
+	++stats.hits;
+	++stats.references;
+	stats.unsharedBytes += e->bytes;
+	stats.secondsSaved += e->seconds;
+	return e;
+}
+
+btCollisionShape * sweet::CollisionShapeCache::add(Entry * _entry, btCollisionShape * _shape, unsigned long int _bytes, double _seconds){
+	_entry->shape = _shape;
+	_entry->bytes = _bytes;
+	_entry->seconds = _seconds;
+	_entry->shared = enabled;
+	if(_entry->shared){
+		shapes[_entry->key] = _entry;
+	}
+	entries[_shape] = _entry;
+
+	++stats.shapes;
+	++stats.references;
+	stats.bytes += _bytes;
+	stats.unsharedBytes += _bytes;
+	stats.seconds += _seconds;
+	return _shape;
+}
+
+btCollisionShape * sweet::CollisionShapeCache::getStaticPlane(float _normalX, float _normalY, float _normalZ, float _distanceFromOrigin){
+	Key key(kPLANE, _normalX, _normalY, _normalZ, _distanceFromOrigin);
+	Entry * e = find(key);
+	if(e != nullptr){
+		return e->shape;
+	}
+	double start = getSeconds();
+	btCollisionShape * shape = new btStaticPlaneShape(btVector3(_normalX, _normalY, _normalZ), _distanceFromOrigin);
+	return add(new Entry(key), shape, sizeof(btStaticPlaneShape), getSeconds() - start);
+}
+
+btCollisionShape * sweet::CollisionShapeCache::getBox(float _halfX, float _halfY, float _halfZ){
+	Key key(kBOX, _halfX, _halfY, _halfZ);
+	Entry * e = find(key);
+	if(e != nullptr){
+		return e->shape;
+	}
+	double start = getSeconds();
+	btCollisionShape * shape = new btBoxShape(btVector3(_halfX, _halfY, _halfZ));
+	return add(new Entry(key), shape, sizeof(btBoxShape), getSeconds() - start);
+}
+
+btCollisionShape * sweet::CollisionShapeCache::getSphere(float _radius){
+	Key key(kSPHERE, _radius);
+	Entry * e = find(key);
+	if(e != nullptr){
+		return e->shape;
+	}
+	double start = getSeconds();
+	btCollisionShape * shape = new btSphereShape(_radius);
+	return add(new Entry(key), shape, sizeof(btSphereShape), getSeconds() - start);
+}
+
+btCollisionShape * sweet::CollisionShapeCache::getCapsule(float _radius, float _height){
+	Key key(kCAPSULE, _radius, _height);
+	Entry * e = find(key);
+	if(e != nullptr){
+		return e->shape;
+	}
+	double start = getSeconds();
+	btCollisionShape * shape = new btCapsuleShape(_radius, _height);
+	return add(new Entry(key), shape, sizeof(btCapsuleShape), getSeconds() - start);
+}
+
+sweet::CollisionShapeCache::Key sweet::CollisionShapeCache::getMeshKey(const MeshInterface * _mesh, bool _convex){
+	// only the positions matter to the shape, so they're all that's hashed
+	unsigned long int vertexCount = _mesh->vertices.size();
+	unsigned long int indexCount = _convex ? 0 : _mesh->indices.size() / 3 * 3;
+	unsigned long long int hash = 0xCBF29CE484222325ULL;
+	for(unsigned long int i = 0; i < vertexCount; ++i){
+		const Vertex & v = _mesh->vertices[i];
+		float p[3] = {v.x, v.y, v.z};
+		hash = hashBytes(hash, p, sizeof(p));
+	}
+	if(indexCount > 0){
+		hash = hashBytes(hash, _mesh->indices.data(), indexCount * sizeof(GLuint));
+	}
+	return Key(_convex ? kCONVEX_MESH : kCONCAVE_MESH, (float)vertexCount, (float)indexCount, 0, 0, hash);
+}
+
+btCollisionShape * sweet::CollisionShapeCache::getMesh(const MeshInterface * _mesh, bool _convex){
+	double start = getSeconds();
+	Key key = getMeshKey(_mesh, _convex);
+	Entry * e = find(key);
+	if(e != nullptr){
+		return e->shape;
+	}
+
+	unsigned long int vertexCount = _mesh->vertices.size();
+	unsigned long int indexCount = (unsigned long int)key.params[1];
+	e = new Entry(key);
+	e->vertices.resize(vertexCount * 3);
+	for(unsigned long int i = 0; i < vertexCount; ++i){
+		const Vertex & v = _mesh->vertices[i];
+		e->vertices[i*3] = v.x;
+		e->vertices[i*3+1] = v.y;
+		e->vertices[i*3+2] = v.z;
+	}
+
+	if(_convex){
+		// passing the points in at once only calculates the bounds once, instead of once per point
+		btConvexHullShape * shape = new btConvexHullShape(e->vertices.data(), vertexCount, 3 * sizeof(btScalar));
+		e->vertices.clear();
+		e->vertices.shrink_to_fit();
+		return add(e, shape, sizeof(btConvexHullShape) + vertexCount * sizeof(btVector3), getSeconds() - start);
+	}
+
+	e->indices.assign(_mesh->indices.begin(), _mesh->indices.begin() + indexCount);
+	unsigned long int bytes = 0;
+	double secondsSaved = 0;
+	btBvhTriangleMeshShape * shape = createConcaveShape(e, bytes, secondsSaved);
+	btCollisionShape * res = add(e, shape, bytes, getSeconds() - start);
+	stats.secondsSaved += secondsSaved;
+	return res;
+}
+
+btBvhTriangleMeshShape * sweet::CollisionShapeCache::createConcaveShape(Entry * _entry, unsigned long int & _bytes, double & _secondsSaved){
+	// the shape indexes into the entry's copy of the mesh, rather than keeping another copy with a btTriangleMesh
+	_entry->meshInterface = new btTriangleIndexVertexArray(
+		_entry->indices.size() / 3, _entry->indices.data(), 3 * sizeof(int),
+		_entry->vertices.size() / 3, _entry->vertices.data(), 3 * sizeof(btScalar)
+	);
+	_bytes = sizeof(btBvhTriangleMeshShape) + sizeof(btTriangleIndexVertexArray) + _entry->vertices.size() * sizeof(btScalar) + _entry->indices.size() * sizeof(int);
+
+	btBvhTriangleMeshShape * shape;
+	double buildSeconds = 0;
+	double start = getSeconds();
+	if(enabled && !bvhDirectory.empty() && loadBvh(_entry->key, _entry, buildSeconds)){
+		shape = new btBvhTriangleMeshShape(_entry->meshInterface, true, false);
+		shape->setOptimizedBvh(_entry->loadedBvh);
+		_secondsSaved = buildSeconds - (getSeconds() - start);
+		++stats.bvhLoads;
+	}else{
+		shape = new btBvhTriangleMeshShape(_entry->meshInterface, true);
+		buildSeconds = getSeconds() - start;
+		++stats.bvhBuilds;
+		if(enabled && !bvhDirectory.empty()){
+			saveBvh(_entry->key, shape->getOptimizedBvh(), buildSeconds);
+		}
+	}
+	_bytes += shape->getOptimizedBvh()->calculateSerializeBufferSize();
+	return shape;
+}
+
+std::string sweet::CollisionShapeCache::getBvhFilename(const MeshInterface * _mesh) const{
+	return getBvhFilename(getMeshKey(_mesh, false));
+}
+
+std::string sweet::CollisionShapeCache::getBvhFilename(const Key & _key) const{
+	std::stringstream ss;
+	ss << bvhDirectory << "/" << std::hex << std::setw(16) << std::setfill('0') << _key.hash << ".bvh";
+	return ss.str();
+}
+
+bool sweet::CollisionShapeCache::loadBvh(const Key & _key, Entry * _entry, double & _buildSeconds){
+	std::ifstream file(getBvhFilename(_key), std::ios::in | std::ios::binary);
+	if(!file.is_open()){
+		return false;
+	}
+	BvhHeader header;
+	if(!file.read((char *)&header, sizeof(header))
+		|| memcmp(header.magic, "SBVH", 4) != 0
+		|| header.format != getBvhFormat()
+		|| header.hash != _key.hash
+		|| header.vertexCount != _key.params[0]
+		|| header.indexCount != _key.params[1]){
+		Log::warn("BVH file for mesh " + getBvhFilename(_key) + " doesn't match; rebuilding it");
+		return false;
+	}
+
+	// the BVH is deserialized in place, so the buffer has to be aligned and has to live as long as the shape
+	void * buffer = btAlignedAlloc(header.bufferSize, 16);
+	btOptimizedBvh * bvh = nullptr;
+	if(file.read((char *)buffer, header.bufferSize)){
+		bvh = btOptimizedBvh::deSerializeInPlace(buffer, header.bufferSize, false);
+	}
+	if(bvh == nullptr){
+		Log::warn("BVH file for mesh " + getBvhFilename(_key) + " couldn't be read; rebuilding it");
+		btAlignedFree(buffer);
+		return false;
+	}
+	_entry->loadedBvh = bvh;
+	_entry->bvhBuffer = buffer;
+	_buildSeconds = header.buildSeconds;
+	return true;
+}
+
+void sweet::CollisionShapeCache::saveBvh(const Key & _key, btOptimizedBvh * _bvh, double _buildSeconds){
+	BvhHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "SBVH", 4);
+	header.format = getBvhFormat();
+	header.hash = _key.hash;
+	header.vertexCount = _key.params[0];
+	header.indexCount = _key.params[1];
+	header.bufferSize = _bvh->calculateSerializeBufferSize();
+	header.buildSeconds = _buildSeconds;
+
+	void * buffer = btAlignedAlloc(header.bufferSize, 16);
+	// called through the base class, since newer versions of Bullet overload serialize
+	bool serialized = static_cast<btQuantizedBvh *>(_bvh)->serialize(buffer, header.bufferSize, false);
+	if(serialized){
+		std::ofstream file(getBvhFilename(_key), std::ios::out | std::ios::binary);
+		if(!file.is_open()){
+			Log::warn("BVH file " + getBvhFilename(_key) + " could not be opened for writing.");
+		}else{
+			file.write((const char *)&header, sizeof(header));
+			file.write((const char *)buffer, header.bufferSize);
+			if(file.good()){
+				++stats.bvhSaves;
+			}
+		}
+	}
+	btAlignedFree(buffer);
+}
+
+bool sweet::CollisionShapeCache::release(btCollisionShape * _shape){
+	auto it = entries.find(_shape);
+	if(it == entries.end()){
+		return false;
+	}
+	Entry * e = it->second;
+	--stats.references;
+	stats.unsharedBytes -= e->bytes;
+	if(--e->references == 0){
+		if(e->shared){
+			shapes.erase(e->key);
+		}
+		entries.erase(it);
+		--stats.shapes;
+		stats.bytes -= e->bytes;
+		delete e;
+	}
+	return true;
+}
+
+bool sweet::CollisionShapeCache::isCached(const btCollisionShape * _shape) const{
+	return entries.find(_shape) != entries.end();
+}
+
+unsigned long int sweet::CollisionShapeCache::getReferenceCount(const btCollisionShape * _shape) const{
+	auto it = entries.find(_shape);
+	return it == entries.end() ? 0 : it->second->references;
+}
+
+const sweet::CollisionShapeCache::Stats & sweet::CollisionShapeCache::getStats() const{
+	return stats;
+}
+
+void sweet::CollisionShapeCache::resetStats(){
+	stats.requests = 0;
+	stats.hits = 0;
+	stats.bvhBuilds = 0;
+	stats.bvhLoads = 0;
+	stats.bvhSaves = 0;
+	stats.seconds = 0;
+	stats.secondsSaved = 0;
+}
+
+std::string sweet::CollisionShapeCache::getReport() const{
+	std::stringstream ss;
+	ss << std::fixed << std::setprecision(1);
+	ss << "Collision shapes: " << stats.shapes << " shapes, " << stats.references << " references, "
+		<< stats.requests << " requests (" << stats.getHitRate() * 100 << "% hits)" << std::endl;
+	ss << "  Memory: " << stats.bytes / 1024.0 << " KB, " << (stats.unsharedBytes - stats.bytes) / 1024.0 << " KB saved by sharing" << std::endl;
+	ss << "  BVHs: " << stats.bvhBuilds << " built, " << stats.bvhLoads << " loaded, " << stats.bvhSaves << " saved" << std::endl;
+	ss << "  Time: " << stats.seconds * 1000 << " ms creating shapes, " << stats.secondsSaved * 1000 << " ms saved by sharing and loading" << std::endl;
+	return ss.str();
+}
\ No newline at end of file
@@ -5,9 +5,23 @@
 
 Command::Command() :
 	executed(false),
-	firstRun(true)
+	firstRun(true),
+	historySize(0),
+	archived(false)
 {
 }
 
 Command::~Command(){
+}
+
+unsigned long int Command::getSize(){
+	return sizeof(Command) + subCmdProc.getHistorySize();
+}
+
+bool Command::coalesce(Command * _next){
+	return false;
+}
+
+Command::Deserializer Command::serialize(std::string & _delta){
+	return nullptr;
 }
\ No newline at end of file
@@ -5,10 +5,15 @@
 #include "CommandProcessor.h"
 #include "Command.h"
 #include "CompressedCommand.h"
+#include "SerializedCommand.h"
 #include "Log.h"
 
 CommandProcessor::CommandProcessor(void) :
-	currentCompressedCommand(nullptr)
+	byteBudget(0),
+	liveCommands(32),
+	coalesceCommands(true),
+	currentCompressedCommand(nullptr),
+	historySize(0)
 {
 }
 
@@ -25,18 +30,34 @@ bool CommandProcessor::executeCommand(Command * c){
 		}
 	}else{
 		redoStack.push_back(c);
-		if(!redo()){
+		track(c);
+		// the history is trimmed below, once the command has had a chance to coalesce with the previous one
+		if(!redoNext()){
 			return false;
 		}else{
 			c->firstRun = false;
 		}
+
+		// fold the command into the previous one if it'll let us
+		if(coalesceCommands && undoStack.size() > 1){
+			Command * prev = undoStack.at(undoStack.size() - 2);
+			if(prev->coalesce(c)){
+				undoStack.pop_back();
+				untrack(c);
+				delete c;
+				untrack(prev);
+				track(prev);
+			}
+		}
 	}
 
 	// Executing a new command will always clear the redoStack
 	while(redoStack.size() > 0){
+		untrack(redoStack.back());
 		delete redoStack.back();
 		redoStack.pop_back();
 	}
+	trimHistory();
 	return true;
 }
 
@@ -53,10 +74,12 @@ void CommandProcessor::endCompressing(){
 	if(currentCompressedCommand != nullptr){
 		if(currentCompressedCommand->firstRun){
 			undoStack.push_back(currentCompressedCommand);
+			track(currentCompressedCommand);
 		}else{
 			delete currentCompressedCommand;
 		}
 		currentCompressedCommand = nullptr;
+		trimHistory();
 	}
 }
 
@@ -66,6 +89,7 @@ bool CommandProcessor::undo(){
 		Command * c = undoStack.back();
 		bool success = c->unexecute();
 		undoStack.pop_back();
+		untrack(c);
 		// Log command's entries
 		for(unsigned long int i = 0; i < c->subCmdProc.consoleEntries.size(); ++i){
 			consoleEntries.push_back(c->subCmdProc.consoleEntries.at(i));
@@ -75,20 +99,29 @@ bool CommandProcessor::undo(){
 		if(success){
 			c->executed = false;
 			redoStack.push_back(c);
+			track(c);
 		}else{
 			delete c;
 		}
+		trimHistory();
 		return success;
 	}
 	return true;
 }
 
 bool CommandProcessor::redo(){
+	bool success = redoNext();
+	trimHistory();
+	return success;
+}
+
+bool CommandProcessor::redoNext(){
 	//log("redo");
 	if (redoStack.size() > 0){
 		Command * c = redoStack.back();
 		bool success = c->execute();
 		redoStack.pop_back();
+		untrack(c);
 		// Log command's entries
 		for(unsigned long int i = 0; i < c->subCmdProc.consoleEntries.size(); ++i){
 			consoleEntries.push_back(c->subCmdProc.consoleEntries.at(i));
@@ -97,6 +130,7 @@ bool CommandProcessor::redo(){
 		if(success){
 			c->executed = true;
 			undoStack.push_back(c);
+			track(c);
 		}else{
 			delete c;
 		}
@@ -127,6 +161,78 @@ void CommandProcessor::reset(){
 		delete redoStack.back();
 		redoStack.pop_back();
 	}
+	historySize = 0;
+}
+
+void CommandProcessor::archiveAll(){
+	for(unsigned long int i = 0; i < undoStack.size(); ++i){
+		archive(undoStack.at(i));
+	}
+	for(unsigned long int i = 0; i < redoStack.size(); ++i){
+		archive(redoStack.at(i));
+	}
+}
+
+unsigned long int CommandProcessor::getHistorySize() const{
+	return historySize;
+}
+
+unsigned long int CommandProcessor::getUndoCount() const{
+	return undoStack.size();
+}
+
+unsigned long int CommandProcessor::getRedoCount() const{
+	return redoStack.size();
+}
+
+void CommandProcessor::track(Command * _c){
+	_c->historySize = _c->getSize();
+	historySize += _c->historySize;
+}
+
+void CommandProcessor::untrack(Command * _c){
+	historySize -= _c->historySize;
+}
+
+void CommandProcessor::archive(Command *& _c){
+	untrack(_c);
+	std::string delta;
+	Command::Deserializer deserializer = _c->serialize(delta);
+	if(deserializer != nullptr){
+		SerializedCommand * s = new SerializedCommand(deserializer, delta);
+		s->executed = _c->executed;
+		delete _c;
+		_c = s;
+	}else{
+		_c->subCmdProc.archiveAll();
+		_c->archived = true;
+	}
+	track(_c);
+}
+
+void CommandProcessor::trimHistory(){
+	// archive everything outside the live range on either side of the current state
+	// everything further out than an archived command will already have been archived, so each stack can stop at the first one it finds
+	for(unsigned long int i = undoStack.size(); i > liveCommands && !undoStack.at(i - 1 - liveCommands)->archived; --i){
+		archive(undoStack.at(i - 1 - liveCommands));
+	}
+	for(unsigned long int i = redoStack.size(); i > liveCommands && !redoStack.at(i - 1 - liveCommands)->archived; --i){
+		archive(redoStack.at(i - 1 - liveCommands));
+	}
+
+	if(byteBudget != 0){
+		// the redo commands furthest from the current state go first, since they're lost as soon as a new command is executed anyway
+		while(historySize > byteBudget && redoStack.size() > 0){
+			untrack(redoStack.front());
+			delete redoStack.front();
+			redoStack.pop_front();
+		}
+		while(historySize > byteBudget && undoStack.size() > 1){
+			untrack(undoStack.front());
+			delete undoStack.front();
+			undoStack.pop_front();
+		}
+	}
 }
 
 
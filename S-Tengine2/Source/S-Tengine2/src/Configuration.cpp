@@ -33,6 +33,7 @@ Configuration::Configuration() :
 	title("Untitled"),
 	useLibOVR(false),
 	nodeCounting(false),
+	workerThreads(-1),
 	windowDecorated(true),
 	windowResizable(true)
 {
@@ -77,6 +78,7 @@ void Configuration::load(const std::string & _filename){
 		monitor = json.get("monitor", monitorDefault).asInt();
 		useLibOVR = json.get("useLibOVR", false).asBool();
 		nodeCounting = json.get("nodeCounting", false).asBool();
+		workerThreads = json.get("workerThreads", -1).asInt();
 		
 		generateMipmapsDefault = json.get("generateMipmapsDefault", true).asBool();
 		scaleModeMagDefault = getScaleMode(json.get("scaleModeMagDefault", "GL_LINEAR").asString());
@@ -112,6 +114,7 @@ void Configuration::save(const std::string & _filename){
 	json["monitor"] = monitor;
 	json["useLibOVR"] = useLibOVR;
 	json["nodeCounting"] = nodeCounting;
+	json["workerThreads"] = workerThreads;
 	json["title"] = title;
 	json["gain"] = Json::Value();
 	for(auto g : gain){
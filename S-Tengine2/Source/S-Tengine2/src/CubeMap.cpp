@@ -33,4 +33,8 @@ void CubeMap::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderO
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture->textureId);
 	MeshEntity::render(_matrixStack, _renderOption);
+}
+
+bool CubeMap::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	return false;
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "DrawData.h"
+#include "Texture.h"
+#include "Rectangle.h"
+
+DrawData::DrawData() :
+	colour(1.f),
+	uvRect(0.f, 1.f, 1.f, -1.f),
+	spriteSheet(nullptr),
+	frame(-1)
+{
+}
+
+DrawData::~DrawData(){
+	clearTextures();
+}
+
+void DrawData::pushTexture2D(Texture * _texture){
+	_texture->incrementReferenceCount();
+	textures.push_back(_texture);
+}
+
+void DrawData::clearTextures(){
+	while(textures.size() > 0){
+		textures.back()->decrementAndDelete();
+		textures.pop_back();
+	}
+}
+
+void DrawData::replaceTextures(Texture * _texture){
+	if(textures.size() == 1 && textures.at(0) == _texture){
+		return;
+	}
+	// hold on to _texture in case it's only referenced by this
+	_texture->incrementReferenceCount();
+	clearTextures();
+	textures.push_back(_texture);
+}
+
+void DrawData::setUvRect(const sweet::Rectangle & _rect){
+	uvRect = glm::vec4(_rect.x, _rect.y, _rect.width, _rect.height);
+}
+
+void DrawData::resetUvRect(){
+	uvRect = glm::vec4(0.f, 1.f, 1.f, -1.f);
+}
\ No newline at end of file
@@ -12,7 +12,8 @@
 Entity::Entity() :
 	childTransform(new Transform()),
 	childTransformExists(true),
-	active(true)
+	active(true),
+	parallelUpdate(false)
 {
 }
 
@@ -36,6 +37,10 @@ void Entity::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOp
 	childTransform->render(_matrixStack, _renderOptions);
 }
 
+bool Entity::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	return childTransform->getBoundingBox(_min, _max);
+}
+
 void Entity::update(Step * _step){
 	if(!active){
 		return;
@@ -43,6 +48,10 @@ void Entity::update(Step * _step){
 	childTransform->update(_step);
 }
 
+bool Entity::isParallelUpdateSafe(){
+	return parallelUpdate;
+}
+
 void Entity::unload(){
 	childTransform->unload();
 	NodeLoadable::unload();
@@ -95,6 +95,16 @@ void sweet::Event::setStringData(std::string _key, std::string _val){
 	dataString[_key] = _val;
 }
 
+const std::map<std::string, int> & sweet::Event::getAllIntData() const{
+	return dataInt;
+}
+const std::map<std::string, float> & sweet::Event::getAllFloatData() const{
+	return dataFloat;
+}
+const std::map<std::string, std::string> & sweet::Event::getAllStringData() const{
+	return dataString;
+}
+
 sweet::EventManager::EventManager(){
 }
 
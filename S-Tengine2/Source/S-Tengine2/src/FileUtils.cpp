@@ -19,6 +19,22 @@ std::string sweet::FileUtils::readFile(const std::string & _filename){
 	return contents.str();
 }
 
+std::string sweet::FileUtils::readBinaryFile(const std::string & _filename){
+	std::ifstream file(_filename, std::ios::in | std::ios::binary);
+	std::stringstream contents;
+
+	if(file.is_open()){
+		Log::info("File \"" + _filename + "\" opened for reading.");
+		contents << file.rdbuf();
+		file.close();
+		Log::info("File \"" + _filename + "\" read.");
+	}else{
+		Log::error("File \"" + _filename + "\" could not be opened for reading.");
+	}
+
+	return contents.str();
+}
+
 bool sweet::FileUtils::createDirectoryIfNotExists(const std::string & _src){
 	return CreateDirectoryA(_src.c_str(), NULL) != ERROR_PATH_NOT_FOUND;
 }
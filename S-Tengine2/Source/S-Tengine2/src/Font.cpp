@@ -3,6 +3,7 @@
 #include <Font.h>
 #include <Sweet.h>
 #include <MeshFactory.h>
+#include <AssetArchive.h>
 
 GlyphMesh::GlyphMesh(FT_GlyphSlot _glyph, bool _antiAliased) :
 	QuadMesh(false),
@@ -35,7 +36,7 @@ void GlyphMesh::set(FT_GlyphSlot _glyph, bool _antiAliased){
 	
 	vertices.at(3).x = vx;
 	vertices.at(3).y = vy - h;
-	dirty = true;
+	makeDirty();
 
 	// set the scale mode
 	if(!_antiAliased){
@@ -140,7 +141,17 @@ Font::Font(std::string _fontSrc, float _size, bool _autoRelease, FontScaleMode _
 	size(_size),
 	scaleMode(_scaleMode)
 {
-	if(FT_New_Face(sweet::freeTypeLibrary, _fontSrc.c_str(), 0, &face) != 0) {
+	// use the packed copy if there is one
+	size_t packedSize;
+	const unsigned char * packed = sweet::AssetArchive::getFile(_fontSrc, packedSize, fileData);
+	if(packed != nullptr){
+		if(packed != (const unsigned char *)fileData.data()){
+			fileData.assign((const char *)packed, packedSize);
+		}
+		if(FT_New_Memory_Face(sweet::freeTypeLibrary, (const FT_Byte *)fileData.data(), fileData.size(), 0, &face) != 0) {
+			Log::error("Couldn't load font: " + _fontSrc);
+		}
+	}else if(FT_New_Face(sweet::freeTypeLibrary, _fontSrc.c_str(), 0, &face) != 0) {
 		Log::error("Couldn't load font: " + _fontSrc);
 	}
 	lineGapRatio = 1.f;
@@ -6,7 +6,9 @@ FrameBufferChannel::FrameBufferChannel(GLint _internalFormat, GLenum _attachment
 	attachmentType(_attachmentType),
 	size(_size),
 	format(_format),
-	numChannels(0)
+	numChannels(0),
+	id(0),
+	owned(true)
 {
 	// derive the number of channels from the internal format
 	switch(internalFormat){
@@ -16,4 +18,20 @@ FrameBufferChannel::FrameBufferChannel(GLint _internalFormat, GLenum _attachment
 	case GL_R: case GL_LUMINANCE: case GL_DEPTH_COMPONENT: numChannels = 1; break;
 	default: throw "unsupported FBO format";
 	}
+}
+
+unsigned long int FrameBufferChannel::getBytesPerPixel() const{
+	// drivers store depth as (at least) 24 bits, padded to 32
+	if(internalFormat == GL_DEPTH_COMPONENT){
+		return 4;
+	}
+	// render buffers don't have a data type; assume a byte per channel
+	if(channelType == RENDER_BUFFER){
+		return numChannels;
+	}
+	switch(size){
+	case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return numChannels * 2;
+	case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: return numChannels * 4;
+	default: return numChannels;
+	}
 }
\ No newline at end of file
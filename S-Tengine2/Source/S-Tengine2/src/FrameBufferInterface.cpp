@@ -2,6 +2,7 @@
 
 #include <FrameBufferInterface.h>
 #include <Log.h>
+#include <Profiler.h>
 
 #include <iostream>
 #include <sstream>
@@ -9,6 +10,35 @@
 #include <stb/stb_image_write.h>
 
 std::stack<GLuint> FrameBufferInterface::fboStack;
+GLuint FrameBufferInterface::boundFbo = 0;
+bool FrameBufferInterface::boundFboKnown = false;
+unsigned long int FrameBufferInterface::bindCount = 0;
+unsigned long int FrameBufferInterface::skippedBindCount = 0;
+
+void FrameBufferInterface::bind(GLuint _fboId){
+	if(boundFboKnown && boundFbo == _fboId){
+		++skippedBindCount;
+		return;
+	}
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, _fboId);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _fboId);
+	boundFbo = _fboId;
+	boundFboKnown = true;
+	++bindCount;
+	SWEET_PROFILE_COUNT(kFRAMEBUFFER_BINDS, 1);
+}
+
+void FrameBufferInterface::invalidateBinding(){
+	boundFboKnown = false;
+}
+
+unsigned long int FrameBufferInterface::getBindCount(){
+	return bindCount;
+}
+
+unsigned long int FrameBufferInterface::getSkippedBindCount(){
+	return skippedBindCount;
+}
 
 void FrameBufferInterface::pushFbo(){
 	pushFbo(this);
@@ -16,9 +46,7 @@ void FrameBufferInterface::pushFbo(){
 
 void FrameBufferInterface::pushFbo(GLuint _fboIdToBind){
 	fboStack.push(_fboIdToBind);
-	
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, _fboIdToBind);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _fboIdToBind);
+	bind(_fboIdToBind);
 }
 
 void FrameBufferInterface::pushFbo(FrameBufferInterface * const _fboToBind){
@@ -31,9 +59,7 @@ void FrameBufferInterface::popFbo(){
 	// the new top is the previously bound FBO, so we need to rebind it
 	// if there is no top, we need to bind the default FBO instead
 	GLuint fboToBind = (fboStack.size() > 0) ? fboStack.top() : 0;
-	
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, fboToBind);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fboToBind);
+	bind(fboToBind);
 }
 
 FrameBufferInterface::FrameBufferInterface(std::vector<FrameBufferChannel> _frameBufferChannels, unsigned long int _width, unsigned long int _height, bool _autoRelease):
@@ -58,27 +84,33 @@ void FrameBufferInterface::load(){
 	// we need to bind the framebuffer in order to configure it
 	pushFbo();
 	for(unsigned long int i = 0; i < frameBufferChannels.size(); i++){
-		switch (frameBufferChannels.at(i).channelType){
+		FrameBufferChannel & channel = frameBufferChannels.at(i);
+		switch (channel.channelType){
 		case FrameBufferChannel::TEXTURE :
-			glGenTextures(1, &frameBufferChannels.at(i).id);
-			glBindTexture(GL_TEXTURE_2D, frameBufferChannels.at(i).id);
-			glTexImage2D(GL_TEXTURE_2D, 0, frameBufferChannels.at(i).internalFormat, width, height, 0,
-				frameBufferChannels.at(i).format, frameBufferChannels.at(i).size, 0);
-
-			// Texture scaling mode
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, scaleModeMag);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, scaleModeMin);
-			if(frameBufferChannels.at(i).attachmentType == GL_COLOR_ATTACHMENT0){
-				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + colorAttachmentCount, GL_TEXTURE_2D, frameBufferChannels.at(i).id, 0);
-			}else{
-				glFramebufferTexture2D(GL_FRAMEBUFFER, frameBufferChannels.at(i).attachmentType, GL_TEXTURE_2D, frameBufferChannels.at(i).id, 0);
+			if(channel.owned){
+				glGenTextures(1, &channel.id);
+				allocateStorage(i);
+
+				// Texture scaling mode
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, scaleModeMag);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, scaleModeMin);
+			}
+			if(channel.id != 0){
+				if(channel.attachmentType == GL_COLOR_ATTACHMENT0){
+					glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + colorAttachmentCount, GL_TEXTURE_2D, channel.id, 0);
+				}else{
+					glFramebufferTexture2D(GL_FRAMEBUFFER, channel.attachmentType, GL_TEXTURE_2D, channel.id, 0);
+				}
 			}
 			break;
 		case FrameBufferChannel::RENDER_BUFFER :
-			glGenRenderbuffers(1, &frameBufferChannels.at(i).id);
-			glBindRenderbuffer(GL_RENDERBUFFER, frameBufferChannels.at(i).id);
-			glRenderbufferStorage(GL_RENDERBUFFER, frameBufferChannels.at(i).internalFormat, width, height);
-			glFramebufferRenderbuffer(GL_FRAMEBUFFER, frameBufferChannels.at(i).attachmentType, GL_RENDERBUFFER, frameBufferChannels.at(i).id);
+			if(channel.owned){
+				glGenRenderbuffers(1, &channel.id);
+				allocateStorage(i);
+			}
+			if(channel.id != 0){
+				glFramebufferRenderbuffer(GL_FRAMEBUFFER, channel.attachmentType, GL_RENDERBUFFER, channel.id);
+			}
 			break;
 		}
 	}
@@ -89,9 +121,17 @@ void FrameBufferInterface::load(){
 }
 
 void FrameBufferInterface::unload(){
+	// deleting the bound framebuffer binds the default one instead
+	if(boundFbo == frameBufferId){
+		boundFbo = 0;
+	}
 	glDeleteFramebuffers(1, &frameBufferId);
 	frameBufferId = 0;
 	for(unsigned long int i = 0; i < frameBufferChannels.size(); i++){
+		// buffers which aren't owned are deleted by whatever created them
+		if(!frameBufferChannels.at(i).owned){
+			continue;
+		}
 		switch (frameBufferChannels.at(i).channelType){
 		case FrameBufferChannel::TEXTURE :
 			glDeleteTextures(1, &frameBufferChannels.at(i).id);
@@ -116,13 +156,51 @@ bool FrameBufferInterface::resize(unsigned long _width, unsigned long _height){
 	if(width != _width || height != _height){
 		width  = _width;
 		height = _height;
-		unload();
-		load();
+		// channels added since the last load don't have buffers yet, so they need a full reload
+		bool created = loaded;
+		for(unsigned long int i = 0; i < frameBufferChannels.size() && created; i++){
+			created = !frameBufferChannels.at(i).owned || frameBufferChannels.at(i).id != 0;
+		}
+		if(created){
+			// the attachments keep their ids, so the framebuffer itself doesn't need to be touched
+			for(unsigned long int i = 0; i < frameBufferChannels.size(); i++){
+				if(frameBufferChannels.at(i).owned){
+					allocateStorage(i);
+				}
+			}
+		}else{
+			unload();
+			load();
+		}
 		return true;
 	}
 	return false;
 }
 
+void FrameBufferInterface::allocateStorage(unsigned long int _index){
+	const FrameBufferChannel & channel = frameBufferChannels.at(_index);
+	switch (channel.channelType){
+	case FrameBufferChannel::TEXTURE :
+		glBindTexture(GL_TEXTURE_2D, channel.id);
+		glTexImage2D(GL_TEXTURE_2D, 0, channel.internalFormat, width, height, 0, channel.format, channel.size, 0);
+		break;
+	case FrameBufferChannel::RENDER_BUFFER :
+		glBindRenderbuffer(GL_RENDERBUFFER, channel.id);
+		glRenderbufferStorage(GL_RENDERBUFFER, channel.internalFormat, width, height);
+		break;
+	}
+}
+
+unsigned long int FrameBufferInterface::getByteSize() const{
+	unsigned long int res = 0;
+	for(unsigned long int i = 0; i < frameBufferChannels.size(); i++){
+		if(frameBufferChannels.at(i).owned){
+			res += width * height * frameBufferChannels.at(i).getBytesPerPixel();
+		}
+	}
+	return res;
+}
+
 GLenum FrameBufferInterface::checkFrameBufferStatus(){
 	GLuint status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
 	switch(status) {
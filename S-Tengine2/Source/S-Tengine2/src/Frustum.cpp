@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Frustum.h>
+
+sweet::Frustum::Frustum(){
+	for(unsigned long int i = 0; i < 6; ++i){
+		planes[i] = glm::vec4(0);
+	}
+}
+
+void sweet::Frustum::set(const glm::mat4 & _viewProjection){
+	// glm is column-major, so the rows have to be pulled out manually
+	glm::vec4 rows[4];
+	for(unsigned long int i = 0; i < 4; ++i){
+		rows[i] = glm::vec4(_viewProjection[0][i], _viewProjection[1][i], _viewProjection[2][i], _viewProjection[3][i]);
+	}
+
+	planes[kLEFT]	= rows[3] + rows[0];
+	planes[kRIGHT]	= rows[3] - rows[0];
+	planes[kBOTTOM]	= rows[3] + rows[1];
+	planes[kTOP]	= rows[3] - rows[1];
+	planes[kNEAR]	= rows[3] + rows[2];
+	planes[kFAR]	= rows[3] - rows[2];
+
+	for(unsigned long int i = 0; i < 6; ++i){
+		float l = glm::length(glm::vec3(planes[i]));
+		if(l > 0){
+			planes[i] /= l;
+		}
+	}
+}
+
+bool sweet::Frustum::intersects(const glm::vec3 & _min, const glm::vec3 & _max) const{
+	glm::vec3 center = (_max + _min) * 0.5f;
+	glm::vec3 extents = (_max - _min) * 0.5f;
+	for(unsigned long int i = 0; i < 6; ++i){
+		glm::vec3 n(planes[i]);
+		// distance from the center to the plane, and the projected "radius" of the box onto the plane normal
+		float d = glm::dot(n, center) + planes[i].w;
+		float r = glm::dot(glm::abs(n), extents);
+		if(d + r < 0){
+			// entirely behind one of the planes
+			return false;
+		}
+	}
+	return true;
+}
+
+bool sweet::Frustum::intersects(const glm::vec3 & _min, const glm::vec3 & _max, const glm::mat4 & _model) const{
+	glm::vec3 worldMin, worldMax;
+	transformBounds(_min, _max, _model, worldMin, worldMax);
+	return intersects(worldMin, worldMax);
+}
+
+void sweet::Frustum::transformBounds(const glm::vec3 & _min, const glm::vec3 & _max, const glm::mat4 & _matrix, glm::vec3 & _resMin, glm::vec3 & _resMax){
+	// transform the center and project the extents onto the new axes (Arvo)
+	glm::vec3 center = (_max + _min) * 0.5f;
+	glm::vec3 extents = (_max - _min) * 0.5f;
+
+	glm::vec3 newCenter(_matrix * glm::vec4(center, 1));
+	glm::vec3 newExtents(0);
+	for(unsigned long int i = 0; i < 3; ++i){
+		newExtents += glm::abs(glm::vec3(_matrix[i])) * extents[i];
+	}
+
+	_resMin = newCenter - newExtents;
+	_resMax = newCenter + newExtents;
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <Game.h>
 #include <Keyboard.h>
 #include <Mouse.h>
+#include <InputEventQueue.h>
+#include <RenderTargetPool.h>
 #include <sweet.h>
 #include <MatrixStack.h>
 #include <RenderOptions.h>
@@ -13,6 +15,7 @@
 #include <Scene_Splash_SweetHeartSquad.h>
 #include <MeshInterface.h>
 #include <Log.h>
+#include <Profiler.h>
 #include <scenario/Scenario.h>
 
 // for screenshots
@@ -44,6 +47,7 @@ Game::Game(std::string _firstSceneKey, Scene * _firstScene, bool _isRunning) :
 	scenes.insert(std::pair<std::string, Scene *>(_firstSceneKey, _firstScene));
 	currentScene = _firstScene;
 	currentSceneKey = _firstSceneKey;
+	sceneCensus = sweet::NodeCensus::getInstance().takeSnapshot();
 }
 
 void Game::addSplashes(){
@@ -79,15 +83,35 @@ void Game::performGameLoop(){
 	if(accumulator >= sweet::step.targetFrameDuration){
 		accumulator -= sweet::step.targetFrameDuration;
 #endif
+		SWEET_PROFILE_FRAME();
 		sweet::calculateDeltaTimeCorrection();
-		glfwPollEvents();
+		{
+			SWEET_PROFILE_SCOPE("glfwPollEvents");
+			glfwPollEvents();
+			// apply the events collected while polling to the keyboard and mouse
+			sweet::InputEventQueue::getInstance().dispatch(glfwGetTime());
+		}
 		update(&sweet::step);
 
 		if(switchingScene){
+			sweet::NodeCensus & census = sweet::NodeCensus::getInstance();
+			sweet::NodeCensus::Snapshot before;
+			if(sweet::config.nodeCounting){
+				before = census.takeSnapshot();
+			}
 			if(deleteOldScene){
 				delete currentScene;
 				scenes.erase(currentSceneKey);
 			}
+			if(sweet::config.nodeCounting){
+				sweet::NodeCensus::Snapshot after = census.takeSnapshot();
+				Log::info("Switching from \"" + currentSceneKey + "\" to \"" + newSceneKey + "\"\n" + sweet::NodeCensus::getDiffReport(before, after));
+				if(deleteOldScene){
+					// anything still alive which was created while the old scene was current was either leaked or handed to another scene
+					Log::info(census.getLeakReport(sceneCensus, before));
+				}
+				sceneCensus = after;
+			}
 			currentSceneKey = newSceneKey;
 			currentScene = scenes.at(currentSceneKey);
 			switchingScene = false;
@@ -103,17 +127,20 @@ void Game::performGameLoop(){
 }
 
 void Game::update(Step * _step){
+	SWEET_PROFILE_FUNCTION();
 	if(printFPS){
 		printFps();
 	}
 	if(sweet::focused){
 		if(currentScene != nullptr/* && sweet::step.deltaTimeCorrection < 5*/){
+			SWEET_PROFILE_SCOPE("Scene::update");
 			currentScene->update(_step);
 		}
 	}
 }
 
 void Game::draw(Scene * _scene){
+	SWEET_PROFILE_FUNCTION();
 	int width, height;
 	glfwGetFramebufferSize(sweet::currentContext, &width, &height);
 	if(width <= 0 || height <= 0) {
@@ -130,27 +157,36 @@ void Game::draw(Scene * _scene){
 	}
 	if(_scene != nullptr){
 		ro.lights = &_scene->lights;
-		for(auto s : Shader::allShaders){
-			ComponentShaderBase * sb = dynamic_cast<ComponentShaderBase *>(s);
-			if(sb != nullptr){
-				sb->lightingDirty = true;
-			}
-			if(s->bindShader()){
-				ro.shader = s;
-				s->clean(&ms, &ro, nullptr);
-				checkForGlError(false);
+		{
+			SWEET_PROFILE_SCOPE("Shader::allShaders clean");
+			for(auto s : Shader::allShaders){
+				ComponentShaderBase * sb = dynamic_cast<ComponentShaderBase *>(s);
+				if(sb != nullptr){
+					sb->lightingDirty = true;
+				}
+				if(s->bindShader()){
+					ro.shader = s;
+					s->clean(&ms, &ro, nullptr);
+					checkForGlError(false);
+				}
 			}
 		}
 		ro.shader = nullptr;
+		SWEET_PROFILE_SCOPE("Scene::render");
 		_scene->render(&ms, &ro);
 	}
+	renderStats = ro.stats;
 	if(sweet::drawAntTweakBar && sweet::antTweakBarInititialized) {
 		TwDraw();
 	}
+	SWEET_PROFILE_SCOPE("glfwSwapBuffers");
 	glfwSwapBuffers(sweet::currentContext);
+	// targets released this frame stay in the pool for the next one; older ones are freed
+	sweet::RenderTargetPool::getInstance().endFrame();
 }
 
 void Game::manageInput(){
+	SWEET_PROFILE_FUNCTION();
 	keyboard.update(nullptr);
 	mouse.update(nullptr);
 }
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <InputEventQueue.h>
+#include <Keyboard.h>
+#include <Mouse.h>
+#include <Log.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <GLFW/glfw3.h>
+
+sweet::InputEvent::InputEvent() :
+	type(kKEY_DOWN),
+	code(0),
+	mods(0),
+	x(0),
+	y(0),
+	time(0),
+	frame(0)
+{
+}
+
+sweet::InputEvent::InputEvent(Type _type, int _code, int _mods, double _x, double _y, double _time) :
+	type(_type),
+	code(_code),
+	mods(_mods),
+	x(_x),
+	y(_y),
+	time(_time),
+	frame(0)
+{
+}
+
+sweet::InputEventQueue::InputEventQueue() :
+	historyDuration(2.0),
+	head(0),
+	tail(0),
+	dropped(0),
+	frame(0),
+	recording(false),
+	recordingStartFrame(0),
+	recordingStartTime(0),
+	replaying(false),
+	replayStartFrame(0),
+	replayStartTime(0),
+	replayIndex(0)
+{
+}
+
+sweet::InputEventQueue::~InputEventQueue(){
+}
+
+bool sweet::InputEventQueue::push(const InputEvent & _event){
+	unsigned long int t = tail.load(std::memory_order_relaxed);
+	if(t - head.load(std::memory_order_acquire) >= CAPACITY){
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	ring[t & (CAPACITY - 1)] = _event;
+	tail.store(t + 1, std::memory_order_release);
+	return true;
+}
+
+void sweet::InputEventQueue::dispatch(double _time){
+	frameEvents.clear();
+
+	// drain the ring; while replaying, live events are dropped
+	unsigned long int h = head.load(std::memory_order_relaxed);
+	unsigned long int t = tail.load(std::memory_order_acquire);
+	for(; h != t; ++h){
+		if(!replaying){
+			apply(ring[h & (CAPACITY - 1)]);
+		}
+	}
+	head.store(h, std::memory_order_release);
+
+	if(replaying){
+		while(replayIndex < replayEvents.size() && replayEvents.at(replayIndex).frame + replayStartFrame <= frame){
+			InputEvent e = replayEvents.at(replayIndex);
+			e.time += replayStartTime;
+			apply(e);
+			++replayIndex;
+		}
+		if(replayIndex >= replayEvents.size()){
+			replaying = false;
+		}
+	}
+
+	// forget events which are too old to be asked about
+	while(history.size() > 0 && history.front().time < _time - historyDuration){
+		history.pop_front();
+	}
+
+	++frame;
+}
+
+void sweet::InputEventQueue::apply(InputEvent _event){
+	_event.frame = frame;
+	switch(_event.type){
+		case InputEvent::kKEY_DOWN:
+		case InputEvent::kKEY_UP:
+		{
+			Keyboard & keyboard = Keyboard::getInstance();
+			keyboard.alt = (_event.mods & GLFW_MOD_ALT) != 0;
+			keyboard.shift = (_event.mods & GLFW_MOD_SHIFT) != 0;
+			keyboard.control = (_event.mods & GLFW_MOD_CONTROL) != 0;
+			keyboard.super = (_event.mods & GLFW_MOD_SUPER) != 0;
+			if(_event.type == InputEvent::kKEY_DOWN){
+				keyboard.keyDownListener(_event.code);
+			}else{
+				keyboard.keyUpListener(_event.code);
+			}
+			break;
+		}
+		case InputEvent::kMOUSE_DOWN:
+			Mouse::getInstance().mouseDownListener(_event.code);
+			break;
+		case InputEvent::kMOUSE_UP:
+			Mouse::getInstance().mouseUpListener(_event.code);
+			break;
+		case InputEvent::kMOUSE_MOVE:
+			Mouse::getInstance().mousePositionListener(_event.x, _event.y);
+			break;
+		case InputEvent::kMOUSE_WHEEL:
+			Mouse::getInstance().mouseWheelListener(_event.y);
+			break;
+	}
+
+	frameEvents.push_back(_event);
+	history.push_back(_event);
+	if(recording){
+		_event.frame -= recordingStartFrame;
+		_event.time -= recordingStartTime;
+		recorded.push_back(_event);
+	}
+}
+
+const std::vector<sweet::InputEvent> & sweet::InputEventQueue::getFrameEvents() const{
+	return frameEvents;
+}
+
+void sweet::InputEventQueue::getEventsForFrame(unsigned long int _frame, std::vector<InputEvent> & _out) const{
+	for(auto & e : history){
+		if(e.frame == _frame){
+			_out.push_back(e);
+		}
+	}
+}
+
+void sweet::InputEventQueue::getEventsInWindow(double _start, double _end, std::vector<InputEvent> & _out) const{
+	for(auto & e : history){
+		if(e.time >= _start && e.time < _end){
+			_out.push_back(e);
+		}
+	}
+}
+
+unsigned long int sweet::InputEventQueue::countEventsInWindow(InputEvent::Type _type, int _code, double _start, double _end) const{
+	unsigned long int res = 0;
+	for(auto & e : history){
+		if(e.type == _type && e.code == _code && e.time >= _start && e.time < _end){
+			++res;
+		}
+	}
+	return res;
+}
+
+unsigned long int sweet::InputEventQueue::getFrame() const{
+	return frame;
+}
+
+unsigned long int sweet::InputEventQueue::getDroppedCount() const{
+	return dropped.load(std::memory_order_relaxed);
+}
+
+void sweet::InputEventQueue::startRecording(){
+	recorded.clear();
+	recording = true;
+	recordingStartFrame = frame;
+	recordingStartTime = glfwGetTime();
+}
+
+const std::vector<sweet::InputEvent> & sweet::InputEventQueue::stopRecording(){
+	recording = false;
+	return recorded;
+}
+
+bool sweet::InputEventQueue::isRecording() const{
+	return recording;
+}
+
+void sweet::InputEventQueue::startReplay(const std::vector<InputEvent> & _events){
+	replayEvents = _events;
+	replayIndex = 0;
+	replayStartFrame = frame;
+	replayStartTime = glfwGetTime();
+	replaying = replayEvents.size() > 0;
+}
+
+void sweet::InputEventQueue::stopReplay(){
+	replaying = false;
+	replayEvents.clear();
+	replayIndex = 0;
+}
+
+bool sweet::InputEventQueue::isReplaying() const{
+	return replaying;
+}
+
+bool sweet::InputEventQueue::saveRecording(const std::vector<InputEvent> & _events, const std::string & _filename){
+	std::ofstream file(_filename);
+	if(!file.is_open()){
+		Log::error("Couldn't write input recording to \"" + _filename + "\"");
+		return false;
+	}
+	file.precision(17);
+	for(auto & e : _events){
+		file << e.frame << " " << e.time << " " << e.type << " " << e.code << " " << e.mods << " " << e.x << " " << e.y << "\n";
+	}
+	return true;
+}
+
+bool sweet::InputEventQueue::loadRecording(const std::string & _filename, std::vector<InputEvent> & _events){
+	std::ifstream file(_filename);
+	if(!file.is_open()){
+		Log::error("Couldn't read input recording from \"" + _filename + "\"");
+		return false;
+	}
+	std::string line;
+	while(std::getline(file, line)){
+		if(line.empty()){
+			continue;
+		}
+		std::stringstream ss(line);
+		InputEvent e;
+		int type;
+		if(!(ss >> e.frame >> e.time >> type >> e.code >> e.mods >> e.x >> e.y) || type < InputEvent::kKEY_DOWN || type > InputEvent::kMOUSE_WHEEL){
+			Log::error("Malformed input recording \"" + _filename + "\"");
+			return false;
+		}
+		e.type = (InputEvent::Type)type;
+		_events.push_back(e);
+	}
+	return true;
+}
+
+sweet::InputEventQueue & sweet::InputEventQueue::getInstance(){
+	static InputEventQueue * queue;
+	if(queue == nullptr){
+		queue = new InputEventQueue();
+	}
+	return *queue;
+}
\ No newline at end of file
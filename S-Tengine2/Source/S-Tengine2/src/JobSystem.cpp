@@ -0,0 +1,204 @@
+#pragma once
+
+#include <JobSystem.h>
+#include <Profiler.h>
+#include <Log.h>
+
+#include <algorithm>
+
+namespace{
+	// the calling thread's queue index; only the workers set it, so every other thread uses queue 0
+	SWEET_THREAD_LOCAL unsigned long int queueIndex = 0;
+}
+
+sweet::JobCounter::JobCounter() :
+	pending(0)
+{
+}
+
+bool sweet::JobCounter::isDone() const{
+	return pending == 0;
+}
+
+sweet::JobSystem::JobSystem() :
+	queuedJobs(0),
+	running(false)
+{
+	queues.push_back(new Queue());
+}
+
+sweet::JobSystem::~JobSystem(){
+	destruct();
+	while(queues.size() > 0){
+		delete queues.back();
+		queues.pop_back();
+	}
+}
+
+sweet::JobSystem & sweet::JobSystem::getInstance(){
+	static JobSystem jobSystem;
+	return jobSystem;
+}
+
+void sweet::JobSystem::initialize(signed long int _numWorkers){
+	destruct();
+
+	if(_numWorkers < 0){
+		_numWorkers = std::max(0l, (signed long int)std::thread::hardware_concurrency() - 1);
+	}
+
+	running = true;
+	for(signed long int i = 0; i < _numWorkers; ++i){
+		queues.push_back(new Queue());
+	}
+	for(signed long int i = 0; i < _numWorkers; ++i){
+		workers.push_back(std::thread(&JobSystem::workerLoop, this, i+1));
+	}
+
+	Log::info("Job system started with " + std::to_string(_numWorkers) + " worker threads");
+}
+
+void sweet::JobSystem::destruct(){
+	if(!running){
+		return;
+	}
+
+	// finish whatever is left
+	while(queuedJobs > 0){
+		runJob(0);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		running = false;
+	}
+	sleepCondition.notify_all();
+
+	for(std::thread & t : workers){
+		t.join();
+	}
+	workers.clear();
+
+	while(queues.size() > 1){
+		delete queues.back();
+		queues.pop_back();
+	}
+}
+
+unsigned long int sweet::JobSystem::getNumThreads() const{
+	return workers.size() + 1;
+}
+
+unsigned long int sweet::JobSystem::getThreadIndex() const{
+	return getQueueIndex();
+}
+
+unsigned long int sweet::JobSystem::getQueueIndex() const{
+	return queueIndex;
+}
+
+void sweet::JobSystem::submit(Job _job, JobCounter * _counter){
+	// without any workers there's no-one to hand the job to
+	if(workers.size() == 0){
+		_job();
+		return;
+	}
+
+	if(_counter != nullptr){
+		++_counter->pending;
+	}
+
+	Entry e;
+	e.job = _job;
+	e.counter = _counter;
+
+	Queue * q = queues.at(getQueueIndex());
+	{
+		std::lock_guard<std::mutex> lock(q->mutex);
+		q->jobs.push_back(e);
+	}
+	++queuedJobs;
+
+	// taking the lock before notifying prevents a worker from missing the wake-up between checking and sleeping
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	sleepCondition.notify_one();
+}
+
+void sweet::JobSystem::wait(JobCounter * _counter){
+	unsigned long int queue = getQueueIndex();
+	while(!_counter->isDone()){
+		// help out instead of blocking
+		if(!runJob(queue)){
+			std::this_thread::yield();
+		}
+	}
+}
+
+void sweet::JobSystem::parallelFor(unsigned long int _count, std::function<void(unsigned long int)> _job, unsigned long int _batchSize){
+	_batchSize = std::max(1ul, _batchSize);
+	JobCounter counter;
+	for(unsigned long int start = 0; start < _count; start += _batchSize){
+		unsigned long int end = std::min(_count, start + _batchSize);
+		submit([start, end, &_job](){
+			for(unsigned long int i = start; i < end; ++i){
+				_job(i);
+			}
+		}, &counter);
+	}
+	wait(&counter);
+}
+
+bool sweet::JobSystem::runJob(unsigned long int _queue){
+	Entry e;
+	bool found = false;
+
+	// own queue first (newest job, since it's most likely to still be in the cache)
+	{
+		Queue * q = queues.at(_queue);
+		std::lock_guard<std::mutex> lock(q->mutex);
+		if(q->jobs.size() > 0){
+			e = q->jobs.back();
+			q->jobs.pop_back();
+			found = true;
+		}
+	}
+
+	// steal the oldest job from one of the other queues
+	for(unsigned long int i = 1; !found && i < queues.size(); ++i){
+		Queue * q = queues.at((_queue + i) % queues.size());
+		std::lock_guard<std::mutex> lock(q->mutex);
+		if(q->jobs.size() > 0){
+			e = q->jobs.front();
+			q->jobs.pop_front();
+			found = true;
+		}
+	}
+
+	if(!found){
+		return false;
+	}
+
+	--queuedJobs;
+	{
+		SWEET_PROFILE_SCOPE("JobSystem::job");
+		e.job();
+	}
+	if(e.counter != nullptr){
+		--e.counter->pending;
+	}
+	return true;
+}
+
+void sweet::JobSystem::workerLoop(unsigned long int _queue){
+	queueIndex = _queue;
+	while(running){
+		if(!runJob(_queue)){
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleepCondition.wait(lock, [this](){
+				return queuedJobs > 0 || !running;
+			});
+		}
+	}
+}
\ No newline at end of file
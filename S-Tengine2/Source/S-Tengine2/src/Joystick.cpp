@@ -38,63 +38,61 @@ Joystick::Joystick(int _id, float _deadZone) :
 }
 
 Joystick::~Joystick(){
-	pressedButtons.clear();
-	justPressedButtons.clear();
-	justReleasedButtons.clear();
 	axesValues.clear();
 }
 
+bool Joystick::isValidButton(int _code){
+	return _code >= 0 && (unsigned long int)_code < NUM_BUTTONS;
+}
+
 bool Joystick::buttonJustUp(int _glfwKeyCode){
-	return justReleasedButtons.find(_glfwKeyCode) != justReleasedButtons.end();
+	return isValidButton(_glfwKeyCode) && justReleasedButtons.test(_glfwKeyCode);
 }
 
 bool Joystick::buttonJustDown(int _glfwKeyCode){
-	return justPressedButtons.find(_glfwKeyCode) != justPressedButtons.end();
+	return isValidButton(_glfwKeyCode) && justPressedButtons.test(_glfwKeyCode);
 }
 
 void Joystick::buttonDownListener(int _glfwKeyCode){
-	// if the button was just released last frame, remove it from the justReleased list
-	if(justReleasedButtons.find(_glfwKeyCode) != justReleasedButtons.end()){
-		justReleasedButtons.erase(_glfwKeyCode);
+	if(!isValidButton(_glfwKeyCode)){
+		return;
 	}
-
-	// if the button was NOT down last frame, put it in the justPressed list
-	// if the button was just down last frame, remove it from the justPressed list
-	if(pressedButtons.find(_glfwKeyCode) == pressedButtons.end()){
-		justPressedButtons.insert(std::pair<int, int>(_glfwKeyCode, _glfwKeyCode));
-	}else if(justPressedButtons.find(_glfwKeyCode) != justPressedButtons.end()){
-		justPressedButtons.erase(_glfwKeyCode);
+	// if the button was just released last frame, remove it from the justReleased set
+	justReleasedButtons.reset(_glfwKeyCode);
+
+	// if the button was NOT down last frame, put it in the justPressed set
+	// if the button was just down last frame, remove it from the justPressed set
+	if(!pressedButtons.test(_glfwKeyCode)){
+		justPressedButtons.set(_glfwKeyCode);
+	}else{
+		justPressedButtons.reset(_glfwKeyCode);
 	}
-	pressedButtons.insert(std::pair<int, int>(_glfwKeyCode, _glfwKeyCode));
+	pressedButtons.set(_glfwKeyCode);
 }
 
 void Joystick::buttonUpListener(int _glfwKeyCode){
-	// if the button was just released last frame, remove it from the justReleased list
-	if(justReleasedButtons.find(_glfwKeyCode) != justReleasedButtons.end()){
-		justReleasedButtons.erase(_glfwKeyCode);
+	if(!isValidButton(_glfwKeyCode)){
+		return;
 	}
-
-	// if the button was down last frame, remove it from the pressed and justPressed lists and put it in the justReleased list
-	if(pressedButtons.find(_glfwKeyCode) != pressedButtons.end()){
-		pressedButtons.erase(_glfwKeyCode);
-		if(justPressedButtons.find(_glfwKeyCode) != justPressedButtons.end()){
-			justPressedButtons.erase(_glfwKeyCode);
-		}
-		justReleasedButtons.insert(std::pair<int, int>(_glfwKeyCode, _glfwKeyCode));
+	// if the button was just released last frame, remove it from the justReleased set
+	justReleasedButtons.reset(_glfwKeyCode);
+
+	// if the button was down last frame, remove it from the pressed and justPressed sets and put it in the justReleased set
+	if(pressedButtons.test(_glfwKeyCode)){
+		pressedButtons.reset(_glfwKeyCode);
+		justPressedButtons.reset(_glfwKeyCode);
+		justReleasedButtons.set(_glfwKeyCode);
 	}
 }
 
 void Joystick::buttonNullListener(int _glfwKeyCode){
-	// if the button isn't doing anything, remove it from all three lists
-	if(pressedButtons.find(_glfwKeyCode) != pressedButtons.end()){
-		pressedButtons.erase(_glfwKeyCode);
-	}
-	if(justPressedButtons.find(_glfwKeyCode) != justPressedButtons.end()){
-		justPressedButtons.erase(_glfwKeyCode);
-	}
-	if(justReleasedButtons.find(_glfwKeyCode) != justReleasedButtons.end()){
-		justReleasedButtons.erase(_glfwKeyCode);
+	if(!isValidButton(_glfwKeyCode)){
+		return;
 	}
+	// if the button isn't doing anything, remove it from all three sets
+	pressedButtons.reset(_glfwKeyCode);
+	justPressedButtons.reset(_glfwKeyCode);
+	justReleasedButtons.reset(_glfwKeyCode);
 }
 
 float Joystick::getAxis(int _code){
@@ -154,7 +152,7 @@ void Joystick::update(Step * _step){
 }
 
 bool Joystick::buttonDown(int _glfwKeyCode){
-	return justPressedButtons.find(_glfwKeyCode) != justPressedButtons.end() || pressedButtons.find(_glfwKeyCode) != pressedButtons.end();
+	return isValidButton(_glfwKeyCode) && (justPressedButtons.test(_glfwKeyCode) || pressedButtons.test(_glfwKeyCode));
 }
 
 
@@ -14,37 +14,39 @@ Keyboard::~Keyboard(){
 }
 
 bool Keyboard::keyJustUp(int _glfwKeyCode) const{
-	return justReleasedKeys.find(_glfwKeyCode) != justReleasedKeys.end();
+	return isValidKey(_glfwKeyCode) && justReleasedKeys.test(_glfwKeyCode);
 }
 
 bool Keyboard::keyJustDown(int _glfwKeyCode) const{
-	return justPressedKeys.find(_glfwKeyCode) != justPressedKeys.end();
+	return isValidKey(_glfwKeyCode) && justPressedKeys.test(_glfwKeyCode);
 }
 
 bool Keyboard::keyDown(int _glfwKeyCode) const{
-	return justPressedKeys.find(_glfwKeyCode) != justPressedKeys.end() || pressedKeys.find(_glfwKeyCode) != pressedKeys.end();
+	return isValidKey(_glfwKeyCode) && pressedKeys.test(_glfwKeyCode);
 }
 
 void Keyboard::keyDownListener(int _glfwKeyCode){
-	justPressedKeys.insert(std::make_pair(_glfwKeyCode, _glfwKeyCode));
-	pressedKeys.insert(std::make_pair(_glfwKeyCode, _glfwKeyCode));
+	if(isValidKey(_glfwKeyCode)){
+		justPressedKeys.set(_glfwKeyCode);
+		pressedKeys.set(_glfwKeyCode);
+	}
 }
 
 void Keyboard::keyUpListener(int _glfwKeyCode){
-	justReleasedKeys.insert(std::make_pair(_glfwKeyCode, _glfwKeyCode));
-
-	if(pressedKeys.find(_glfwKeyCode) != pressedKeys.end()){
-		pressedKeys.erase(_glfwKeyCode);
-	}
-
-	if(justPressedKeys.find(_glfwKeyCode) != justPressedKeys.end()){
-		justPressedKeys.erase(_glfwKeyCode);
+	if(isValidKey(_glfwKeyCode)){
+		justReleasedKeys.set(_glfwKeyCode);
+		pressedKeys.reset(_glfwKeyCode);
+		justPressedKeys.reset(_glfwKeyCode);
 	}
 }
 
 void Keyboard::update(Step * _step){
-	justPressedKeys.clear();
-	justReleasedKeys.clear();
+	justPressedKeys.reset();
+	justReleasedKeys.reset();
+}
+
+bool Keyboard::isValidKey(int _glfwKeyCode){
+	return _glfwKeyCode >= 0 && (unsigned long int)_glfwKeyCode < NUM_KEYS;
 }
 
 Keyboard & Keyboard::getInstance(){
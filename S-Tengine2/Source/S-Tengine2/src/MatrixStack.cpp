@@ -10,7 +10,8 @@ sweet::MatrixStack::MatrixStack() :
 	mvp(glm::mat4(1)),
 	mvpDirty(false),
 	vp(glm::mat4(1)),
-	vpDirty(false)
+	vpDirty(false),
+	frustumDirty(true)
 {
 }
 
@@ -46,11 +47,13 @@ void sweet::MatrixStack::setProjectionMatrix(const glm::mat4 * _projectionMatrix
 	projectionMatrix = *_projectionMatrix;
 	vpDirty = true;
 	mvpDirty = true;
+	frustumDirty = true;
 }
 void sweet::MatrixStack::setViewMatrix(const glm::mat4 * _viewMatrix){
 	viewMatrix = *_viewMatrix;
 	vpDirty = true;
 	mvpDirty = true;
+	frustumDirty = true;
 }
 
 void sweet::MatrixStack::scale(glm::mat4 _scaleMatrix){
@@ -89,6 +92,14 @@ const glm::mat4 * sweet::MatrixStack::getVP(){
 	return &vp;
 }
 
+const sweet::Frustum & sweet::MatrixStack::getFrustum(){
+	if(frustumDirty){
+		frustum.set(*getVP());
+		frustumDirty = false;
+	}
+	return frustum;
+}
+
 const glm::mat4 * sweet::MatrixStack::getMVP(){
 	if(mvpDirty){
 		mvp = *getVP() * currentModelMatrix;
@@ -27,6 +27,7 @@ void MeshDeformation::flare(MeshInterface * _mesh, float _lowerVal, float _upper
 		v.y = newVertVector4.y * deformerBoundingBox.height + deformerBoundingBox.y + _lowerBound;
 		v.z = newVertVector4.z * deformerBoundingBox.depth;
 	}
+	_mesh->makeDirty();
 }
 void MeshDeformation::twist(MeshInterface * _mesh, float _lowerVal, float _upperVal, float _lowerBound, Easing::Type _easing){
 	sweet::Box deformerBoundingBox = _mesh->calcBoundingBox();
@@ -52,6 +53,7 @@ void MeshDeformation::twist(MeshInterface * _mesh, float _lowerVal, float _upper
 		v.y = newVertVector4.y * deformerBoundingBox.height + deformerBoundingBox.y + _lowerBound;
 		v.z = newVertVector4.z * deformerBoundingBox.depth;
 	}
+	_mesh->makeDirty();
 }
 void MeshDeformation::bend(MeshInterface * _mesh, float _lowerVal, float _upperVal, float _lowerBound, Easing::Type _easing){
 	sweet::Box deformerBoundingBox = _mesh->calcBoundingBox();
@@ -76,4 +78,5 @@ void MeshDeformation::bend(MeshInterface * _mesh, float _lowerVal, float _upperV
 		v.y = newVertVector4.y * deformerBoundingBox.height + deformerBoundingBox.y + _lowerBound;
 		v.z = newVertVector4.z * deformerBoundingBox.depth;
 	}
+	_mesh->makeDirty();
 }
\ No newline at end of file
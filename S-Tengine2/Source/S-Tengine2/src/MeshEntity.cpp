@@ -8,6 +8,7 @@
 #include "RenderOptions.h"
 #include "MatrixStack.h"
 #include <Box.h>
+#include <Log.h>
 
 #include <algorithm>
 
@@ -34,9 +35,12 @@ void MeshEntity::render(sweet::MatrixStack * _matrixStack, RenderOptions * _rend
 	}
 
 	Shader * prev = _renderOptions->shader;
+	DrawData * prevDrawData = _renderOptions->drawData;
 	NodeShadable::applyShader(_renderOptions);
+	_renderOptions->drawData = &drawData;
 	Entity::render(_matrixStack, _renderOptions);
 	_renderOptions->shader = prev;
+	_renderOptions->drawData = prevDrawData;
 }
 
 void MeshEntity::setShader(Shader * _shader, bool _configureDefaultAttributes){
@@ -117,6 +121,11 @@ void MeshEntity::load(){
 }*/
 
 void MeshEntity::freezeTransformation(){
+	// shared meshes can't be baked, since that would move every entity using them
+	if(mesh->isImmutable()){
+		Log::warn("Cannot freeze the transformation of an entity with an immutable mesh");
+		return;
+	}
 	mesh->applyTransformation(meshTransform);
 	meshTransform->reset();
 	mesh->applyTransformation(childTransform);
@@ -4,6 +4,8 @@
 #include "Vertex.h"
 #include "MeshInterface.h"
 
+std::map<std::tuple<MeshFactory::PrimitiveType, float, float>, QuadMesh *> MeshFactory::sharedMeshes;
+
 QuadMesh* MeshFactory::getCubeMesh(float _halfSize, bool _autorelease){	
 	QuadMesh * m = new QuadMesh(_autorelease);
 	//Top
@@ -111,4 +113,53 @@ QuadMesh* MeshFactory::getPlaneMesh(float _halfWidth, float _halfHeight, bool _a
 
 QuadMesh* MeshFactory::getPlaneMesh(float _halfSize, bool _autorelease){
 	return getPlaneMesh(_halfSize, _halfSize, _autorelease);
+}
+
+QuadMesh * MeshFactory::getSharedMesh(PrimitiveType _type, float _a, float _b){
+	std::tuple<PrimitiveType, float, float> key(_type, _a, _b);
+	auto it = sharedMeshes.find(key);
+	if(it != sharedMeshes.end()){
+		return it->second;
+	}
+
+	QuadMesh * m = nullptr;
+	switch(_type){
+		case kCUBE: m = getCubeMesh(_a, true); break;
+		case kPLANE: m = getPlaneMesh(_a, _b, true); break;
+	}
+	m->makeImmutable();
+	// the library's reference
+	m->incrementReferenceCount();
+	sharedMeshes[key] = m;
+	return m;
+}
+
+QuadMesh * MeshFactory::getSharedCubeMesh(float _halfSize){
+	return getSharedMesh(kCUBE, _halfSize, _halfSize);
+}
+
+QuadMesh * MeshFactory::getSharedPlaneMesh(float _halfSize){
+	return getSharedMesh(kPLANE, _halfSize, _halfSize);
+}
+
+QuadMesh * MeshFactory::getSharedPlaneMesh(float _halfWidth, float _halfHeight){
+	return getSharedMesh(kPLANE, _halfWidth, _halfHeight);
+}
+
+unsigned long int MeshFactory::releaseUnusedSharedMeshes(){
+	unsigned long int res = 0;
+	for(auto it = sharedMeshes.begin(); it != sharedMeshes.end();){
+		if(it->second->getReferenceCount() <= 1){
+			it->second->decrementAndDelete();
+			it = sharedMeshes.erase(it);
+			++res;
+		}else{
+			++it;
+		}
+	}
+	return res;
+}
+
+unsigned long int MeshFactory::getSharedMeshCount(){
+	return sharedMeshes.size();
 }
\ No newline at end of file
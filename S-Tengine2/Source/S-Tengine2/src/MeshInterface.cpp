@@ -8,11 +8,25 @@
 #include "VoxRenderOptions.h"
 #include "Transform.h"
 #include <Log.h>
+#include <Profiler.h>
 
 #include <algorithm>
 
 MeshInterface::MeshInterface(GLenum polygonalDrawMode, GLenum drawMode) :
 	NodeResource(true),
+	boundingBoxDirty(true),
+	boundingBoxMin(0),
+	boundingBoxMax(0),
+	dirtyVerticesFirst(-1),
+	dirtyVerticesEnd(0),
+	dirtyIndicesFirst(-1),
+	dirtyIndicesEnd(0),
+	rangesDirty(false),
+	vboCapacity(0),
+	iboCapacity(0),
+	vboCount(0),
+	iboCount(0),
+	immutable(false),
 	dirty(true),
 	drawMode(drawMode),
 	polygonalDrawMode(polygonalDrawMode),
@@ -116,26 +130,110 @@ void MeshInterface::unload(){
 		iboId = 0;
 		vboId = 0;
 		vaoId = 0;
+		vboCapacity = 0;
+		iboCapacity = 0;
+		vboCount = 0;
+		iboCount = 0;
 
 		dirty = true;
+		rangesDirty = false;
+		dirtyVerticesFirst = dirtyIndicesFirst = -1;
+		dirtyVerticesEnd = dirtyIndicesEnd = 0;
 		checkForGlError(false);
 	}
 	NodeLoadable::unload();
 }
 
+void MeshInterface::makeDirty(){
+	dirty = true;
+	makeBoundingBoxDirty();
+}
+
+void MeshInterface::makeVerticesDirty(unsigned long int _first, unsigned long int _count){
+	// dirty is left alone so that it only means "upload everything"; if it's set at any point before the next clean
+	// (e.g. directly, after changing other vertices), the ranges are ignored and the whole mesh is uploaded
+	dirtyVerticesFirst = std::min(dirtyVerticesFirst, _first);
+	dirtyVerticesEnd = std::max(dirtyVerticesEnd, _first + _count);
+	rangesDirty = true;
+	makeBoundingBoxDirty();
+}
+
+void MeshInterface::makeIndicesDirty(unsigned long int _first, unsigned long int _count){
+	dirtyIndicesFirst = std::min(dirtyIndicesFirst, _first);
+	dirtyIndicesEnd = std::max(dirtyIndicesEnd, _first + _count);
+	rangesDirty = true;
+}
+
+void MeshInterface::makeImmutable(){
+	immutable = true;
+}
+
+bool MeshInterface::isImmutable() const{
+	return immutable;
+}
+
+bool MeshInterface::checkMutable(const std::string & _action) const{
+	if(immutable){
+		Log::warn("Cannot " + _action + " on an immutable mesh; use the entity's DrawData or a private copy instead");
+		return false;
+	}
+	return true;
+}
+
+void MeshInterface::uploadBuffer(GLenum _target, unsigned long int & _capacity, unsigned long int & _uploaded, size_t _elementSize, const void * _data, unsigned long int _count, bool _partial, unsigned long int _first, unsigned long int _end){
+	const char * data = static_cast<const char *>(_data);
+	if(_partial && _count == _uploaded && _count <= _capacity){
+		_end = std::min(_end, _count);
+		if(_first < _end){
+			glBufferSubData(_target, _first * _elementSize, (_end - _first) * _elementSize, data + _first * _elementSize);
+			SWEET_PROFILE_COUNT(kBUFFER_UPLOADS, 1);
+			SWEET_PROFILE_COUNT(kBUFFER_UPLOAD_BYTES, (_end - _first) * _elementSize);
+		}
+	}else if(drawMode == GL_STATIC_DRAW){
+		// static meshes are sized exactly
+		glBufferData(_target, _count * _elementSize, _data, drawMode);
+		_capacity = _count;
+		SWEET_PROFILE_COUNT(kBUFFER_UPLOADS, 1);
+		SWEET_PROFILE_COUNT(kBUFFER_UPLOAD_BYTES, _count * _elementSize);
+	}else{
+		// orphan the old storage (growing it if needed) so that the driver doesn't have to sync with draws still using it, then fill it
+		if(_count > _capacity){
+			_capacity = std::max(_count, _capacity + _capacity / 2);
+		}
+		glBufferData(_target, _capacity * _elementSize, nullptr, drawMode);
+		if(_count > 0){
+			glBufferSubData(_target, 0, _count * _elementSize, _data);
+			SWEET_PROFILE_COUNT(kBUFFER_UPLOADS, 1);
+			SWEET_PROFILE_COUNT(kBUFFER_UPLOAD_BYTES, _count * _elementSize);
+		}
+	}
+	_uploaded = _count;
+}
+
 void MeshInterface::clean(){
-	if(dirty){
+	if(dirty || rangesDirty){
+		// the dirty flag may have been set directly after moving verts, so assume the bounds have changed too
+		if(dirty){
+			makeBoundingBoxDirty();
+		}
+		// only upload the ranges if nothing else has been flagged since the last upload
+		bool partialUpload = !dirty;
+
 		GLint prev;
 		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &prev);
 		glBindVertexArray(0);
 		// Vertex Buffer Object (VBO)
 		glBindBuffer(GL_ARRAY_BUFFER, vboId);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * (vertices.size()), vertices.data(), drawMode);
+		uploadBuffer(GL_ARRAY_BUFFER, vboCapacity, vboCount, sizeof(Vertex), vertices.data(), vertices.size(), partialUpload, dirtyVerticesFirst, dirtyVerticesEnd);
 
 		// Index Buffer Object (IBO)
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * (indices.size()), indices.data(), drawMode);
+		uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, iboCapacity, iboCount, sizeof(GLuint), indices.data(), indices.size(), partialUpload, dirtyIndicesFirst, dirtyIndicesEnd);
+
 		dirty = false;
+		rangesDirty = false;
+		dirtyVerticesFirst = dirtyIndicesFirst = -1;
+		dirtyVerticesEnd = dirtyIndicesEnd = 0;
 		glBindVertexArray(prev);
 		checkForGlError(false);
 	}
@@ -196,6 +294,8 @@ void MeshInterface::render(sweet::MatrixStack * _matrixStack, RenderOptions * _r
 
 	// Draw (note that the last argument is expecting a pointer to the indices, but since we have an ibo, it's actually interpreted as an offset)
 	glDrawRangeElements(polygonalDrawMode, 0, indices.size(), indices.size(), GL_UNSIGNED_INT, 0);
+	++_renderOption->stats.nodesDrawn;
+	SWEET_PROFILE_COUNT(kDRAW_CALLS, 1);
 	checkForGlError(false);
 
 	//if(prev != -1){
@@ -213,12 +313,18 @@ void MeshInterface::configureDefaultVertexAttributes(Shader *_shader){
 }
 
 void MeshInterface::pushVert(Vertex _vertex){
+	if(!checkMutable("pushVert")){
+		return;
+	}
 	indices.push_back(vertices.size());
 	vertices.push_back(_vertex);
-	dirty = true;
+	makeDirty();
 }
 
 Texture * MeshInterface::popTexture2D(){
+	if(!checkMutable("popTexture2D")){
+		return nullptr;
+	}
 	Texture * t = textures.back();
 	if(t->decrementAndDelete()){
 		t = nullptr;
@@ -228,6 +334,9 @@ Texture * MeshInterface::popTexture2D(){
 }
 
 void MeshInterface::clearTextures(){
+	if(!checkMutable("clearTextures")){
+		return;
+	}
 	while(textures.size() > 0){
 		popTexture2D();
 	}
@@ -239,11 +348,17 @@ void MeshInterface::replaceTextures(Texture * _newTexture){
 }
 
 void MeshInterface::removeTextureAt(int _idx){
+	if(!checkMutable("removeTextureAt")){
+		return;
+	}
 	textures.at(_idx)->decrementAndDelete();
 	textures.erase(textures.begin() + _idx);
 }
 
 void MeshInterface::pushTexture2D(Texture* _texture){
+	if(!checkMutable("pushTexture2D")){
+		return;
+	}
 	_texture->incrementReferenceCount();
 	textures.push_back(_texture);
 }
@@ -266,11 +381,14 @@ void MeshInterface::setScaleMode(GLenum _both){
 }
 
 void MeshInterface::setNormal(unsigned long int _vertId, float _x, float _y, float _z){
+	if(!checkMutable("setNormal")){
+		return;
+	}
 	vertices.at(_vertId).nx = _x;
 	vertices.at(_vertId).ny = _y;
 	vertices.at(_vertId).nz = _z;
 
-	dirty = true;
+	makeVerticesDirty(_vertId);
 }
 
 glm::vec3 MeshInterface::calcNormal(unsigned long int _v1, unsigned long int _v2, unsigned long int _v3) const{
@@ -292,10 +410,13 @@ glm::vec3 MeshInterface::setAutoNormal(unsigned long int _v1, unsigned long int
 }
 
 void MeshInterface::setUV(unsigned long _vertId, float _u, float _v){
+	if(!checkMutable("setUV")){
+		return;
+	}
 	vertices.at(_vertId).u = _u;
 	vertices.at(_vertId).v = _v;
 
-	dirty = true;
+	makeVerticesDirty(_vertId);
 }
 
 TriMesh::TriMesh(const QuadMesh * const _mesh, bool _autoRelease) :
@@ -314,6 +435,9 @@ TriMesh::TriMesh(const QuadMesh * const _mesh, bool _autoRelease) :
 }
 
 void TriMesh::pushTri(GLuint _v0, GLuint _v1, GLuint _v2){
+	if(!checkMutable("pushTri")){
+		return;
+	}
 	indices.push_back(_v0);
 	indices.push_back(_v1);
 	indices.push_back(_v2);
@@ -321,6 +445,9 @@ void TriMesh::pushTri(GLuint _v0, GLuint _v1, GLuint _v2){
 	dirty = true;
 }
 void QuadMesh::pushQuad(GLuint _v0, GLuint _v1, GLuint _v2, GLuint _v3){
+	if(!checkMutable("pushQuad")){
+		return;
+	}
 	indices.push_back(_v0);
 	indices.push_back(_v1);
 	indices.push_back(_v2);
@@ -346,7 +473,36 @@ sweet::Box MeshInterface::calcBoundingBox() const{
 	return sweet::Box(minX, minY, minZ, maxX - minX, maxY - minY, maxZ - minZ);
 }
 
+void MeshInterface::makeBoundingBoxDirty(){
+	// if it's already dirty, the parents will be too
+	if(!boundingBoxDirty){
+		boundingBoxDirty = true;
+		NodeChild::makeBoundingBoxDirty();
+	}
+}
+
+bool MeshInterface::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	if(boundingBoxDirty){
+		if(vertices.size() > 0){
+			boundingBoxMin = boundingBoxMax = glm::vec3(vertices.at(0).x, vertices.at(0).y, vertices.at(0).z);
+			for(const Vertex & v : vertices){
+				boundingBoxMin = glm::min(boundingBoxMin, glm::vec3(v.x, v.y, v.z));
+				boundingBoxMax = glm::max(boundingBoxMax, glm::vec3(v.x, v.y, v.z));
+			}
+		}else{
+			boundingBoxMin = boundingBoxMax = glm::vec3(0);
+		}
+		boundingBoxDirty = false;
+	}
+	_min = boundingBoxMin;
+	_max = boundingBoxMax;
+	return true;
+}
+
 void MeshInterface::applyTransformation(Transform * _transform){
+	if(!checkMutable("applyTransformation")){
+		return;
+	}
 	const glm::mat4x4 m = _transform->getModelMatrix();
 	for(Vertex & i : vertices){
 		glm::vec3 v(m * glm::vec4(i.x, i.y, i.z, 1));
@@ -354,10 +510,13 @@ void MeshInterface::applyTransformation(Transform * _transform){
 		i.y = v.y;
 		i.z = v.z;
 	}
-	dirty = true;
+	makeDirty();
 }
 
 void MeshInterface::insertVertices(const MeshInterface & _mesh){
+	if(!checkMutable("insertVertices")){
+		return;
+	}
 	// save the number of vertices and indices so we can offset them later
 	unsigned long int
 		vertOffset = vertices.size(),
@@ -373,7 +532,7 @@ void MeshInterface::insertVertices(const MeshInterface & _mesh){
 		indices.at(i) += vertOffset;
 	}
 
-	dirty = true;
+	makeDirty();
 }
 
 std::ostream& operator<<(std::ostream& os, const MeshInterface& obj){
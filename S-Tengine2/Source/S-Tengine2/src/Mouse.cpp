@@ -20,27 +20,27 @@ Mouse::~Mouse(){
 }
 
 bool Mouse::leftJustPressed() const{
-	return justPressedButtons.find(GLFW_MOUSE_BUTTON_LEFT) != justPressedButtons.end();
+	return justPressedButtons.test(GLFW_MOUSE_BUTTON_LEFT);
 }
 
 bool Mouse::leftJustReleased() const{
-	return justReleasedButtons.find(GLFW_MOUSE_BUTTON_LEFT) != justReleasedButtons.end();
+	return justReleasedButtons.test(GLFW_MOUSE_BUTTON_LEFT);
 }
 
 bool Mouse::leftDown() const{
-	return pressedButtons.find(GLFW_MOUSE_BUTTON_LEFT) != pressedButtons.end();
+	return pressedButtons.test(GLFW_MOUSE_BUTTON_LEFT);
 }
 
 bool Mouse::rightJustPressed() const{
-	return justPressedButtons.find(GLFW_MOUSE_BUTTON_RIGHT) != justPressedButtons.end();
+	return justPressedButtons.test(GLFW_MOUSE_BUTTON_RIGHT);
 }
 
 bool Mouse::rightJustReleased() const{
-	return justReleasedButtons.find(GLFW_MOUSE_BUTTON_RIGHT) != justReleasedButtons.end();
+	return justReleasedButtons.test(GLFW_MOUSE_BUTTON_RIGHT);
 }
 
 bool Mouse::rightDown() const{
-	return pressedButtons.find(GLFW_MOUSE_BUTTON_RIGHT) != pressedButtons.end();
+	return pressedButtons.test(GLFW_MOUSE_BUTTON_RIGHT);
 }
 
 double Mouse::mouseX(bool _clamped) const{
@@ -67,25 +67,23 @@ void Mouse::translate(glm::vec2 _v, bool _relative){
 }
 
 void Mouse::update(Step * _step){
-	justPressedButtons.clear();
-	justReleasedButtons.clear();
+	justPressedButtons.reset();
+	justReleasedButtons.reset();
 	mouseWheelDelta = 0;
 }
 
 void Mouse::mouseDownListener(int _glfwMouseCode){
-	justPressedButtons.insert(std::make_pair(_glfwMouseCode, _glfwMouseCode));
-	pressedButtons.insert(std::make_pair(_glfwMouseCode, _glfwMouseCode));
+	if(_glfwMouseCode >= 0 && (unsigned long int)_glfwMouseCode < NUM_BUTTONS){
+		justPressedButtons.set(_glfwMouseCode);
+		pressedButtons.set(_glfwMouseCode);
+	}
 }
 
 void Mouse::mouseUpListener(int _glfwMouseCode){
-	justReleasedButtons.insert(std::make_pair(_glfwMouseCode, _glfwMouseCode));
-
-	if(pressedButtons.find(_glfwMouseCode) != pressedButtons.end()){
-		pressedButtons.erase(_glfwMouseCode);
-	}
-
-	if(justPressedButtons.find(_glfwMouseCode) != justPressedButtons.end()){
-		justPressedButtons.erase(_glfwMouseCode);
+	if(_glfwMouseCode >= 0 && (unsigned long int)_glfwMouseCode < NUM_BUTTONS){
+		justReleasedButtons.set(_glfwMouseCode);
+		pressedButtons.reset(_glfwMouseCode);
+		justPressedButtons.reset(_glfwMouseCode);
 	}
 }
 
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <NodeAllocator.h>
+
+#include <node/Node.h>
+#include <node/NodeChild.h>
+#include <node/NodeUpdatable.h>
+#include <node/NodeRenderable.h>
+#include <node/NodeResource.h>
+#include <node/NodeLoadable.h>
+#include <node/NodeShadable.h>
+#include <Transform.h>
+#include <Entity.h>
+#include <MeshEntity.h>
+#include <MeshInterface.h>
+#include <Sprite.h>
+#include <NodeUI.h>
+#include <Log.h>
+#include <Profiler.h>
+
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+sweet::SlabPool::SlabPool(unsigned long int _blockSize, unsigned long int _blocksPerSlab) :
+	blockSize(std::max(_blockSize, (unsigned long int)sizeof(FreeBlock))),
+	blocksPerSlab(std::max(_blocksPerSlab, 1ul)),
+	freeList(nullptr),
+	numLive(0),
+	peakLive(0),
+	numAllocations(0)
+{
+}
+
+sweet::SlabPool::~SlabPool(){
+	for(char * slab : slabs){
+		::operator delete(slab);
+	}
+}
+
+void * sweet::SlabPool::allocate(){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(freeList == nullptr){
+		grow();
+	}
+	FreeBlock * block = freeList;
+	freeList = block->next;
+	++numAllocations;
+	peakLive = std::max(peakLive, ++numLive);
+	return block;
+}
+
+void sweet::SlabPool::deallocate(void * _block){
+	std::lock_guard<std::mutex> lock(mutex);
+	FreeBlock * block = static_cast<FreeBlock *>(_block);
+	block->next = freeList;
+	freeList = block;
+	--numLive;
+}
+
+void sweet::SlabPool::grow(){
+	char * slab = static_cast<char *>(::operator new(blockSize * blocksPerSlab));
+	slabs.push_back(slab);
+	// link the blocks in order so that consecutive allocations are next to each other in memory
+	for(signed long int i = blocksPerSlab-1; i >= 0; --i){
+		FreeBlock * block = reinterpret_cast<FreeBlock *>(slab + i * blockSize);
+		block->next = freeList;
+		freeList = block;
+	}
+}
+
+unsigned long int sweet::SlabPool::getNumLive() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return numLive;
+}
+unsigned long int sweet::SlabPool::getPeakLive() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return peakLive;
+}
+unsigned long int sweet::SlabPool::getNumAllocations() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return numAllocations;
+}
+unsigned long int sweet::SlabPool::getNumSlabs() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return slabs.size();
+}
+unsigned long int sweet::SlabPool::getReservedBytes() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return slabs.size() * blockSize * blocksPerSlab;
+}
+bool sweet::SlabPool::owns(const void * _ptr) const{
+	std::lock_guard<std::mutex> lock(mutex);
+	const char * p = static_cast<const char *>(_ptr);
+	for(const char * slab : slabs){
+		if(p >= slab && p < slab + blockSize * blocksPerSlab){
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+sweet::NodeAllocator::NodeAllocator() :
+	numLargeAllocations(0),
+	poolsEnabled(true),
+	numHeapAllocations(0),
+	numHeapLive(0)
+{
+	for(unsigned long int size = granularity; size <= maxBlockSize; size += granularity){
+		pools.push_back(new SlabPool(size, slabBytes / size));
+	}
+}
+
+sweet::NodeAllocator::~NodeAllocator(){
+	for(SlabPool * pool : pools){
+		delete pool;
+	}
+}
+
+sweet::NodeAllocator & sweet::NodeAllocator::getInstance(){
+	// intentionally never deleted: static nodes may be destroyed after any function-local static,
+	// and their memory has to stay valid until then
+	static NodeAllocator * allocator = new NodeAllocator();
+	return *allocator;
+}
+
+void * sweet::NodeAllocator::allocate(size_t _size){
+	if(_size == 0 || _size > maxBlockSize){
+		++numLargeAllocations;
+		SWEET_PROFILE_COUNT(kNODE_ALLOCATIONS, 1);
+		return ::operator new(_size);
+	}
+	SWEET_PROFILE_COUNT(kNODE_ALLOCATIONS, 1);
+	if(!poolsEnabled){
+		++numHeapAllocations;
+		++numHeapLive;
+		return ::operator new(_size);
+	}
+	return pools.at((_size - 1) / granularity)->allocate();
+}
+
+void sweet::NodeAllocator::deallocate(void * _ptr, size_t _size){
+	if(_ptr == nullptr){
+		return;
+	}
+	if(_size == 0 || _size > maxBlockSize){
+		::operator delete(_ptr);
+		return;
+	}
+	SlabPool * pool = pools.at((_size - 1) / granularity);
+	if(numHeapLive > 0 && !pool->owns(_ptr)){
+		--numHeapLive;
+		::operator delete(_ptr);
+		return;
+	}
+	pool->deallocate(_ptr);
+}
+
+unsigned long int sweet::NodeAllocator::getNumLargeAllocations() const{
+	return numLargeAllocations;
+}
+
+unsigned long int sweet::NodeAllocator::getNumSystemAllocations() const{
+	unsigned long int res = numLargeAllocations + numHeapAllocations;
+	for(const SlabPool * pool : pools){
+		res += pool->getNumSlabs();
+	}
+	return res;
+}
+
+void sweet::NodeAllocator::setPoolsEnabled(bool _enabled){
+	poolsEnabled = _enabled;
+}
+
+bool sweet::NodeAllocator::isPoolsEnabled() const{
+	return poolsEnabled;
+}
+
+std::string sweet::NodeAllocator::getReport() const{
+	std::stringstream ss;
+
+	ss << "Node class sizes (bytes):" << std::endl;
+	auto row = [&ss](const char * _name, size_t _size){
+		ss << "  " << std::left << std::setw(16) << _name << std::right << std::setw(8) << _size << std::endl;
+	};
+	row("Node", sizeof(Node));
+	row("NodeChild", sizeof(NodeChild));
+	row("NodeUpdatable", sizeof(NodeUpdatable));
+	row("NodeRenderable", sizeof(NodeRenderable));
+	row("NodeResource", sizeof(NodeResource));
+	row("NodeLoadable", sizeof(NodeLoadable));
+	row("NodeShadable", sizeof(NodeShadable));
+	row("Transform", sizeof(Transform));
+	row("Entity", sizeof(Entity));
+	row("MeshEntity", sizeof(MeshEntity));
+	row("MeshInterface", sizeof(MeshInterface));
+	row("Sprite", sizeof(Sprite));
+	row("NodeUI", sizeof(NodeUI));
+
+	ss << "Node pools (block size, live, peak, allocations, slabs, reserved bytes):" << std::endl;
+	unsigned long int totalLive = 0, totalReserved = 0, totalSlabs = 0;
+	for(const SlabPool * pool : pools){
+		unsigned long int slabs = pool->getNumSlabs();
+		if(slabs == 0){
+			continue;
+		}
+		unsigned long int live = pool->getNumLive();
+		unsigned long int reserved = pool->getReservedBytes();
+		ss << "  "
+			<< std::setw(6) << pool->blockSize
+			<< std::setw(10) << live
+			<< std::setw(10) << pool->getPeakLive()
+			<< std::setw(12) << pool->getNumAllocations()
+			<< std::setw(8) << slabs
+			<< std::setw(12) << reserved << std::endl;
+		totalLive += live * pool->blockSize;
+		totalReserved += reserved;
+		totalSlabs += slabs;
+	}
+	ss << "Total: " << totalLive << " bytes live in " << totalReserved << " bytes reserved across " << totalSlabs << " slabs; "
+		<< numLargeAllocations.load() << " allocations too large for the pools" << std::endl;
+	return ss.str();
+}
+
+void sweet::NodeAllocator::printReport() const{
+	Log::info(getReport());
+}
\ No newline at end of file
@@ -1,38 +1,57 @@
 #pragma once
 
 #include <NodeBulletBody.h>
+#include <BulletMotionState.h>
 #include <btBulletDynamicsCommon.h>
 #include <BulletHeightField.h>
 #include <Transform.h>
 #include <MeshInterface.h>
 #include <Texture.h>
+#include <CollisionShapeCache.h>
+
+#include <algorithm>
 
 NodeBulletBody::NodeBulletBody(BulletWorld * _world) :
 	world(_world),
 	body(nullptr),
 	shape(nullptr),
+	motionState(nullptr),
 	internalPos(0,0,0),
 	maxVelocity(-1,-1,-1)
 {
 }
 
 NodeBulletBody::~NodeBulletBody(){
+	if(world != nullptr && motionState != nullptr && motionState->queued){
+		world->movedBodies.erase(std::find(world->movedBodies.begin(), world->movedBodies.end(), this));
+	}
 	if(world != nullptr && body != nullptr) {
 		world->world->removeRigidBody(body);	
+		body->setMotionState(nullptr);
 		body = nullptr;
 		world = nullptr;
 	}
+	delete motionState;
+	motionState = nullptr;
+	releaseShape();
 }
 
 void NodeBulletBody::update(Step * _step){
-	if(body != nullptr && (body->isActive() || directAdjustment)){
+	if(body != nullptr && directAdjustment){
 		realign();
 	}
 	NodePhysicsBody::update(_step);
 }
 
+void NodeBulletBody::resetInterpolation(){
+	body->setInterpolationWorldTransform(body->getWorldTransform());
+	if(motionState != nullptr){
+		motionState->transform = body->getWorldTransform();
+	}
+}
+
 void NodeBulletBody::realign(){
-	const btTransform & t = body->getWorldTransform();
+	const btTransform & t = (world->interpolate && motionState != nullptr) ? motionState->transform : body->getWorldTransform();
 	const btQuaternion & angle = t.getRotation();
 	internalPos = t.getOrigin();
 	childTransform->translate(internalPos.x(), internalPos.y(), internalPos.z(), false);
@@ -53,48 +72,27 @@ void NodeBulletBody::realign(){
 
 void NodeBulletBody::setColliderAsStaticPlane(float _normalX, float _normalY, float _normalZ, float _distanceFromOrigin){
 	assert(shape == nullptr);
-	shape = new btStaticPlaneShape(btVector3(_normalX, _normalY, _normalZ), _distanceFromOrigin);
+	shape = sweet::CollisionShapeCache::getInstance().getStaticPlane(_normalX, _normalY, _normalZ, _distanceFromOrigin);
 }
 
 void NodeBulletBody::setColliderAsBox(float _halfX, float _halfY, float _halfZ){
 	assert(shape == nullptr);
-	shape = new btBoxShape(btVector3(_halfX, _halfY, _halfZ));
+	shape = sweet::CollisionShapeCache::getInstance().getBox(_halfX, _halfY, _halfZ);
 }
 
 void NodeBulletBody::setColliderAsSphere(float _radius){	
 	assert(shape == nullptr);
-	shape = new btSphereShape(_radius);
+	shape = sweet::CollisionShapeCache::getInstance().getSphere(_radius);
 }
 
 void NodeBulletBody::setColliderAsCapsule(float _radius, float _height){
 	assert(shape == nullptr);
-	shape = new btCapsuleShape(_radius, _height);
+	shape = sweet::CollisionShapeCache::getInstance().getCapsule(_radius, _height);
 }
 
 void NodeBulletBody::setColliderAsMesh(TriMesh * _colliderMesh, bool _convex){
 	assert(shape == nullptr);
-	if(_convex){
-        shape = new btConvexHullShape();
-		for (unsigned long int i = 0; i < _colliderMesh->vertices.size(); i++){
-            btVector3 v = btVector3(_colliderMesh->vertices[i].x, _colliderMesh->vertices[i].y, _colliderMesh->vertices[i].z);
-            static_cast<btConvexHullShape *>(shape)->addPoint(v);
-        }
-	}else{
-		btTriangleMesh * mesh = new btTriangleMesh();
-		for(unsigned long int i = 0; i < _colliderMesh->indices.size(); i+=3){
-		
-			unsigned long int index1 = _colliderMesh->indices.at(i);
-			unsigned long int index2 = _colliderMesh->indices.at(i+1);
-			unsigned long int index3 = _colliderMesh->indices.at(i+2);
-
-			mesh->addTriangle(
-				btVector3(_colliderMesh->vertices.at(index1).x, _colliderMesh->vertices.at(index1).y, _colliderMesh->vertices.at(index1).z),
-				btVector3(_colliderMesh->vertices.at(index2).x, _colliderMesh->vertices.at(index2).y, _colliderMesh->vertices.at(index2).z),
-				btVector3(_colliderMesh->vertices.at(index3).x, _colliderMesh->vertices.at(index3).y, _colliderMesh->vertices.at(index3).z)
-			);
-		}
-		shape = new btBvhTriangleMeshShape(mesh, true);
-	}
+	shape = sweet::CollisionShapeCache::getInstance().getMesh(_colliderMesh, _convex);
 }
 
 void NodeBulletBody::setColliderAsHeightMap(Texture * _heightMap, glm::vec3 _scale, unsigned long int _upAxis){
@@ -105,6 +103,13 @@ void NodeBulletBody::setColliderAsHeightMap(Texture * _heightMap, glm::vec3 _sca
 	shape = new BulletHeightFieldShape(_heightMap, _scale, _upAxis);
 }
 
+void NodeBulletBody::releaseShape(){
+	if(shape != nullptr && !sweet::CollisionShapeCache::getInstance().release(shape)){
+		delete shape;
+	}
+	shape = nullptr;
+}
+
 void NodeBulletBody::translatePhysical(glm::vec3 _translation, bool _relative){
 	btVector3 & t = body->getWorldTransform().getOrigin();
 	if(_relative){
@@ -113,6 +118,7 @@ void NodeBulletBody::translatePhysical(glm::vec3 _translation, bool _relative){
 		t = btVector3(_translation.x, _translation.y, _translation.z);
 	}
 	// getOrigin returned a reference to the translation vector, so we only had to modify it
+	resetInterpolation();
 	NodePhysicsBody::translatePhysical(_translation, _relative);
 }
 
@@ -158,6 +164,7 @@ void NodeBulletBody::rotatePhysical(glm::quat _rotation, bool _relative){
 	}
 	// getRotation didn't return a reference to the quaternion, so we have to set rotation explicitly after modifying it
 	body->getWorldTransform().setRotation(q);
+	resetInterpolation();
 	directAdjustment = true;
 }
 
@@ -167,12 +174,19 @@ void NodeBulletBody::createRigidBody(float _mass, unsigned short int _collisionG
 
 	assert(shape != nullptr && body == nullptr);
 	btTransform t(btQuaternion(0, 0, 0), internalPos);
-	btMotionState * motion = new btDefaultMotionState(t);
+	// a previous body may have been removed without deleting its motion state (e.g. NodeUI::setMouseEnabled)
+	if(motionState != nullptr){
+		if(motionState->queued){
+			world->movedBodies.erase(std::find(world->movedBodies.begin(), world->movedBodies.end(), this));
+		}
+		delete motionState;
+	}
+	motionState = new BulletMotionState(this, t);
 	btVector3 inertia(0, 0, 0);
 	if(_mass != 0 && !shape->isConcave()){
 		shape->calculateLocalInertia(_mass, inertia);
 	}
-	btRigidBody::btRigidBodyConstructionInfo info(_mass, motion, shape, inertia);
+	btRigidBody::btRigidBodyConstructionInfo info(_mass, motionState, shape, inertia);
 	body = new btRigidBody(info);
 	world->world->addRigidBody(body, collisionGroup, collisionMask);
 	body->setUserPointer(this);
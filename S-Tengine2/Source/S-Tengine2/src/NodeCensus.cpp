@@ -0,0 +1,282 @@
+#pragma once
+
+#include <NodeCensus.h>
+#include <node/Node.h>
+#include <node/NodeResource.h>
+#include <Log.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+sweet::NodeCensus::TypeCount::TypeCount() :
+	live(0),
+	bytes(0),
+	peak(0),
+	constructed(0),
+	destroyed(0)
+{
+}
+
+sweet::NodeCensus::Snapshot::Snapshot() :
+	serial(0),
+	live(0),
+	bytes(0)
+{
+}
+
+sweet::NodeCensus::NodeCensus() :
+	first(nullptr),
+	live(0),
+	bytes(0),
+	nextSerial(0)
+{
+}
+
+sweet::NodeCensus::~NodeCensus(){
+}
+
+sweet::NodeCensus & sweet::NodeCensus::getInstance(){
+	// intentionally never deleted, for the same reason as the NodeAllocator: static nodes may be destroyed after any function-local static
+	static NodeCensus * census = new NodeCensus();
+	return *census;
+}
+
+void sweet::NodeCensus::add(Node * _node, unsigned long int _bytes, void * _site){
+	std::lock_guard<std::mutex> lock(mutex);
+	_node->censusType = -1;
+	_node->censusBytes = _bytes;
+	_node->censusSite = _site;
+	_node->censusSerial = nextSerial++;
+
+	// new nodes go on the front, with the others which haven't been sorted yet
+	_node->censusPrev = nullptr;
+	_node->censusNext = first;
+	if(first != nullptr){
+		first->censusPrev = _node;
+	}
+	first = _node;
+
+	++live;
+	bytes += _bytes;
+}
+
+void sweet::NodeCensus::remove(Node * _node){
+	std::lock_guard<std::mutex> lock(mutex);
+	if(_node->censusPrev != nullptr){
+		_node->censusPrev->censusNext = _node->censusNext;
+	}else{
+		first = _node->censusNext;
+	}
+	if(_node->censusNext != nullptr){
+		_node->censusNext->censusPrev = _node->censusPrev;
+	}
+
+	--live;
+	bytes -= _node->censusBytes;
+	if(_node->censusType >= 0){
+		TypeCount & t = types.at(_node->censusType);
+		--t.live;
+		t.bytes -= _node->censusBytes;
+		++t.destroyed;
+	}
+}
+
+void sweet::NodeCensus::classify(){
+	for(Node * n = first; n != nullptr && n->censusType < 0; n = n->censusNext){
+		std::type_index type(typeid(*n));
+		auto it = typeIndices.find(type);
+		if(it == typeIndices.end()){
+			it = typeIndices.insert(std::make_pair(type, types.size())).first;
+			types.push_back(TypeCount());
+			types.back().name = type.name();
+		}
+		n->censusType = it->second;
+
+		TypeCount & t = types.at(it->second);
+		++t.live;
+		t.bytes += n->censusBytes;
+		++t.constructed;
+		t.peak = std::max(t.peak, t.live);
+	}
+}
+
+unsigned long int sweet::NodeCensus::getLiveCount() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return live;
+}
+
+sweet::NodeCensus::Snapshot sweet::NodeCensus::takeSnapshot(){
+	std::lock_guard<std::mutex> lock(mutex);
+	classify();
+	Snapshot res;
+	res.serial = nextSerial;
+	res.live = live;
+	res.bytes = bytes;
+	for(const TypeCount & t : types){
+		res.types[t.name] = t;
+	}
+	return res;
+}
+
+std::vector<sweet::NodeCensus::TypeDiff> sweet::NodeCensus::diff(const Snapshot & _before, const Snapshot & _after){
+	std::map<std::string, TypeDiff> diffs;
+	for(auto & t : _after.types){
+		TypeDiff & d = diffs[t.first];
+		d.name = t.first;
+		d.live = t.second.live;
+		d.bytes = t.second.bytes;
+	}
+	for(auto & t : _before.types){
+		TypeDiff & d = diffs[t.first];
+		d.name = t.first;
+		d.live -= t.second.live;
+		d.bytes -= t.second.bytes;
+	}
+
+	std::vector<TypeDiff> res;
+	for(auto & d : diffs){
+		if(d.second.live != 0 || d.second.bytes != 0){
+			res.push_back(d.second);
+		}
+	}
+	std::sort(res.begin(), res.end(), [](const TypeDiff & _a, const TypeDiff & _b){
+		signed long long int a = _a.bytes < 0 ? -_a.bytes : _a.bytes;
+		signed long long int b = _b.bytes < 0 ? -_b.bytes : _b.bytes;
+		return a != b ? a > b : _a.name < _b.name;
+	});
+	return res;
+}
+
+std::string sweet::NodeCensus::getDiffReport(const Snapshot & _before, const Snapshot & _after){
+	std::stringstream ss;
+	ss << "Node census change (live, bytes, type): "
+		<< std::showpos << ((signed long int)_after.live - (signed long int)_before.live) << " nodes, "
+		<< ((signed long long int)_after.bytes - (signed long long int)_before.bytes) << " bytes" << std::noshowpos << std::endl;
+	for(const TypeDiff & d : diff(_before, _after)){
+		ss << "  " << std::showpos
+			<< std::setw(8) << d.live
+			<< std::setw(12) << d.bytes << std::noshowpos
+			<< "  " << d.name << std::endl;
+	}
+	return ss.str();
+}
+
+std::vector<sweet::NodeCensus::Leak> sweet::NodeCensus::getLeaks(const Snapshot & _since, const Snapshot & _until){
+	std::lock_guard<std::mutex> lock(mutex);
+	classify();
+	std::vector<Leak> res;
+	for(Node * n = first; n != nullptr; n = n->censusNext){
+		if(n->censusSerial < _since.serial || n->censusSerial >= _until.serial){
+			continue;
+		}
+		NodeResource * resource = n->asNodeResource();
+		if(resource == nullptr){
+			continue;
+		}
+		Leak l;
+		l.type = types.at(n->censusType).name;
+		l.nodeName = n->nodeName;
+		l.referenceCount = resource->getReferenceCount();
+		l.autoRelease = resource->isAutoReleasing();
+		l.serial = n->censusSerial;
+		l.site = getSiteName(n->censusSite);
+		res.push_back(l);
+	}
+	// oldest first
+	std::reverse(res.begin(), res.end());
+	return res;
+}
+
+std::string sweet::NodeCensus::getLeakReport(const Snapshot & _since, const Snapshot & _until){
+	std::vector<Leak> leaks = getLeaks(_since, _until);
+	std::stringstream ss;
+	ss << leaks.size() << " node resources created in that time are still alive (serial, references, auto release, type, name, allocation site):" << std::endl;
+	for(const Leak & l : leaks){
+		ss << "  "
+			<< std::setw(10) << l.serial
+			<< std::setw(6) << l.referenceCount
+			<< std::setw(4) << (l.autoRelease ? "y" : "n")
+			<< "  " << l.type << " \"" << l.nodeName << "\" at " << l.site << std::endl;
+	}
+	return ss.str();
+}
+
+std::string sweet::NodeCensus::getReport(){
+	Snapshot s = takeSnapshot();
+	std::vector<const TypeCount *> sorted;
+	for(auto & t : s.types){
+		if(t.second.live > 0){
+			sorted.push_back(&t.second);
+		}
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const TypeCount * _a, const TypeCount * _b){
+		return _a->bytes != _b->bytes ? _a->bytes > _b->bytes : _a->live > _b->live;
+	});
+
+	std::stringstream ss;
+	ss << "Node census (live, bytes, peak, constructed, type):" << std::endl;
+	for(const TypeCount * t : sorted){
+		ss << "  "
+			<< std::setw(8) << t->live
+			<< std::setw(12) << t->bytes
+			<< std::setw(8) << t->peak
+			<< std::setw(10) << t->constructed
+			<< "  " << t->name << std::endl;
+	}
+	ss << "  Total: " << s.live << " nodes, " << s.bytes << " bytes" << std::endl;
+	return ss.str();
+}
+
+void sweet::NodeCensus::printReport(){
+	Log::info(getReport());
+}
+
+std::string sweet::NodeCensus::getNodeList(){
+	std::lock_guard<std::mutex> lock(mutex);
+	classify();
+	std::stringstream ss;
+	for(Node * n = first; n != nullptr; n = n->censusNext){
+		ss << types.at(n->censusType).name << " " << n << " -- Name: " << n->nodeName << std::endl;
+	}
+	return ss.str();
+}
+
+std::string sweet::NodeCensus::getSiteName(void * _site){
+	if(_site == nullptr){
+		return "unknown";
+	}
+	std::stringstream ss;
+#ifdef _WIN32
+	// module and offset; these can be looked up in the pdb
+	HMODULE module = nullptr;
+	char path[MAX_PATH];
+	if(GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)_site, &module) && GetModuleFileNameA(module, path, MAX_PATH) > 0){
+		std::string name(path);
+		ss << name.substr(name.find_last_of("\\/") + 1) << "+0x" << std::hex << ((char *)_site - (char *)module);
+		return ss.str();
+	}
+#else
+	Dl_info info;
+	if(dladdr(_site, &info) != 0){
+		if(info.dli_sname != nullptr){
+			ss << info.dli_sname << "+0x" << std::hex << ((char *)_site - (char *)info.dli_saddr);
+		}else{
+			std::string name(info.dli_fname != nullptr ? info.dli_fname : "?");
+			ss << name.substr(name.find_last_of("/") + 1) << "+0x" << std::hex << ((char *)_site - (char *)info.dli_fbase);
+		}
+		return ss.str();
+	}
+#endif
+	ss << _site;
+	return ss.str();
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <StandardFrameBuffer.h>
 #include <Texture.h>
 #include <FBOTexture.h>
+#include <RenderTargetPool.h>
 
 #include <shader\ComponentShaderBase.h>
 #include <shader\ShaderComponentTexture.h>
@@ -44,7 +45,6 @@ NodeUI::NodeUI(BulletWorld * _world, RenderMode _renderMode, bool _mouseEnabled)
 	nodeUIParent(nullptr),
 	background(new Plane(glm::vec3(-0.5f, -0.5f, 0.f), 1.f, bgShader)),
 	textureCam(nullptr),
-	frameBuffer(nullptr),
 	renderedTexture(nullptr),
 	texturedPlane(nullptr),
 	boxSizing(kBORDER_BOX), // we initialize the variable to the opposite so that setMouseEnabled gets called properly at the end of the constructor
@@ -94,7 +94,6 @@ NodeUI::NodeUI(BulletWorld * _world, RenderMode _renderMode, bool _mouseEnabled)
 NodeUI::~NodeUI() {
 	if(textureCam != nullptr){
 		delete textureCam;
-		delete frameBuffer;
 		delete texturedPlane;
 	}
 	delete eventManager;
@@ -119,7 +118,6 @@ void NodeUI::unload(){
 
 		if(textureCam != nullptr){
 			delete textureCam;
-			delete frameBuffer;
 			delete texturedPlane;
 		}
 
@@ -226,10 +224,8 @@ void NodeUI::setMouseEnabled(bool _mouseEnabled){
 		updateCollider();
 	}else{
 		// delete the NodeBulletBody collider stuff
-		if(shape != nullptr){
-			delete shape;
-			shape = nullptr;
-		}if(body != nullptr){
+		releaseShape();
+		if(body != nullptr){
 			world->world->removeRigidBody(body);
 			body = nullptr;
 		}
@@ -258,11 +254,8 @@ Texture * NodeUI::renderToTexture(RenderOptions * _ro){
 		textureCam->nodeName = "NodeUI texture cam";
 	}
 
-	if(frameBuffer == nullptr){
-		frameBuffer = new StandardFrameBuffer(false);
-		frameBuffer->load();
-		frameBuffer->nodeName = "NodeUI texture framebuffer";
-	}
+	// the render target is only needed until its pixels are copied into renderedTexture
+	FrameBufferInterface * frameBuffer = sweet::RenderTargetPool::getInstance().acquire(StandardFrameBuffer::getChannels(), w, h);
 
 	auto vd = _ro->viewPortDimensions;
 	_ro->setViewPort(0, 0, w, h);
@@ -270,7 +263,7 @@ Texture * NodeUI::renderToTexture(RenderOptions * _ro){
 	texturedPlane->childTransform->translate(w * 0.5f, h * 0.5f, 0.f, false);
 	texturedPlane->childTransform->scale(w, -h, 1.f, false);
 
-	if(frameBuffer->resize(w, h) && renderedTexture != nullptr){
+	if(renderedTexture != nullptr && ((unsigned long int)renderedTexture->width != frameBuffer->width || (unsigned long int)renderedTexture->height != frameBuffer->height)){
 		textureCam->resize(0, w, 0, h);
 		texturedPlane->mesh->removeTextureAt(0);
 		renderedTexture = nullptr;
@@ -313,6 +306,7 @@ Texture * NodeUI::renderToTexture(RenderOptions * _ro){
 		renderedTexture->data = frameBuffer->getPixelData(0);
 		renderedTexture->bufferData();
 	}
+	sweet::RenderTargetPool::getInstance().release(frameBuffer);
 
 	_ro->setViewPort(vd.x, vd.y, vd.width, vd.height);
 	//renderedTexture->saveImageData("test.tga");
@@ -327,6 +321,10 @@ MeshEntity * NodeUI::getTexturedPlane() {
 	return texturedPlane;
 }
 
+bool NodeUI::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	return false;
+}
+
 void NodeUI::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
 	// don't bother doing any work if we aren't rendering anyway
 	if(!isVisible()){
@@ -776,10 +774,7 @@ void NodeUI::updateCollider(){
 		}
 	}
 
-	if(shape != nullptr){
-		delete shape;
-		shape = nullptr;
-	}
+	releaseShape();
 	setColliderAsMesh(colliderMesh, true);
 
 	if(body != nullptr){
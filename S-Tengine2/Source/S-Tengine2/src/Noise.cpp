@@ -0,0 +1,398 @@
+#pragma once
+
+#include <Noise.h>
+#include <JobSystem.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+	#define SWEET_NOISE_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace{
+	// skewing factors for 3D simplex noise
+	const float F3 = 1.f/3.f;
+	const float G3 = 1.f/6.f;
+
+	// size of the pieces that fill splits textures into
+	const unsigned long int tileWidth = 64;
+	const unsigned long int tileHeight = 16;
+
+	inline unsigned char permute(const unsigned char * _perm, signed long int _x, signed long int _y, signed long int _z){
+		return _perm[_perm[_perm[_x & 255] + (_y & 255)] + (_z & 255)];
+	}
+
+	inline float fade(float _t){
+		return _t * _t * _t * (_t * (_t * 6 - 15) + 10);
+	}
+
+	inline float lerp(float _t, float _a, float _b){
+		return _a + _t * (_b - _a);
+	}
+
+	// same gradient set as NumberUtils::pNoise (the 12 cube edge directions, with four repeated)
+	inline float grad(unsigned char _hash, float _x, float _y, float _z){
+		int h = _hash & 15;
+		float u = h < 8 ? _x : _y;
+		float v = h < 4 ? _y : (h == 12 || h == 14 ? _x : _z);
+		return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+	}
+
+	inline signed long int fastFloor(float _x){
+		signed long int i = (signed long int)_x;
+		return _x < i ? i - 1 : i;
+	}
+
+#ifdef SWEET_NOISE_SSE
+	inline __m128 select(__m128 _mask, __m128 _a, __m128 _b){
+		return _mm_or_ps(_mm_and_ps(_mask, _a), _mm_andnot_ps(_mask, _b));
+	}
+
+	inline __m128 floor4(__m128 _x){
+		__m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(_x));
+		return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, _x), _mm_set1_ps(1.f)));
+	}
+
+	inline __m128 fade4(__m128 _t){
+		__m128 r = _mm_sub_ps(_mm_mul_ps(_t, _mm_set1_ps(6.f)), _mm_set1_ps(15.f));
+		r = _mm_add_ps(_mm_mul_ps(_t, r), _mm_set1_ps(10.f));
+		return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_t, _t), _t), r);
+	}
+
+	inline __m128 lerp4(__m128 _t, __m128 _a, __m128 _b){
+		return _mm_add_ps(_a, _mm_mul_ps(_t, _mm_sub_ps(_b, _a)));
+	}
+
+	inline __m128 grad4(__m128i _hash, __m128 _x, __m128 _y, __m128 _z){
+		__m128i h = _mm_and_si128(_hash, _mm_set1_epi32(15));
+		__m128 lt8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+		__m128 lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+		__m128 is12or14 = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+		__m128 u = select(lt8, _x, _y);
+		__m128 v = select(lt4, _y, select(is12or14, _x, _z));
+		// move bits 1 and 2 of the hash into the sign bits
+		__m128 signU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+		__m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+		return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+	}
+
+	// looks up the permutation of each lane's lattice point offset by (_dx, _dy, _dz)
+	// there's no gather in SSE2, so this part is scalar
+	inline __m128i permute4(const unsigned char * _perm, const int * _x, const int * _y, const int * _z, const int * _dx, const int * _dy, const int * _dz){
+		int res[4];
+		for(unsigned long int i = 0; i < 4; ++i){
+			res[i] = permute(_perm, _x[i] + _dx[i], _y[i] + _dy[i], _z[i] + _dz[i]);
+		}
+		return _mm_loadu_si128((const __m128i *)res);
+	}
+
+	const int zero4[4] = {0, 0, 0, 0};
+	const int one4[4] = {1, 1, 1, 1};
+
+	__m128 perlin4(const unsigned char * _perm, __m128 _x, __m128 _y, __m128 _z){
+		__m128 fx = floor4(_x), fy = floor4(_y), fz = floor4(_z);
+		int X[4], Y[4], Z[4];
+		_mm_storeu_si128((__m128i *)X, _mm_cvttps_epi32(fx));
+		_mm_storeu_si128((__m128i *)Y, _mm_cvttps_epi32(fy));
+		_mm_storeu_si128((__m128i *)Z, _mm_cvttps_epi32(fz));
+
+		// relative position in the cell
+		__m128 x0 = _mm_sub_ps(_x, fx), y0 = _mm_sub_ps(_y, fy), z0 = _mm_sub_ps(_z, fz);
+		__m128 one = _mm_set1_ps(1.f);
+		__m128 x1 = _mm_sub_ps(x0, one), y1 = _mm_sub_ps(y0, one), z1 = _mm_sub_ps(z0, one);
+		__m128 u = fade4(x0), v = fade4(y0), w = fade4(z0);
+
+		const int * o = zero4;
+		const int * l = one4;
+		return lerp4(w,
+			lerp4(v,
+				lerp4(u, grad4(permute4(_perm, X, Y, Z, o, o, o), x0, y0, z0), grad4(permute4(_perm, X, Y, Z, l, o, o), x1, y0, z0)),
+				lerp4(u, grad4(permute4(_perm, X, Y, Z, o, l, o), x0, y1, z0), grad4(permute4(_perm, X, Y, Z, l, l, o), x1, y1, z0))),
+			lerp4(v,
+				lerp4(u, grad4(permute4(_perm, X, Y, Z, o, o, l), x0, y0, z1), grad4(permute4(_perm, X, Y, Z, l, o, l), x1, y0, z1)),
+				lerp4(u, grad4(permute4(_perm, X, Y, Z, o, l, l), x0, y1, z1), grad4(permute4(_perm, X, Y, Z, l, l, l), x1, y1, z1))));
+	}
+
+	__m128 value4(const unsigned char * _perm, __m128 _x, __m128 _y, __m128 _z){
+		__m128 fx = floor4(_x), fy = floor4(_y), fz = floor4(_z);
+		int X[4], Y[4], Z[4];
+		_mm_storeu_si128((__m128i *)X, _mm_cvttps_epi32(fx));
+		_mm_storeu_si128((__m128i *)Y, _mm_cvttps_epi32(fy));
+		_mm_storeu_si128((__m128i *)Z, _mm_cvttps_epi32(fz));
+
+		__m128 u = fade4(_mm_sub_ps(_x, fx)), v = fade4(_mm_sub_ps(_y, fy)), w = fade4(_mm_sub_ps(_z, fz));
+
+		// maps a permutation in 0-255 to -1 to 1
+		__m128 scale = _mm_set1_ps(2.f/255.f);
+		__m128 one = _mm_set1_ps(1.f);
+		const int * o = zero4;
+		const int * l = one4;
+		__m128 c[8];
+		for(unsigned long int i = 0; i < 8; ++i){
+			__m128i h = permute4(_perm, X, Y, Z, (i & 1) ? l : o, (i & 2) ? l : o, (i & 4) ? l : o);
+			c[i] = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(h), scale), one);
+		}
+		return lerp4(w,
+			lerp4(v, lerp4(u, c[0], c[1]), lerp4(u, c[2], c[3])),
+			lerp4(v, lerp4(u, c[4], c[5]), lerp4(u, c[6], c[7])));
+	}
+
+	__m128 simplex4(const unsigned char * _perm, __m128 _x, __m128 _y, __m128 _z){
+		// skew the input space to find which simplex cell we're in
+		__m128 s = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_x, _y), _z), _mm_set1_ps(F3));
+		__m128 fi = floor4(_mm_add_ps(_x, s)), fj = floor4(_mm_add_ps(_y, s)), fk = floor4(_mm_add_ps(_z, s));
+		int I[4], J[4], K[4];
+		_mm_storeu_si128((__m128i *)I, _mm_cvttps_epi32(fi));
+		_mm_storeu_si128((__m128i *)J, _mm_cvttps_epi32(fj));
+		_mm_storeu_si128((__m128i *)K, _mm_cvttps_epi32(fk));
+
+		// unskew the cell origin back to xyz space and get the distance from it
+		__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(fi, fj), fk), _mm_set1_ps(G3));
+		__m128 x0 = _mm_sub_ps(_x, _mm_sub_ps(fi, t));
+		__m128 y0 = _mm_sub_ps(_y, _mm_sub_ps(fj, t));
+		__m128 z0 = _mm_sub_ps(_z, _mm_sub_ps(fk, t));
+
+		// find which of the six tetrahedra we're in without branching (see the scalar version for the same logic)
+		__m128 xy = _mm_cmpge_ps(x0, y0), xz = _mm_cmpge_ps(x0, z0), yz = _mm_cmpge_ps(y0, z0);
+		__m128 one = _mm_set1_ps(1.f);
+		__m128 i1 = _mm_and_ps(_mm_and_ps(xy, xz), one);
+		__m128 j1 = _mm_and_ps(_mm_andnot_ps(xy, yz), one);
+		__m128 k1 = _mm_andnot_ps(_mm_or_ps(xz, yz), one);
+		__m128 i2 = _mm_and_ps(_mm_or_ps(xy, xz), one);
+		__m128 j2 = _mm_and_ps(_mm_or_ps(_mm_andnot_ps(xy, one), yz), one);
+		__m128 k2 = _mm_andnot_ps(_mm_and_ps(xz, yz), one);
+
+		__m128 g1 = _mm_set1_ps(G3), g2 = _mm_set1_ps(2.f*G3), g3 = _mm_set1_ps(3.f*G3 - 1.f);
+		__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, i1), g1), y1 = _mm_add_ps(_mm_sub_ps(y0, j1), g1), z1 = _mm_add_ps(_mm_sub_ps(z0, k1), g1);
+		__m128 x2 = _mm_add_ps(_mm_sub_ps(x0, i2), g2), y2 = _mm_add_ps(_mm_sub_ps(y0, j2), g2), z2 = _mm_add_ps(_mm_sub_ps(z0, k2), g2);
+		__m128 x3 = _mm_add_ps(x0, g3), y3 = _mm_add_ps(y0, g3), z3 = _mm_add_ps(z0, g3);
+
+		int I1[4], J1[4], K1[4], I2[4], J2[4], K2[4];
+		_mm_storeu_si128((__m128i *)I1, _mm_cvttps_epi32(i1));
+		_mm_storeu_si128((__m128i *)J1, _mm_cvttps_epi32(j1));
+		_mm_storeu_si128((__m128i *)K1, _mm_cvttps_epi32(k1));
+		_mm_storeu_si128((__m128i *)I2, _mm_cvttps_epi32(i2));
+		_mm_storeu_si128((__m128i *)J2, _mm_cvttps_epi32(j2));
+		_mm_storeu_si128((__m128i *)K2, _mm_cvttps_epi32(k2));
+
+		__m128i h0 = permute4(_perm, I, J, K, zero4, zero4, zero4);
+		__m128i h1 = permute4(_perm, I, J, K, I1, J1, K1);
+		__m128i h2 = permute4(_perm, I, J, K, I2, J2, K2);
+		__m128i h3 = permute4(_perm, I, J, K, one4, one4, one4);
+
+		// contribution of each corner, falling off to zero at a radius of sqrt(0.6)
+		__m128 r = _mm_set1_ps(0.6f), zero = _mm_setzero_ps();
+		__m128 res = zero;
+		__m128 xs[4] = {x0, x1, x2, x3}, ys[4] = {y0, y1, y2, y3}, zs[4] = {z0, z1, z2, z3};
+		__m128i hs[4] = {h0, h1, h2, h3};
+		for(unsigned long int i = 0; i < 4; ++i){
+			__m128 c = _mm_sub_ps(r, _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs[i], xs[i]), _mm_mul_ps(ys[i], ys[i])), _mm_mul_ps(zs[i], zs[i])));
+			c = _mm_max_ps(c, zero);
+			c = _mm_mul_ps(c, c);
+			c = _mm_mul_ps(c, c);
+			res = _mm_add_ps(res, _mm_mul_ps(c, grad4(hs[i], xs[i], ys[i], zs[i])));
+		}
+		return _mm_mul_ps(res, _mm_set1_ps(32.f));
+	}
+#endif
+}
+
+sweet::Noise::Noise(Type _type, unsigned long int _seed) :
+	type(_type),
+	octaves(1),
+	lacunarity(2.f),
+	persistence(0.5f)
+{
+	setSeed(_seed);
+}
+
+void sweet::Noise::setSeed(unsigned long int _seed){
+	seed = _seed;
+
+	// shuffle 0-255 using the hashed seed so that every generator gets its own table
+	for(unsigned long int i = 0; i < 256; ++i){
+		perm[i] = (unsigned char)i;
+	}
+	unsigned long int h = hash(seed);
+	for(unsigned long int i = 255; i > 0; --i){
+		h = hash(h + i);
+		std::swap(perm[i], perm[h % (i+1)]);
+	}
+	for(unsigned long int i = 0; i < 256; ++i){
+		perm[i+256] = perm[i];
+	}
+}
+
+unsigned long int sweet::Noise::getSeed() const{
+	return seed;
+}
+
+unsigned long int sweet::Noise::hash(unsigned long int _x){
+	// 32-bit integer finalizer from MurmurHash3
+	unsigned long int h = _x & 0xFFFFFFFF;
+	h ^= h >> 16;
+	h = (h * 0x85EBCA6B) & 0xFFFFFFFF;
+	h ^= h >> 13;
+	h = (h * 0xC2B2AE35) & 0xFFFFFFFF;
+	h ^= h >> 16;
+	return h;
+}
+
+unsigned char sweet::Noise::hash3(signed long int _x, signed long int _y, signed long int _z) const{
+	return permute(perm, _x, _y, _z);
+}
+
+float sweet::Noise::perlin(float _x, float _y, float _z) const{
+	signed long int X = fastFloor(_x), Y = fastFloor(_y), Z = fastFloor(_z);
+	float x0 = _x - X, y0 = _y - Y, z0 = _z - Z;
+	float x1 = x0 - 1, y1 = y0 - 1, z1 = z0 - 1;
+	float u = fade(x0), v = fade(y0), w = fade(z0);
+	return lerp(w,
+		lerp(v,
+			lerp(u, grad(hash3(X, Y, Z), x0, y0, z0), grad(hash3(X+1, Y, Z), x1, y0, z0)),
+			lerp(u, grad(hash3(X, Y+1, Z), x0, y1, z0), grad(hash3(X+1, Y+1, Z), x1, y1, z0))),
+		lerp(v,
+			lerp(u, grad(hash3(X, Y, Z+1), x0, y0, z1), grad(hash3(X+1, Y, Z+1), x1, y0, z1)),
+			lerp(u, grad(hash3(X, Y+1, Z+1), x0, y1, z1), grad(hash3(X+1, Y+1, Z+1), x1, y1, z1))));
+}
+
+float sweet::Noise::value(float _x, float _y, float _z) const{
+	signed long int X = fastFloor(_x), Y = fastFloor(_y), Z = fastFloor(_z);
+	float u = fade(_x - X), v = fade(_y - Y), w = fade(_z - Z);
+	float c[8];
+	for(unsigned long int i = 0; i < 8; ++i){
+		c[i] = hash3(X + (i & 1 ? 1 : 0), Y + (i & 2 ? 1 : 0), Z + (i & 4 ? 1 : 0)) * (2.f/255.f) - 1.f;
+	}
+	return lerp(w,
+		lerp(v, lerp(u, c[0], c[1]), lerp(u, c[2], c[3])),
+		lerp(v, lerp(u, c[4], c[5]), lerp(u, c[6], c[7])));
+}
+
+float sweet::Noise::simplex(float _x, float _y, float _z) const{
+	// skew the input space to find which simplex cell we're in
+	float s = (_x + _y + _z) * F3;
+	signed long int i = fastFloor(_x + s), j = fastFloor(_y + s), k = fastFloor(_z + s);
+
+	// unskew the cell origin back to xyz space and get the distance from it
+	float t = (i + j + k) * G3;
+	float x0 = _x - (i - t), y0 = _y - (j - t), z0 = _z - (k - t);
+
+	// find which of the six tetrahedra we're in: the second corner steps along the largest axis, the third corner along the two largest
+	bool xy = x0 >= y0, xz = x0 >= z0, yz = y0 >= z0;
+	signed long int
+		i1 = xy && xz,
+		j1 = !xy && yz,
+		k1 = !xz && !yz,
+		i2 = xy || xz,
+		j2 = !xy || yz,
+		k2 = !(xz && yz);
+
+	float xs[4] = {x0, x0 - i1 + G3, x0 - i2 + 2.f*G3, x0 - 1.f + 3.f*G3};
+	float ys[4] = {y0, y0 - j1 + G3, y0 - j2 + 2.f*G3, y0 - 1.f + 3.f*G3};
+	float zs[4] = {z0, z0 - k1 + G3, z0 - k2 + 2.f*G3, z0 - 1.f + 3.f*G3};
+	unsigned char hs[4] = {
+		hash3(i, j, k),
+		hash3(i+i1, j+j1, k+k1),
+		hash3(i+i2, j+j2, k+k2),
+		hash3(i+1, j+1, k+1)
+	};
+
+	// contribution of each corner, falling off to zero at a radius of sqrt(0.6)
+	float res = 0;
+	for(unsigned long int c = 0; c < 4; ++c){
+		float r = std::max(0.f, 0.6f - xs[c]*xs[c] - ys[c]*ys[c] - zs[c]*zs[c]);
+		r *= r;
+		res += r * r * grad(hs[c], xs[c], ys[c], zs[c]);
+	}
+	return res * 32.f;
+}
+
+float sweet::Noise::get(float _x, float _y, float _z) const{
+	float res;
+	getRow(&res, 1, _x, 0, _y, _z);
+	return res;
+}
+
+void sweet::Noise::getRow(float * _res, unsigned long int _count, float _x, float _dx, float _y, float _z) const{
+	for(unsigned long int i = 0; i < _count; ++i){
+		_res[i] = 0;
+	}
+
+	float frequency = 1;
+	float amplitude = 1;
+	float total = 0;
+	for(unsigned long int o = 0; o < std::max(1ul, octaves); ++o){
+		addRow(_res, _count, _x * frequency, _dx * frequency, _y * frequency, _z * frequency, amplitude);
+		total += amplitude;
+		frequency *= lacunarity;
+		amplitude *= persistence;
+	}
+
+	// normalize so that adding octaves doesn't change the range
+	if(total > 0 && total != 1){
+		for(unsigned long int i = 0; i < _count; ++i){
+			_res[i] /= total;
+		}
+	}
+}
+
+void sweet::Noise::addRow(float * _res, unsigned long int _count, float _x, float _dx, float _y, float _z, float _amplitude) const{
+	unsigned long int i = 0;
+#ifdef SWEET_NOISE_SSE
+	__m128 amplitude = _mm_set1_ps(_amplitude);
+	__m128 y = _mm_set1_ps(_y);
+	__m128 z = _mm_set1_ps(_z);
+	__m128 lanes = _mm_mul_ps(_mm_set_ps(3, 2, 1, 0), _mm_set1_ps(_dx));
+	for(; i + 4 <= _count; i += 4){
+		__m128 x = _mm_add_ps(_mm_set1_ps(_x + i * _dx), lanes);
+		__m128 n;
+		switch(type){
+			case kSIMPLEX: n = simplex4(perm, x, y, z); break;
+			case kVALUE: n = value4(perm, x, y, z); break;
+			default: n = perlin4(perm, x, y, z); break;
+		}
+		_mm_storeu_ps(_res + i, _mm_add_ps(_mm_loadu_ps(_res + i), _mm_mul_ps(n, amplitude)));
+	}
+#endif
+	// whatever is left over (or everything, if SSE isn't available)
+	for(; i < _count; ++i){
+		float x = _x + i * _dx;
+		float n;
+		switch(type){
+			case kSIMPLEX: n = simplex(x, _y, _z); break;
+			case kVALUE: n = value(x, _y, _z); break;
+			default: n = perlin(x, _y, _z); break;
+		}
+		_res[i] += n * _amplitude;
+	}
+}
+
+void sweet::Noise::fill(unsigned char * _data, unsigned long int _width, unsigned long int _height, unsigned long int _channels, glm::vec3 _frequency, float _z, float _amplitude, float _offset) const{
+	unsigned long int tilesX = (_width + tileWidth - 1) / tileWidth;
+	unsigned long int tilesY = (_height + tileHeight - 1) / tileHeight;
+
+	float dx = _frequency.x / _width;
+	float dy = _frequency.y / _height;
+	float z = _z * _frequency.z;
+
+	sweet::JobSystem::getInstance().parallelFor(tilesX * tilesY, [&](unsigned long int _tile){
+		unsigned long int x0 = (_tile % tilesX) * tileWidth;
+		unsigned long int y0 = (_tile / tilesX) * tileHeight;
+		unsigned long int w = std::min(tileWidth, _width - x0);
+		unsigned long int h = std::min(tileHeight, _height - y0);
+
+		float row[tileWidth];
+		for(unsigned long int y = y0; y < y0 + h; ++y){
+			getRow(row, w, x0 * dx, dx, y * dy, z);
+			unsigned char * p = _data + (x0 + y * _width) * _channels;
+			for(unsigned long int x = 0; x < w; ++x){
+				unsigned char v = (unsigned char)std::max(0.f, std::min(255.f, row[x] * _amplitude + _offset));
+				for(unsigned long int c = 0; c < _channels; ++c){
+					*(p++) = v;
+				}
+			}
+		}
+	});
+}
\ No newline at end of file
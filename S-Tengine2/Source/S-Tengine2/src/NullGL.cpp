@@ -0,0 +1,255 @@
+#pragma once
+
+#include <NullGL.h>
+
+#include <GL/glew.h>
+
+namespace{
+	sweet::NullGL::Stats stats;
+	bool recording = false;
+	std::vector<const char *> callLog;
+	// ids handed out by the gen/create stubs; 0 is never used since it means "no object" in GL
+	GLuint nextId = 1;
+
+	void record(const char * _name){
+		++stats.calls;
+		if(recording){
+			callLog.push_back(_name);
+		}
+	}
+	void generate(const char * _name, GLsizei _n, GLuint * _ids){
+		record(_name);
+		for(GLsizei i = 0; i < _n; ++i){
+			_ids[i] = nextId++;
+		}
+		stats.objectsCreated += _n;
+	}
+
+	// buffers
+	void GLAPIENTRY nullGenBuffers(GLsizei _n, GLuint * _buffers){ generate("glGenBuffers", _n, _buffers); }
+	void GLAPIENTRY nullBindBuffer(GLenum _target, GLuint _buffer){ record("glBindBuffer"); }
+	void GLAPIENTRY nullBufferData(GLenum _target, GLsizeiptr _size, const void * _data, GLenum _usage){
+		record("glBufferData");
+		// a null pointer just allocates (or orphans) the buffer without sending anything
+		if(_data != nullptr){
+			++stats.bufferUploads;
+			stats.bufferUploadBytes += _size;
+		}
+	}
+	void GLAPIENTRY nullBufferSubData(GLenum _target, GLintptr _offset, GLsizeiptr _size, const void * _data){
+		record("glBufferSubData");
+		++stats.bufferUploads;
+		stats.bufferUploadBytes += _size;
+	}
+	void GLAPIENTRY nullDeleteBuffers(GLsizei _n, const GLuint * _buffers){ record("glDeleteBuffers"); }
+	GLboolean GLAPIENTRY nullIsBuffer(GLuint _buffer){ record("glIsBuffer"); return _buffer != 0 && _buffer < nextId; }
+
+	// vertex arrays
+	void GLAPIENTRY nullGenVertexArrays(GLsizei _n, GLuint * _arrays){ generate("glGenVertexArrays", _n, _arrays); }
+	void GLAPIENTRY nullBindVertexArray(GLuint _array){ record("glBindVertexArray"); ++stats.vertexArrayBinds; }
+	void GLAPIENTRY nullDeleteVertexArrays(GLsizei _n, const GLuint * _arrays){ record("glDeleteVertexArrays"); }
+	GLboolean GLAPIENTRY nullIsVertexArray(GLuint _array){ record("glIsVertexArray"); return _array != 0 && _array < nextId; }
+	void GLAPIENTRY nullVertexAttribPointer(GLuint _index, GLint _size, GLenum _type, GLboolean _normalized, GLsizei _stride, const void * _pointer){ record("glVertexAttribPointer"); }
+	void GLAPIENTRY nullEnableVertexAttribArray(GLuint _index){ record("glEnableVertexAttribArray"); }
+	void GLAPIENTRY nullDisableVertexAttribArray(GLuint _index){ record("glDisableVertexAttribArray"); }
+
+	// shaders and programs
+	GLuint GLAPIENTRY nullCreateShader(GLenum _type){ record("glCreateShader"); ++stats.objectsCreated; return nextId++; }
+	GLuint GLAPIENTRY nullCreateProgram(){ record("glCreateProgram"); ++stats.objectsCreated; return nextId++; }
+	void GLAPIENTRY nullShaderSource(GLuint _shader, GLsizei _count, const GLchar * const * _string, const GLint * _length){ record("glShaderSource"); }
+	void GLAPIENTRY nullCompileShader(GLuint _shader){ record("glCompileShader"); }
+	void GLAPIENTRY nullAttachShader(GLuint _program, GLuint _shader){ record("glAttachShader"); }
+	void GLAPIENTRY nullDetachShader(GLuint _program, GLuint _shader){ record("glDetachShader"); }
+	void GLAPIENTRY nullBindAttribLocation(GLuint _program, GLuint _index, const GLchar * _name){ record("glBindAttribLocation"); }
+	void GLAPIENTRY nullLinkProgram(GLuint _program){ record("glLinkProgram"); }
+	void GLAPIENTRY nullUseProgram(GLuint _program){ record("glUseProgram"); ++stats.programBinds; }
+	void GLAPIENTRY nullDeleteShader(GLuint _shader){ record("glDeleteShader"); }
+	void GLAPIENTRY nullDeleteProgram(GLuint _program){ record("glDeleteProgram"); }
+	GLboolean GLAPIENTRY nullIsProgram(GLuint _program){ record("glIsProgram"); return _program != 0 && _program < nextId; }
+	// compiling and linking always succeed, with an empty info log
+	void GLAPIENTRY nullGetShaderiv(GLuint _shader, GLenum _pname, GLint * _params){
+		record("glGetShaderiv");
+		*_params = _pname == GL_INFO_LOG_LENGTH || _pname == GL_SHADER_SOURCE_LENGTH ? 0 : GL_TRUE;
+	}
+	void GLAPIENTRY nullGetProgramiv(GLuint _program, GLenum _pname, GLint * _params){
+		record("glGetProgramiv");
+		*_params = _pname == GL_INFO_LOG_LENGTH ? 0 : GL_TRUE;
+	}
+	void GLAPIENTRY nullGetShaderInfoLog(GLuint _shader, GLsizei _bufSize, GLsizei * _length, GLchar * _infoLog){
+		record("glGetShaderInfoLog");
+		if(_length != nullptr){
+			*_length = 0;
+		}
+		if(_bufSize > 0){
+			_infoLog[0] = '\0';
+		}
+	}
+	void GLAPIENTRY nullGetProgramInfoLog(GLuint _program, GLsizei _bufSize, GLsizei * _length, GLchar * _infoLog){
+		record("glGetProgramInfoLog");
+		if(_length != nullptr){
+			*_length = 0;
+		}
+		if(_bufSize > 0){
+			_infoLog[0] = '\0';
+		}
+	}
+	// every uniform and attribute exists
+	GLint GLAPIENTRY nullGetUniformLocation(GLuint _program, const GLchar * _name){ record("glGetUniformLocation"); return 0; }
+	GLint GLAPIENTRY nullGetAttribLocation(GLuint _program, const GLchar * _name){ record("glGetAttribLocation"); return 0; }
+
+	// uniforms
+	void uniform(const char * _name){
+		record(_name);
+		++stats.uniformUploads;
+	}
+	void GLAPIENTRY nullUniform1i(GLint _location, GLint _v0){ uniform("glUniform1i"); }
+	void GLAPIENTRY nullUniform1iv(GLint _location, GLsizei _count, const GLint * _value){ uniform("glUniform1iv"); }
+	void GLAPIENTRY nullUniform1f(GLint _location, GLfloat _v0){ uniform("glUniform1f"); }
+	void GLAPIENTRY nullUniform2f(GLint _location, GLfloat _v0, GLfloat _v1){ uniform("glUniform2f"); }
+	void GLAPIENTRY nullUniform3f(GLint _location, GLfloat _v0, GLfloat _v1, GLfloat _v2){ uniform("glUniform3f"); }
+	void GLAPIENTRY nullUniform4f(GLint _location, GLfloat _v0, GLfloat _v1, GLfloat _v2, GLfloat _v3){ uniform("glUniform4f"); }
+	void GLAPIENTRY nullUniform1fv(GLint _location, GLsizei _count, const GLfloat * _value){ uniform("glUniform1fv"); }
+	void GLAPIENTRY nullUniform3fv(GLint _location, GLsizei _count, const GLfloat * _value){ uniform("glUniform3fv"); }
+	void GLAPIENTRY nullUniform4fv(GLint _location, GLsizei _count, const GLfloat * _value){ uniform("glUniform4fv"); }
+	void GLAPIENTRY nullUniformMatrix4fv(GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat * _value){ uniform("glUniformMatrix4fv"); }
+
+	// drawing and state
+	void GLAPIENTRY nullDrawRangeElements(GLenum _mode, GLuint _start, GLuint _end, GLsizei _count, GLenum _type, const void * _indices){
+		record("glDrawRangeElements");
+		++stats.drawCalls;
+		stats.indicesDrawn += _count;
+	}
+	void GLAPIENTRY nullActiveTexture(GLenum _texture){ record("glActiveTexture"); }
+	void GLAPIENTRY nullGenerateMipmap(GLenum _target){ record("glGenerateMipmap"); }
+	void GLAPIENTRY nullBlendEquation(GLenum _mode){ record("glBlendEquation"); }
+
+	// framebuffers and renderbuffers
+	void GLAPIENTRY nullGenFramebuffers(GLsizei _n, GLuint * _framebuffers){ generate("glGenFramebuffers", _n, _framebuffers); stats.framebuffersCreated += _n; }
+	void GLAPIENTRY nullBindFramebuffer(GLenum _target, GLuint _framebuffer){ record("glBindFramebuffer"); ++stats.framebufferBinds; }
+	void GLAPIENTRY nullDeleteFramebuffers(GLsizei _n, const GLuint * _framebuffers){ record("glDeleteFramebuffers"); }
+	void GLAPIENTRY nullFramebufferTexture2D(GLenum _target, GLenum _attachment, GLenum _textarget, GLuint _texture, GLint _level){ record("glFramebufferTexture2D"); }
+	GLenum GLAPIENTRY nullCheckFramebufferStatus(GLenum _target){ record("glCheckFramebufferStatus"); return GL_FRAMEBUFFER_COMPLETE; }
+	void GLAPIENTRY nullBlitFramebuffer(GLint _srcX0, GLint _srcY0, GLint _srcX1, GLint _srcY1, GLint _dstX0, GLint _dstY0, GLint _dstX1, GLint _dstY1, GLbitfield _mask, GLenum _filter){ record("glBlitFramebuffer"); }
+	void GLAPIENTRY nullGenRenderbuffers(GLsizei _n, GLuint * _renderbuffers){ generate("glGenRenderbuffers", _n, _renderbuffers); }
+	void GLAPIENTRY nullBindRenderbuffer(GLenum _target, GLuint _renderbuffer){ record("glBindRenderbuffer"); }
+	void GLAPIENTRY nullDeleteRenderbuffers(GLsizei _n, const GLuint * _renderbuffers){ record("glDeleteRenderbuffers"); }
+	void GLAPIENTRY nullRenderbufferStorage(GLenum _target, GLenum _internalformat, GLsizei _width, GLsizei _height){
+		record("glRenderbufferStorage");
+		++stats.renderbufferAllocations;
+		stats.renderbufferBytes += _width * _height * 4;
+	}
+	void GLAPIENTRY nullFramebufferRenderbuffer(GLenum _target, GLenum _attachment, GLenum _renderbuffertarget, GLuint _renderbuffer){ record("glFramebufferRenderbuffer"); }
+}
+
+// GLEW stores each entry point in a variable named __glew<Function>; the casts cover the differences in
+// constness between GLEW versions (e.g. glShaderSource), which don't change the calling convention
+#define SWEET_NULL_GL(_name, _type) __glew##_name = (_type)&null##_name
+
+bool sweet::NullGL::installed = false;
+
+sweet::NullGL::Stats::Stats() :
+	calls(0),
+	drawCalls(0),
+	indicesDrawn(0),
+	bufferUploads(0),
+	bufferUploadBytes(0),
+	uniformUploads(0),
+	programBinds(0),
+	vertexArrayBinds(0),
+	framebufferBinds(0),
+	objectsCreated(0),
+	framebuffersCreated(0),
+	renderbufferAllocations(0),
+	renderbufferBytes(0)
+{
+}
+
+void sweet::NullGL::install(){
+	SWEET_NULL_GL(GenBuffers, PFNGLGENBUFFERSPROC);
+	SWEET_NULL_GL(BindBuffer, PFNGLBINDBUFFERPROC);
+	SWEET_NULL_GL(BufferData, PFNGLBUFFERDATAPROC);
+	SWEET_NULL_GL(BufferSubData, PFNGLBUFFERSUBDATAPROC);
+	SWEET_NULL_GL(DeleteBuffers, PFNGLDELETEBUFFERSPROC);
+	SWEET_NULL_GL(IsBuffer, PFNGLISBUFFERPROC);
+
+	SWEET_NULL_GL(GenVertexArrays, PFNGLGENVERTEXARRAYSPROC);
+	SWEET_NULL_GL(BindVertexArray, PFNGLBINDVERTEXARRAYPROC);
+	SWEET_NULL_GL(DeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC);
+	SWEET_NULL_GL(IsVertexArray, PFNGLISVERTEXARRAYPROC);
+	SWEET_NULL_GL(VertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC);
+	SWEET_NULL_GL(EnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC);
+	SWEET_NULL_GL(DisableVertexAttribArray, PFNGLDISABLEVERTEXATTRIBARRAYPROC);
+
+	SWEET_NULL_GL(CreateShader, PFNGLCREATESHADERPROC);
+	SWEET_NULL_GL(CreateProgram, PFNGLCREATEPROGRAMPROC);
+	SWEET_NULL_GL(ShaderSource, PFNGLSHADERSOURCEPROC);
+	SWEET_NULL_GL(CompileShader, PFNGLCOMPILESHADERPROC);
+	SWEET_NULL_GL(AttachShader, PFNGLATTACHSHADERPROC);
+	SWEET_NULL_GL(DetachShader, PFNGLDETACHSHADERPROC);
+	SWEET_NULL_GL(BindAttribLocation, PFNGLBINDATTRIBLOCATIONPROC);
+	SWEET_NULL_GL(LinkProgram, PFNGLLINKPROGRAMPROC);
+	SWEET_NULL_GL(UseProgram, PFNGLUSEPROGRAMPROC);
+	SWEET_NULL_GL(DeleteShader, PFNGLDELETESHADERPROC);
+	SWEET_NULL_GL(DeleteProgram, PFNGLDELETEPROGRAMPROC);
+	SWEET_NULL_GL(IsProgram, PFNGLISPROGRAMPROC);
+	SWEET_NULL_GL(GetShaderiv, PFNGLGETSHADERIVPROC);
+	SWEET_NULL_GL(GetProgramiv, PFNGLGETPROGRAMIVPROC);
+	SWEET_NULL_GL(GetShaderInfoLog, PFNGLGETSHADERINFOLOGPROC);
+	SWEET_NULL_GL(GetProgramInfoLog, PFNGLGETPROGRAMINFOLOGPROC);
+	SWEET_NULL_GL(GetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC);
+	SWEET_NULL_GL(GetAttribLocation, PFNGLGETATTRIBLOCATIONPROC);
+
+	SWEET_NULL_GL(Uniform1i, PFNGLUNIFORM1IPROC);
+	SWEET_NULL_GL(Uniform1iv, PFNGLUNIFORM1IVPROC);
+	SWEET_NULL_GL(Uniform1f, PFNGLUNIFORM1FPROC);
+	SWEET_NULL_GL(Uniform2f, PFNGLUNIFORM2FPROC);
+	SWEET_NULL_GL(Uniform3f, PFNGLUNIFORM3FPROC);
+	SWEET_NULL_GL(Uniform4f, PFNGLUNIFORM4FPROC);
+	SWEET_NULL_GL(Uniform1fv, PFNGLUNIFORM1FVPROC);
+	SWEET_NULL_GL(Uniform3fv, PFNGLUNIFORM3FVPROC);
+	SWEET_NULL_GL(Uniform4fv, PFNGLUNIFORM4FVPROC);
+	SWEET_NULL_GL(UniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC);
+
+	SWEET_NULL_GL(DrawRangeElements, PFNGLDRAWRANGEELEMENTSPROC);
+	SWEET_NULL_GL(ActiveTexture, PFNGLACTIVETEXTUREPROC);
+	SWEET_NULL_GL(GenerateMipmap, PFNGLGENERATEMIPMAPPROC);
+	SWEET_NULL_GL(BlendEquation, PFNGLBLENDEQUATIONPROC);
+
+	SWEET_NULL_GL(GenFramebuffers, PFNGLGENFRAMEBUFFERSPROC);
+	SWEET_NULL_GL(BindFramebuffer, PFNGLBINDFRAMEBUFFERPROC);
+	SWEET_NULL_GL(DeleteFramebuffers, PFNGLDELETEFRAMEBUFFERSPROC);
+	SWEET_NULL_GL(FramebufferTexture2D, PFNGLFRAMEBUFFERTEXTURE2DPROC);
+	SWEET_NULL_GL(CheckFramebufferStatus, PFNGLCHECKFRAMEBUFFERSTATUSPROC);
+	SWEET_NULL_GL(BlitFramebuffer, PFNGLBLITFRAMEBUFFERPROC);
+	SWEET_NULL_GL(GenRenderbuffers, PFNGLGENRENDERBUFFERSPROC);
+	SWEET_NULL_GL(BindRenderbuffer, PFNGLBINDRENDERBUFFERPROC);
+	SWEET_NULL_GL(DeleteRenderbuffers, PFNGLDELETERENDERBUFFERSPROC);
+	SWEET_NULL_GL(RenderbufferStorage, PFNGLRENDERBUFFERSTORAGEPROC);
+	SWEET_NULL_GL(FramebufferRenderbuffer, PFNGLFRAMEBUFFERRENDERBUFFERPROC);
+
+	installed = true;
+}
+
+bool sweet::NullGL::isInstalled(){
+	return installed;
+}
+
+const sweet::NullGL::Stats & sweet::NullGL::getStats(){
+	return stats;
+}
+
+void sweet::NullGL::resetStats(){
+	stats = Stats();
+}
+
+void sweet::NullGL::setRecording(bool _recording){
+	recording = _recording;
+}
+
+const std::vector<const char *> & sweet::NullGL::getCallLog(){
+	return callLog;
+}
+
+void sweet::NullGL::clearCallLog(){
+	callLog.clear();
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <rng.h>
 #include <NumberUtils.h>
+#include <Random.h>
 #include <Log.h>
 #include <algorithm>
 
@@ -9,6 +9,17 @@
 
 unsigned long int sweet::NumberUtils::numRandCalls = 0;
 
+namespace{
+	// the "default" stream, cached so that every call doesn't have to look it up
+	sweet::Random * defaultRandom = nullptr;
+
+	sweet::Random & getDefaultRandom(){
+		if(defaultRandom == nullptr){
+			defaultRandom = &sweet::Random::getStream("default");
+		}
+		return *defaultRandom;
+	}
+}
 
 
 
@@ -29,26 +40,31 @@ float sweet::NumberUtils::map(float _val, float _oldMin, float _oldMax, float _n
 }
 
 float sweet::NumberUtils::randomFloat(float _min, float _max){
-	return _min + randomFloat() * (_max - _min);
-	return 0;
+	++numRandCalls;
+	return getDefaultRandom().nextFloat(_min, _max);
 }
 float sweet::NumberUtils::randomFloat(){
-	return (float)randomInt()/(INT_MAX/2);
+	++numRandCalls;
+	return getDefaultRandom().nextFloat();
 }
 
 int sweet::NumberUtils::randomInt(int _min, int _max){
-	return _min + randomInt() % (_max - _min +1);
+	++numRandCalls;
+	return getDefaultRandom().nextInt(_min, _max);
 }
 int sweet::NumberUtils::randomInt(){
 	++numRandCalls;
-	return ran_arr_cycle();
+	// 30 bits, to keep the range the same as the generator this used to use
+	return getDefaultRandom().next() >> 2;
 }
 bool sweet::NumberUtils::randomBool(){
-	return randomInt(0, 1) == 1;
+	++numRandCalls;
+	return getDefaultRandom().nextBool();
 }
 
 glm::vec3 sweet::NumberUtils::randomVec3(glm::vec3 _min, glm::vec3 _max){
-	return glm::vec3(randomFloat(_min.x, _max.x), randomFloat(_min.y, _max.y), randomFloat(_min.z, _max.z));
+	++numRandCalls;
+	return getDefaultRandom().nextVec3(_min, _max);
 }
 
 
@@ -58,14 +74,17 @@ long int sweet::NumberUtils::p[512];
 void sweet::NumberUtils::seed(unsigned long int _seed){
 	numRandCalls = 0;
 	Log::info("Seeded RNG with: " + std::to_string(_seed));
-	ran_start(_seed);
+	sweet::Random::seedStreams(_seed);
 
 	// stuff for perlin noise permutation array
+	sweet::Random & noise = sweet::Random::getStream("perlin");
 	for(unsigned long int i = 0; i < 256; ++i){
-		ran_array(p, 256);
+		p[i] = i;
+	}
+	for(unsigned long int i = 255; i > 0; --i){
+		std::swap(p[i], p[noise.nextBounded(i + 1)]);
 	}
 	for(unsigned long int i = 0; i < 256; ++i){
-		p[i] %= 256;
 		p[256+i] = p[i];
 	}
 }
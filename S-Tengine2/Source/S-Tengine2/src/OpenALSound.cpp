@@ -5,8 +5,10 @@
 #include <Camera.h>
 
 #include <sndfile.hh>
+#include <AssetArchive.h>
 
 #include <algorithm>
+#include <cstring>
 
 
 ALCcontext * NodeOpenAL::context = nullptr; 
@@ -74,6 +76,37 @@ float NodeOpenAL::getListenerGain(){
 	return listenerGain;
 }
 
+// libsndfile virtual io for reading sounds out of an asset archive
+namespace{
+	struct MemoryFile{
+		const unsigned char * data;
+		sf_count_t size;
+		sf_count_t pos;
+	};
+	sf_count_t memoryGetLength(void * _file){
+		return static_cast<MemoryFile *>(_file)->size;
+	}
+	sf_count_t memorySeek(sf_count_t _offset, int _whence, void * _file){
+		MemoryFile * f = static_cast<MemoryFile *>(_file);
+		sf_count_t pos = _whence == SEEK_SET ? _offset : _whence == SEEK_CUR ? f->pos + _offset : f->size + _offset;
+		f->pos = std::max<sf_count_t>(0, std::min(pos, f->size));
+		return f->pos;
+	}
+	sf_count_t memoryRead(void * _ptr, sf_count_t _count, void * _file){
+		MemoryFile * f = static_cast<MemoryFile *>(_file);
+		sf_count_t n = std::min(_count, f->size - f->pos);
+		memcpy(_ptr, f->data + f->pos, (size_t)n);
+		f->pos += n;
+		return n;
+	}
+	sf_count_t memoryWrite(const void * _ptr, sf_count_t _count, void * _file){
+		return 0;
+	}
+	sf_count_t memoryTell(void * _file){
+		return static_cast<MemoryFile *>(_file)->pos;
+	}
+}
+
 OpenAL_Buffer::OpenAL_Buffer(const char * _filename, bool _autoRelease) :
 	NodeResource(_autoRelease),
 	bufferId(0),
@@ -85,8 +118,22 @@ OpenAL_Buffer::OpenAL_Buffer(const char * _filename, bool _autoRelease) :
 
 	if(_filename != nullptr){
 		// open the file
+		// (using the packed copy if there is one)
 		SF_INFO fileInfo;
-		SNDFILE * file = sf_open(_filename, SFM_READ, &fileInfo);
+		SNDFILE * file;
+		std::string buffer;
+		size_t packedSize;
+		MemoryFile memoryFile;
+		memoryFile.data = sweet::AssetArchive::getFile(_filename, packedSize, buffer);
+		if(memoryFile.data != nullptr){
+			SF_VIRTUAL_IO io = { &memoryGetLength, &memorySeek, &memoryRead, &memoryWrite, &memoryTell };
+			memoryFile.size = packedSize;
+			memoryFile.pos = 0;
+			fileInfo.format = 0;
+			file = sf_open_virtual(&io, SFM_READ, &fileInfo, &memoryFile);
+		}else{
+			file = sf_open(_filename, SFM_READ, &fileInfo);
+		}
 
 		// get the number of samples and sample rate
 		numSamples = static_cast<ALsizei>(fileInfo.channels * fileInfo.frames);
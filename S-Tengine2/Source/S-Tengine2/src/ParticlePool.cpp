@@ -0,0 +1,344 @@
+#pragma once
+
+#include <ParticlePool.h>
+
+#include <MeshInterface.h>
+#include <Box2DWorld.h>
+#include <Texture.h>
+#include <JobSystem.h>
+#include <Random.h>
+#include <Step.h>
+
+#include <algorithm>
+
+namespace{
+	// number of particles handled by each job
+	const unsigned long int batchSize = 512;
+
+	// particles draw from their own stream so that emitting them doesn't shift the sequence seen by gameplay code
+	// (cached so that every call doesn't have to look it up)
+	sweet::Random * particleRandom = nullptr;
+	sweet::Random & getParticleRandom(){
+		if(particleRandom == nullptr){
+			particleRandom = &sweet::Random::getStream("particles");
+		}
+		return *particleRandom;
+	}
+
+	// returns _value plus a random offset between -_variance and _variance
+	float vary(float _value, float _variance){
+		return _variance == 0 ? _value : _value + getParticleRandom().nextFloat(-_variance, _variance);
+	}
+	glm::vec3 vary(glm::vec3 _value, glm::vec3 _variance){
+		return glm::vec3(vary(_value.x, _variance.x), vary(_value.y, _variance.y), vary(_value.z, _variance.z));
+	}
+
+	// collects the fixtures in an area which would collide with a given filter
+	class NearbyFixtureQuery : public b2QueryCallback{
+	public:
+		const b2Filter & filter;
+		std::vector<b2Fixture *> & fixtures;
+
+		NearbyFixtureQuery(const b2Filter & _filter, std::vector<b2Fixture *> & _fixtures) :
+			filter(_filter),
+			fixtures(_fixtures)
+		{
+		}
+
+		virtual bool ReportFixture(b2Fixture * _fixture) override{
+			if(_fixture->IsSensor()){
+				return true;
+			}
+			// same rules as b2ContactFilter::ShouldCollide
+			const b2Filter & other = _fixture->GetFilterData();
+			bool collide;
+			if(filter.groupIndex == other.groupIndex && filter.groupIndex != 0){
+				collide = filter.groupIndex > 0;
+			}else{
+				collide = (filter.maskBits & other.categoryBits) != 0 && (filter.categoryBits & other.maskBits) != 0;
+			}
+			if(collide){
+				fixtures.push_back(_fixture);
+			}
+			return true;
+		}
+	};
+}
+
+ParticleEmitter::ParticleEmitter() :
+	position(0),
+	positionVariance(0),
+	velocity(0),
+	velocityVariance(0),
+	life(1.f),
+	lifeVariance(0),
+	startSize(1.f),
+	endSize(1.f),
+	sizeVariance(0),
+	startColour(1.f),
+	endColour(1.f),
+	rate(0),
+	active(true),
+	accumulator(0)
+{
+}
+
+ParticleForce::ParticleForce(Type _type, glm::vec3 _vector, float _strength) :
+	type(_type),
+	vector(_vector),
+	strength(_strength)
+{
+}
+
+ParticlePool::ParticlePool(unsigned long int _capacity, Texture * _texture, Shader * _shader) :
+	MeshEntity(new TriMesh(true, GL_TRIANGLES, GL_DYNAMIC_DRAW), _shader),
+	world(nullptr),
+	restitution(0.5f),
+	friction(0.9f),
+	capacity(_capacity),
+	count(0),
+	positions(_capacity),
+	velocities(_capacity),
+	ages(_capacity),
+	lives(_capacity),
+	startSizes(_capacity),
+	endSizes(_capacity),
+	startColours(_capacity),
+	endColours(_capacity),
+	previousPositions(_capacity)
+{
+	if(_texture != nullptr){
+		mesh->pushTexture2D(_texture);
+	}
+
+	// the quads never change order, so the indices for the whole pool can be generated up front
+	quadIndices.reserve(capacity * 6);
+	for(unsigned long int i = 0; i < capacity; ++i){
+		GLuint v = i * 4;
+		quadIndices.push_back(v);
+		quadIndices.push_back(v+1);
+		quadIndices.push_back(v+2);
+		quadIndices.push_back(v+2);
+		quadIndices.push_back(v+3);
+		quadIndices.push_back(v);
+	}
+	mesh->vertices.reserve(capacity * 4);
+	mesh->indices.reserve(capacity * 6);
+}
+
+ParticlePool::~ParticlePool(){
+}
+
+void ParticlePool::update(Step * _step){
+	for(auto & e : emitters){
+		if(e.active && e.rate > 0){
+			e.accumulator += e.rate * _step->deltaTime;
+			unsigned long int n = (unsigned long int)e.accumulator;
+			e.accumulator -= n;
+			emit(e, n);
+		}
+	}
+
+	simulate(_step->deltaTime);
+	updateMesh();
+
+	MeshEntity::update(_step);
+}
+
+unsigned long int ParticlePool::emit(const ParticleEmitter & _emitter, unsigned long int _count){
+	_count = std::min(_count, capacity - count);
+	for(unsigned long int i = 0; i < _count; ++i, ++count){
+		positions[count] = previousPositions[count] = vary(_emitter.position, _emitter.positionVariance);
+		velocities[count] = vary(_emitter.velocity, _emitter.velocityVariance);
+		ages[count] = 0;
+		lives[count] = std::max(0.f, vary(_emitter.life, _emitter.lifeVariance));
+		float size = vary(0, _emitter.sizeVariance);
+		startSizes[count] = _emitter.startSize + size;
+		endSizes[count] = _emitter.endSize + size;
+		startColours[count] = _emitter.startColour;
+		endColours[count] = _emitter.endColour;
+	}
+	return _count;
+}
+
+void ParticlePool::simulate(float _deltaTime){
+	if(count == 0){
+		return;
+	}
+
+	// integrate in parallel; each batch only touches its own particles
+	unsigned long int numBatches = (count + batchSize - 1) / batchSize;
+	sweet::JobSystem::getInstance().parallelFor(numBatches, [&](unsigned long int _batch){
+		unsigned long int start = _batch * batchSize;
+		unsigned long int end = std::min(count, start + batchSize);
+		for(unsigned long int i = start; i < end; ++i){
+			glm::vec3 acceleration(0);
+			for(const auto & f : forces){
+				switch(f.type){
+					case ParticleForce::kDIRECTIONAL:
+						acceleration += f.vector * f.strength;
+						break;
+					case ParticleForce::kPOINT:{
+						glm::vec3 d = f.vector - positions[i];
+						float len = glm::length(d);
+						if(len > 0){
+							acceleration += d / len * f.strength;
+						}
+						break;
+					}
+					case ParticleForce::kDRAG:
+						acceleration -= velocities[i] * f.strength;
+						break;
+				}
+			}
+			velocities[i] += acceleration * _deltaTime;
+			previousPositions[i] = positions[i];
+			positions[i] += velocities[i] * _deltaTime;
+			ages[i] += _deltaTime;
+		}
+	});
+
+	if(world != nullptr){
+		collide();
+	}
+
+	// kill from the back so that the particle swapped into each slot has already been checked
+	for(signed long int i = count - 1; i >= 0; --i){
+		if(ages[i] >= lives[i]){
+			kill(i);
+		}
+	}
+}
+
+void ParticlePool::collide(){
+	// find everything near the particles with a single query
+	b2AABB bounds;
+	bounds.lowerBound.Set(positions[0].x, positions[0].y);
+	bounds.upperBound = bounds.lowerBound;
+	for(unsigned long int i = 0; i < count; ++i){
+		bounds.lowerBound.x = std::min(bounds.lowerBound.x, std::min(positions[i].x, previousPositions[i].x));
+		bounds.lowerBound.y = std::min(bounds.lowerBound.y, std::min(positions[i].y, previousPositions[i].y));
+		bounds.upperBound.x = std::max(bounds.upperBound.x, std::max(positions[i].x, previousPositions[i].x));
+		bounds.upperBound.y = std::max(bounds.upperBound.y, std::max(positions[i].y, previousPositions[i].y));
+	}
+	nearbyFixtures.clear();
+	NearbyFixtureQuery query(collisionFilter, nearbyFixtures);
+	world->b2world->QueryAABB(&query, bounds);
+	if(nearbyFixtures.size() == 0){
+		return;
+	}
+
+	// raycast each particle against the nearby fixtures
+	// the world isn't stepped during this, so the fixtures can be read from several threads at once
+	unsigned long int numBatches = (count + batchSize - 1) / batchSize;
+	sweet::JobSystem::getInstance().parallelFor(numBatches, [&](unsigned long int _batch){
+		unsigned long int start = _batch * batchSize;
+		unsigned long int end = std::min(count, start + batchSize);
+		for(unsigned long int i = start; i < end; ++i){
+			b2RayCastInput input;
+			input.p1.Set(previousPositions[i].x, previousPositions[i].y);
+			input.p2.Set(positions[i].x, positions[i].y);
+			input.maxFraction = 1.f;
+			if(input.p1 == input.p2){
+				continue;
+			}
+			b2AABB segment;
+			segment.lowerBound = b2Min(input.p1, input.p2);
+			segment.upperBound = b2Max(input.p1, input.p2);
+
+			bool hit = false;
+			b2Vec2 normal;
+			for(b2Fixture * fixture : nearbyFixtures){
+				for(int32 child = 0; child < fixture->GetShape()->GetChildCount(); ++child){
+					if(!b2TestOverlap(segment, fixture->GetAABB(child))){
+						continue;
+					}
+					b2RayCastOutput output;
+					if(fixture->RayCast(&output, input, child)){
+						// only keep the closest hit
+						input.maxFraction = output.fraction;
+						normal = output.normal;
+						hit = true;
+					}
+				}
+			}
+
+			if(hit){
+				glm::vec3 n(normal.x, normal.y, 0);
+				glm::vec3 & v = velocities[i];
+				float vn = glm::dot(v, n);
+				if(vn < 0){
+					glm::vec3 normalVelocity = n * vn;
+					v = (v - normalVelocity) * friction - normalVelocity * restitution;
+				}
+				// put the particle at the point of contact, nudged off of the surface
+				glm::vec3 contact = previousPositions[i] + (positions[i] - previousPositions[i]) * input.maxFraction;
+				positions[i] = contact + n * b2_linearSlop;
+			}
+		}
+	});
+}
+
+void ParticlePool::updateMesh(){
+	mesh->vertices.resize(count * 4, Vertex(0, 0, 0));
+	mesh->indices.assign(quadIndices.begin(), quadIndices.begin() + count * 6);
+
+	unsigned long int numBatches = (count + batchSize - 1) / batchSize;
+	sweet::JobSystem::getInstance().parallelFor(numBatches, [&](unsigned long int _batch){
+		unsigned long int start = _batch * batchSize;
+		unsigned long int end = std::min(count, start + batchSize);
+		for(unsigned long int i = start; i < end; ++i){
+			float t = lives[i] > 0 ? std::min(1.f, ages[i] / lives[i]) : 1.f;
+			float halfSize = (startSizes[i] + (endSizes[i] - startSizes[i]) * t) * 0.5f;
+			glm::vec4 c = startColours[i] + (endColours[i] - startColours[i]) * t;
+			const glm::vec3 & p = positions[i];
+
+			Vertex * v = &mesh->vertices[i * 4];
+			v[0] = Vertex(p.x - halfSize, p.y - halfSize, p.z, c.r, c.g, c.b, c.a, 0, 0, 1.f, 0, 0);
+			v[1] = Vertex(p.x + halfSize, p.y - halfSize, p.z, c.r, c.g, c.b, c.a, 0, 0, 1.f, 1.f, 0);
+			v[2] = Vertex(p.x + halfSize, p.y + halfSize, p.z, c.r, c.g, c.b, c.a, 0, 0, 1.f, 1.f, 1.f);
+			v[3] = Vertex(p.x - halfSize, p.y + halfSize, p.z, c.r, c.g, c.b, c.a, 0, 0, 1.f, 0, 1.f);
+		}
+	});
+	// the particles have moved, so every vertex and the culling bounds need to be updated before the next render
+	mesh->makeDirty();
+}
+
+void ParticlePool::clear(){
+	count = 0;
+}
+
+void ParticlePool::kill(unsigned long int _idx){
+	--count;
+	if(_idx != count){
+		positions[_idx] = positions[count];
+		previousPositions[_idx] = previousPositions[count];
+		velocities[_idx] = velocities[count];
+		ages[_idx] = ages[count];
+		lives[_idx] = lives[count];
+		startSizes[_idx] = startSizes[count];
+		endSizes[_idx] = endSizes[count];
+		startColours[_idx] = startColours[count];
+		endColours[_idx] = endColours[count];
+	}
+}
+
+unsigned long int ParticlePool::getCount() const{
+	return count;
+}
+unsigned long int ParticlePool::getCapacity() const{
+	return capacity;
+}
+
+const glm::vec3 * ParticlePool::getPositions() const{
+	return positions.data();
+}
+const glm::vec3 * ParticlePool::getVelocities() const{
+	return velocities.data();
+}
+const float * ParticlePool::getAges() const{
+	return ages.data();
+}
+const float * ParticlePool::getLives() const{
+	return lives.data();
+}
\ No newline at end of file
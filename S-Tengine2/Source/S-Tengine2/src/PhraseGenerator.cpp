@@ -38,11 +38,89 @@ void PhraseGenerator::makeDatabases(std::string _databaseSrc) {
 				}
 			}
 		}
+
+		// compile every term up-front so that expansion never has to parse anything
+		// (this happens after the whole file is read in case the escapeChar came after some of the terms)
+		clearTemplates();
+		for(auto memberName : termLists){
+			if(memberName != "escapeChar"){
+				for(Json::Value::ArrayIndex i = 0; i < root[memberName].size(); ++i){
+					getTemplate(root[memberName][i].asString());
+				}
+			}
+		}
+	}
+}
+
+void PhraseGenerator::clearTemplates(){
+	templates.clear();
+	templateEscapeChar = escapeChar;
+}
+
+const PhraseTemplate & PhraseGenerator::getTemplate(const std::string & _phrase){
+	if(templateEscapeChar != escapeChar){
+		clearTemplates();
+	}
+	auto it = templates.find(_phrase);
+	if(it != templates.end()){
+		return it->second;
+	}
+
+	PhraseTemplate & t = templates[_phrase];
+	std::string literal;
+	size_t pos = 0;
+	while(pos < _phrase.size()){
+		size_t start = escapeChar.empty() ? std::string::npos : _phrase.find(escapeChar, pos);
+		size_t end = start == std::string::npos ? std::string::npos : _phrase.find(escapeChar, start + escapeChar.size());
+		if(end == std::string::npos){
+			// no more complete placeholders; an unmatched escapeChar is kept as literal text
+			literal.append(_phrase, pos, std::string::npos);
+			break;
+		}
+		literal.append(_phrase, pos, start - pos);
+		std::string word = _phrase.substr(start + escapeChar.size(), end - start - escapeChar.size());
+		if(word.empty()){
+			literal.append(escapeChar);
+		}else{
+			if(!literal.empty()){
+				PhraseTemplate::Segment s = { literal, nullptr };
+				t.segments.push_back(s);
+				literal.clear();
+			}
+			PhraseTemplate::Segment s = { word, &terms[word] };
+			t.segments.push_back(s);
+		}
+		pos = end + escapeChar.size();
+	}
+	if(!literal.empty()){
+		PhraseTemplate::Segment s = { literal, nullptr };
+		t.segments.push_back(s);
 	}
+	return t;
+}
+
+void PhraseGenerator::expand(const PhraseTemplate & _template, std::string & _output, unsigned long int _depth){
+	for(const PhraseTemplate::Segment & s : _template.segments){
+		if(s.terms == nullptr){
+			_output.append(s.text);
+		}else if(s.terms->size() == 0){
+			Log::warn("PhraseGenerator: no terms for \"" + s.text + "\"");
+		}else if(_depth >= 32){
+			Log::warn("PhraseGenerator: \"" + s.text + "\" is nested too deeply");
+		}else{
+			expand(getTemplate(s.terms->pop()), _output, _depth + 1);
+		}
+	}
+}
+
+std::string PhraseGenerator::replaceWords(std::string _phrase){
+	buffer.clear();
+	expand(getTemplate(_phrase), buffer);
+	return buffer;
 }
 
 
-std::string PhraseGenerator::replaceWords(std::string phrase) {
+std::string PhraseGenerator::replaceWordsRegex(std::string phrase) {
 	while(phrase.find(escapeChar) != std::string::npos){
 		std::regex r("\\" + escapeChar + "(.+?)\\" + escapeChar);
 		std::smatch match;
@@ -12,7 +12,7 @@ Plane::Plane(glm::vec3 _center, float _size, Shader * _shader) :
 		mesh->vertices.at(i).y -= _center.y;
 		mesh->vertices.at(i).z -= _center.z;
 	}
-	mesh->dirty = true;
+	mesh->makeDirty();
 }
 
 Plane::~Plane(){
@@ -25,7 +25,7 @@ void Plane::setColour(float _red, float _green, float _blue, float _alpha){
 		mesh->vertices.at(i).blue  = _blue;
 		mesh->vertices.at(i).alpha = _alpha;
 	}
-	mesh->dirty = true;
+	mesh->makeVerticesDirty(0, 4);
 }
 
 void Plane::setVertexColour(int _index, float _red, float _green, float _blue, float _alpha){
@@ -33,5 +33,5 @@ void Plane::setVertexColour(int _index, float _red, float _green, float _blue, f
 	mesh->vertices.at(_index).green = _green;
 	mesh->vertices.at(_index).blue  = _blue;
 	mesh->vertices.at(_index).alpha = _alpha;
-	mesh->dirty = true;
+	mesh->makeVerticesDirty(_index);
 }
\ No newline at end of file
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <Profiler.h>
+#include <JobSystem.h>
+#include <Log.h>
+
+#include <fstream>
+#include <algorithm>
+#include <cassert>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#else
+	#include <chrono>
+#endif
+
+namespace{
+	// returns a timestamp in platform-specific ticks
+	long long int getTicks(){
+#ifdef _WIN32
+		LARGE_INTEGER t;
+		QueryPerformanceCounter(&t);
+		return t.QuadPart;
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+	// returns the number of ticks in a second
+	double getTickFrequency(){
+#ifdef _WIN32
+		LARGE_INTEGER f;
+		QueryPerformanceFrequency(&f);
+		return (double)f.QuadPart;
+#else
+		return 1e9;
+#endif
+	}
+
+	// the calling thread's index in Profiler::threads, plus one (0 means it hasn't been given one yet)
+	SWEET_THREAD_LOCAL unsigned long int profilerThread = 0;
+
+	// escapes _s for use inside of a JSON string
+	std::string escape(const char * _s){
+		std::string res;
+		for(; *_s != '\0'; ++_s){
+			if(*_s == '"' || *_s == '\\'){
+				res += '\\';
+			}
+			res += *_s;
+		}
+		return res;
+	}
+}
+
+sweet::Profiler::Profiler() :
+	enabled(true),
+	nextFrame(0),
+	numFrames(0),
+	frameIndex(0),
+	frameStart(-1),
+	mainThread(std::this_thread::get_id()),
+	nextOtherThread(firstOtherThread),
+	startTicks(getTicks()),
+	tickFrequency(getTickFrequency())
+{
+	for(unsigned long int i = 0; i < maxThreads; ++i){
+		threads[i].locked = false;
+		threads[i].depth = 0;
+	}
+	for(unsigned long int i = 0; i < kNUM_COUNTERS; ++i){
+		counters[i] = 0;
+	}
+	setHistoryLength(300);
+}
+
+sweet::Profiler::~Profiler(){
+}
+
+sweet::Profiler & sweet::Profiler::getInstance(){
+	static Profiler profiler;
+	return profiler;
+}
+
+const char * sweet::Profiler::getCounterName(Counter _counter){
+	switch(_counter){
+		case kDRAW_CALLS: return "draw calls";
+		case kUNIFORM_UPLOADS: return "uniform uploads";
+		case kBUFFER_UPLOADS: return "buffer uploads";
+		case kBUFFER_UPLOAD_BYTES: return "buffer upload bytes";
+		case kNODE_ALLOCATIONS: return "node allocations";
+		case kPHYSICS_SYNCS: return "physics syncs";
+		case kFRAMEBUFFER_BINDS: return "framebuffer binds";
+		default: return "unknown";
+	}
+}
+
+double sweet::Profiler::getTime() const{
+	return (getTicks() - startTicks) / tickFrequency;
+}
+
+void sweet::Profiler::beginFrame(){
+	double now = getTime();
+
+	// the first call only marks the start
+	if(frameStart >= 0){
+		Frame & f = frames.at(nextFrame);
+		f.index = frameIndex;
+		f.start = frameStart;
+		f.duration = now - frameStart;
+		// clearing keeps the capacity, so a frame only allocates when it has more samples than it did the last time around
+		f.samples.clear();
+		for(unsigned long int i = 0; i < maxThreads; ++i){
+			ThreadState & t = threads[i];
+			while(t.locked.exchange(true)){}
+			f.samples.insert(f.samples.end(), t.samples.begin(), t.samples.end());
+			t.samples.clear();
+			t.locked = false;
+		}
+		for(unsigned long int i = 0; i < kNUM_COUNTERS; ++i){
+			f.counters[i] = counters[i].exchange(0);
+		}
+
+		nextFrame = (nextFrame + 1) % frames.size();
+		numFrames = std::min(numFrames + 1, (unsigned long int)frames.size());
+		++frameIndex;
+	}
+	frameStart = now;
+}
+
+void sweet::Profiler::count(Counter _counter, unsigned long int _amount){
+	if(enabled){
+		counters[_counter] += _amount;
+	}
+}
+
+void sweet::Profiler::setHistoryLength(unsigned long int _frames){
+	frames.clear();
+	frames.resize(std::max(1ul, _frames));
+	nextFrame = 0;
+	numFrames = 0;
+}
+unsigned long int sweet::Profiler::getHistoryLength() const{
+	return frames.size();
+}
+unsigned long int sweet::Profiler::getNumFrames() const{
+	return numFrames;
+}
+const sweet::Profiler::Frame & sweet::Profiler::getFrame(unsigned long int _age) const{
+	assert(_age < numFrames);
+	return frames.at((nextFrame + frames.size() - 1 - _age) % frames.size());
+}
+
+bool sweet::Profiler::pushScope(unsigned long int & _thread, unsigned long int & _depth){
+	if(profilerThread == 0){
+		unsigned long int worker = JobSystem::getInstance().getThreadIndex();
+		if(std::this_thread::get_id() == mainThread){
+			profilerThread = 1;
+		}else if(worker > 0 && worker < firstOtherThread){
+			profilerThread = worker + 1;
+		}else{
+			profilerThread = nextOtherThread++ + 1;
+			if(profilerThread == maxThreads + 1){
+				Log::warn("The profiler has run out of thread slots; scopes on new threads will be dropped");
+			}
+		}
+	}
+	if(profilerThread > maxThreads){
+		return false;
+	}
+
+	_thread = profilerThread - 1;
+	_depth = threads[_thread].depth++;
+	return true;
+}
+
+void sweet::Profiler::popScope(const char * _name, double _start, unsigned long int _thread, unsigned long int _depth){
+	ProfileSample s;
+	s.name = _name;
+	s.start = _start;
+	s.duration = getTime() - _start;
+	s.thread = _thread;
+	s.depth = _depth;
+
+	ThreadState & t = threads[_thread];
+	while(t.locked.exchange(true)){}
+	t.samples.push_back(s);
+	t.depth = _depth;
+	t.locked = false;
+}
+
+bool sweet::Profiler::exportChromeTrace(const std::string & _filename) const{
+	std::ofstream file(_filename);
+	if(!file.is_open()){
+		Log::error("Couldn't open " + _filename + " to write the profiler trace");
+		return false;
+	}
+
+	// timestamps are in microseconds
+	// the frames are put on their own track after the threads
+	file << "{\"traceEvents\":[" << std::endl;
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"main\"}}," << std::endl;
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << maxThreads << ",\"args\":{\"name\":\"frames\"}}";
+	auto separator = [&](){
+		file << "," << std::endl;
+	};
+	for(signed long int age = numFrames-1; age >= 0; --age){
+		const Frame & f = getFrame(age);
+
+		separator();
+		file << "{\"name\":\"Frame " << f.index << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":" << maxThreads << ",\"ts\":" << f.start * 1e6 << ",\"dur\":" << f.duration * 1e6 << "}";
+
+		for(const ProfileSample & s : f.samples){
+			separator();
+			file << "{\"name\":\"" << escape(s.name) << "\",\"cat\":\"scope\",\"ph\":\"X\",\"pid\":0,\"tid\":" << s.thread << ",\"ts\":" << s.start * 1e6 << ",\"dur\":" << s.duration * 1e6 << "}";
+		}
+
+		separator();
+		file << "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":0,\"ts\":" << f.start * 1e6 << ",\"args\":{";
+		for(unsigned long int i = 0; i < kNUM_COUNTERS; ++i){
+			file << (i > 0 ? "," : "") << "\"" << getCounterName((Counter)i) << "\":" << f.counters[i];
+		}
+		file << "}}";
+	}
+	file << std::endl << "]}" << std::endl;
+	return true;
+}
+
+
+
+sweet::ProfileScope::ProfileScope(const char * _name) :
+	name(_name),
+	active(Profiler::getInstance().enabled)
+{
+	if(active){
+		Profiler & p = Profiler::getInstance();
+		active = p.pushScope(thread, depth);
+		start = p.getTime();
+	}
+}
+
+sweet::ProfileScope::~ProfileScope(){
+	if(active){
+		Profiler::getInstance().popScope(name, start, thread, depth);
+	}
+}
\ No newline at end of file
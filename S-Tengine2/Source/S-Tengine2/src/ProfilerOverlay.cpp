@@ -0,0 +1,104 @@
+#pragma once
+
+#include <ProfilerOverlay.h>
+#include <Profiler.h>
+#include <shader/Shader.h>
+
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <map>
+
+ProfilerOverlay::ProfilerOverlay(BulletWorld * _world, Font * _font, Shader * _textShader) :
+	TextArea(_world, _font, _textShader),
+	maxDepth(2),
+	refreshInterval(0.25f),
+	lastRefresh(0)
+{
+}
+
+void ProfilerOverlay::update(Step * _step){
+	if(!textShader->loaded){
+		textShader->load();
+	}
+
+	if(_step->time - lastRefresh >= refreshInterval){
+		lastRefresh = _step->time;
+		setText(getSummary(maxDepth));
+	}
+	TextArea::update(_step);
+}
+
+std::wstring ProfilerOverlay::getSummary(unsigned long int _maxDepth){
+	sweet::Profiler & profiler = sweet::Profiler::getInstance();
+	unsigned long int numFrames = profiler.getNumFrames();
+	if(numFrames == 0){
+		return L"No profiled frames";
+	}
+
+	struct Entry{
+		std::string name;
+		unsigned long int depth;
+		double total;
+		double worst;
+	};
+	// listed in the order they were first seen, so that the hierarchy reads top to bottom
+	std::vector<Entry> entries;
+	std::map<std::string, unsigned long int> lookup;
+	double totalFrame = 0, worstFrame = 0;
+	double totalCounters[sweet::Profiler::kNUM_COUNTERS] = {0};
+
+	for(signed long int age = numFrames-1; age >= 0; --age){
+		const sweet::Profiler::Frame & f = profiler.getFrame(age);
+		totalFrame += f.duration;
+		worstFrame = std::max(worstFrame, f.duration);
+		for(unsigned long int i = 0; i < sweet::Profiler::kNUM_COUNTERS; ++i){
+			totalCounters[i] += f.counters[i];
+		}
+
+		// samples are recorded when they end, so children come before their parents; sort by start time instead
+		std::vector<const sweet::ProfileSample *> samples;
+		for(const sweet::ProfileSample & s : f.samples){
+			if(s.thread == 0 && s.depth <= _maxDepth){
+				samples.push_back(&s);
+			}
+		}
+		std::stable_sort(samples.begin(), samples.end(), [](const sweet::ProfileSample * _a, const sweet::ProfileSample * _b){
+			return _a->start < _b->start;
+		});
+
+		// a scope can run several times in a frame, so each frame's time is summed before checking the worst
+		std::map<unsigned long int, double> frameTotals;
+		for(const sweet::ProfileSample * s : samples){
+			std::string key = std::string(s->depth, ' ') + s->name;
+			auto it = lookup.find(key);
+			if(it == lookup.end()){
+				Entry e;
+				e.name = s->name;
+				e.depth = s->depth;
+				e.total = 0;
+				e.worst = 0;
+				it = lookup.insert(std::make_pair(key, entries.size())).first;
+				entries.push_back(e);
+			}
+			entries.at(it->second).total += s->duration;
+			frameTotals[it->second] += s->duration;
+		}
+		for(auto & t : frameTotals){
+			entries.at(t.first).worst = std::max(entries.at(t.first).worst, t.second);
+		}
+	}
+
+	std::wstringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	ss << L"Frame: " << totalFrame / numFrames * 1000.0 << L"ms avg, " << worstFrame * 1000.0 << L"ms worst (" << numFrames << L" frames)" << std::endl;
+	for(const Entry & e : entries){
+		ss << std::wstring(e.depth * 2 + 2, L' ') << std::wstring(e.name.begin(), e.name.end()) << L": "
+			<< e.total / numFrames * 1000.0 << L"ms avg, " << e.worst * 1000.0 << L"ms worst" << std::endl;
+	}
+	for(unsigned long int i = 0; i < sweet::Profiler::kNUM_COUNTERS; ++i){
+		std::string name = sweet::Profiler::getCounterName((sweet::Profiler::Counter)i);
+		ss << std::wstring(name.begin(), name.end()) << L": " << totalCounters[i] / numFrames << L" avg" << std::endl;
+	}
+	return ss.str();
+}
\ No newline at end of file
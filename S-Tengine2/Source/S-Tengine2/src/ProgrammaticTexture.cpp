@@ -1,19 +1,37 @@
 #pragma once
 
 #include <ProgrammaticTexture.h>
-#include <NumberUtils.h>
+#include <Random.h>
 #include <TextureUtils.h>
 
 #include <assert.h>
+#include <algorithm>
+
+namespace{
+	// procedural textures draw their seeds from their own stream so that creating one doesn't shift the sequence seen by gameplay code
+	// (cached so that every call doesn't have to look it up)
+	sweet::Random * textureRandom = nullptr;
+	sweet::Random & getTextureRandom(){
+		if(textureRandom == nullptr){
+			textureRandom = &sweet::Random::getStream("textures");
+		}
+		return *textureRandom;
+	}
+}
 
 ProgrammaticTexture::ProgrammaticTexture(unsigned char * _data, bool _autoRelease, bool _useMipmaps) :
 	Texture("", true, _autoRelease, _useMipmaps),
-	NodeResource(_autoRelease)
+	NodeResource(_autoRelease),
+	backBuffer(nullptr),
+	backBufferBytes(0),
+	backBufferFilled(false)
 {
 	data = _data;
 }
 
 ProgrammaticTexture::~ProgrammaticTexture() {
+	sweet::JobSystem::getInstance().wait(&backBufferJobs);
+	free(backBuffer);
 }
 
 void ProgrammaticTexture::load() {
@@ -38,21 +56,72 @@ void ProgrammaticTexture::allocate(unsigned long int _width, unsigned long int _
 	data = static_cast<unsigned char *>(malloc(sizeof(unsigned char) * numBytes));
 }
 
+void ProgrammaticTexture::fillBackBuffer(std::function<void(unsigned char *)> _fill){
+	sweet::JobSystem & jobs = sweet::JobSystem::getInstance();
+	jobs.wait(&backBufferJobs);
+	// the texture may have been resized since the back buffer was made
+	if(backBuffer == nullptr || backBufferBytes != numBytes){
+		free(backBuffer);
+		backBuffer = static_cast<unsigned char *>(malloc(sizeof(unsigned char) * numBytes));
+		backBufferBytes = numBytes;
+	}
+	backBufferFilled = true;
+	unsigned char * buffer = backBuffer;
+	jobs.submit([_fill, buffer](){
+		_fill(buffer);
+	}, &backBufferJobs);
+}
+
+bool ProgrammaticTexture::swapBuffers(){
+	sweet::JobSystem::getInstance().wait(&backBufferJobs);
+	if(!backBufferFilled){
+		return false;
+	}
+	backBufferFilled = false;
+	// a back buffer filled before a resize is the wrong size, so it's thrown away
+	if(backBufferBytes != numBytes){
+		return false;
+	}
+	std::swap(data, backBuffer);
+	return true;
+}
+
 
 NoiseTexture::NoiseTexture(unsigned long int _width, unsigned long int _height, bool _autoRelease, bool _useMipmaps) :
 	ProgrammaticTexture(nullptr, _autoRelease, _useMipmaps),
 	NodeResource(_autoRelease),
 	maxVal(255),
-	minVal(0)
+	minVal(0),
+	// seeded from the "textures" stream so that the noise still follows the configured seed
+	generation(getTextureRandom().next())
 {
 	allocate(_width, _height, 1);
 	setNoise();
 }
 
 void NoiseTexture::setNoise(){
-	for(unsigned long int i = 0; i < numBytes; ++i){
-		data[i] = sweet::NumberUtils::randomInt(minVal, maxVal);
-	}
+	generate(data, generation++);
+}
+
+void NoiseTexture::setNoiseAsync(){
+	unsigned long int g = generation++;
+	fillBackBuffer([this, g](unsigned char * _data){
+		generate(_data, g);
+	});
+}
+
+void NoiseTexture::generate(unsigned char * _data, unsigned long int _generation) const{
+	const unsigned long int batch = 4096;
+	unsigned long int seed = sweet::Noise::hash(_generation);
+	unsigned long int range = maxVal - minVal + 1;
+	unsigned long int n = numBytes;
+	unsigned char minV = minVal;
+	sweet::JobSystem::getInstance().parallelFor((n + batch - 1) / batch, [=](unsigned long int _batch){
+		unsigned long int end = std::min(n, (_batch+1) * batch);
+		for(unsigned long int i = _batch * batch; i < end; ++i){
+			_data[i] = minV + sweet::Noise::hash(i ^ seed) % range;
+		}
+	});
 }
 
 
@@ -61,18 +130,27 @@ void NoiseTexture::setNoise(){
 PerlinNoiseTexture::PerlinNoiseTexture(unsigned long int _width, unsigned long int _height, bool _autoRelease, bool _useMipmaps) :
 	ProgrammaticTexture(nullptr, _autoRelease, _useMipmaps),
 	NodeResource(_autoRelease),
-	amplitude(255),
-	offset(0),
-	frequency(1.f)
+	// maps the noise's [-1, 1] range onto 1-255
+	amplitude(127),
+	offset(128),
+	frequency(1.f),
+	noise(sweet::Noise::kPERLIN, getTextureRandom().next())
 {
 	allocate(_width, _height, 1);
 	setNoise(0);
 }
 
 void PerlinNoiseTexture::setNoise(float _time){
-	for(unsigned long int y = 0; y < height; ++y){
-	for(unsigned long int x = 0; x < width; ++x){
-		sweet::TextureUtils::setPixel(this, x, y, sweet::NumberUtils::pNoise( ((float)x)/(width) * frequency.x, ((float)y)/(height) * frequency.y, _time * frequency.z )*255.f + offset);
-	}
-	}
+	noise.fill(data, width, height, channels, frequency, _time, amplitude, offset);
+}
+
+void PerlinNoiseTexture::setNoiseAsync(float _time){
+	// copy the settings so that changing them doesn't affect the noise which is already being generated
+	sweet::Noise n = noise;
+	glm::vec3 f = frequency;
+	float a = amplitude, o = offset;
+	unsigned long int w = width, h = height, c = channels;
+	fillBackBuffer([n, f, a, o, w, h, c, _time](unsigned char * _data){
+		n.fill(_data, w, h, c, f, _time, a, o);
+	});
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Random.h>
+
+#include <algorithm>
+
+namespace{
+	// splitmix64; used to expand seeds into full generator states
+	unsigned long long int splitMix(unsigned long long int & _x){
+		unsigned long long int z = (_x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	// FNV-1a
+	unsigned long long int hashName(const std::string & _name){
+		unsigned long long int res = 0xCBF29CE484222325ULL;
+		for(unsigned long int i = 0; i < _name.size(); ++i){
+			res ^= (unsigned char)_name[i];
+			res *= 0x100000001B3ULL;
+		}
+		return res;
+	}
+}
+
+unsigned long long int sweet::Random::streamSeed = 0;
+std::map<std::string, sweet::Random> sweet::Random::streams;
+
+sweet::Random::Random(unsigned long long int _seed){
+	seed(_seed);
+}
+
+void sweet::Random::seed(unsigned long long int _seed){
+	unsigned long long int a = splitMix(_seed);
+	unsigned long long int b = splitMix(_seed);
+	state[0] = (unsigned int)a;
+	state[1] = (unsigned int)(a >> 32);
+	state[2] = (unsigned int)b;
+	state[3] = (unsigned int)(b >> 32);
+	// the all-zero state never changes
+	if(state[0] == 0 && state[1] == 0 && state[2] == 0 && state[3] == 0){
+		state[0] = 1;
+	}
+}
+
+unsigned int sweet::Random::nextBounded(unsigned int _bound){
+	// multiply-shift, rejecting the few low results which would make some values more likely than others
+	unsigned long long int m = (unsigned long long int)next() * _bound;
+	unsigned int low = (unsigned int)m;
+	if(low < _bound){
+		unsigned int threshold = (0u - _bound) % _bound;
+		while(low < threshold){
+			m = (unsigned long long int)next() * _bound;
+			low = (unsigned int)m;
+		}
+	}
+	return (unsigned int)(m >> 32);
+}
+
+int sweet::Random::nextInt(int _min, int _max){
+	if(_max < _min){
+		std::swap(_min, _max);
+	}
+	unsigned int range = (unsigned int)((long long int)_max - _min) + 1;
+	if(range == 0){
+		// the full 32-bit range
+		return (int)next();
+	}
+	return (int)((long long int)_min + nextBounded(range));
+}
+
+bool sweet::Random::nextBool(){
+	return (next() >> 31) != 0;
+}
+
+glm::vec3 sweet::Random::nextVec3(glm::vec3 _min, glm::vec3 _max){
+	// evaluated in order, so the result is the same on every compiler
+	float x = nextFloat(_min.x, _max.x);
+	float y = nextFloat(_min.y, _max.y);
+	float z = nextFloat(_min.z, _max.z);
+	return glm::vec3(x, y, z);
+}
+
+void sweet::Random::fill(float * _out, unsigned long int _count, float _min, float _max){
+	const float scale = (_max - _min) * (1.f / 16777216.f);
+	for(unsigned long int i = 0; i < _count; ++i){
+		_out[i] = _min + (next() >> 8) * scale;
+	}
+}
+
+void sweet::Random::fill(int * _out, unsigned long int _count, int _min, int _max){
+	if(_max < _min){
+		std::swap(_min, _max);
+	}
+	unsigned int range = (unsigned int)((long long int)_max - _min) + 1;
+	for(unsigned long int i = 0; i < _count; ++i){
+		_out[i] = range == 0 ? (int)next() : (int)((long long int)_min + nextBounded(range));
+	}
+}
+
+void sweet::Random::fill(glm::vec3 * _out, unsigned long int _count, glm::vec3 _min, glm::vec3 _max){
+	const glm::vec3 scale = (_max - _min) * (1.f / 16777216.f);
+	for(unsigned long int i = 0; i < _count; ++i){
+		float x = _min.x + (next() >> 8) * scale.x;
+		float y = _min.y + (next() >> 8) * scale.y;
+		float z = _min.z + (next() >> 8) * scale.z;
+		_out[i] = glm::vec3(x, y, z);
+	}
+}
+
+void sweet::Random::jump(){
+	static const unsigned int JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+	unsigned int s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	for(unsigned long int i = 0; i < 4; ++i){
+		for(unsigned long int b = 0; b < 32; ++b){
+			if(JUMP[i] & (1u << b)){
+				s0 ^= state[0];
+				s1 ^= state[1];
+				s2 ^= state[2];
+				s3 ^= state[3];
+			}
+			next();
+		}
+	}
+	state[0] = s0;
+	state[1] = s1;
+	state[2] = s2;
+	state[3] = s3;
+}
+
+sweet::Random sweet::Random::split(){
+	Random res(*this);
+	jump();
+	return res;
+}
+
+unsigned long long int sweet::Random::getStreamSeed(const std::string & _name){
+	unsigned long long int x = streamSeed ^ hashName(_name);
+	return splitMix(x);
+}
+
+sweet::Random & sweet::Random::getStream(const std::string & _name){
+	auto it = streams.find(_name);
+	if(it == streams.end()){
+		it = streams.insert(std::make_pair(_name, Random(getStreamSeed(_name)))).first;
+	}
+	return it->second;
+}
+
+void sweet::Random::seedStreams(unsigned long long int _seed){
+	streamSeed = _seed;
+	for(auto & s : streams){
+		s.second.seed(getStreamSeed(s.first));
+	}
+}
\ No newline at end of file
@@ -12,7 +12,8 @@ RenderOptions::RenderOptions(Shader* _shader, std::vector<Light *> *_lights, Sha
 	depthBufferId(0),
 	normalBufferId(0),
 	alphaEnabled(true),
-	depthEnabled(true)
+	depthEnabled(true),
+	drawData(nullptr)
 {
 	setClearColour(0,0,0,1);
 	viewPortDimensions.x = 0;
@@ -4,6 +4,7 @@
 #include "RenderSurface.h"
 
 #include "shader/Shader.h"
+#include <Profiler.h>
 
 RenderSurface::RenderSurface(Shader * _shader, bool _autoRelease, bool _configureDefaultVertexAttributes) :
 	MeshInterface(GL_QUADS, GL_STATIC_DRAW),
@@ -154,6 +155,7 @@ void RenderSurface::render(GLuint _textureId, bool _disableBlending){
 
 	// Draw (note that the last argument is expecting a pointer to the indices, but since we have an ibo, it's actually interpreted as an offset)
 	glDrawRangeElements(polygonalDrawMode, 0, indices.size(), indices.size(), GL_UNSIGNED_INT, 0);
+	SWEET_PROFILE_COUNT(kDRAW_CALLS, 1);
 	checkForGlError(false);
 
 	if (dt == GL_TRUE){
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <RenderTargetPool.h>
+#include <FrameBufferInterface.h>
+#include <Log.h>
+
+sweet::RenderTargetPool::Stats::Stats() :
+	acquisitions(0),
+	reuses(0),
+	allocations(0),
+	renderBufferAllocations(0),
+	frees(0),
+	targets(0),
+	targetsInUse(0),
+	renderBuffers(0),
+	bytes(0),
+	peakBytes(0)
+{
+}
+
+double sweet::RenderTargetPool::Stats::getReuseRate() const{
+	return acquisitions > 0 ? (double)reuses / acquisitions : 0;
+}
+
+sweet::RenderTargetPool::RenderTargetPool() :
+	maxIdleFrames(60),
+	frame(0)
+{
+}
+
+sweet::RenderTargetPool::~RenderTargetPool(){
+	clear();
+}
+
+sweet::RenderTargetPool & sweet::RenderTargetPool::getInstance(){
+	static RenderTargetPool * pool;
+	if(pool == nullptr){
+		pool = new RenderTargetPool();
+	}
+	return *pool;
+}
+
+bool sweet::RenderTargetPool::matches(const Target * _target, const std::vector<FrameBufferChannel> & _channels, unsigned long int _width, unsigned long int _height){
+	const FrameBufferInterface * fbo = _target->fbo;
+	if(fbo->width != _width || fbo->height != _height || fbo->frameBufferChannels.size() != _channels.size()){
+		return false;
+	}
+	for(unsigned long int i = 0; i < _channels.size(); ++i){
+		const FrameBufferChannel & a = fbo->frameBufferChannels.at(i);
+		const FrameBufferChannel & b = _channels.at(i);
+		if(a.channelType != b.channelType || a.internalFormat != b.internalFormat || a.attachmentType != b.attachmentType || a.format != b.format || a.size != b.size){
+			return false;
+		}
+	}
+	return true;
+}
+
+FrameBufferInterface * sweet::RenderTargetPool::acquire(const std::vector<FrameBufferChannel> & _channels, unsigned long int _width, unsigned long int _height){
+	++stats.acquisitions;
+
+	Target * target = nullptr;
+	for(auto t : targets){
+		if(!t->inUse && matches(t, _channels, _width, _height)){
+			target = t;
+			break;
+		}
+	}
+
+	if(target != nullptr){
+		++stats.reuses;
+	}else{
+		// the render buffers are attached below, from the shared ones
+		std::vector<FrameBufferChannel> channels(_channels);
+		for(auto & c : channels){
+			if(c.channelType == FrameBufferChannel::RENDER_BUFFER){
+				c.owned = false;
+				c.id = 0;
+			}
+		}
+		target = new Target();
+		target->fbo = new FrameBufferInterface(channels, _width, _height, false);
+		target->fbo->nodeName = "pooled render target";
+		target->renderBuffers.resize(channels.size(), nullptr);
+		target->inUse = false;
+		targets.push_back(target);
+
+		++stats.allocations;
+		++stats.targets;
+		addBytes(target->fbo->getByteSize());
+	}
+
+	target->inUse = true;
+	target->lastUsedFrame = frame;
+	++stats.targetsInUse;
+
+	// keep the render buffers which are still attached if nothing else took them in the meantime
+	for(unsigned long int i = 0; i < target->renderBuffers.size(); ++i){
+		FrameBufferChannel & channel = target->fbo->frameBufferChannels.at(i);
+		if(channel.channelType != FrameBufferChannel::RENDER_BUFFER){
+			continue;
+		}
+		RenderBuffer * rb = target->renderBuffers.at(i);
+		if(rb == nullptr || rb->inUse){
+			rb = acquireRenderBuffer(channel, _width, _height);
+			FrameBufferInterface::pushFbo(target->fbo);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, channel.attachmentType, GL_RENDERBUFFER, rb->id);
+			FrameBufferInterface::popFbo();
+			channel.id = rb->id;
+			target->renderBuffers.at(i) = rb;
+		}
+		rb->inUse = true;
+		rb->lastUsedFrame = frame;
+	}
+
+	return target->fbo;
+}
+
+sweet::RenderTargetPool::RenderBuffer * sweet::RenderTargetPool::acquireRenderBuffer(const FrameBufferChannel & _channel, unsigned long int _width, unsigned long int _height){
+	for(auto rb : renderBuffers){
+		if(!rb->inUse && rb->internalFormat == _channel.internalFormat && rb->width == _width && rb->height == _height){
+			return rb;
+		}
+	}
+
+	RenderBuffer * rb = new RenderBuffer();
+	rb->internalFormat = _channel.internalFormat;
+	rb->width = _width;
+	rb->height = _height;
+	rb->bytes = _width * _height * _channel.getBytesPerPixel();
+	rb->inUse = false;
+	rb->lastUsedFrame = frame;
+	glGenRenderbuffers(1, &rb->id);
+	glBindRenderbuffer(GL_RENDERBUFFER, rb->id);
+	glRenderbufferStorage(GL_RENDERBUFFER, rb->internalFormat, _width, _height);
+	renderBuffers.push_back(rb);
+
+	++stats.renderBufferAllocations;
+	++stats.renderBuffers;
+	addBytes(rb->bytes);
+	return rb;
+}
+
+void sweet::RenderTargetPool::release(FrameBufferInterface * _target){
+	for(auto t : targets){
+		if(t->fbo == _target){
+			if(!t->inUse){
+				Log::warn("Render target released twice");
+				return;
+			}
+			t->inUse = false;
+			t->lastUsedFrame = frame;
+			--stats.targetsInUse;
+			for(auto rb : t->renderBuffers){
+				if(rb != nullptr){
+					rb->inUse = false;
+					rb->lastUsedFrame = frame;
+				}
+			}
+			return;
+		}
+	}
+	Log::warn("Released a render target which didn't come from the pool");
+}
+
+void sweet::RenderTargetPool::endFrame(){
+	++frame;
+	if(frame > maxIdleFrames){
+		deleteIdle(frame - maxIdleFrames - 1);
+	}
+}
+
+void sweet::RenderTargetPool::clear(){
+	deleteIdle((unsigned long int)-1);
+}
+
+void sweet::RenderTargetPool::deleteIdle(unsigned long int _frame){
+	for(signed long int i = targets.size() - 1; i >= 0; --i){
+		Target * t = targets.at(i);
+		if(!t->inUse && t->lastUsedFrame <= _frame){
+			stats.bytes -= t->fbo->getByteSize();
+			--stats.targets;
+			++stats.frees;
+			// the shared render buffers aren't owned by the framebuffer, so they're left alone
+			delete t->fbo;
+			delete t;
+			targets.erase(targets.begin() + i);
+		}
+	}
+
+	for(signed long int i = renderBuffers.size() - 1; i >= 0; --i){
+		RenderBuffer * rb = renderBuffers.at(i);
+		if(!rb->inUse && rb->lastUsedFrame <= _frame){
+			// detach it from any targets which are keeping it around, otherwise its storage can't be freed
+			for(auto t : targets){
+				for(unsigned long int j = 0; j < t->renderBuffers.size(); ++j){
+					if(t->renderBuffers.at(j) == rb){
+						FrameBufferChannel & channel = t->fbo->frameBufferChannels.at(j);
+						FrameBufferInterface::pushFbo(t->fbo);
+						glFramebufferRenderbuffer(GL_FRAMEBUFFER, channel.attachmentType, GL_RENDERBUFFER, 0);
+						FrameBufferInterface::popFbo();
+						channel.id = 0;
+						t->renderBuffers.at(j) = nullptr;
+					}
+				}
+			}
+			glDeleteRenderbuffers(1, &rb->id);
+			stats.bytes -= rb->bytes;
+			--stats.renderBuffers;
+			++stats.frees;
+			delete rb;
+			renderBuffers.erase(renderBuffers.begin() + i);
+		}
+	}
+}
+
+void sweet::RenderTargetPool::addBytes(unsigned long int _bytes){
+	stats.bytes += _bytes;
+	if(stats.bytes > stats.peakBytes){
+		stats.peakBytes = stats.bytes;
+	}
+}
+
+const sweet::RenderTargetPool::Stats & sweet::RenderTargetPool::getStats() const{
+	return stats;
+}
+
+void sweet::RenderTargetPool::resetStats(){
+	stats.acquisitions = 0;
+	stats.reuses = 0;
+	stats.allocations = 0;
+	stats.renderBufferAllocations = 0;
+	stats.frees = 0;
+	stats.peakBytes = stats.bytes;
+}
\ No newline at end of file
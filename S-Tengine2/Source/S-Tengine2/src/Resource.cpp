@@ -11,6 +11,7 @@
 #include "MeshInterface.h"
 #include "Resource.h"
 #include "FileUtils.h"
+#include "AssetArchive.h"
 #include "Animation.h"
 #include "Box2DSprite.h"
 #include "Box2DWorld.h"
@@ -20,12 +21,21 @@
 
 std::vector<TriMesh *> Resource::loadMeshFromObj(std::string _objSrc, bool _autorelease){
 
-	std::string inputfile = sweet::FileUtils::readFile(_objSrc);
-	
 	std::vector<tinyobj::shape_t> shapes;
 	std::vector<tinyobj::material_t> materials;
 
-	std::string err = tinyobj::LoadObj(shapes, materials, _objSrc.c_str());
+	// use the packed copy if there is one (materials are still read from loose files)
+	std::string err;
+	std::string buffer;
+	size_t packedSize;
+	const unsigned char * packed = sweet::AssetArchive::getFile(_objSrc, packedSize, buffer);
+	if(packed != nullptr){
+		std::istringstream objStream(std::string((const char *)packed, packedSize));
+		tinyobj::MaterialFileReader materialReader(_objSrc.substr(0, _objSrc.find_last_of("\\/") + 1));
+		err = tinyobj::LoadObj(shapes, materials, objStream, materialReader);
+	}else{
+		err = tinyobj::LoadObj(shapes, materials, _objSrc.c_str());
+	}
 	
 	if (!err.empty()) {
 	  std::cerr << err << std::endl;
@@ -95,6 +95,10 @@ void Scene::unload(){
 	Entity::unload();
 }
 
+bool Scene::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	return false;
+}
+
 void Scene::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
 	// don't bother doing any work if we aren't rendering anyway
 	if(!isVisible()){
@@ -35,7 +35,7 @@ Scene_Splash_Engine::Scene_Splash_Engine(Game * _game) :
 		splash->mesh->vertices.at(1).v = v;
 		splash->mesh->vertices.at(2).v = v + 1;
 		splash->mesh->vertices.at(3).v = v + 1;
-		splash->mesh->dirty = true;
+		splash->mesh->makeDirty();
 		alphaComponent->setAlpha(b);
 	});
 }
@@ -26,7 +26,7 @@ Scene_Splash_SweetHeartSquad::Scene_Splash_SweetHeartSquad(Game * _game) :
 		splash->mesh->vertices.at(1).v = v;
 		splash->mesh->vertices.at(2).v = v + 1;
 		splash->mesh->vertices.at(3).v = v + 1;
-		splash->mesh->dirty = true;
+		splash->mesh->makeDirty();
 	});
 }
 
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <SerialPort.h>
+#include <Log.h>
+
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <stdlib.h>
+#endif
+
+#ifdef _WIN32
+
+sweet::SerialPort::SerialPort() :
+	handle(INVALID_HANDLE_VALUE)
+{
+}
+
+bool sweet::SerialPort::open(const std::string & _portName, unsigned long int _baudRate){
+	close();
+
+	HANDLE h = CreateFileA(_portName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(h == INVALID_HANDLE_VALUE){
+		if(GetLastError() == ERROR_FILE_NOT_FOUND){
+			Log::warn("Serial port " + _portName + " not available");
+		}else{
+			Log::warn("Couldn't open serial port " + _portName);
+		}
+		return false;
+	}
+
+	DCB params = {0};
+	params.DCBlength = sizeof(params);
+	if(!GetCommState(h, &params)){
+		Log::warn("Failed to get current serial parameters for " + _portName);
+		CloseHandle(h);
+		return false;
+	}
+	params.BaudRate = _baudRate;
+	params.ByteSize = 8;
+	params.StopBits = ONESTOPBIT;
+	params.Parity = NOPARITY;
+	if(!SetCommState(h, &params)){
+		Log::warn("Could not set serial parameters for " + _portName);
+		CloseHandle(h);
+		return false;
+	}
+
+	// return immediately from ReadFile with whatever has already arrived
+	COMMTIMEOUTS timeouts = {0};
+	timeouts.ReadIntervalTimeout = MAXDWORD;
+	timeouts.ReadTotalTimeoutMultiplier = 0;
+	timeouts.ReadTotalTimeoutConstant = 0;
+	timeouts.WriteTotalTimeoutMultiplier = 0;
+	timeouts.WriteTotalTimeoutConstant = 1000;
+	if(!SetCommTimeouts(h, &timeouts)){
+		Log::warn("Could not set serial timeouts for " + _portName);
+		CloseHandle(h);
+		return false;
+	}
+
+	handle = h;
+	return true;
+}
+
+void sweet::SerialPort::close(){
+	if(handle != INVALID_HANDLE_VALUE){
+		CloseHandle(handle);
+		handle = INVALID_HANDLE_VALUE;
+	}
+}
+
+bool sweet::SerialPort::isOpen() const{
+	return handle != INVALID_HANDLE_VALUE;
+}
+
+signed long int sweet::SerialPort::read(char * _buffer, unsigned long int _size){
+	if(handle == INVALID_HANDLE_VALUE){
+		return -1;
+	}
+	DWORD bytesRead = 0;
+	if(!ReadFile(handle, _buffer, _size, &bytesRead, NULL)){
+		DWORD errors;
+		COMSTAT status;
+		ClearCommError(handle, &errors, &status);
+		return -1;
+	}
+	return bytesRead;
+}
+
+bool sweet::SerialPort::write(const char * _buffer, unsigned long int _size){
+	if(handle == INVALID_HANDLE_VALUE){
+		return false;
+	}
+	DWORD bytesWritten = 0;
+	if(!WriteFile(handle, _buffer, _size, &bytesWritten, NULL) || bytesWritten != _size){
+		DWORD errors;
+		COMSTAT status;
+		ClearCommError(handle, &errors, &status);
+		return false;
+	}
+	return true;
+}
+
+signed long int sweet::SerialPort::available(){
+	DWORD errors;
+	COMSTAT status;
+	if(handle == INVALID_HANDLE_VALUE || !ClearCommError(handle, &errors, &status)){
+		return -1;
+	}
+	return status.cbInQue;
+}
+
+bool sweet::SerialPort::waitForData(unsigned long int _milliseconds){
+	// the comm API can only wait with a timeout on overlapped handles, so poll instead
+	for(unsigned long int i = 0; ; ++i){
+		signed long int n = available();
+		if(n != 0){
+			return n > 0;
+		}
+		if(i >= _milliseconds){
+			return false;
+		}
+		Sleep(1);
+	}
+}
+
+void sweet::SerialPort::purge(){
+	if(handle != INVALID_HANDLE_VALUE){
+		PurgeComm(handle, PURGE_RXABORT | PURGE_TXABORT | PURGE_RXCLEAR | PURGE_TXCLEAR);
+	}
+}
+
+bool sweet::SerialPort::openLoopback(SerialPort & _device){
+	Log::warn("Serial loopback is only available on POSIX systems");
+	return false;
+}
+
+#else
+
+namespace{
+	speed_t getSpeed(unsigned long int _baudRate){
+		switch(_baudRate){
+			case 9600: return B9600;
+			case 19200: return B19200;
+			case 38400: return B38400;
+			case 57600: return B57600;
+			case 115200: return B115200;
+			case 230400: return B230400;
+			default:
+				std::stringstream ss;
+				ss << "Unsupported baud rate " << _baudRate << ", using 115200";
+				Log::warn(ss.str());
+				return B115200;
+		}
+	}
+}
+
+sweet::SerialPort::SerialPort() :
+	fd(-1)
+{
+}
+
+bool sweet::SerialPort::open(const std::string & _portName, unsigned long int _baudRate){
+	close();
+
+	int f = ::open(_portName.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if(f < 0){
+		if(errno == ENOENT){
+			Log::warn("Serial port " + _portName + " not available");
+		}else{
+			Log::warn("Couldn't open serial port " + _portName);
+		}
+		return false;
+	}
+
+	termios params;
+	if(tcgetattr(f, &params) != 0){
+		Log::warn("Failed to get current serial parameters for " + _portName);
+		::close(f);
+		return false;
+	}
+	// raw bytes, 8N1, no flow control; reads return immediately with whatever has arrived
+	cfmakeraw(&params);
+	params.c_cflag |= CLOCAL | CREAD;
+	params.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+	params.c_iflag &= ~(IXON | IXOFF | IXANY);
+	params.c_cc[VMIN] = 0;
+	params.c_cc[VTIME] = 0;
+	speed_t speed = getSpeed(_baudRate);
+	cfsetispeed(&params, speed);
+	cfsetospeed(&params, speed);
+	if(tcsetattr(f, TCSANOW, &params) != 0){
+		Log::warn("Could not set serial parameters for " + _portName);
+		::close(f);
+		return false;
+	}
+
+	fd = f;
+	return true;
+}
+
+void sweet::SerialPort::close(){
+	if(fd >= 0){
+		::close(fd);
+		fd = -1;
+	}
+}
+
+bool sweet::SerialPort::isOpen() const{
+	return fd >= 0;
+}
+
+signed long int sweet::SerialPort::read(char * _buffer, unsigned long int _size){
+	if(fd < 0){
+		return -1;
+	}
+	ssize_t n = ::read(fd, _buffer, _size);
+	if(n < 0){
+		return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+	}else if(n == 0){
+		// nothing has arrived, or the device hung up
+		pollfd p = { fd, POLLIN, 0 };
+		if(poll(&p, 1, 0) > 0 && (p.revents & (POLLHUP | POLLERR)) != 0){
+			return -1;
+		}
+	}
+	return n;
+}
+
+bool sweet::SerialPort::write(const char * _buffer, unsigned long int _size){
+	if(fd < 0){
+		return false;
+	}
+	while(_size > 0){
+		ssize_t n = ::write(fd, _buffer, _size);
+		if(n < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			if(errno != EAGAIN && errno != EWOULDBLOCK){
+				return false;
+			}
+			// the device's buffer is full; give it a second to catch up
+			pollfd p = { fd, POLLOUT, 0 };
+			if(poll(&p, 1, 1000) <= 0){
+				return false;
+			}
+			continue;
+		}
+		_buffer += n;
+		_size -= n;
+	}
+	return true;
+}
+
+signed long int sweet::SerialPort::available(){
+	int n = 0;
+	if(fd < 0 || ioctl(fd, FIONREAD, &n) != 0){
+		return -1;
+	}
+	return n;
+}
+
+bool sweet::SerialPort::waitForData(unsigned long int _milliseconds){
+	if(fd < 0){
+		return false;
+	}
+	pollfd p = { fd, POLLIN, 0 };
+	return poll(&p, 1, _milliseconds) > 0 && (p.revents & POLLIN) != 0;
+}
+
+void sweet::SerialPort::purge(){
+	if(fd >= 0){
+		tcflush(fd, TCIOFLUSH);
+	}
+}
+
+bool sweet::SerialPort::openLoopback(SerialPort & _device){
+	close();
+	_device.close();
+
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+		Log::warn("Couldn't create a pseudo-terminal");
+		if(master >= 0){
+			::close(master);
+		}
+		return false;
+	}
+	const char * name = ptsname(master);
+	if(name == nullptr || !open(name)){
+		::close(master);
+		return false;
+	}
+	fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+	_device.fd = master;
+	return true;
+}
+
+#endif
+
+sweet::SerialPort::~SerialPort(){
+	close();
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <SerialReader.h>
+#include <SerialPort.h>
+#include <Log.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+sweet::SerialReader::SerialReader(SerialPort & _port, unsigned long int _capacity) :
+	port(_port),
+	mask(0),
+	head(0),
+	tail(0),
+	bytesRead(0),
+	running(false),
+	failed(false)
+{
+	unsigned long int capacity = 1;
+	while(capacity < _capacity){
+		capacity <<= 1;
+	}
+	ring.resize(capacity);
+	mask = capacity - 1;
+}
+
+sweet::SerialReader::~SerialReader(){
+	stop();
+}
+
+void sweet::SerialReader::start(){
+	if(running){
+		return;
+	}
+	failed = false;
+	running = true;
+	thread = std::thread(&SerialReader::run, this);
+}
+
+void sweet::SerialReader::stop(){
+	running = false;
+	if(thread.joinable()){
+		thread.join();
+	}
+}
+
+bool sweet::SerialReader::isRunning() const{
+	return running;
+}
+
+bool sweet::SerialReader::hasFailed() const{
+	return failed;
+}
+
+void sweet::SerialReader::run(){
+	const unsigned long int capacity = mask + 1;
+	while(running){
+		unsigned long int t = tail.load(std::memory_order_relaxed);
+		unsigned long int space = capacity - (t - head.load(std::memory_order_acquire));
+		if(space == 0){
+			// wait for the main thread to make room
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		// only read up to the end of the ring; the rest wraps around on the next pass
+		unsigned long int offset = t & mask;
+		unsigned long int n = std::min(space, capacity - offset);
+		signed long int res = port.read(&ring[offset], n);
+		if(res < 0){
+			Log::warn("Serial port failed; stopping reader");
+			failed = true;
+			running = false;
+			return;
+		}else if(res == 0){
+			// the timeout keeps stop responsive
+			port.waitForData(10);
+		}else{
+			bytesRead.fetch_add(res, std::memory_order_relaxed);
+			tail.store(t + res, std::memory_order_release);
+		}
+	}
+}
+
+unsigned long int sweet::SerialReader::available() const{
+	return tail.load(std::memory_order_acquire) - head.load(std::memory_order_relaxed);
+}
+
+unsigned long int sweet::SerialReader::peek(const char *& _first, unsigned long int & _firstSize, const char *& _second, unsigned long int & _secondSize) const{
+	unsigned long int h = head.load(std::memory_order_relaxed);
+	unsigned long int n = tail.load(std::memory_order_acquire) - h;
+	unsigned long int offset = h & mask;
+
+	_first = &ring[offset];
+	_firstSize = std::min(n, mask + 1 - offset);
+	_second = &ring[0];
+	_secondSize = n - _firstSize;
+	return n;
+}
+
+void sweet::SerialReader::consume(unsigned long int _count){
+	unsigned long int h = head.load(std::memory_order_relaxed);
+	_count = std::min(_count, tail.load(std::memory_order_acquire) - h);
+	head.store(h + _count, std::memory_order_release);
+}
+
+unsigned long int sweet::SerialReader::read(char * _buffer, unsigned long int _size){
+	const char * first;
+	const char * second;
+	unsigned long int firstSize, secondSize;
+	peek(first, firstSize, second, secondSize);
+
+	unsigned long int a = std::min(_size, firstSize);
+	unsigned long int b = std::min(_size - a, secondSize);
+	memcpy(_buffer, first, a);
+	memcpy(_buffer + a, second, b);
+	consume(a + b);
+	return a + b;
+}
+
+unsigned long long int sweet::SerialReader::getBytesRead() const{
+	return bytesRead.load(std::memory_order_relaxed);
+}
\ No newline at end of file
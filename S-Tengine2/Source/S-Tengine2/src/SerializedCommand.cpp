@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SerializedCommand.h"
+#include "Log.h"
+
+SerializedCommand::SerializedCommand(Deserializer _deserializer, const std::string & _delta) :
+	deserializer(_deserializer),
+	delta(_delta)
+{
+	firstRun = false;
+	archived = true;
+}
+
+SerializedCommand::~SerializedCommand(){
+}
+
+bool SerializedCommand::execute(){
+	return run(true);
+}
+
+bool SerializedCommand::unexecute(){
+	return run(false);
+}
+
+unsigned long int SerializedCommand::getSize(){
+	return Command::getSize() + delta.capacity();
+}
+
+bool SerializedCommand::run(bool _execute){
+	Command * c = deserializer(delta);
+	if(c == nullptr){
+		Log::error("Serialized command failed: couldn't rebuild command from delta");
+		return false;
+	}
+	c->firstRun = false;
+	c->executed = !_execute;
+	bool success = _execute ? c->execute() : c->unexecute();
+	// pass the command's entries on as if they were this one's
+	for(unsigned long int i = 0; i < c->subCmdProc.consoleEntries.size(); ++i){
+		subCmdProc.consoleEntries.push_back(c->subCmdProc.consoleEntries.at(i));
+	}
+	c->subCmdProc.consoleEntries.clear();
+	delete c;
+	return success;
+}
\ No newline at end of file
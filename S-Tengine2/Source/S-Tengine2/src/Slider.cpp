@@ -138,7 +138,7 @@ void Slider::updateValue(){
 		fill->background->mesh->setUV(0, 0.0, 1-v);
 		fill->background->mesh->setUV(1, 1.0, 1-v);
 	}
-	fill->background->mesh->dirty = true;
+	fill->background->mesh->makeDirty();
 	layout->invalidateLayout();
 	fill->invalidateLayout();
 
@@ -7,33 +7,44 @@
 #include "SpriteSheetAnimation.h"
 #include "Rectangle.h"
 #include "Box2DSuperSprite.h"
+#include "SpriteMesh.h"
 #include <Texture.h>
 #include <TextureSampler.h>
 #include <MeshFactory.h>
 #include <MeshInterface.h>
+#include <shader/ShaderVariables.h>
 #include <Log.h>
 
 struct b2Vec2;
 
-Sprite::Sprite(Shader * _shader) :
-	MeshEntity(MeshFactory::getPlaneMesh(), _shader),
+Sprite::Sprite(Shader * _shader, bool _sharedMesh) :
+	MeshEntity(_sharedMesh ? MeshFactory::getSharedPlaneMesh() : new SpriteMesh(true), _shader),
+	spriteSheet(nullptr),
 	currentAnimation(nullptr),
-	playAnimation(true)
+	playAnimation(true),
+	sharedFrames(_sharedMesh),
+	unitUvs(true)
 {
 }
 
-Sprite::Sprite(Texture * _texture, Shader * _shader) :
-	MeshEntity(MeshFactory::getPlaneMesh(), _shader),
+Sprite::Sprite(Texture * _texture, Shader * _shader, bool _sharedMesh) :
+	MeshEntity(_sharedMesh ? MeshFactory::getSharedPlaneMesh() : new SpriteMesh(true), _shader),
+	spriteSheet(nullptr),
 	currentAnimation(nullptr),
-	playAnimation(true)
+	playAnimation(true),
+	sharedFrames(_sharedMesh),
+	unitUvs(true)
 {
 	setPrimaryTexture(_texture);
 }
 
-Sprite::Sprite(TextureSampler * _textureSampler, Shader * _shader) :
-	MeshEntity(MeshFactory::getPlaneMesh(), _shader),
+Sprite::Sprite(TextureSampler * _textureSampler, Shader * _shader, bool _sharedMesh) :
+	MeshEntity(_sharedMesh ? MeshFactory::getSharedPlaneMesh() : new SpriteMesh(true), _shader),
+	spriteSheet(nullptr),
 	currentAnimation(nullptr),
-	playAnimation(true)
+	playAnimation(true),
+	sharedFrames(_sharedMesh),
+	unitUvs(true)
 {
 	setPrimaryTexture(_textureSampler);
 }
@@ -51,68 +62,83 @@ Sprite::~Sprite(){
 void Sprite::update(Step* _step){
 	MeshEntity::update(_step);
 	if(currentAnimation != nullptr && playAnimation){
-		mesh->dirty = true;
+		unsigned long int prevFrame = currentAnimation->currentFrame;
 		currentAnimation->update(_step);
-		setUvs(currentAnimation->definition->frames.at(currentAnimation->currentFrame));
-		while(mesh->textures.size() > 0){
-			mesh->textures.back()->decrementAndDelete();
-			mesh->textures.pop_back();
+		// the sheet's texture is normally set along with the animation, but spriteSheet can be changed directly
+		applySpriteSheetTexture();
+		// nothing needs to change on the mesh unless the frame did
+		if(currentAnimation->currentFrame != prevFrame){
+			applyFrame();
 		}
-		mesh->pushTexture2D(spriteSheet->texture);
 	}
 }
 
-void Sprite::setPrimaryTexture(Texture * _texture) {
-	if(mesh->textures.size() == 0) {
-		mesh->pushTexture2D(_texture);
-	}else {
-		mesh->textures[0] = _texture;
-		_texture->incrementReferenceCount();
+void Sprite::applyFrame(){
+	unsigned long int frame = currentAnimation->definition->firstFrame + currentAnimation->currentFrame;
+	if((sharedFrames || mesh->isImmutable()) && frame < MAX_SPRITE_FRAMES){
+		if(!unitUvs){
+			setUvs(0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 1.f);
+			unitUvs = true;
+		}
+		drawData.spriteSheet = spriteSheet;
+		drawData.frame = frame;
+	}else{
+		drawData.frame = -1;
+		setUvs(currentAnimation->definition->frames.at(currentAnimation->currentFrame));
 	}
-	
-	float mag = std::max(mesh->getTexture(0)->width, mesh->getTexture(0)->height);
-
-	float width = _texture->width;
-	float height = _texture->height;
-	
-	float posHeight =  height/mag/2;
-	float posWidth  =  width/mag/2;
-	float negHeight = -posHeight;
-	float negWidth  = -posWidth;
+}
 
-	mesh->vertices.at(0).x = negWidth;
-	mesh->vertices.at(0).y = posHeight;
-	mesh->vertices.at(1).x = posWidth;
-	mesh->vertices.at(1).y = posHeight;
-	mesh->vertices.at(2).x = posWidth;
-	mesh->vertices.at(2).y = negHeight;
-	mesh->vertices.at(3).x = negWidth;
-	mesh->vertices.at(3).y = negHeight;
+void Sprite::applySpriteSheetTexture(){
+	if(mesh->isImmutable()){
+		drawData.replaceTextures(spriteSheet->texture);
+		return;
+	}
+	if(mesh->textures.size() == 1 && mesh->textures.at(0) == spriteSheet->texture){
+		return;
+	}
+	while(mesh->textures.size() > 0){
+		mesh->textures.back()->decrementAndDelete();
+		mesh->textures.pop_back();
+	}
+	mesh->pushTexture2D(spriteSheet->texture);
+}
 
-	mesh->dirty = true;
+void Sprite::setPrimaryTexture(Texture * _texture) {
+	applyPrimaryTexture(_texture, _texture->width, _texture->height);
 }
 
 void Sprite::setPrimaryTexture(TextureSampler * _textureSampler) {
-
-	if(mesh->textures.size() == 0) {
-		mesh->pushTexture2D(_textureSampler->texture);
-	}else {
-		mesh->textures[0] = _textureSampler->texture;
-		_textureSampler->texture->incrementReferenceCount();
-	}
-
-	float mag = std::max(mesh->getTexture(0)->width, mesh->getTexture(0)->height);
+	float mag = std::max(_textureSampler->texture->width, _textureSampler->texture->height);
 
 	float u = _textureSampler->u;
 	float v = _textureSampler->v;
 	float width = _textureSampler->width;
 	float height = _textureSampler->height;
 
-
+	applyPrimaryTexture(_textureSampler->texture, width, height);
 	setUvs(sweet::Rectangle(u/mag, v/mag, width/mag, height/mag));
+}
+
+void Sprite::applyPrimaryTexture(Texture * _texture, float _width, float _height){
+	if(mesh->isImmutable()){
+		// the shared plane is a unit square, so the size goes in the mesh's transform instead
+		drawData.replaceTextures(_texture);
+		float mag = std::max(_texture->width, _texture->height);
+		meshTransform->scale(_width/mag, _height/mag, 1.f, false);
+		return;
+	}
+
+	if(mesh->textures.size() == 0) {
+		mesh->pushTexture2D(_texture);
+	}else {
+		mesh->textures[0] = _texture;
+		_texture->incrementReferenceCount();
+	}
 	
-	float posHeight =  height/mag/2;
-	float posWidth  =  width/mag/2;
+	float mag = std::max(mesh->getTexture(0)->width, mesh->getTexture(0)->height);
+
+	float posHeight =  _height/mag/2;
+	float posWidth  =  _width/mag/2;
 	float negHeight = -posHeight;
 	float negWidth  = -posWidth;
 
@@ -125,7 +151,7 @@ void Sprite::setPrimaryTexture(TextureSampler * _textureSampler) {
 	mesh->vertices.at(3).x = negWidth;
 	mesh->vertices.at(3).y = negHeight;
 
-	mesh->dirty = true;
+	mesh->makeDirty();
 }
 
 void Sprite::setSpriteSheet(SpriteSheet * _spriteSheet, std::string _currentAnimation){
@@ -139,6 +165,7 @@ void Sprite::setCurrentAnimation(std::string _name){
 	auto anim = spriteSheet->animations.find(_name);
 	if(anim == spriteSheet->animations.end()){
 		Log::error("Animation with name \""+_name+"\" does not exist.");
+		return;
 	}
 
 	
@@ -155,6 +182,8 @@ void Sprite::setCurrentAnimation(std::string _name){
 
 	// copy the new animation and set it
 	currentAnimation = new SpriteSheetAnimationInstance(anim->second);
+	applySpriteSheetTexture();
+	applyFrame();
 }
 
 Vertex * Sprite::getTopLeft(){
@@ -175,6 +204,11 @@ Vertex * Sprite::getBottomLeft(){
 
 void Sprite::setUvs(float _topLeftU, float _topLeftV, float _topRightU, float _topRightV,
 					float _bottomLeftU, float _bottomLeftV, float _bottomRightU, float _bottomRightV){
+	unitUvs = false;
+	if(mesh->isImmutable()){
+		drawData.uvRect = glm::vec4(_bottomLeftU, _bottomLeftV, _topRightU - _bottomLeftU, _topRightV - _bottomLeftV);
+		return;
+	}
 	getBottomLeft()->u    = _bottomLeftU;
 	getBottomLeft()->v    = _bottomLeftV;
 	getTopLeft()->u       = _topLeftU;
@@ -183,7 +217,7 @@ void Sprite::setUvs(float _topLeftU, float _topLeftV, float _topRightU, float _t
 	getTopRight()->v      = _topRightV;
 	getBottomRight()->u   = _bottomRightU;
 	getBottomRight()->v   = _bottomRightV;
-	mesh->dirty = true;
+	mesh->makeVerticesDirty(0, 4);
 }
 
 void Sprite::setUvs(sweet::Rectangle _rect){
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "SpriteMesh.h"
+#include "RenderOptions.h"
+
+SpriteMesh::SpriteMesh(bool _autorelease) :
+	QuadMesh(_autorelease),
+	NodeResource(_autorelease),
+	spriteSheet(nullptr),
+	frame(-1)
+{
+	pushVert(Vertex(-0.5f, 0.5f, 0.f));
+	pushVert(Vertex(0.5f, 0.5f, 0.f));
+	pushVert(Vertex(0.5f, -0.5f, 0.f));
+	pushVert(Vertex(-0.5f, -0.5f, 0.f));
+	setNormal(0, 0.0, 0.0, 1.0);
+	setNormal(1, 0.0, 0.0, 1.0);
+	setNormal(2, 0.0, 0.0, 1.0);
+	setNormal(3, 0.0, 0.0, 1.0);
+	setUV(0, 0.0, 0.0);
+	setUV(1, 1.0, 0.0);
+	setUV(2, 1.0, 1.0);
+	setUV(3, 0.0, 1.0);
+}
+
+void SpriteMesh::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOption){
+	DrawData * drawData = _renderOption->drawData;
+	// an entity's own frame takes priority over the mesh's
+	if(frame < 0 || (drawData != nullptr && drawData->frame >= 0)){
+		QuadMesh::render(_matrixStack, _renderOption);
+		return;
+	}
+	if(drawData == nullptr){
+		drawData = &meshDrawData;
+		_renderOption->drawData = drawData;
+	}
+
+	SpriteSheet * prevSpriteSheet = drawData->spriteSheet;
+	signed long int prevFrame = drawData->frame;
+	drawData->spriteSheet = spriteSheet;
+	drawData->frame = frame;
+	QuadMesh::render(_matrixStack, _renderOption);
+	drawData->spriteSheet = prevSpriteSheet;
+	drawData->frame = prevFrame;
+
+	if(drawData == &meshDrawData){
+		_renderOption->drawData = nullptr;
+	}
+}
\ No newline at end of file
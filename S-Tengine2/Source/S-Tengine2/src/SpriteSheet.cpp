@@ -3,9 +3,16 @@
 #include "SpriteSheet.h"
 #include "Texture.h"
 #include <SpriteSheetAnimation.h>
+#include <shader/ShaderVariables.h>
 #include <Log.h>
 
-SpriteSheet::SpriteSheet(Texture* _texture){
+namespace{
+	signed long int nextFrameTableId = 0;
+}
+
+SpriteSheet::SpriteSheet(Texture* _texture) :
+	frameTableId(nextFrameTableId++)
+{
 	texture = _texture;
 	texture->incrementReferenceCount();
 }
@@ -32,7 +39,16 @@ void SpriteSheet::addAnimation(std::string _name, SpriteSheetAnimationDefinition
 	auto res = animations.insert(std::pair<std::string, SpriteSheetAnimationDefinition * >(_name, _animation));
 	if(!res.second){
 		Log::error("Animation with name \""+_name+"\" already exists; not added.");
+		return;
+	}
+	_animation->firstFrame = frameTable.size();
+	for(const sweet::Rectangle & r : _animation->frames){
+		frameTable.push_back(glm::vec4(r.x, r.y, r.width, r.height));
+	}
+	if(frameTable.size() > MAX_SPRITE_FRAMES){
+		Log::warn("Sprite sheet has more than " + std::to_string(MAX_SPRITE_FRAMES) + " frames; the extra frames can't be drawn from the shared frame table.");
 	}
+	frameTableId = nextFrameTableId++;
 }
 
 void SpriteSheet::addAnimation(std::string _name, unsigned long int _start, unsigned long int _end, float _width, float _height, float _secondsPerFrame){
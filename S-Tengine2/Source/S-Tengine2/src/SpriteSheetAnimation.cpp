@@ -8,7 +8,8 @@
 #include "Texture.h"
 
 SpriteSheetAnimationDefinition::SpriteSheetAnimationDefinition(float _secondsPerFrame) :
-	secondsPerFrame(_secondsPerFrame)
+	secondsPerFrame(_secondsPerFrame),
+	firstFrame(0)
 {
 }
 
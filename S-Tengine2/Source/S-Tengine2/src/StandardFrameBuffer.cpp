@@ -4,8 +4,7 @@
 StandardFrameBuffer::StandardFrameBuffer( bool _autoRelase):
 	FrameBufferInterface(std::vector<FrameBufferChannel>(), 1, 1, _autoRelase)
 {
-	frameBufferChannels.push_back(FrameBufferChannel(GL_RGBA, GL_COLOR_ATTACHMENT0, GL_RGBA,  FrameBufferChannel::TEXTURE, GL_BYTE));
-	frameBufferChannels.push_back(FrameBufferChannel(GL_DEPTH_COMPONENT, GL_DEPTH_ATTACHMENT, GL_DEPTH_COMPONENT, FrameBufferChannel::RENDER_BUFFER, 0));
+	frameBufferChannels = getChannels();
 
 	int width, height;
 	glfwGetFramebufferSize(glfwGetCurrentContext(), &width, &height);
@@ -15,6 +14,13 @@ StandardFrameBuffer::StandardFrameBuffer( bool _autoRelase):
 StandardFrameBuffer::~StandardFrameBuffer(){
 }
 
+std::vector<FrameBufferChannel> StandardFrameBuffer::getChannels(){
+	std::vector<FrameBufferChannel> res;
+	res.push_back(FrameBufferChannel(GL_RGBA, GL_COLOR_ATTACHMENT0, GL_RGBA,  FrameBufferChannel::TEXTURE, GL_BYTE));
+	res.push_back(FrameBufferChannel(GL_DEPTH_COMPONENT, GL_DEPTH_ATTACHMENT, GL_DEPTH_COMPONENT, FrameBufferChannel::RENDER_BUFFER, 0));
+	return res;
+}
+
 GLuint StandardFrameBuffer::getTextureId(){
 	return frameBufferChannels.at(0).id;
 }
@@ -324,6 +324,7 @@ void StereoCamera::blitTo(GLint _targetFbo){
 	if(sweet::ovrInitialized){
 		FrameBufferInterface::pushFbo(mirrorFBO);
 		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _targetFbo); // bind _targetFbo to the draw buffer to blit across FBOs
+		FrameBufferInterface::invalidateBinding();
 		// Blit mirror texture to back buffer
 		GLint w = mirrorTexture->OGL.Header.TextureSize.w;
 		GLint h = mirrorTexture->OGL.Header.TextureSize.h;
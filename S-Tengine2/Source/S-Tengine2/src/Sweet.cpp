@@ -13,6 +13,7 @@
 
 #include <Keyboard.h>
 #include <Mouse.h>
+#include <InputEventQueue.h>
 
 #include <OpenALSound.h>
 #include "scenario/Scenario.h"
@@ -22,6 +23,8 @@
 
 #include <FileUtils.h>
 #include <NumberUtils.h>
+#include <JobSystem.h>
+#include <NodeCensus.h>
 
 #include <AntTweakBar.h>
 
@@ -60,15 +63,11 @@ void sweet::setGlfwWindowHints(){
 
 void sweet::keyCallback(GLFWwindow * _window, int _key, int _scancode, int _action, int _mods){
 	if(!sweet::antTweakBarInititialized || !TwEventKeyGLFW(_key, _action) ) {
-		Keyboard * keyboard = &Keyboard::getInstance();
-		keyboard->alt = (_mods & GLFW_MOD_ALT) != 0;
-		keyboard->shift = (_mods & GLFW_MOD_SHIFT) != 0;
-		keyboard->control = (_mods & GLFW_MOD_CONTROL) != 0;
-		keyboard->super = (_mods & GLFW_MOD_SUPER) != 0;
+		// the keyboard is updated when the queue is dispatched
 		if(_action == GLFW_PRESS){
-			keyboard->keyDownListener(_key);
+			sweet::InputEventQueue::getInstance().push(sweet::InputEvent(sweet::InputEvent::kKEY_DOWN, _key, _mods, 0, 0, glfwGetTime()));
 		}else if(_action == GLFW_RELEASE){
-			keyboard->keyUpListener(_key);
+			sweet::InputEventQueue::getInstance().push(sweet::InputEvent(sweet::InputEvent::kKEY_UP, _key, _mods, 0, 0, glfwGetTime()));
 		}
 	}
 }
@@ -81,25 +80,22 @@ void sweet::charCallback(GLFWwindow* _window, unsigned int _key) {
 
 void sweet::mouseButtonCallback(GLFWwindow * _window, int _button, int _action, int _mods){
 	if(!sweet::antTweakBarInititialized || !TwEventMouseButtonGLFW(_button, _action) ) {
-		Mouse * mouse = &Mouse::getInstance();
 		if(_action == GLFW_PRESS){
-			mouse->mouseDownListener(_button);
+			sweet::InputEventQueue::getInstance().push(sweet::InputEvent(sweet::InputEvent::kMOUSE_DOWN, _button, _mods, 0, 0, glfwGetTime()));
 		}else if(_action == GLFW_RELEASE){
-			mouse->mouseUpListener(_button);
+			sweet::InputEventQueue::getInstance().push(sweet::InputEvent(sweet::InputEvent::kMOUSE_UP, _button, _mods, 0, 0, glfwGetTime()));
 		}
 	}
 }
 void sweet::mousePositionCallback(GLFWwindow *_window, double _x, double _y){
 	if(!sweet::antTweakBarInititialized || !TwEventMousePosGLFW(_x, _y) ) {
-		Mouse * mouse = &Mouse::getInstance();
 		glm::uvec2 sd = getWindowDimensions();
-		mouse->mousePositionListener(_x, sd.y - _y);
+		sweet::InputEventQueue::getInstance().push(sweet::InputEvent(sweet::InputEvent::kMOUSE_MOVE, 0, 0, _x, sd.y - _y, glfwGetTime()));
 	}
 }
 void sweet::mouseScrollCallback(GLFWwindow *_window, double _x, double _y){
 	if(!sweet::antTweakBarInititialized || !TwEventMouseWheelGLFW(_y) ) {
-		Mouse * mouse = &Mouse::getInstance();
-		mouse->mouseWheelListener(_y);
+		sweet::InputEventQueue::getInstance().push(sweet::InputEvent(sweet::InputEvent::kMOUSE_WHEEL, 0, 0, 0, _y, glfwGetTime()));
 	}
 }
 
@@ -157,16 +153,12 @@ void sweet::error_callback(int _error, const char * _description){
 }
 
 void sweet::printNodes() {
-#ifdef _DEBUG
-	if(Node::nodeCounting){
-		std::cout << "Final node count: " << Node::nodes.size() << std::endl;
-
-		for(auto n : Node::nodes){
-			std::cout << typeid(*n).name() << " " << n << " -- Name: " << n->nodeName << std::endl;
-		}
+	if(config.nodeCounting){
+		NodeCensus & census = NodeCensus::getInstance();
+		std::cout << "Final node count: " << census.getLiveCount() << std::endl;
+		std::cout << census.getNodeList();
+		std::cout << census.getReport();
 	}
-
-#endif
 }
 
 GLFWwindow * sweet::initWindow(){
@@ -256,7 +248,6 @@ void sweet::initialize(){
 	title = config.title;
 #ifdef _DEBUG
 	title += " - DEBUG BUILD";
-	Node::nodeCounting = config.nodeCounting;
 #endif
 
 	
@@ -281,6 +272,9 @@ void sweet::initialize(){
 	// seed RNG
 	sweet::NumberUtils::seed(config.rngSeed);
 
+	// start the worker threads
+	JobSystem::getInstance().initialize(config.workerThreads);
+
 	// set the audio gain
 	for(auto g : config.gain){
 		if(g.first == "master"){
@@ -328,6 +322,9 @@ void sweet::initialize(){
 }
 
 void sweet::destruct(){
+	// stop the worker threads
+	JobSystem::getInstance().destruct();
+
 	// get rid of static assets
 	Scenario::destruct();
 	NodeUI::bgShader->decrementAndDelete();
@@ -6,6 +6,7 @@
 #include <Texture.h>
 #include <Resource.h>
 #include <GLUtils.h>
+#include <AssetArchive.h>
 #include <Log.h>
 
 Texture::Texture(std::string _src, bool _storeData, bool _autoRelease, bool _useMipmaps) :
@@ -66,7 +67,15 @@ void Texture::unload(){
 
 void Texture::loadImageData(){
 	int w, h, c;
-	data = stbi_load(src.c_str(), &w, &h, &c, 0);
+	// use the packed copy if there is one
+	std::string buffer;
+	size_t packedSize;
+	const unsigned char * packed = sweet::AssetArchive::getFile(src, packedSize, buffer);
+	if(packed != nullptr){
+		data = stbi_load_from_memory(packed, packedSize, &w, &h, &c, 0);
+	}else{
+		data = stbi_load(src.c_str(), &w, &h, &c, 0);
+	}
 	assert(data != nullptr);
 	resize(w,h,c);
 }
@@ -3,6 +3,7 @@
 #include <TextureSampler.h>
 #include <Texture.h>
 #include <FileUtils.h>
+#include <AssetArchive.h>
 #include <Log.h>
 
 #include <json\json.h>
@@ -28,7 +29,7 @@ TextureSampler::TextureSampler(std::string _definitionDir, std::string _definiti
 	releaseTexture(_releaseTexture)
 {
 	if(!_definitionName.empty()){
-		std::string jsonString = sweet::FileUtils::readFile(_definitionDir + _definitionName);
+		std::string jsonString = sweet::AssetArchive::readFile(_definitionDir + _definitionName);
 		Json::Value root;
 		Json::Reader reader;
 		bool parsedSuccess = reader.parse(jsonString, root);
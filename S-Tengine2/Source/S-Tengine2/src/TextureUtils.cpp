@@ -2,6 +2,58 @@
 
 #include <TextureUtils.h>
 #include <Easing.h>
+#include <JobSystem.h>
+#include <Log.h>
+
+#include <unordered_map>
+#include <algorithm>
+
+namespace{
+	// edges crossed by the contour for each marching square code (pairs of edge indices, -1 terminated)
+	// edges are 0 = top, 1 = right, 2 = bottom, 3 = left
+	const signed char edgeTable[16][4] = {
+		{-1, -1, -1, -1},	// 0x0 is empty b/c it's completely outside
+		{0, 3, -1, -1},
+		{0, 1, -1, -1},
+		{1, 3, -1, -1},
+		{1, 2, -1, -1},
+		{1, 0, 3, 2},
+		{0, 2, -1, -1},
+		{2, 3, -1, -1},
+		{2, 3, -1, -1},
+		{0, 2, -1, -1},
+		{0, 3, 1, 2},
+		{1, 2, -1, -1},
+		{1, 3, -1, -1},
+		{0, 1, -1, -1},
+		{0, 3, -1, -1},
+		{-1, -1, -1, -1}	// 0xF is empty b/c it's completely inside
+	};
+
+	// same as edgeTable, but each segment is directed so that the inside is on its right (in image space, y down)
+	// this makes the segments chain together into loops which wind counter-clockwise around filled areas once the y axis is flipped
+	// entries 16 and 17 are the joined versions of the ambiguous cases 0x5 and 0xA (used when the centre of the square is inside)
+	const signed char contourTable[18][4] = {
+		{-1, -1, -1, -1},
+		{3, 0, -1, -1},
+		{0, 1, -1, -1},
+		{3, 1, -1, -1},
+		{1, 2, -1, -1},
+		{3, 0, 1, 2},
+		{0, 2, -1, -1},
+		{3, 2, -1, -1},
+		{2, 3, -1, -1},
+		{2, 0, -1, -1},
+		{0, 1, 2, 3},
+		{2, 1, -1, -1},
+		{1, 3, -1, -1},
+		{1, 0, -1, -1},
+		{0, 3, -1, -1},
+		{-1, -1, -1, -1},
+		{1, 0, 3, 2},
+		{0, 3, 2, 1}
+	};
+}
 
 glm::vec2 sweet::TextureUtils::interpolate(unsigned long int _x1, unsigned long int _y1, unsigned long int _x2, unsigned long int _y2){
 	return glm::vec2(
@@ -22,26 +74,7 @@ glm::vec2 sweet::TextureUtils::interpolate(unsigned long int _threshold, float _
 std::vector<glm::vec2> sweet::TextureUtils::getMarchingSquaresContour(Texture * _texture, unsigned long int _threshold, bool _smooth, bool _includeNormals){
 	std::vector<glm::vec2> res;
 
-	// lookup table describing edges based on marching square code
-	std::vector<unsigned long int> edgeTable[16];
-	//edgeTable[0x0] is empty b/c it's completely outside
-	edgeTable[0x1].push_back(0); edgeTable[0x1].push_back(3);
-	edgeTable[0x2].push_back(0); edgeTable[0x2].push_back(1);
-	edgeTable[0x3].push_back(1); edgeTable[0x3].push_back(3);
-	edgeTable[0x4].push_back(1); edgeTable[0x4].push_back(2);
-	edgeTable[0x5].push_back(1); edgeTable[0x5].push_back(0); edgeTable[0x5].push_back(3); edgeTable[0x5].push_back(2);
-	edgeTable[0x6].push_back(0); edgeTable[0x6].push_back(2);
-	edgeTable[0x7].push_back(2); edgeTable[0x7].push_back(3);
-	edgeTable[0x8].push_back(2); edgeTable[0x8].push_back(3);
-	edgeTable[0x9].push_back(0); edgeTable[0x9].push_back(2);
-	edgeTable[0xA].push_back(0); edgeTable[0xA].push_back(3); edgeTable[0xA].push_back(1); edgeTable[0xA].push_back(2);
-	edgeTable[0xB].push_back(1); edgeTable[0xB].push_back(2);
-	edgeTable[0xC].push_back(1); edgeTable[0xC].push_back(3);
-	edgeTable[0xD].push_back(0); edgeTable[0xD].push_back(1);
-	edgeTable[0xE].push_back(0); edgeTable[0xE].push_back(3);
-	//edgeTable[0xF] is empty b/c it's completely inside
-
-	bool reverse[16][2] = {
+	static const bool reverse[16][2] = {
 		{0,	0},
 		{true,	0},
 		{false,	0},
@@ -61,6 +94,13 @@ std::vector<glm::vec2> sweet::TextureUtils::getMarchingSquaresContour(Texture *
 	};
 	bool flipped = false;
 
+	// read the pixels directly instead of going through getPixel, which would reload the data for every pixel if it isn't stored
+	if(!_texture->storeData){
+		_texture->loadImageData();
+	}
+	const unsigned char * data = _texture->data;
+	const unsigned long int channels = _texture->channels;
+
 	// size of marching square
 	unsigned long int size = 1;
 
@@ -72,10 +112,10 @@ std::vector<glm::vec2> sweet::TextureUtils::getMarchingSquaresContour(Texture *
 	for(unsigned long int y = 0; y < _texture->height - size; y += size){
 		for(unsigned long int x = 0; x < _texture->width - size; x += size){
 			// get adjacent pixel values (just uses first channel)
-			p0 = sweet::TextureUtils::getPixel(_texture, x, y);
-			p1 = x+size < _texture->width ? sweet::TextureUtils::getPixel(_texture, x+size, y) : 0;
-			p2 = x+size < _texture->width && y+size < _texture->height ? sweet::TextureUtils::getPixel(_texture, x+size, y+size) : 0;
-			p3 = y+size < _texture->height ? sweet::TextureUtils::getPixel(_texture, x, y+size) : 0;
+			p0 = data[(x + y*_texture->width) * channels];
+			p1 = x+size < _texture->width ? data[(x+size + y*_texture->width) * channels] : 0;
+			p2 = x+size < _texture->width && y+size < _texture->height ? data[(x+size + (y+size)*_texture->width) * channels] : 0;
+			p3 = y+size < _texture->height ? data[(x + (y+size)*_texture->width) * channels] : 0;
 
 			// determine code for the current square location
 			code = 0;
@@ -103,9 +143,9 @@ std::vector<glm::vec2> sweet::TextureUtils::getMarchingSquaresContour(Texture *
 
 			// create the verts based on the code
 			// right now the interpolate function just cares about the position, but it can be modified to take the pixel values into account
-			for(unsigned long int i = 0 ; i < edgeTable[code].size(); i += 2){
-				unsigned long int vertType1 = edgeTable[code].at(i);
-				unsigned long int vertType2 = edgeTable[code].at(i+1);
+			for(unsigned long int i = 0 ; i < 4 && edgeTable[code][i] >= 0; i += 2){
+				unsigned long int vertType1 = edgeTable[code][i];
+				unsigned long int vertType2 = edgeTable[code][i+1];
 				glm::vec2 v1, v2;
 				if(_smooth){
 					switch(vertType1){
@@ -148,6 +188,324 @@ std::vector<glm::vec2> sweet::TextureUtils::getMarchingSquaresContour(Texture *
 			}
 		}
 	}
+
+	if(!_texture->storeData){
+		_texture->unloadImageData();
+	}
+	return res;
+}
+
+std::vector<std::vector<glm::vec2>> sweet::TextureUtils::getContours(Texture * _texture, unsigned long int _threshold, bool _smooth, float _tolerance, unsigned long int _channel){
+	std::vector<std::vector<glm::vec2>> res;
+
+	if(!_texture->storeData){
+		_texture->loadImageData();
+	}
+	const unsigned char * data = _texture->data;
+	const unsigned long int channels = _texture->channels;
+	const signed long int w = _texture->width;
+	const signed long int h = _texture->height;
+	// the grid of crossing points is padded by one pixel on each side
+	const unsigned long int pw = w + 2;
+
+	// returns the pixel value, treating everything outside of the image as empty
+	auto pixel = [&](signed long int _x, signed long int _y) -> unsigned long int{
+		if(_x < 0 || _y < 0 || _x >= w || _y >= h){
+			return 0;
+		}
+		return data[(_x + _y*w) * channels + _channel];
+	};
+	// keys identifying the crossing point on the edge from (_x, _y) to (_x+1, _y) or from (_x, _y) to (_x, _y+1)
+	auto horizontalKey = [pw](signed long int _x, signed long int _y) -> unsigned long int{
+		return ((_y+1) * pw + (_x+1)) * 2;
+	};
+	auto verticalKey = [pw](signed long int _x, signed long int _y) -> unsigned long int{
+		return ((_y+1) * pw + (_x+1)) * 2 + 1;
+	};
+
+	// march through the cells in bands of rows, starting one pixel outside of the image so that contours touching the edges are closed
+	JobSystem & jobs = JobSystem::getInstance();
+	unsigned long int numRows = h + 1;
+	unsigned long int numBands = std::max(1ul, std::min(numRows, jobs.getNumThreads() * 4));
+	std::vector<std::vector<std::pair<unsigned long int, unsigned long int>>> bands(numBands);
+	jobs.parallelFor(numBands, [&](unsigned long int _band){
+		signed long int y0 = (signed long int)(numRows * _band / numBands) - 1;
+		signed long int y1 = (signed long int)(numRows * (_band+1) / numBands) - 1;
+		std::vector<std::pair<unsigned long int, unsigned long int>> & segments = bands.at(_band);
+		for(signed long int y = y0; y < y1; ++y){
+			for(signed long int x = -1; x < w; ++x){
+				unsigned long int
+					p0 = pixel(x, y),
+					p1 = pixel(x+1, y),
+					p2 = pixel(x+1, y+1),
+					p3 = pixel(x, y+1);
+				unsigned long int code =
+					(p0 > _threshold ? 0x1 : 0) |
+					(p1 > _threshold ? 0x2 : 0) |
+					(p2 > _threshold ? 0x4 : 0) |
+					(p3 > _threshold ? 0x8 : 0);
+				if(code == 0x0 || code == 0xF){
+					continue;
+				}
+				// ambiguous cases use the joined version if the centre of the cell is inside
+				if((code == 0x5 || code == 0xA) && p0 + p1 + p2 + p3 > _threshold*4){
+					code = code == 0x5 ? 16 : 17;
+				}
+				unsigned long int keys[4] = {
+					horizontalKey(x, y),
+					verticalKey(x+1, y),
+					horizontalKey(x, y+1),
+					verticalKey(x, y)
+				};
+				for(unsigned long int i = 0; i < 4 && contourTable[code][i] >= 0; i += 2){
+					segments.push_back(std::make_pair(keys[contourTable[code][i]], keys[contourTable[code][i+1]]));
+				}
+			}
+		}
+	});
+
+	// every crossing point has exactly one outgoing segment, so the loops can be followed from point to point
+	std::unordered_map<unsigned long int, unsigned long int> next;
+	for(auto & band : bands){
+		for(auto & s : band){
+			next[s.first] = s.second;
+		}
+	}
+
+	auto position = [&](unsigned long int _key) -> glm::vec2{
+		unsigned long int i = _key / 2;
+		signed long int x1 = (signed long int)(i % pw) - 1;
+		signed long int y1 = (signed long int)(i / pw) - 1;
+		signed long int x2 = x1 + (_key % 2 == 0 ? 1 : 0);
+		signed long int y2 = y1 + (_key % 2 == 0 ? 0 : 1);
+		glm::vec2 v;
+		if(_smooth){
+			v = interpolate(_threshold, x1, y1, pixel(x1, y1), x2, y2, pixel(x2, y2));
+		}else{
+			v = glm::vec2((x1 + x2) * 0.5f, (y1 + y2) * 0.5f);
+		}
+		// same offset and flip as getMarchingSquaresContour
+		v.x += 0.5f;
+		v.y = h - v.y - 0.5f;
+		return v;
+	};
+
+	while(next.size() > 0){
+		std::vector<glm::vec2> contour;
+		unsigned long int start = next.begin()->first;
+		unsigned long int key = start;
+		do{
+			auto it = next.find(key);
+			if(it == next.end()){
+				// shouldn't happen, since every segment has a matching neighbour
+				Log::warn("Open contour found while stitching marching squares");
+				break;
+			}
+			contour.push_back(position(key));
+			key = it->second;
+			next.erase(it);
+		}while(key != start);
+
+		if(_tolerance > 0){
+			contour = simplifyContour(contour, _tolerance);
+		}
+		if(contour.size() >= 3){
+			res.push_back(contour);
+		}
+	}
+
+	if(!_texture->storeData){
+		_texture->unloadImageData();
+	}
+	return res;
+}
+
+std::vector<glm::vec2> sweet::TextureUtils::simplifyContour(const std::vector<glm::vec2> & _contour, float _tolerance){
+	unsigned long int n = _contour.size();
+	if(n < 4){
+		return _contour;
+	}
+
+	// split the loop into two open halves at the first point and the point furthest from it
+	unsigned long int split = 0;
+	float splitDist = -1;
+	for(unsigned long int i = 1; i < n; ++i){
+		float d = glm::distance(_contour.at(0), _contour.at(i));
+		if(d > splitDist){
+			splitDist = d;
+			split = i;
+		}
+	}
+
+	std::vector<bool> keep(n, false);
+	keep.at(0) = keep.at(split) = true;
+
+	// each range is simplified by keeping the point furthest from the line between its ends if it's outside of the tolerance
+	// uses an explicit stack instead of recursion since contours can be very long
+	std::vector<std::pair<unsigned long int, unsigned long int>> ranges;
+	ranges.push_back(std::make_pair(0ul, split));
+	ranges.push_back(std::make_pair(split, n));
+	while(ranges.size() > 0){
+		unsigned long int a = ranges.back().first;
+		unsigned long int b = ranges.back().second;
+		ranges.pop_back();
+
+		const glm::vec2 & pa = _contour.at(a);
+		const glm::vec2 & pb = _contour.at(b % n);
+		glm::vec2 ab = pb - pa;
+		float len = glm::length(ab);
+
+		unsigned long int furthest = a;
+		float furthestDist = _tolerance;
+		for(unsigned long int i = a+1; i < b; ++i){
+			glm::vec2 ap = _contour.at(i) - pa;
+			float d = len > 0 ? std::abs(ab.x * ap.y - ab.y * ap.x) / len : glm::length(ap);
+			if(d > furthestDist){
+				furthestDist = d;
+				furthest = i;
+			}
+		}
+		if(furthest != a){
+			keep.at(furthest) = true;
+			ranges.push_back(std::make_pair(a, furthest));
+			ranges.push_back(std::make_pair(furthest, b));
+		}
+	}
+
+	std::vector<glm::vec2> res;
+	for(unsigned long int i = 0; i < n; ++i){
+		if(keep.at(i)){
+			res.push_back(_contour.at(i));
+		}
+	}
+	return res;
+}
+
+float sweet::TextureUtils::getSignedArea(const std::vector<glm::vec2> & _polygon){
+	float res = 0;
+	for(unsigned long int i = 0; i < _polygon.size(); ++i){
+		const glm::vec2 & a = _polygon.at(i);
+		const glm::vec2 & b = _polygon.at((i+1) % _polygon.size());
+		res += a.x * b.y - b.x * a.y;
+	}
+	return res * 0.5f;
+}
+
+std::vector<std::vector<glm::vec2>> sweet::TextureUtils::getConvexDecomposition(const std::vector<glm::vec2> & _polygon, unsigned long int _maxVertices){
+	std::vector<std::vector<glm::vec2>> res;
+	if(_polygon.size() < 3){
+		return res;
+	}
+	_maxVertices = std::max(3ul, _maxVertices);
+
+	// z component of the cross product of (_b - _a) and (_c - _b); positive if the corner at _b turns left
+	auto turn = [&](unsigned long int _a, unsigned long int _b, unsigned long int _c) -> float{
+		glm::vec2 ab = _polygon.at(_b) - _polygon.at(_a);
+		glm::vec2 bc = _polygon.at(_c) - _polygon.at(_b);
+		return ab.x * bc.y - ab.y * bc.x;
+	};
+
+	// triangulate by ear clipping
+	std::vector<std::vector<unsigned long int>> pieces;
+	std::vector<unsigned long int> remaining;
+	for(unsigned long int i = 0; i < _polygon.size(); ++i){
+		remaining.push_back(i);
+	}
+	while(remaining.size() > 3){
+		unsigned long int n = remaining.size();
+		bool clipped = false;
+		for(unsigned long int i = 0; i < n && !clipped; ++i){
+			unsigned long int
+				a = remaining.at((i+n-1) % n),
+				b = remaining.at(i),
+				c = remaining.at((i+1) % n);
+			if(turn(a, b, c) <= 0){
+				continue;
+			}
+			// an ear can't have any of the other vertices inside of it
+			bool ear = true;
+			for(unsigned long int j = 0; j < n && ear; ++j){
+				unsigned long int p = remaining.at(j);
+				if(p == a || p == b || p == c){
+					continue;
+				}
+				if(turn(a, b, p) >= 0 && turn(b, c, p) >= 0 && turn(c, a, p) >= 0){
+					ear = false;
+				}
+			}
+			if(ear){
+				std::vector<unsigned long int> tri;
+				tri.push_back(a);
+				tri.push_back(b);
+				tri.push_back(c);
+				pieces.push_back(tri);
+				remaining.erase(remaining.begin() + i);
+				clipped = true;
+			}
+		}
+		if(!clipped){
+			// the polygon isn't simple (or is degenerate); drop a vertex so that we don't get stuck
+			remaining.erase(remaining.begin());
+		}
+	}
+	if(remaining.size() == 3 && turn(remaining.at(0), remaining.at(1), remaining.at(2)) > 0){
+		pieces.push_back(remaining);
+	}
+
+	// merge pieces across their shared edges as long as the result is still convex and small enough
+	auto isConvex = [&](const std::vector<unsigned long int> & _piece) -> bool{
+		unsigned long int n = _piece.size();
+		for(unsigned long int i = 0; i < n; ++i){
+			if(turn(_piece.at(i), _piece.at((i+1) % n), _piece.at((i+2) % n)) < 0){
+				return false;
+			}
+		}
+		return true;
+	};
+	bool merged = true;
+	while(merged){
+		merged = false;
+		for(unsigned long int i = 0; i < pieces.size() && !merged; ++i){
+			for(unsigned long int j = i+1; j < pieces.size() && !merged; ++j){
+				std::vector<unsigned long int> & p1 = pieces.at(i);
+				std::vector<unsigned long int> & p2 = pieces.at(j);
+				if(p1.size() + p2.size() - 2 > _maxVertices){
+					continue;
+				}
+				// find an edge a->b in p1 which appears as b->a in p2
+				for(unsigned long int e1 = 0; e1 < p1.size() && !merged; ++e1){
+					unsigned long int a = p1.at(e1);
+					unsigned long int b = p1.at((e1+1) % p1.size());
+					for(unsigned long int e2 = 0; e2 < p2.size() && !merged; ++e2){
+						if(p2.at(e2) != b || p2.at((e2+1) % p2.size()) != a){
+							continue;
+						}
+						// walk p1 from b around to a, then p2 from a around to b (without repeating the shared vertices)
+						std::vector<unsigned long int> combined;
+						for(unsigned long int k = 0; k < p1.size(); ++k){
+							combined.push_back(p1.at((e1+1+k) % p1.size()));
+						}
+						for(unsigned long int k = 2; k < p2.size(); ++k){
+							combined.push_back(p2.at((e2+k) % p2.size()));
+						}
+						if(isConvex(combined)){
+							pieces.at(i) = combined;
+							pieces.erase(pieces.begin() + j);
+							merged = true;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for(auto & piece : pieces){
+		std::vector<glm::vec2> poly;
+		for(unsigned long int i : piece){
+			poly.push_back(_polygon.at(i));
+		}
+		res.push_back(poly);
+	}
 	return res;
 }
 
@@ -12,23 +12,44 @@
 #include <Log.h>
 #include <AntTweakBar.h>
 #include <ctime>
+#include <cfloat>
 #include <NumberUtils.h>
+#include <Frustum.h>
+#include <JobSystem.h>
 
 MeshInterface * Transform::transformIndicator = nullptr;
 ComponentShaderBase * Transform::transformShader = nullptr;
 bool Transform::staticInit = true;
 bool Transform::drawTransforms = false;
+bool Transform::frustumCulling = true;
+
+namespace{
+	// the transform whose children the current thread is updating in parallel (see Transform::update)
+	// bounds changes in those children stop there instead of going up to it from several threads at once
+	SWEET_THREAD_LOCAL Transform * parallelUpdateParent = nullptr;
+	// set when a bounds change stopped at parallelUpdateParent
+	SWEET_THREAD_LOCAL bool parallelUpdateBoundsDirty = false;
+}
 
 Transform::Transform():
 	translationVector(0.f, 0.f, 0.f),
 	scaleVector(1.f, 1.f, 1.f),
 	orientation(1.f, 0.f, 0.f, 0.f),
+	localBoundingBoxMin(0),
+	localBoundingBoxMax(0),
+	boundingBoxMin(0),
+	boundingBoxMax(0),
+	worldBoundingBoxMin(0),
+	worldBoundingBoxMax(0),
 	tDirty(true),
 	sDirty(true),
 	oDirty(true),
 	osDirty(true),
 	mDirty(true),
 	isIdentity(true),
+	boundingBoxDirty(true),
+	boundingBoxKnown(true),
+	worldBoundingBoxDirty(true),
 	cumulativeModelMatrix(1)
 {
 	ptrTransform = this;
@@ -59,6 +80,8 @@ Transform::Transform():
 Transform::~Transform(){
 	while(!children.empty()){
 		if(NodeResource * nr = children.back()->asNodeResource()){
+			// resources can be shared (e.g. MeshFactory's shared meshes), so they shouldn't keep pointing at this
+			children.back()->removeParent(this);
 			nr->decrementAndDelete();
 		}else{
 			delete children.back();
@@ -69,6 +92,7 @@ Transform::~Transform(){
 }
 
 void Transform::makeCumulativeModelMatrixDirty(){
+	worldBoundingBoxDirty = true;
 	if(!cumulativeModelMatrixDirty){
 		NodeChild::makeCumulativeModelMatrixDirty();
 		for(NodeChild * child : children){
@@ -97,6 +121,78 @@ void Transform::addParent(Transform * _parent){
 	NodeChild::addParent(_parent);
 }
 
+void Transform::makeBoundingBoxDirty(){
+	// a child is being updated on a worker; this is dirtied once all of them have finished
+	if(this == parallelUpdateParent){
+		parallelUpdateBoundsDirty = true;
+		return;
+	}
+	worldBoundingBoxDirty = true;
+	// if it's already dirty, the ancestors will be too
+	if(!boundingBoxDirty){
+		boundingBoxDirty = true;
+		NodeChild::makeBoundingBoxDirty();
+	}
+}
+
+void Transform::cleanBoundingBox(){
+	if(boundingBoxDirty){
+		bool empty = true;
+		boundingBoxKnown = true;
+		localBoundingBoxMin = glm::vec3(FLT_MAX);
+		localBoundingBoxMax = glm::vec3(-FLT_MAX);
+
+		for(NodeChild * child : children){
+			NodeRenderable * nr = child->asNodeRenderable();
+			if(nr == nullptr){
+				continue;
+			}
+			glm::vec3 min, max;
+			// keep going even if the bounds are unknown so that every child gets cleaned
+			if(nr->getBoundingBox(min, max)){
+				localBoundingBoxMin = glm::min(localBoundingBoxMin, min);
+				localBoundingBoxMax = glm::max(localBoundingBoxMax, max);
+				empty = false;
+			}else{
+				boundingBoxKnown = false;
+			}
+		}
+
+		// a transform without anything in it is treated as a point at its origin
+		if(empty){
+			localBoundingBoxMin = localBoundingBoxMax = glm::vec3(0);
+		}
+
+		sweet::Frustum::transformBounds(localBoundingBoxMin, localBoundingBoxMax, getModelMatrix(), boundingBoxMin, boundingBoxMax);
+		boundingBoxDirty = false;
+	}
+}
+
+bool Transform::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	cleanBoundingBox();
+	_min = boundingBoxMin;
+	_max = boundingBoxMax;
+	return boundingBoxKnown;
+}
+
+bool Transform::getLocalBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	cleanBoundingBox();
+	_min = localBoundingBoxMin;
+	_max = localBoundingBoxMax;
+	return boundingBoxKnown;
+}
+
+bool Transform::getWorldBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	cleanBoundingBox();
+	if(worldBoundingBoxDirty){
+		sweet::Frustum::transformBounds(localBoundingBoxMin, localBoundingBoxMax, getCumulativeModelMatrix(), worldBoundingBoxMin, worldBoundingBoxMax);
+		worldBoundingBoxDirty = false;
+	}
+	_min = worldBoundingBoxMin;
+	_max = worldBoundingBoxMax;
+	return boundingBoxKnown;
+}
+
 Transform * const Transform::scale(float _scaleX, float _scaleY, float _scaleZ, bool _relative){
 	scale(glm::vec3(_scaleX, _scaleY, _scaleZ), _relative);
 	return this;
@@ -118,6 +214,7 @@ Transform * const Transform::scale(glm::vec3 _scale, bool relative){
 	mDirty = true;
 	isIdentity = false;
 	makeCumulativeModelMatrixDirty();
+	makeBoundingBoxDirty();
 	return this;
 }
 
@@ -136,6 +233,7 @@ Transform * const Transform::translate(glm::vec3 _translate, bool _relative){
 	mDirty = true;
 	isIdentity = false;
 	makeCumulativeModelMatrixDirty();
+	makeBoundingBoxDirty();
 	return this;
 }
 
@@ -162,6 +260,7 @@ Transform * const Transform::setOrientation(glm::quat _orientation){
 	mDirty = true;
 	isIdentity = false;
 	makeCumulativeModelMatrixDirty();
+	makeBoundingBoxDirty();
 	return this;
 }
 
@@ -245,11 +344,57 @@ glm::quat Transform::getOrientationQuat() const {
 }
 
 void Transform::update(Step * _step){
+	sweet::JobSystem & jobs = sweet::JobSystem::getInstance();
+	bool parallel = jobs.getNumThreads() > 1;
+	sweet::JobCounter counter;
+	// whether any of the parallel children changed their bounds
+	std::atomic<bool> boundsDirty(false);
+	for(unsigned long int i = 0; i < children.size(); ++i){
+		NodeUpdatable * nu = children.at(i)->asNodeUpdatable();
+		if(nu != nullptr){
+			if(parallel && nu->isParallelUpdateSafe()){
+				jobs.submit([this, nu, _step, &boundsDirty](){
+					// waiting inside the update can run other jobs on this thread, so the previous values are restored afterwards
+					Transform * prevParent = parallelUpdateParent;
+					bool prevDirty = parallelUpdateBoundsDirty;
+					parallelUpdateParent = this;
+					parallelUpdateBoundsDirty = false;
+					nu->update(_step);
+					if(parallelUpdateBoundsDirty){
+						boundsDirty = true;
+					}
+					parallelUpdateParent = prevParent;
+					parallelUpdateBoundsDirty = prevDirty;
+				}, &counter);
+			}else{
+				// join before anything which isn't parallel-safe so that the update order is the same as the serial version
+				jobs.wait(&counter);
+				if(boundsDirty.exchange(false)){
+					makeBoundingBoxDirty();
+				}
+				nu->update(_step);
+			}
+		}
+	}
+	jobs.wait(&counter);
+	if(boundsDirty.exchange(false)){
+		makeBoundingBoxDirty();
+	}
+}
+
+bool Transform::isParallelUpdateSafe(){
+	// only looks one level down so that this stays cheap to call every frame
+	bool res = false;
 	for(unsigned long int i = 0; i < children.size(); ++i){
-		if(children.at(i)->asNodeUpdatable() != nullptr){
-			children.at(i)->asNodeUpdatable()->update(_step);
+		NodeUpdatable * nu = children.at(i)->asNodeUpdatable();
+		if(nu != nullptr){
+			if(children.at(i)->asTransform() != nullptr || !nu->isParallelUpdateSafe()){
+				return false;
+			}
+			res = true;
 		}
 	}
+	return res;
 }
 
 void Transform::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
@@ -267,8 +412,18 @@ void Transform::render(sweet::MatrixStack * _matrixStack, RenderOptions * _rende
 
 	// render all of the transform's children
 	for(unsigned long int i = 0; i < children.size(); i++){
-		if(children.at(i)->asNodeRenderable() != nullptr){
-			children.at(i)->asNodeRenderable()->render(_matrixStack, _renderOptions);
+		NodeRenderable * nr = children.at(i)->asNodeRenderable();
+		if(nr != nullptr){
+			++_renderOptions->stats.nodesVisited;
+			if(frustumCulling){
+				// skip the whole subtree if its bounds are known and entirely off-screen
+				glm::vec3 min, max;
+				if(nr->getBoundingBox(min, max) && !_matrixStack->getFrustum().intersects(min, max, *_matrixStack->getModelMatrix())){
+					++_renderOptions->stats.nodesCulled;
+					continue;
+				}
+			}
+			nr->render(_matrixStack, _renderOptions);
 		}
 	}
 	if(drawTransforms){
@@ -322,12 +477,14 @@ Transform * const Transform::addChild(NodeChild * const _child, bool _underNewTr
 		t->addChild(_child, false);
 		children.push_back(t);
 		t->addParent(this);
+		makeBoundingBoxDirty();
 		return t;
 	}
 
 	removeChild(_child);
 	children.push_back(_child);
 	_child->addParent(this);
+	makeBoundingBoxDirty();
 	return nullptr;
 }
 
@@ -349,18 +506,21 @@ Transform * const Transform::addChildAtIndex(NodeChild * const _child, int _inde
 		t->addChild(_child, false);
 		children.insert(children.begin() + _index, t);
 		t->addParent(this);
+		makeBoundingBoxDirty();
 		return t;
 	}
 
 	removeChild(_child);
 	children.insert(children.begin() + _index, _child);
 	_child->addParent(this);
+	makeBoundingBoxDirty();
 	return nullptr;
 }
 
 void Transform::removeChildAtIndex(int _index){
 	children.erase(children.begin() + _index);
 	children.at(_index)->removeParent(this);
+	makeBoundingBoxDirty();
 }
 
 unsigned long int Transform::removeChild(NodeChild * const _child){
@@ -368,6 +528,7 @@ unsigned long int Transform::removeChild(NodeChild * const _child){
 		if(_child == children.at(i)){
 			children.erase(children.begin() + i);
 			_child->removeParent(this);
+			makeBoundingBoxDirty();
 			return i;
 		}
 	}
@@ -12,6 +12,7 @@
 #include <Sprite.h>
 #include <Texture.h>
 #include <MeshInterface.h>
+#include <Profiler.h>
 
 RayTestInfo::RayTestInfo() :
 	raycb(raystart, rayend)
@@ -101,6 +102,7 @@ void UILayer::resize(float _left, float _right, float _bottom, float _top){
 }
 
 void UILayer::update(Step * _step){
+	SWEET_PROFILE_FUNCTION();
 	NodeUI::update(_step);
 	cam->update(_step);
 
@@ -126,6 +128,7 @@ void UILayer::update(Step * _step){
 		rayInfo.rayfrom.setIdentity(); rayInfo.rayfrom.setOrigin(rayInfo.raystart);
 		rayInfo.rayto.setIdentity(); rayInfo.rayto.setOrigin(rayInfo.rayend);
 		rayInfo.raycb = btCollisionWorld::AllHitsRayResultCallback(rayInfo.raystart, rayInfo.rayend);
+		SWEET_PROFILE_SCOPE("UILayer::hitTest");
 		hitTest(this);
 	}
 
@@ -188,7 +191,7 @@ Sprite * UILayer::addMouseIndicator(){
 		mouseIndicator->mesh->vertices[i].x += 0.5f;
 		mouseIndicator->mesh->vertices[i].y -= 0.5f;
 	}
-	mouseIndicator->mesh->dirty = true;
+	mouseIndicator->mesh->makeDirty();
 
 	return mouseIndicator;
 }
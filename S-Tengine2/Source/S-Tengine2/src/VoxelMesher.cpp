@@ -0,0 +1,245 @@
+#pragma once
+
+#include <VoxelMesher.h>
+
+#include <algorithm>
+
+sweet::VoxelChunk::VoxelChunk() :
+	voxels(SIZE * SIZE * SIZE, 0),
+	solidCount(0)
+{
+}
+
+unsigned char sweet::VoxelChunk::get(unsigned long int _x, unsigned long int _y, unsigned long int _z) const{
+	return voxels[_x + (_y + _z * SIZE) * SIZE];
+}
+
+bool sweet::VoxelChunk::set(unsigned long int _x, unsigned long int _y, unsigned long int _z, unsigned char _value){
+	unsigned char & v = voxels[_x + (_y + _z * SIZE) * SIZE];
+	if(v == _value){
+		return false;
+	}
+	if(v == 0){
+		++solidCount;
+	}else if(_value == 0){
+		--solidCount;
+	}
+	v = _value;
+	return true;
+}
+
+unsigned long int sweet::VoxelChunk::getSolidCount() const{
+	return solidCount;
+}
+
+void sweet::VoxelChunk::fill(unsigned char _value){
+	std::fill(voxels.begin(), voxels.end(), _value);
+	solidCount = _value == 0 ? 0 : voxels.size();
+}
+
+sweet::VoxelMesher::VoxelMesher() :
+	ambientOcclusionStrength(0.2f),
+	padded(PADDED_SIZE * PADDED_SIZE * PADDED_SIZE, 0)
+{
+}
+
+void sweet::VoxelMesher::gather(const VoxelChunk * const _chunks[27]){
+	const signed long int size = VoxelChunk::SIZE;
+	unsigned long int i = 0;
+	for(signed long int z = -1; z <= size; ++z){
+		unsigned long int cz = z < 0 ? 0 : (z < size ? 1 : 2);
+		for(signed long int y = -1; y <= size; ++y){
+			unsigned long int cy = y < 0 ? 0 : (y < size ? 1 : 2);
+			for(signed long int x = -1; x <= size; ++x, ++i){
+				unsigned long int cx = x < 0 ? 0 : (x < size ? 1 : 2);
+				const VoxelChunk * c = _chunks[cx + cy * 3 + cz * 9];
+				padded[i] = c == nullptr ? 0 : c->get((x + size) % size, (y + size) % size, (z + size) % size);
+			}
+		}
+	}
+}
+
+unsigned char sweet::VoxelMesher::get(signed long int _x, signed long int _y, signed long int _z) const{
+	return padded[(_x + 1) + ((_y + 1) + (_z + 1) * PADDED_SIZE) * PADDED_SIZE];
+}
+
+unsigned long int sweet::VoxelMesher::getOcclusion(const glm::ivec3 & _p, const glm::ivec3 & _normal, const glm::ivec3 & _u, const glm::ivec3 & _v) const{
+	// the voxels which touch the corner on the open side of the face
+	glm::ivec3 q = _p + _normal;
+	unsigned long int side1 = get(q.x + _u.x, q.y + _u.y, q.z + _u.z) != 0 ? 1 : 0;
+	unsigned long int side2 = get(q.x + _v.x, q.y + _v.y, q.z + _v.z) != 0 ? 1 : 0;
+	unsigned long int corner = get(q.x + _u.x + _v.x, q.y + _u.y + _v.y, q.z + _u.z + _v.z) != 0 ? 1 : 0;
+	// if both sides are solid, the corner is hidden whether or not the voxel between them is
+	if(side1 == 1 && side2 == 1){
+		return 0;
+	}
+	return 3 - (side1 + side2 + corner);
+}
+
+void sweet::VoxelMesher::pushQuad(const glm::ivec3 & _p, unsigned long int _axis, signed long int _side, unsigned long int _width, unsigned long int _height, const unsigned long int _occlusion[4], const glm::vec4 & _colour, const glm::vec3 & _origin, float _resolution, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const{
+	unsigned long int u = (_axis + 1) % 3;
+	unsigned long int v = (_axis + 2) % 3;
+
+	glm::vec3 normal(0);
+	normal[_axis] = (float)_side;
+
+	glm::vec3 base((float)_p.x, (float)_p.y, (float)_p.z);
+	if(_side > 0){
+		base[_axis] += 1.f;
+	}
+
+	// corners counter-clockwise in (u, v), which faces +axis; the -axis side is wound the other way
+	static const float cornerU[4] = {0, 1, 1, 0};
+	static const float cornerV[4] = {0, 0, 1, 1};
+	GLuint first = _vertices.size();
+	for(unsigned long int i = 0; i < 4; ++i){
+		unsigned long int c = _side > 0 ? i : (4 - i) % 4;
+		glm::vec3 pos = base;
+		pos[u] += cornerU[c] * _width;
+		pos[v] += cornerV[c] * _height;
+		pos = (pos + _origin) * _resolution;
+
+		float light = 1.f - ambientOcclusionStrength * (3 - _occlusion[c]);
+		_vertices.push_back(Vertex(
+			pos.x, pos.y, pos.z,
+			_colour.r * light, _colour.g * light, _colour.b * light, _colour.a,
+			normal.x, normal.y, normal.z,
+			cornerU[c] * _width, cornerV[c] * _height
+		));
+	}
+
+	// split along the diagonal between the brighter pair of corners, so that the occlusion is interpolated evenly across the quad
+	// (the -axis side only swaps corners 1 and 3, so the diagonals are the same either way)
+	if(_occlusion[0] + _occlusion[2] >= _occlusion[1] + _occlusion[3]){
+		_indices.push_back(first);
+		_indices.push_back(first + 1);
+		_indices.push_back(first + 2);
+		_indices.push_back(first);
+		_indices.push_back(first + 2);
+		_indices.push_back(first + 3);
+	}else{
+		_indices.push_back(first);
+		_indices.push_back(first + 1);
+		_indices.push_back(first + 3);
+		_indices.push_back(first + 1);
+		_indices.push_back(first + 2);
+		_indices.push_back(first + 3);
+	}
+}
+
+void sweet::VoxelMesher::mesh(const glm::vec3 & _origin, float _resolution, const std::vector<glm::vec4> & _palette, bool _merge, bool _ambientOcclusion, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const{
+	const unsigned long int size = VoxelChunk::SIZE;
+	// one entry per face in a slice: the palette index in the low byte, and the occlusion of each corner in two bits each above it; 0 means no face
+	std::vector<unsigned long int> mask(size * size);
+
+	for(unsigned long int d = 0; d < 3; ++d){
+		unsigned long int u = (d + 1) % 3;
+		unsigned long int v = (d + 2) % 3;
+		for(signed long int side = -1; side <= 1; side += 2){
+			glm::ivec3 normal(0);
+			normal[d] = side;
+
+			for(unsigned long int slice = 0; slice < size; ++slice){
+				// find the visible faces in this slice
+				for(unsigned long int j = 0; j < size; ++j){
+					for(unsigned long int i = 0; i < size; ++i){
+						glm::ivec3 p(0);
+						p[d] = slice;
+						p[u] = i;
+						p[v] = j;
+						unsigned char voxel = get(p.x, p.y, p.z);
+						if(voxel == 0 || get(p.x + normal.x, p.y + normal.y, p.z + normal.z) != 0){
+							mask[i + j * size] = 0;
+							continue;
+						}
+
+						unsigned long int key = voxel;
+						if(_ambientOcclusion){
+							for(unsigned long int c = 0; c < 4; ++c){
+								glm::ivec3 du(0), dv(0);
+								du[u] = (c == 1 || c == 2) ? 1 : -1;
+								dv[v] = (c == 2 || c == 3) ? 1 : -1;
+								key |= getOcclusion(p, normal, du, dv) << (8 + c * 2);
+							}
+						}else{
+							key |= 0xFF << 8;
+						}
+						mask[i + j * size] = key;
+					}
+				}
+
+				// turn them into quads, growing each one as far as it'll go along u and then v
+				for(unsigned long int j = 0; j < size; ++j){
+					for(unsigned long int i = 0; i < size;){
+						unsigned long int key = mask[i + j * size];
+						if(key == 0){
+							++i;
+							continue;
+						}
+
+						unsigned long int occlusion[4];
+						for(unsigned long int c = 0; c < 4; ++c){
+							occlusion[c] = (key >> (8 + c * 2)) & 3;
+						}
+						bool evenlyLit = occlusion[0] == occlusion[1] && occlusion[0] == occlusion[2] && occlusion[0] == occlusion[3];
+
+						unsigned long int w = 1;
+						unsigned long int h = 1;
+						if(_merge && evenlyLit){
+							while(i + w < size && mask[i + w + j * size] == key){
+								++w;
+							}
+							bool grow = true;
+							while(grow && j + h < size){
+								for(unsigned long int k = 0; k < w; ++k){
+									if(mask[i + k + (j + h) * size] != key){
+										grow = false;
+										break;
+									}
+								}
+								if(grow){
+									++h;
+								}
+							}
+						}
+
+						glm::ivec3 p(0);
+						p[d] = slice;
+						p[u] = i;
+						p[v] = j;
+						unsigned char voxel = key & 0xFF;
+						glm::vec4 colour = voxel < _palette.size() ? _palette.at(voxel) : glm::vec4(1);
+						pushQuad(p, d, side, w, h, occlusion, colour, _origin, _resolution, _vertices, _indices);
+
+						for(unsigned long int y = 0; y < h; ++y){
+							for(unsigned long int x = 0; x < w; ++x){
+								mask[i + x + (j + y) * size] = 0;
+							}
+						}
+						i += w;
+					}
+				}
+			}
+		}
+	}
+}
+
+void sweet::VoxelMesher::meshNaive(const glm::vec3 & _origin, float _resolution, const std::vector<glm::vec4> & _palette, std::vector<Vertex> & _vertices, std::vector<GLuint> & _indices) const{
+	const unsigned long int size = VoxelChunk::SIZE;
+	const unsigned long int occlusion[4] = {3, 3, 3, 3};
+	for(unsigned long int z = 0; z < size; ++z){
+		for(unsigned long int y = 0; y < size; ++y){
+			for(unsigned long int x = 0; x < size; ++x){
+				unsigned char voxel = get(x, y, z);
+				if(voxel == 0){
+					continue;
+				}
+				glm::vec4 colour = voxel < _palette.size() ? _palette.at(voxel) : glm::vec4(1);
+				for(unsigned long int d = 0; d < 3; ++d){
+					pushQuad(glm::ivec3((int)x, (int)y, (int)z), d, -1, 1, 1, occlusion, colour, _origin, _resolution, _vertices, _indices);
+					pushQuad(glm::ivec3((int)x, (int)y, (int)z), d, 1, 1, 1, occlusion, colour, _origin, _resolution, _vertices, _indices);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
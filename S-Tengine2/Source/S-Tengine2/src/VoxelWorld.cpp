@@ -0,0 +1,270 @@
+#pragma once
+
+#include <VoxelWorld.h>
+#include <MeshInterface.h>
+#include <Material.h>
+#include <RenderOptions.h>
+#include <Texture.h>
+#include <shader\Shader.h>
+
+VoxelWorldChunk::VoxelWorldChunk(VoxelWorld * _world, const glm::ivec3 & _position) :
+	position(_position),
+	world(_world),
+	dirty(true),
+	state(kIDLE),
+	mesh(nullptr),
+	configuredShader(nullptr)
+{
+}
+
+VoxelWorldChunk::~VoxelWorldChunk(){
+	if(mesh != nullptr){
+		mesh->decrementAndDelete();
+	}
+}
+
+bool VoxelWorldChunk::isDirty() const{
+	return dirty;
+}
+
+void VoxelWorldChunk::makeDirty(){
+	dirty = true;
+}
+
+bool VoxelWorldChunk::remesh(sweet::JobCounter * _jobs){
+	if(state == kPENDING){
+		return false;
+	}
+	dirty = false;
+
+	const sweet::VoxelChunk * neighbours[27];
+	for(signed long int z = -1; z <= 1; ++z){
+		for(signed long int y = -1; y <= 1; ++y){
+			for(signed long int x = -1; x <= 1; ++x){
+				VoxelWorldChunk * c = world->getChunk(position + glm::ivec3(x, y, z));
+				neighbours[(x + 1) + (y + 1) * 3 + (z + 1) * 9] = c == nullptr ? nullptr : &c->voxels;
+			}
+		}
+	}
+	mesher.gather(neighbours);
+	palette = world->palette;
+	vertices.clear();
+	indices.clear();
+	state = kPENDING;
+
+	glm::vec3 origin(position.x, position.y, position.z);
+	origin *= (float)sweet::VoxelChunk::SIZE;
+	float resolution = world->resolution;
+	bool merge = world->merge;
+	bool ambientOcclusion = world->ambientOcclusion;
+	auto job = [this, origin, resolution, merge, ambientOcclusion](){
+		mesher.mesh(origin, resolution, palette, merge, ambientOcclusion, vertices, indices);
+		state = kGENERATED;
+	};
+	if(_jobs != nullptr){
+		sweet::JobSystem::getInstance().submit(job, _jobs);
+	}else{
+		job();
+	}
+	return true;
+}
+
+unsigned long int VoxelWorldChunk::getTriangleCount() const{
+	return mesh == nullptr ? 0 : mesh->indices.size() / 3;
+}
+
+void VoxelWorldChunk::syncMaterials(){
+	MeshInterface * source = world->mesh;
+	if(mesh->textures != source->textures){
+		mesh->clearTextures();
+		for(Texture * t : source->textures){
+			mesh->pushTexture2D(t);
+		}
+	}
+	if(mesh->materials != source->materials){
+		while(mesh->materials.size() > 0){
+			mesh->materials.back()->decrementAndDelete();
+			mesh->materials.pop_back();
+		}
+		for(Material * m : source->materials){
+			mesh->pushMaterial(m);
+		}
+	}
+	mesh->uvEdgeMode = source->uvEdgeMode;
+	mesh->scaleModeMag = source->scaleModeMag;
+	mesh->scaleModeMin = source->scaleModeMin;
+}
+
+void VoxelWorldChunk::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
+	// don't bother doing any work if we aren't rendering anyway
+	if(!isVisible()){
+		return;
+	}
+
+	if(state == kGENERATED){
+		if(mesh == nullptr){
+			mesh = new TriMesh(true);
+			mesh->incrementReferenceCount();
+		}
+		mesh->vertices.swap(vertices);
+		mesh->indices.swap(indices);
+		mesh->makeDirty();
+		vertices.clear();
+		indices.clear();
+		state = kIDLE;
+	}
+	if(mesh == nullptr || mesh->indices.size() == 0){
+		return;
+	}
+
+	syncMaterials();
+	if(_renderOptions->shader != nullptr && configuredShader != _renderOptions->shader){
+		mesh->load();
+		mesh->configureDefaultVertexAttributes(_renderOptions->shader);
+		configuredShader = _renderOptions->shader;
+	}
+	mesh->render(_matrixStack, _renderOptions);
+}
+
+void VoxelWorldChunk::load(){
+	// the mesh is loaded and configured for the current shader the next time it's rendered
+	NodeLoadable::load();
+}
+
+void VoxelWorldChunk::unload(){
+	if(mesh != nullptr){
+		mesh->unload();
+	}
+	configuredShader = nullptr;
+	NodeLoadable::unload();
+}
+
+bool VoxelWorldChunk::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	float size = sweet::VoxelChunk::SIZE * world->resolution;
+	_min = glm::vec3(position.x, position.y, position.z) * size;
+	_max = _min + glm::vec3(size);
+	return true;
+}
+
+VoxelWorld::VoxelWorld(Shader * _shader, float _resolution) :
+	MeshEntity(new TriMesh(true), _shader),
+	resolution(_resolution),
+	merge(true),
+	ambientOcclusion(true),
+	useJobs(true),
+	remeshCount(0)
+{
+	palette.push_back(glm::vec4(0));
+}
+
+VoxelWorld::~VoxelWorld(){
+	// the chunks are deleted along with the meshTransform, but the jobs need to finish first
+	finishMeshing();
+}
+
+void VoxelWorld::update(Step * _step){
+	remesh();
+	MeshEntity::update(_step);
+}
+
+signed long long int VoxelWorld::getKey(const glm::ivec3 & _position){
+	// 21 bits per axis
+	const signed long long int mask = (1 << 21) - 1;
+	return ((signed long long int)_position.x & mask) | (((signed long long int)_position.y & mask) << 21) | (((signed long long int)_position.z & mask) << 42);
+}
+
+signed long int VoxelWorld::getChunkCoordinate(signed long int _x){
+	const signed long int size = sweet::VoxelChunk::SIZE;
+	return _x >= 0 ? _x / size : (_x + 1) / size - 1;
+}
+
+VoxelWorldChunk * VoxelWorld::getChunk(const glm::ivec3 & _position) const{
+	auto it = chunks.find(getKey(_position));
+	return it == chunks.end() ? nullptr : it->second;
+}
+
+unsigned char VoxelWorld::getVoxel(signed long int _x, signed long int _y, signed long int _z) const{
+	const signed long int size = sweet::VoxelChunk::SIZE;
+	glm::ivec3 c(getChunkCoordinate(_x), getChunkCoordinate(_y), getChunkCoordinate(_z));
+	VoxelWorldChunk * chunk = getChunk(c);
+	if(chunk == nullptr){
+		return 0;
+	}
+	return chunk->voxels.get(_x - c.x * size, _y - c.y * size, _z - c.z * size);
+}
+
+void VoxelWorld::setVoxel(signed long int _x, signed long int _y, signed long int _z, unsigned char _value){
+	const signed long int size = sweet::VoxelChunk::SIZE;
+	glm::ivec3 c(getChunkCoordinate(_x), getChunkCoordinate(_y), getChunkCoordinate(_z));
+	VoxelWorldChunk * chunk = getChunk(c);
+	if(chunk == nullptr){
+		if(_value == 0){
+			return;
+		}
+		chunk = new VoxelWorldChunk(this, c);
+		chunks[getKey(c)] = chunk;
+		meshTransform->addChild(chunk, false);
+	}
+
+	glm::ivec3 local(_x - c.x * size, _y - c.y * size, _z - c.z * size);
+	if(!chunk->voxels.set(local.x, local.y, local.z, _value)){
+		return;
+	}
+
+	// the neighbours which have this voxel in their border (for culling and ambient occlusion) need remeshing too
+	for(signed long int z = -1; z <= 1; ++z){
+		if((z < 0 && local.z != 0) || (z > 0 && local.z != size - 1)){
+			continue;
+		}
+		for(signed long int y = -1; y <= 1; ++y){
+			if((y < 0 && local.y != 0) || (y > 0 && local.y != size - 1)){
+				continue;
+			}
+			for(signed long int x = -1; x <= 1; ++x){
+				if((x < 0 && local.x != 0) || (x > 0 && local.x != size - 1)){
+					continue;
+				}
+				VoxelWorldChunk * n = getChunk(c + glm::ivec3(x, y, z));
+				if(n != nullptr){
+					n->makeDirty();
+				}
+			}
+		}
+	}
+}
+
+void VoxelWorld::remesh(){
+	for(auto & c : chunks){
+		if(c.second->isDirty() && c.second->remesh(useJobs ? &meshJobs : nullptr)){
+			++remeshCount;
+		}
+	}
+}
+
+void VoxelWorld::remeshAll(){
+	finishMeshing();
+	for(auto & c : chunks){
+		c.second->makeDirty();
+	}
+	remesh();
+}
+
+void VoxelWorld::finishMeshing(){
+	sweet::JobSystem::getInstance().wait(&meshJobs);
+}
+
+unsigned long int VoxelWorld::getChunkCount() const{
+	return chunks.size();
+}
+
+unsigned long int VoxelWorld::getTriangleCount() const{
+	unsigned long int res = 0;
+	for(auto & c : chunks){
+		res += c.second->getTriangleCount();
+	}
+	return res;
+}
+
+unsigned long int VoxelWorld::getRemeshCount() const{
+	return remeshCount;
+}
\ No newline at end of file
@@ -1,22 +1,58 @@
 #pragma once
 
 #include <node/Node.h>
+#include <NodeAllocator.h>
+#include <NodeCensus.h>
+#include <JobSystem.h>
 
-#ifdef _DEBUG
-std::vector<Node *>Node::nodes;
-bool Node::nodeCounting = false;
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define SWEET_NOINLINE __declspec(noinline)
+#define SWEET_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define SWEET_NOINLINE __attribute__((noinline))
+#define SWEET_RETURN_ADDRESS() __builtin_return_address(0)
 #endif
 
+namespace{
+	struct PendingAllocation{
+		char * ptr;
+		size_t bytes;
+		void * site;
+	};
+
+	// allocations made by operator new on this thread whose Node constructor hasn't run yet
+	// there can be several at once, since a constructor's arguments can allocate nodes of their own (e.g. new MeshEntity(new MeshInterface(...)))
+	// and the compiler is free to allocate the outer node first; each constructor picks up the allocation which contains it
+	// Node is a virtual base, so its constructor runs before any member nodes of the new object are constructed
+	const unsigned long int maxPending = 16;
+	SWEET_THREAD_LOCAL PendingAllocation pending[maxPending];
+	SWEET_THREAD_LOCAL unsigned long int numPending = 0;
+}
+
 Node::~Node(){
-#ifdef _DEBUG
-	if(nodeCounting){
-		for(signed long int j = nodes.size()-1; j >= 0; --j){
-			if(nodes.at(j) == this){
-				nodes.erase(nodes.begin() + j);
-			}
-		}
+	sweet::NodeCensus::getInstance().remove(this);
+}
+
+SWEET_NOINLINE void * Node::operator new(size_t _size){
+	void * res = sweet::NodeAllocator::getInstance().allocate(_size);
+	// if a constructor never ran (i.e. it threw), its allocation is left behind until it's pushed out by newer ones
+	if(numPending == maxPending){
+		memmove(pending, pending + 1, sizeof(PendingAllocation) * (maxPending - 1));
+		--numPending;
 	}
-#endif
+	PendingAllocation & p = pending[numPending++];
+	p.ptr = static_cast<char *>(res);
+	p.bytes = _size;
+	p.site = SWEET_RETURN_ADDRESS();
+	return res;
+}
+
+void Node::operator delete(void * _ptr, size_t _size){
+	sweet::NodeAllocator::getInstance().deallocate(_ptr, _size);
 }
 
 NodeRenderable * Node::asNodeRenderable() const {
@@ -68,9 +104,20 @@ Node::Node() :
 	nodeName("UNNAMED")
 {
 	nodeType |= kNODE;
-#ifdef _DEBUG
-	if(nodeCounting){
-		nodes.push_back(this);
+
+	// nodes which weren't allocated with operator new (e.g. on the stack, or members of other nodes) don't have an allocation
+	size_t bytes = 0;
+	void * site = nullptr;
+	const char * self = reinterpret_cast<const char *>(this);
+	for(unsigned long int i = numPending; i > 0; --i){
+		PendingAllocation & p = pending[i-1];
+		if(self >= p.ptr && self < p.ptr + p.bytes){
+			bytes = p.bytes;
+			site = p.site;
+			memmove(pending + i - 1, pending + i, sizeof(PendingAllocation) * (numPending - i));
+			--numPending;
+			break;
+		}
 	}
-#endif
+	sweet::NodeCensus::getInstance().add(this, bytes, site);
 }
\ No newline at end of file
@@ -21,6 +21,12 @@ void NodeChild::makeCumulativeModelMatrixDirty(){
 	cumulativeModelMatrixDirty = true;
 }
 
+void NodeChild::makeBoundingBoxDirty(){
+	for(Transform * p : parents){
+		p->makeBoundingBoxDirty();
+	}
+}
+
 bool NodeChild::hasAncestor(const Transform * const _parent) const{
 	if(_parent == nullptr){
 		return false;
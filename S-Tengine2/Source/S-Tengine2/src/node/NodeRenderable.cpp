@@ -16,6 +16,10 @@ bool NodeRenderable::isVisible(){
 	return visible;
 }
 
+bool NodeRenderable::getBoundingBox(glm::vec3 & _min, glm::vec3 & _max){
+	return false;
+}
+
 /*void NodeRenderable::render(sweet::MatrixStack * _matrixStack, RenderOptions * _renderOptions){
 }
 */
\ No newline at end of file
@@ -28,6 +28,10 @@ unsigned long int NodeResource::incrementReferenceCount(){
 	return ++referenceCount;
 }
 
+unsigned long int NodeResource::getReferenceCount() const{
+	return referenceCount;
+}
+
 bool NodeResource::isAutoReleasing(){
 	return autoRelease;
 }
\ No newline at end of file
@@ -3,4 +3,8 @@
 NodeUpdatable::NodeUpdatable() {
 	nodeType |= NodeType::kNODE_UPDATABLE;
 	ptrNodeUpdatable = this;
+}
+
+bool NodeUpdatable::isParallelUpdateSafe(){
+	return false;
 }
\ No newline at end of file
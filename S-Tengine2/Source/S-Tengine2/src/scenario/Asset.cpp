@@ -2,6 +2,7 @@
 
 #include <scenario/Asset.h>
 #include <FileUtils.h>
+#include <AssetArchive.h>
 #include <json/json.h>
 #include <Resource.h>
 #include <MeshFactory.h>
@@ -70,7 +71,7 @@ AssetTextureSampler::AssetTextureSampler(Json::Value _json, Scenario * const _sc
 		src = "assets/textures/" + src;
 	}
 
-	const std::string defJsonRaw = sweet::FileUtils::readFile(src);
+	const std::string defJsonRaw = sweet::AssetArchive::readFile(src);
 
 	Json::Reader reader;
 	Json::Value defJson;
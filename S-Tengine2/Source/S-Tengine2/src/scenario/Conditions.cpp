@@ -14,6 +14,15 @@ Condition::Condition(Json::Value _json, Scenario * _scenario) :
 	event(new sweet::Event(_json)), 
 	scenario(_scenario) {
 	event->setStringData("scenario", _scenario->id);
+	conditionId = _scenario->getConditionId(event->tag);
+}
+
+Condition::Condition(sweet::Event * _event, Scenario * _scenario) :
+	event(_event),
+	scenario(_scenario),
+	conditionId(_scenario->getConditionId(_event->tag))
+{
+	event->setStringData("scenario", _scenario->id);
 }
 
 Condition::~Condition(){
@@ -21,6 +30,10 @@ Condition::~Condition(){
 }
 
 bool Condition::evaluate() {
+	const std::function<bool(sweet::Event *)> & implementation = scenario->getConditionImplementation(conditionId);
+	if(implementation){
+		return implementation(event);
+	}
 	if(scenario->conditionImplementations != nullptr &&
 		scenario->conditionImplementations->find(event->tag) != scenario->conditionImplementations->end()) {
 		return scenario->conditionImplementations->at(event->tag)(event);
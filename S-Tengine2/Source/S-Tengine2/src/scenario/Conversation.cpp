@@ -10,7 +10,15 @@
 
 Option::Option(Json::Value _json, Scenario * const _scenario) :
 	text(_json.get("label", "").asString()),
-	link(_json.get("convoId", "END").asString())
+	link(_json.get("convoId", "END").asString()),
+	linkedConversation(nullptr)
+{
+}
+
+Option::Option(std::string _text, std::string _link) :
+	text(_text),
+	link(_link),
+	linkedConversation(nullptr)
 {
 }
 
@@ -101,6 +109,13 @@ bool Conversation::advance(){
 }
 
 
+Conversation * Conversation::getLinkedConversation(Option * _option){
+	if(_option->linkedConversation != nullptr){
+		return _option->linkedConversation;
+	}
+	return scenario->getConversation(_option->link)->conversation;
+}
+
 void Conversation::reset(){
 	Log::info("Reset conversation: " + id);
 	for(Dialogue * d : dialogueObjects){
@@ -137,7 +152,7 @@ void ConversationIterator::select(unsigned long int _option){
 	if(!waitingForInput){
 		throw "you can't do that";
 	}
-	currentConversation = currentConversation->scenario->getConversation(currentConversation->options.at(_option)->link)->conversation;
+	currentConversation = currentConversation->getLinkedConversation(currentConversation->options.at(_option));
 	currentConversation->reset();
 	waitingForInput = false;
 	sayNext();
@@ -167,7 +182,7 @@ bool ConversationIterator::sayNext(){
 			waitingForInput = true;
 		}else if(currentConversation->options.size() == 1){
 			// single option means go to the link
-			currentConversation = currentConversation->scenario->getConversation(currentConversation->options.front()->link)->conversation;
+			currentConversation = currentConversation->getLinkedConversation(currentConversation->options.front());
 			currentConversation->reset();
 			sayNext();
 		}else{
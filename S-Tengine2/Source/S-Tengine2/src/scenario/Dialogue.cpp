@@ -28,6 +28,13 @@ Dialogue::Dialogue(Json::Value _json, Scenario * const _scenario) :
 	}
 }
 
+Dialogue::Dialogue(std::string _speaker, Scenario * const _scenario) :
+	currentText(-1),
+	scenario(_scenario),
+	speaker(_speaker)
+{
+}
+
 Dialogue::~Dialogue(){
 	while(triggers.size() > 0){
 		delete triggers.back();
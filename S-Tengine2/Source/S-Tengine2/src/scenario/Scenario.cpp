@@ -3,10 +3,12 @@
 #include <scenario/Scenario.h>
 #include <scenario/Conversation.h>
 #include <scenario/Dialogue.h>
+#include <scenario/ScenarioBinary.h>
 #include <NineSlicing.h>
 
 #include <Log.h>
 #include <FileUtils.h>
+#include <AssetArchive.h>
 
 Character::Character(Json::Value _json) :
 	id(_json.get("id", "NO_ID").asString())
@@ -39,8 +41,14 @@ Scenario::Scenario(std::string _jsonSrc) :
 	variables(new sweet::Event("__VARIABLES__")),
 	id(_jsonSrc),
 	currentConversation(nullptr),
-	eventManager(new sweet::EventManager())
+	eventManager(new sweet::EventManager()),
+	archive(nullptr)
 {
+	if(sweet::FileUtils::fileExists(_jsonSrc + ".pack")){
+		archive = new sweet::AssetArchive(_jsonSrc + ".pack");
+		sweet::AssetArchive::mount(archive);
+	}
+
 	Json::Reader reader;
 	Json::Value defJson;
 	bool parsingSuccessful;
@@ -100,7 +108,15 @@ Scenario::Scenario(std::string _jsonSrc) :
 		defaultAssets.push_back(defaultMesh);
 	}
 
-	std::string jsonLoaded = sweet::FileUtils::readFile(_jsonSrc);
+	// compiled scenarios are binary, so they have to be read without any newline conversion
+	std::string jsonLoaded = sweet::FileUtils::readBinaryFile(_jsonSrc);
+	if(ScenarioBinary::isCompiled(jsonLoaded)){
+		if(!ScenarioBinary::load(jsonLoaded, this)){
+			Log::error("Compiled scenario \"" + _jsonSrc + "\" could not be loaded.");
+		}
+		resolveLinks();
+		return;
+	}
 	parsingSuccessful = reader.parse( jsonLoaded, root );
 	if(!parsingSuccessful){
 		Log::error("JSON parse failed: " + reader.getFormattedErrorMessages()/* + "\n" + jsonLoaded*/);
@@ -123,6 +139,54 @@ Scenario::Scenario(std::string _jsonSrc) :
 			 Asset * a = Asset::getAsset(texturesJson[i], this);
 			 assets[a->type][a->id] = a;
 		 }
+		 resolveLinks();
+	}
+}
+
+void Scenario::resolveLinks(){
+	auto conversations = assets.find("conversation");
+	if(conversations == assets.end()){
+		return;
+	}
+	for(auto a : conversations->second){
+		AssetConversation * c = dynamic_cast<AssetConversation *>(a.second);
+		if(c == nullptr){
+			continue;
+		}
+		for(Option * o : c->conversation->options){
+			if(o->linkedConversation == nullptr){
+				auto target = conversations->second.find(o->link);
+				if(target != conversations->second.end()){
+					AssetConversation * t = dynamic_cast<AssetConversation *>(target->second);
+					o->linkedConversation = t != nullptr ? t->conversation : nullptr;
+				}
+			}
+		}
+	}
+}
+
+unsigned long int Scenario::getConditionId(const std::string & _tag){
+	auto it = conditionIds.find(_tag);
+	if(it != conditionIds.end()){
+		return it->second;
+	}
+	unsigned long int id = conditionTable.size();
+	conditionIds[_tag] = id;
+	conditionTable.push_back(std::function<bool(sweet::Event *)>());
+	return id;
+}
+
+const std::function<bool(sweet::Event *)> & Scenario::getConditionImplementation(unsigned long int _id) const{
+	return conditionTable.at(_id);
+}
+
+void Scenario::registerCondition(const std::string & _tag, std::function<bool(sweet::Event *)> _implementation){
+	conditionTable.at(getConditionId(_tag)) = _implementation;
+}
+
+void Scenario::registerConditions(const ConditionImplementations & _implementations){
+	for(auto & i : _implementations){
+		registerCondition(i.first, i.second);
 	}
 }
 
@@ -141,6 +205,8 @@ Scenario::~Scenario(){
 	}assets.clear();
 	delete variables;
 	delete eventManager;
+	// the destructor unmounts it
+	delete archive;
 }
 
 Asset * Scenario::getAsset(std::string _type, std::string _id){
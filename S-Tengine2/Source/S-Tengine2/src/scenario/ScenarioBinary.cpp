@@ -0,0 +1,450 @@
+#pragma once
+
+#include <scenario/ScenarioBinary.h>
+#include <scenario/Scenario.h>
+#include <scenario/Conversation.h>
+#include <scenario/Dialogue.h>
+#include <scenario/Conditions.h>
+
+#include <EventManager.h>
+#include <FileUtils.h>
+#include <Log.h>
+
+#include <fstream>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace{
+	const char MAGIC[4] = {'S', 'T', 'S', 'C'};
+	const unsigned long int VERSION = 2;
+	const unsigned long int NO_LINK = 0xFFFFFFFF;
+
+	typedef enum{
+		kJSON_ASSET,
+		kCONVERSATION
+	} AssetKind;
+
+	typedef enum{
+		kNULL,
+		kINT,
+		kUINT,
+		kREAL,
+		kSTRING,
+		kBOOL,
+		kARRAY,
+		kOBJECT
+	} JsonType;
+
+	typedef enum{
+		kARG_INT,
+		kARG_FLOAT,
+		kARG_STRING
+	} ArgType;
+
+	// writes little-endian values into a buffer, and collects strings into a table
+	class Writer{
+	public:
+		std::string body;
+		std::vector<std::string> strings;
+		std::map<std::string, unsigned long int> stringIds;
+
+		void writeBytes(const void * _data, size_t _size){
+			body.append((const char *)_data, _size);
+		}
+		void writeU8(unsigned char _v){
+			body.push_back((char)_v);
+		}
+		void writeU32(unsigned long int _v){
+			for(unsigned long int i = 0; i < 4; ++i){
+				body.push_back((char)((_v >> (i*8)) & 0xFF));
+			}
+		}
+		void writeU64(unsigned long long int _v){
+			for(unsigned long int i = 0; i < 8; ++i){
+				body.push_back((char)((_v >> (i*8)) & 0xFF));
+			}
+		}
+		void writeFloat(float _v){
+			unsigned long int bits;
+			memcpy(&bits, &_v, 4);
+			writeU32(bits);
+		}
+		void writeDouble(double _v){
+			unsigned long long int bits;
+			memcpy(&bits, &_v, 8);
+			writeU64(bits);
+		}
+		void writeString(const std::string & _s){
+			auto it = stringIds.find(_s);
+			if(it == stringIds.end()){
+				it = stringIds.insert(std::make_pair(_s, strings.size())).first;
+				strings.push_back(_s);
+			}
+			writeU32(it->second);
+		}
+
+		void writeJson(const Json::Value & _v){
+			switch(_v.type()){
+			case Json::intValue:
+				writeU8(kINT);
+				writeU64((unsigned long long int)_v.asLargestInt());
+				break;
+			case Json::uintValue:
+				writeU8(kUINT);
+				writeU64(_v.asLargestUInt());
+				break;
+			case Json::realValue:
+				writeU8(kREAL);
+				writeDouble(_v.asDouble());
+				break;
+			case Json::stringValue:
+				writeU8(kSTRING);
+				writeString(_v.asString());
+				break;
+			case Json::booleanValue:
+				writeU8(kBOOL);
+				writeU8(_v.asBool() ? 1 : 0);
+				break;
+			case Json::arrayValue:
+				writeU8(kARRAY);
+				writeU32(_v.size());
+				for(Json::Value::ArrayIndex i = 0; i < _v.size(); ++i){
+					writeJson(_v[i]);
+				}
+				break;
+			case Json::objectValue:{
+				writeU8(kOBJECT);
+				Json::Value::Members members = _v.getMemberNames();
+				writeU32(members.size());
+				for(auto & m : members){
+					writeString(m);
+					writeJson(_v[m]);
+				}
+				break;
+			}
+			default:
+				writeU8(kNULL);
+				break;
+			}
+		}
+
+		// writes the event's tag and typed data (as converted by its json constructor)
+		void writeEvent(const Json::Value & _json){
+			sweet::Event e(_json);
+			writeString(e.tag);
+			writeU32(e.getAllIntData().size() + e.getAllFloatData().size() + e.getAllStringData().size());
+			for(auto & d : e.getAllIntData()){
+				writeString(d.first);
+				writeU8(kARG_INT);
+				writeU32((unsigned long int)d.second);
+			}
+			for(auto & d : e.getAllFloatData()){
+				writeString(d.first);
+				writeU8(kARG_FLOAT);
+				writeFloat(d.second);
+			}
+			for(auto & d : e.getAllStringData()){
+				writeString(d.first);
+				writeU8(kARG_STRING);
+				writeString(d.second);
+			}
+		}
+	};
+
+	// bounds-checked reader; once anything is out of range, ok is false and everything reads as zero
+	class Reader{
+	public:
+		const unsigned char * pos;
+		const unsigned char * end;
+		std::vector<std::string> strings;
+		bool ok;
+
+		Reader(const std::string & _data) :
+			pos((const unsigned char *)_data.data()),
+			end((const unsigned char *)_data.data() + _data.size()),
+			ok(true)
+		{
+		}
+
+		bool has(size_t _size){
+			if(!ok || (size_t)(end - pos) < _size){
+				ok = false;
+			}
+			return ok;
+		}
+		unsigned char readU8(){
+			return has(1) ? *pos++ : 0;
+		}
+		unsigned long int readU32(){
+			if(!has(4)){
+				return 0;
+			}
+			unsigned long int v = pos[0] | (pos[1] << 8) | (pos[2] << 16) | ((unsigned long int)pos[3] << 24);
+			pos += 4;
+			return v;
+		}
+		unsigned long long int readU64(){
+			unsigned long long int lo = readU32();
+			unsigned long long int hi = readU32();
+			return lo | (hi << 32);
+		}
+		float readFloat(){
+			unsigned long int bits = readU32();
+			float v;
+			memcpy(&v, &bits, 4);
+			return v;
+		}
+		double readDouble(){
+			unsigned long long int bits = readU64();
+			double v;
+			memcpy(&v, &bits, 8);
+			return v;
+		}
+		const std::string & readString(){
+			static const std::string empty;
+			unsigned long int idx = readU32();
+			if(idx >= strings.size()){
+				ok = false;
+				return empty;
+			}
+			return strings[idx];
+		}
+
+		Json::Value readJson(unsigned long int _depth = 0){
+			if(_depth > 256){
+				ok = false;
+			}
+			if(!ok){
+				return Json::Value();
+			}
+			switch(readU8()){
+			case kINT: return Json::Value((Json::LargestInt)readU64());
+			case kUINT: return Json::Value((Json::LargestUInt)readU64());
+			case kREAL: return Json::Value(readDouble());
+			case kSTRING: return Json::Value(readString());
+			case kBOOL: return Json::Value(readU8() != 0);
+			case kARRAY:{
+				Json::Value v(Json::arrayValue);
+				unsigned long int n = readU32();
+				for(unsigned long int i = 0; i < n && ok; ++i){
+					v.append(readJson(_depth + 1));
+				}
+				return v;
+			}
+			case kOBJECT:{
+				Json::Value v(Json::objectValue);
+				unsigned long int n = readU32();
+				for(unsigned long int i = 0; i < n && ok; ++i){
+					const std::string & key = readString();
+					v[key] = readJson(_depth + 1);
+				}
+				return v;
+			}
+			default: return Json::Value();
+			}
+		}
+
+		sweet::Event * readEvent(){
+			sweet::Event * e = new sweet::Event(readString());
+			unsigned long int n = readU32();
+			for(unsigned long int i = 0; i < n && ok; ++i){
+				const std::string & key = readString();
+				switch(readU8()){
+				case kARG_INT: e->setIntData(key, (int)readU32()); break;
+				case kARG_FLOAT: e->setFloatData(key, readFloat()); break;
+				case kARG_STRING: e->setStringData(key, readString()); break;
+				default: ok = false; break;
+				}
+			}
+			return e;
+		}
+	};
+}
+
+void ScenarioBinary::compile(const Json::Value & _root, std::string & _output){
+	Writer w;
+
+	// the whole root (including the assets' json) is kept so that Scenario::root is the same as when the json is loaded
+	w.writeJson(_root);
+
+	const Json::Value assetsJson = _root["assets"];
+
+	// conversation links are resolved to the index of the conversation they refer to
+	// if there are duplicate ids, the last one wins (as it would when the json is loaded)
+	std::map<std::string, unsigned long int> conversationIds;
+	unsigned long int numConversations = 0;
+	for(Json::Value::ArrayIndex i = 0; i < assetsJson.size(); ++i){
+		if(assetsJson[i].get("type", "NO_TYPE").asString() == "conversation"){
+			conversationIds[assetsJson[i].get("id", "NO_ID").asString()] = numConversations++;
+		}
+	}
+
+	w.writeU32(assetsJson.size());
+	for(Json::Value::ArrayIndex i = 0; i < assetsJson.size(); ++i){
+		const Json::Value & a = assetsJson[i];
+		if(a.get("type", "NO_TYPE").asString() != "conversation"){
+			w.writeU8(kJSON_ASSET);
+			w.writeJson(a);
+			continue;
+		}
+
+		// the same defaults as Conversation, Dialogue, and Option
+		w.writeU8(kCONVERSATION);
+		w.writeString(a.get("id", "NO_ID").asString());
+
+		const Json::Value dialogueJson = a["dialogue"];
+		w.writeU32(dialogueJson.size());
+		for(Json::Value::ArrayIndex j = 0; j < dialogueJson.size(); ++j){
+			const Json::Value & d = dialogueJson[j];
+			w.writeString(d.get("speaker", "NO_SPEAKER_DEFINED").asString());
+			const Json::Value textJson = d["text"];
+			w.writeU32(textJson.size());
+			for(Json::Value t : textJson){
+				w.writeString(t.asString());
+			}
+			const Json::Value triggersJson = d["triggers"];
+			w.writeU32(triggersJson.size());
+			for(Json::Value t : triggersJson){
+				w.writeEvent(t);
+			}
+			const Json::Value conditionsJson = d["conditions"];
+			w.writeU32(conditionsJson.size());
+			for(Json::Value c : conditionsJson){
+				w.writeEvent(c);
+			}
+		}
+
+		const Json::Value optionsJson = a["options"];
+		w.writeU32(optionsJson.size());
+		for(Json::Value::ArrayIndex j = 0; j < optionsJson.size(); ++j){
+			const Json::Value & o = optionsJson[j];
+			std::string link = o.get("convoId", "END").asString();
+			w.writeString(o.get("label", "").asString());
+			w.writeString(link);
+			auto target = conversationIds.find(link);
+			w.writeU32(target != conversationIds.end() ? target->second : NO_LINK);
+		}
+	}
+
+	// header, string table, then the body
+	Writer header;
+	header.writeBytes(MAGIC, 4);
+	header.writeU32(VERSION);
+	header.writeU32(w.strings.size());
+	for(auto & s : w.strings){
+		header.writeU32(s.size());
+		header.writeBytes(s.data(), s.size());
+	}
+	_output = header.body + w.body;
+}
+
+bool ScenarioBinary::compileFile(std::string _jsonSrc, std::string _outputSrc){
+	Json::Reader reader;
+	Json::Value root;
+	if(!reader.parse(sweet::FileUtils::readFile(_jsonSrc), root)){
+		Log::error("JSON parse failed: " + reader.getFormattedErrorMessages());
+		return false;
+	}
+	std::string output;
+	compile(root, output);
+
+	std::ofstream file(_outputSrc, std::ios::out | std::ios::binary);
+	if(!file.is_open()){
+		Log::error("File \"" + _outputSrc + "\" could not be opened for writing.");
+		return false;
+	}
+	file.write(output.data(), output.size());
+	return true;
+}
+
+bool ScenarioBinary::isCompiled(const std::string & _data){
+	return _data.size() >= 4 && memcmp(_data.data(), MAGIC, 4) == 0;
+}
+
+bool ScenarioBinary::load(const std::string & _data, Scenario * _scenario){
+	if(!isCompiled(_data)){
+		return false;
+	}
+	Reader r(_data);
+	r.pos += 4;
+	if(r.readU32() != VERSION){
+		Log::error("Compiled scenario is from a different version.");
+		return false;
+	}
+
+	unsigned long int numStrings = r.readU32();
+	for(unsigned long int i = 0; i < numStrings && r.has(4); ++i){
+		unsigned long int len = r.readU32();
+		if(r.has(len)){
+			r.strings.push_back(std::string((const char *)r.pos, len));
+			r.pos += len;
+		}
+	}
+
+	_scenario->root = r.readJson();
+
+	std::vector<AssetConversation *> conversations;
+	std::vector<std::vector<unsigned long int>> links;
+	unsigned long int numAssets = r.readU32();
+	for(unsigned long int i = 0; i < numAssets && r.ok; ++i){
+		Asset * a = nullptr;
+		if(r.readU8() == kJSON_ASSET){
+			a = Asset::getAsset(r.readJson(), _scenario);
+		}else{
+			Json::Value json;
+			json["id"] = r.readString();
+			json["type"] = "conversation";
+			AssetConversation * ac = AssetConversation::create(json, _scenario);
+			Conversation * c = ac->conversation;
+
+			unsigned long int numDialogue = r.readU32();
+			for(unsigned long int j = 0; j < numDialogue && r.ok; ++j){
+				Dialogue * d = new Dialogue(r.readString(), _scenario);
+				unsigned long int numText = r.readU32();
+				for(unsigned long int k = 0; k < numText && r.ok; ++k){
+					d->text.push_back(r.readString());
+				}
+				unsigned long int numTriggers = r.readU32();
+				for(unsigned long int k = 0; k < numTriggers && r.ok; ++k){
+					sweet::Event * e = r.readEvent();
+					e->setStringData("scenario", _scenario->id);
+					d->triggers.push_back(e);
+				}
+				unsigned long int numConditions = r.readU32();
+				for(unsigned long int k = 0; k < numConditions && r.ok; ++k){
+					d->conditions.push_back(new Condition(r.readEvent(), _scenario));
+				}
+				c->dialogueObjects.push_back(d);
+			}
+
+			links.push_back(std::vector<unsigned long int>());
+			unsigned long int numOptions = r.readU32();
+			for(unsigned long int j = 0; j < numOptions && r.ok; ++j){
+				std::string text = r.readString();
+				c->options.push_back(new Option(text, r.readString()));
+				links.back().push_back(r.readU32());
+			}
+			conversations.push_back(ac);
+			a = ac;
+		}
+		if(a != nullptr){
+			_scenario->assets[a->type][a->id] = a;
+		}
+	}
+
+	for(unsigned long int i = 0; i < conversations.size(); ++i){
+		std::vector<Option *> & options = conversations[i]->conversation->options;
+		for(unsigned long int j = 0; j < options.size() && j < links[i].size(); ++j){
+			unsigned long int target = links[i][j];
+			if(target != NO_LINK && target < conversations.size()){
+				options[j]->linkedConversation = conversations[target]->conversation;
+			}
+		}
+	}
+
+	if(!r.ok){
+		Log::error("Compiled scenario is truncated or malformed.");
+	}
+	return r.ok;
+}
\ No newline at end of file
@@ -1,41 +1,88 @@
+#pragma once
+
 #include "shader/BlurShader.h"
+#include <BlurKernel.h>
+
+#include <sstream>
 
-BlurShader::BlurShader(bool _autoRelease) : Shader( _autoRelease)
+BlurShader::BlurShader(bool _autoRelease) :
+	Shader( _autoRelease),
+	texelStepLocation(-1),
+	numTapsLocation(-1),
+	tapOffsetsLocation(-1),
+	tapWeightsLocation(-1)
 {
 	init(getVertString(), getFragString());
 }
 
+void BlurShader::load(){
+	if(!loaded){
+		Shader::load();
+		texelStepLocation = glGetUniformLocation(getProgramId(), "texelStep");
+		numTapsLocation = glGetUniformLocation(getProgramId(), "numTaps");
+		tapOffsetsLocation = glGetUniformLocation(getProgramId(), "tapOffsets");
+		tapWeightsLocation = glGetUniformLocation(getProgramId(), "tapWeights");
+	}
+}
+
+void BlurShader::unload(){
+	if(loaded){
+		texelStepLocation = -1;
+		numTapsLocation = -1;
+		tapOffsetsLocation = -1;
+		tapWeightsLocation = -1;
+	}
+	Shader::unload();
+}
+
+void BlurShader::setPass(const sweet::BlurKernel & _kernel, float _stepU, float _stepV){
+	glUniform2f(texelStepLocation, _stepU, _stepV);
+	glUniform1i(numTapsLocation, _kernel.getTapCount());
+	glUniform1fv(tapOffsetsLocation, _kernel.getTapCount(), _kernel.tapOffsets.data());
+	glUniform1fv(tapWeightsLocation, _kernel.getTapCount(), _kernel.tapWeights.data());
+}
+
+void BlurShader::setCopy(){
+	float one = 1.f;
+	float zero = 0.f;
+	glUniform2f(texelStepLocation, 0.f, 0.f);
+	glUniform1i(numTapsLocation, 1);
+	glUniform1fv(tapOffsetsLocation, 1, &zero);
+	glUniform1fv(tapWeightsLocation, 1, &one);
+}
+
 std::string BlurShader::getVertString(){
 	return
 		"#version 150\n"
-		"#extension GL_ARB_explicit_attrib_location : enable\n"
 
-		"layout(location = 1) in vec2 aVertexPosition;\n"
-		"layout(location = 2) in vec2 aVertexUVs;\n"
+		"in vec3 aVertexPosition;\n"
+		"in vec2 aVertexUVs;\n"
 		"out vec2 Texcoord;\n"
 		"void main() {\n"
 			"Texcoord = aVertexUVs;\n"
-			"gl_Position = vec4(aVertexPosition, 0.0, 1.0);\n"
+			"gl_Position = vec4(aVertexPosition.xy, 0.0, 1.0);\n"
 		"}";
 }
 
 std::string BlurShader::getFragString(){
-	return
-		"#version 150\n"
+	std::stringstream ss;
+	ss << "#version 150\n"
 		"in vec2 Texcoord;\n"
 		"out vec4 outColor;\n"
 		"uniform sampler2D texFramebuffer;\n"
 
-		"const float blurSizeH = 1.0 / 2000.0;\n"
-		"const float blurSizeV = 1.0 / 2000.0;\n"
+		// distance between texels along the pass, in UV space
+		"uniform vec2 texelStep;\n"
+		"uniform int numTaps;\n"
+		"uniform float tapOffsets[" << sweet::BlurKernel::MAX_TAPS << "];\n"
+		"uniform float tapWeights[" << sweet::BlurKernel::MAX_TAPS << "];\n"
 		"void main() {\n"
-			"vec4 sum = vec4(0.0);\n"
-			"for (int x = -4; x <= 4; x++)\n"
-				"for (int y = -4; y <= 4; y++)\n"
-					"sum += texture(\n"
-						"texFramebuffer,\n"
-						"vec2(Texcoord.x + x * blurSizeH, Texcoord.y + y * blurSizeV)\n"
-					") / 81.0;\n"
+			"vec4 sum = texture(texFramebuffer, Texcoord) * tapWeights[0];\n"
+			"for (int i = 1; i < numTaps; i++) {\n"
+				"vec2 o = texelStep * tapOffsets[i];\n"
+				"sum += (texture(texFramebuffer, Texcoord + o) + texture(texFramebuffer, Texcoord - o)) * tapWeights[i];\n"
+			"}\n"
 			"outColor = sum;\n"
 		"}\n";
+	return ss.str();
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "MatrixStack.h"
 #include "RenderOptions.h"
 #include "shader/GeometryComponent.h"
+#include <Profiler.h>
 
 ComponentShaderBase::ComponentShaderBase(bool _autoRelease) :
 	Shader(_autoRelease),
@@ -140,6 +141,7 @@ void ComponentShaderBase::clean(sweet::MatrixStack* _matrixStack, RenderOptions*
 	for(unsigned long int i = 0; i < components.size(); i++){
 		components.at(i)->clean(_matrixStack, _renderOption, _nodeRenderable);
 	}
+	SWEET_PROFILE_COUNT(kUNIFORM_UPLOADS, components.size());
 
 	if(geometryComponent != nullptr){
 		geometryComponent->clean(_matrixStack, _renderOption, _nodeRenderable);
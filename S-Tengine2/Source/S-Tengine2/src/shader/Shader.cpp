@@ -112,6 +112,11 @@ void Shader::load(){
 		if (hasGeometryShader){
 			glAttachShader(programId, geometryShader);
 		}
+		// fixed attribute locations (see ShaderVariables.h); these have to be bound before linking
+		glBindAttribLocation(programId, GL_ATTRIBUTE_LOCATION_VERTEX_POSITION, GL_ATTRIBUTE_ID_VERTEX_POSITION.c_str());
+		glBindAttribLocation(programId, GL_ATTRIBUTE_LOCATION_VERTEX_COLOR, GL_ATTRIBUTE_ID_VERTEX_COLOR.c_str());
+		glBindAttribLocation(programId, GL_ATTRIBUTE_LOCATION_VERTEX_NORMALS, GL_ATTRIBUTE_ID_VERTEX_NORMALS.c_str());
+		glBindAttribLocation(programId, GL_ATTRIBUTE_LOCATION_VERTEX_UVS, GL_ATTRIBUTE_ID_VERTEX_UVS.c_str());
 		glLinkProgram(programId);
 		checkForGlError(false);
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "shader/ShaderComponentDrawColour.h"
+#include "shader/ShaderVariables.h"
+#include "shader/ComponentShaderBase.h"
+#include "MatrixStack.h"
+#include "RenderOptions.h"
+#include "DrawData.h"
+
+ShaderComponentDrawColour::ShaderComponentDrawColour(ComponentShaderBase * _shader) :
+	ShaderComponent(_shader),
+	colourLoc(-1)
+{
+}
+
+ShaderComponentDrawColour::~ShaderComponentDrawColour(){
+}
+
+std::string ShaderComponentDrawColour::getVertexVariablesString(){
+	return DEFINE + SHADER_COMPONENT_DRAW_COLOUR + ENDL;
+}
+
+std::string ShaderComponentDrawColour::getFragmentVariablesString(){
+	return 
+		DEFINE + SHADER_COMPONENT_DRAW_COLOUR + ENDL +
+		"uniform vec4 " + GL_UNIFORM_ID_DRAW_COLOUR + SEMI_ENDL;
+}
+
+std::string ShaderComponentDrawColour::getVertexBodyString(){
+	return "";
+}
+
+std::string ShaderComponentDrawColour::getFragmentBodyString(){
+	return "";
+}
+
+std::string ShaderComponentDrawColour::getOutColorMod(){
+	return GL_OUT_OUT_COLOR + " *= " + GL_UNIFORM_ID_DRAW_COLOUR + SEMI_ENDL;
+}
+
+void ShaderComponentDrawColour::clean(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable){
+	// the colour is per-draw
+	makeDirty();
+	ShaderComponent::clean(_matrixStack, _renderOption, _nodeRenderable);
+}
+
+void ShaderComponentDrawColour::load(){
+	if(!loaded){
+		colourLoc = glGetUniformLocation(shader->getProgramId(), GL_UNIFORM_ID_DRAW_COLOUR.c_str());
+	}
+	ShaderComponent::load();
+}
+
+void ShaderComponentDrawColour::configureUniforms(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable){
+	if(_renderOption->drawData != nullptr){
+		glUniform4fv(colourLoc, 1, &_renderOption->drawData->colour.x);
+	}else{
+		glUniform4f(colourLoc, 1.f, 1.f, 1.f, 1.f);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "shader/ShaderComponentSpriteSheet.h"
+#include "shader/ShaderVariables.h"
+#include "shader/ComponentShaderBase.h"
+#include "MatrixStack.h"
+#include "RenderOptions.h"
+#include "node/NodeRenderable.h"
+#include "DrawData.h"
+#include "SpriteSheet.h"
+
+#include <algorithm>
+
+ShaderComponentSpriteSheet::ShaderComponentSpriteSheet(ComponentShaderBase * _shader) :
+	ShaderComponent(_shader),
+	framesLoc(-1),
+	frameLoc(-1),
+	rectLoc(-1),
+	currentFrameTable(-1)
+{
+}
+
+ShaderComponentSpriteSheet::~ShaderComponentSpriteSheet(){
+}
+
+std::string ShaderComponentSpriteSheet::getVertexVariablesString(){
+	return 
+		DEFINE + SHADER_COMPONENT_SPRITE_SHEET + ENDL +
+		"uniform vec4 " + GL_UNIFORM_ID_SPRITE_FRAMES + "[" + std::to_string(MAX_SPRITE_FRAMES) + "]" + SEMI_ENDL +
+		"uniform int " + GL_UNIFORM_ID_SPRITE_FRAME + SEMI_ENDL +
+		"uniform vec4 " + GL_UNIFORM_ID_SPRITE_RECT + SEMI_ENDL;
+}
+
+std::string ShaderComponentSpriteSheet::getFragmentVariablesString(){
+	return DEFINE + SHADER_COMPONENT_SPRITE_SHEET + ENDL;
+}
+
+std::string ShaderComponentSpriteSheet::getVertexBodyString(){
+	// frames and rects are stored as (x, y, width, height), with the top of the quad at y + height
+	return
+		"vec4 uvRect = " + GL_UNIFORM_ID_SPRITE_RECT + SEMI_ENDL +
+		"if(" + GL_UNIFORM_ID_SPRITE_FRAME + " >= 0){" + ENDL +
+			TAB + "uvRect = " + GL_UNIFORM_ID_SPRITE_FRAMES + "[" + GL_UNIFORM_ID_SPRITE_FRAME + "]" + SEMI_ENDL +
+		"}" + ENDL +
+		GL_IN_OUT_FRAG_UV + " = vec2(uvRect.x + " + GL_IN_OUT_FRAG_UV + ".x * uvRect.z, uvRect.y + (1.0 - " + GL_IN_OUT_FRAG_UV + ".y) * uvRect.w)" + SEMI_ENDL;
+}
+
+std::string ShaderComponentSpriteSheet::getFragmentBodyString(){
+	return "";
+}
+
+std::string ShaderComponentSpriteSheet::getOutColorMod(){
+	return "";
+}
+
+void ShaderComponentSpriteSheet::clean(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable){
+	// the frame index and rect are per-draw
+	makeDirty();
+	ShaderComponent::clean(_matrixStack, _renderOption, _nodeRenderable);
+}
+
+void ShaderComponentSpriteSheet::load(){
+	if(!loaded){
+		framesLoc = glGetUniformLocation(shader->getProgramId(), GL_UNIFORM_ID_SPRITE_FRAMES.c_str());
+		frameLoc = glGetUniformLocation(shader->getProgramId(), GL_UNIFORM_ID_SPRITE_FRAME.c_str());
+		rectLoc = glGetUniformLocation(shader->getProgramId(), GL_UNIFORM_ID_SPRITE_RECT.c_str());
+	}
+	ShaderComponent::load();
+}
+
+void ShaderComponentSpriteSheet::unload(){
+	// the program's uniforms are lost along with it
+	currentFrameTable = -1;
+	ShaderComponent::unload();
+}
+
+void ShaderComponentSpriteSheet::configureUniforms(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable){
+	const DrawData * drawData = _renderOption->drawData;
+	if(drawData != nullptr && drawData->spriteSheet != nullptr && drawData->frame >= 0 && drawData->frame < MAX_SPRITE_FRAMES){
+		const SpriteSheet * sheet = drawData->spriteSheet;
+		if(sheet->frameTableId != currentFrameTable && sheet->frameTable.size() > 0){
+			glUniform4fv(framesLoc, std::min<unsigned long int>(sheet->frameTable.size(), MAX_SPRITE_FRAMES), &sheet->frameTable[0].x);
+			currentFrameTable = sheet->frameTableId;
+		}
+		glUniform1i(frameLoc, drawData->frame);
+	}else{
+		glUniform1i(frameLoc, -1);
+		if(drawData != nullptr){
+			glUniform4fv(rectLoc, 1, &drawData->uvRect.x);
+		}else{
+			glUniform4f(rectLoc, 0.f, 1.f, 1.f, -1.f);
+		}
+	}
+}
\ No newline at end of file
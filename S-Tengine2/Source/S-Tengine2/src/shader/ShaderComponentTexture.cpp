@@ -8,6 +8,7 @@
 #include "Texture.h"
 #include "node/NodeRenderable.h"
 #include "MeshInterface.h"
+#include "DrawData.h"
 #include "Sprite.h"
 #include "SpriteSheetAnimation.h"
 
@@ -93,16 +94,18 @@ void ShaderComponentTexture::unload(){
 void ShaderComponentTexture::configureUniforms(sweet::MatrixStack* _matrixStack, RenderOptions* _renderOption, NodeRenderable* _nodeRenderable){
 	MeshInterface * mesh = dynamic_cast<MeshInterface *>(_nodeRenderable);
 	if(mesh != nullptr){
+		// the entity's draw data textures take priority over the mesh's
+		const std::vector<Texture *> & textures = (_renderOption->drawData != nullptr && _renderOption->drawData->textures.size() > 0) ? _renderOption->drawData->textures : mesh->textures;
 		// check if the number of textures has changes and send new value to OpenGL
-		unsigned long int newNumTextures = mesh->textureCount();
+		unsigned long int newNumTextures = textures.size();
 		if(newNumTextures != numTextures){
 			glUniform1i(texNumLoc, newNumTextures);
 			numTextures = newNumTextures;
 		}
 		// Bind each texture to the texture sampler array in the frag _shader
-		for(unsigned long int i = 0; i < mesh->textureCount(); ++i){
+		for(unsigned long int i = 0; i < textures.size(); ++i){
 			glActiveTexture(GL_TEXTURE0 + i);
-			glBindTexture(GL_TEXTURE_2D, mesh->getTexture(i)->textureId);
+			glBindTexture(GL_TEXTURE_2D, textures.at(i)->textureId);
 			glUniform1i(texSamLoc, i);
 		}
 	}else{